@@ -27,18 +27,32 @@
 
 #include "OPTIGATrustX.h"
 #include <Arduino.h>
+#include "optiga_trustx/ObjectDump.h"
 #include "debug.h"
 
 uint8_t sys_init =0;
 
-uint16_t OID[] = {0xE0C0, 0xE0C1, 0xE0C2, 0xE0C3, 0xE0C4, 0xE0C5, 0xE0C6, 0xE0E0, 0xE0E1, 0xE0E2, 0xE0E3, 0xE0E8, 0xE0EF};
-uint16_t OID_max_size[] = {1, 1, 27, 1, 1, 1, 2, 1728, 1728, 1728, 1728, 1024, 1024};
-#define MAX_OID_SIZE_VALUE  1728
+/*
+ * Objects of each section are read into one snapshot: metadata and data of all objects back to back,
+ * keys and session contexts with their metadata only. Objects not fitting the buffer are marked in the snapshot.
+ */
+#define SNAPSHOT_SIZE  2048
+uint8_t snapshot[SNAPSHOT_SIZE];
+
+const uint16_t CHARACTERISTICS_OID[] = {0xE0C0, 0xE0C1, 0xE0C2, 0xE0C3, 0xE0C4, 0xE0C5, 0xE0C6, 0xF1C0};
+const uint16_t IFX_CERT_OID[] = {0xE0E0};
+const uint16_t PROJECT_CERT_OID[] = {0xE0E1, 0xE0E2, 0xE0E3};
+const uint16_t ROOTCA_CERT_OID[] = {0xE0E8, 0xE0EF};
+const uint16_t KEY_SESSION_OID[] = {0xE0F0, 0xE0F1, 0xE0F2, 0xE0F3, 0xE100, 0xE101, 0xE102, 0xE103};
+const uint16_t SMALL_DATA_OID[] = {0xF1D0, 0xF1D1, 0xF1D2, 0xF1D3, 0xF1D4, 0xF1D5, 0xF1D6, 0xF1D7,
+                                   0xF1D8, 0xF1D9, 0xF1DA, 0xF1DB, 0xF1DC, 0xF1DD, 0xF1DE};
+const uint16_t LARGE_DATA_OID[] = {0xF1E0, 0xF1E1};
 
 #define ENABLE_TRUSTX_CHARACTERISTICS_OBJECT  1
 #define ENABLE_IFX_ISSUED_CERT_OBJECT         1
 #define ENABLE_PROJECT_SPECIFIC_CERT_OBJECTS  1
 #define ENABLE_ROOTCA_CERTIFICATES            1
+#define ENABLE_KEY_AND_SESSION_METADATA       1
 #define ENABLE_ARBITRARY_OBJECTS              1
 
 #define EASY_CUT_PASTE 1
@@ -74,65 +88,66 @@ uint8_t reset()
   return 0;
 }
 
-void printObject(uint8_t object)
+void printBytes(const uint8_t* p_data, uint16_t len)
 {
-  uint32_t ret = 0;
-  uint16_t MAX_OID_SIZE =1500;
-  uint8_t temp[MAX_OID_SIZE_VALUE];
-
-  //Clear temp buffer
-  memset(temp, 0x0, MAX_OID_SIZE_VALUE);
-
-  ret = trustX.getArbitaryDataObject(OID[object], temp, OID_max_size[object]);
-  if (ret){
-    Serial.print("Error: Failed to read object");
-    Serial.println(ret, HEX);
-  }
-  else{
 #if (EASY_CUT_PASTE ==1)
-      HEXONLYDUMP(temp, OID_max_size[object]);Serial.println("============");
+  HEXONLYDUMP(p_data, len);Serial.println("============");
 #endif
-      HEXDUMP(temp, OID_max_size[object]);
-    }
+  HEXDUMP(p_data, len);
 }
 
-void printDataObject(uint16_t object)
+void dumpObjects(const char* title, const uint16_t oids[], uint8_t count)
 {
   uint32_t ret = 0;
-  uint16_t MAX_BIG_SIZE =1500;
-  uint16_t MAX_SMALL_SIZE =100;
-  uint8_t temp[MAX_BIG_SIZE];
-
-  //Clear temp buffer
-  memset(temp, 0x0, MAX_BIG_SIZE);
-
-  if((object == 0xF1E0) || ( object ==0xF1E1)){
-    //Serial.println("Large Data Object");
-    ret = trustX.getArbitaryDataObject(object, temp, MAX_BIG_SIZE);
-  }
-  else{
-    //Serial.println("Small Data Object");
-    ret = trustX.getArbitaryDataObject(object, temp, MAX_SMALL_SIZE);
-  }
-  if (ret){
-    Serial.print("Error: Failed to read object");
+  uint16_t length = SNAPSHOT_SIZE;
+  uint32_t ts = 0;
+  sObjDumpHeader_d header;
+  sObjDumpEntry_d entry;
+
+  Serial.print("\r\n");
+  Serial.println(title);
+
+  ts = millis();
+  ret = trustX.getObjectSnapshot(oids, count, snapshot, length);
+  ts = millis() - ts;
+  if (ret || ObjDump_GetHeader(snapshot, length, &header) != INT_LIB_OK) {
+    Serial.print("Error: Failed to read snapshot");
     Serial.println(ret, HEX);
+    return;
   }
-  else{
-    if((object == 0xF1E0) || ( object ==0xF1E1))
-    {
-#if (EASY_CUT_PASTE ==1)
-      HEXONLYDUMP(temp, MAX_BIG_SIZE);Serial.println("============");
-#endif
-      HEXDUMP(temp, MAX_BIG_SIZE);
-    }else{
-#if (EASY_CUT_PASTE ==1)
-      HEXONLYDUMP(temp, MAX_SMALL_SIZE);Serial.println("============");
-#endif
-      HEXDUMP(temp, MAX_SMALL_SIZE);
-      }
+
+  Serial.print("Snapshot of ");
+  Serial.print(header.bEntries);
+  Serial.print(" objects, ");
+  Serial.print(header.wLength);
+  Serial.print(" bytes in ");
+  Serial.print(ts);
+  Serial.println(" ms");
+
+  for (uint8_t i = 0; i < header.bEntries; i++) {
+    if (ObjDump_GetEntry(snapshot, length, i, &entry) != INT_LIB_OK) {
+      continue;
+    }
+    Serial.print("\r\nData Object: 0x");
+    Serial.println(entry.wOID, HEX);
+    switch (entry.bStatus) {
+      case eOBJ_DUMP_ACCESS_DENIED: Serial.println("Data not readable"); break;
+      case eOBJ_DUMP_NO_SPACE:      Serial.println("Error: Snapshot buffer too small"); break;
+      case eOBJ_DUMP_METADATA_FAILED: Serial.println("Error: Failed to read object"); break;
+      case eOBJ_DUMP_DATA_FAILED:   Serial.println("Error: Failed to read data"); break;
+      default: break;
+    }
+    if (entry.sMetaData.wLen != 0) {
+      Serial.println("Metadata:");
+      printBytes(entry.sMetaData.prgbStream, entry.sMetaData.wLen);
+    }
+    if (entry.sData.wLen != 0) {
+      Serial.println("Data:");
+      printBytes(entry.sData.prgbStream, entry.sData.wLen);
+    }
   }
 }
+
 void loop()
 {
   uint32_t ret = 0;
@@ -141,96 +156,32 @@ void loop()
   {
 
 #if (ENABLE_TRUSTX_CHARACTERISTICS_OBJECT == 1)
-    // Get Data structure Global (LcsG) = 0xE0C0
-    Serial.print("\r\nLscG Object(Default=0x07): 0x");
-    Serial.println(OID[0],HEX);
-    printObject(0);
-
-    // Get Security State = E0C1
-    Serial.print("\r\nSecurity State Object(Default=0x00): 0x");
-    Serial.println(OID[1],HEX);
-    printObject(1);
-
-    // Get co-processor Unique ID of 27 bytes  = 0xE0C2
-    Serial.print("\r\nGet co-processor Unique ID Object: 0x");
-    Serial.println(OID[2],HEX);
-    printObject(2);
-
-    // Get Sleep mode activation delay  = 0xE0C3
-    Serial.print("\r\nSleep mode activation delay Object(Default=0x14): 0x");
-    Serial.println(OID[3],HEX);
-    printObject(3);
-
-    // Get current limitation  = 0xE0C4
-    Serial.print("\r\nCurrent limit Object(Default=0x06): 0x");
-    Serial.println(OID[4],HEX);
-    printObject(4);
-
-    // Get Security Event Counter  = 0xE0C5
-    Serial.print("\r\nSecurity Event Counter Object(Default=0xXX): 0x");
-    Serial.println(OID[5],HEX);
-    printObject(5);
-
-    // Get Max Com buffer Size  = 0xE0C6
-    Serial.print("\r\nMax Comm buffer size Object(Default=0xXX 0xXX): 0x");
-    Serial.println(OID[6],HEX);
-    printObject(6);
+    // LcsG, Security State, Unique ID, Sleep mode activation delay, Current limit,
+    // Security Event Counter, Max Comm buffer size and LcsA
+    dumpObjects("Trust X characteristics", CHARACTERISTICS_OID, sizeof(CHARACTERISTICS_OID) / sizeof(uint16_t));
 #endif
 
 #if (ENABLE_IFX_ISSUED_CERT_OBJECT == 1)
-    // Get IFX issued Device Public Key Certificate  = 0xE0E0
-    Serial.print("\r\nIFX issued Device Public Key Certificate Object: 0x");
-    Serial.println(OID[7],HEX);
-    printObject(7);
+    dumpObjects("IFX issued Device Public Key Certificate", IFX_CERT_OID, sizeof(IFX_CERT_OID) / sizeof(uint16_t));
 #endif
 
 #if (ENABLE_PROJECT_SPECIFIC_CERT_OBJECTS == 1)
-    // Get Project specific device Public Key Certificate  = 0xE0E1
-    Serial.print("\r\nProject 1 device Public Key Certificate Object: 0x");
-    Serial.println(OID[8],HEX);
-    printObject(8);
-
-    // Get Project 1 device Public Key Certificate  = 0xE0E2
-    Serial.print("\r\nProject 2 device Public Key Certificate Object: 0x");
-    Serial.println(OID[9],HEX);
-    printObject(9);
-
-    // Get Project specific device Public Key Certificate  = 0xE0E3
-    Serial.print("\r\nProject 3 device Public Key Certificate Object: 0x");
-    Serial.println(OID[10],HEX);
-    printObject(10);
+    dumpObjects("Project specific device Public Key Certificates", PROJECT_CERT_OID, sizeof(PROJECT_CERT_OID) / sizeof(uint16_t));
 #endif
 
 #if (ENABLE_ROOTCA_CERTIFICATES==1)
-    // Get RootCA Public Key Certificate  = 0xE0E8
-    Serial.print("\r\nRootCA Public Key Certificate Object: 0x");
-    Serial.println(OID[11],HEX);
-    printObject(11);
-
-    // Get Platform Integrity Public Key Certificate  = 0xE0EF
-    Serial.print("\r\nPlatform Integrity Public Key Certificate Object: 0x");
-    Serial.println(OID[12],HEX);
-    printObject(12);
+    dumpObjects("RootCA and Platform Integrity Public Key Certificates", ROOTCA_CERT_OID, sizeof(ROOTCA_CERT_OID) / sizeof(uint16_t));
 #endif
 
-#if (ENABLE_ARBITRARY_OBJECTS == 1)
-    uint16_t DATA_OID = 0xF1D0;
-
-    //Get small NVM data objects
-    for(uint8_t i=0;i<15;i++){
-      Serial.print("\r\nData Object: 0x");
-      Serial.println(DATA_OID+i,HEX);
-      printDataObject(DATA_OID+i);
-      delay(100);
-     }
-
-    Serial.println("\r\nData Object: 0xF1E0");
-    printDataObject(0xF1E0);
-
-    delay(100);
+#if (ENABLE_KEY_AND_SESSION_METADATA == 1)
+    dumpObjects("Private keys and session contexts", KEY_SESSION_OID, sizeof(KEY_SESSION_OID) / sizeof(uint16_t));
+#endif
 
-    Serial.println("\r\nData Object: 0xF1E1");
-    printDataObject(0xF1E1);
+#if (ENABLE_ARBITRARY_OBJECTS == 1)
+    dumpObjects("Small data objects", SMALL_DATA_OID, sizeof(SMALL_DATA_OID) / sizeof(uint16_t));
+    //Up to 1500 bytes each, one snapshot per object
+    dumpObjects("Large data object", &LARGE_DATA_OID[0], 1);
+    dumpObjects("Large data object", &LARGE_DATA_OID[1], 1);
 #endif
   }
   Serial.print("\r\nPress i to re-initialize.. other key to loop...");
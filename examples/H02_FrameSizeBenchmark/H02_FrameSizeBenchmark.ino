@@ -0,0 +1,106 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Infineon Technologies AG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE
+ *
+ * Demonstrates use of the
+ * Infineon Technologies AG OPTIGA™ Trust X Arduino library
+ */
+
+#include "OPTIGATrustX.h"
+#include "optiga_trustx/ifx_i2c_config.h"
+
+/*
+ * Reads the device certificate once per frame size and reports the number of
+ * data link frames (sent and received) and the time it took.
+ * Frame sizes above DL_MAX_FRAME_SIZE are reduced to it. On Arduino it is 0x19
+ * unless IFX_I2C_LARGE_FRAMES is defined for an I2C driver with a larger buffer.
+ */
+#define CERT_MAXLENGTH   1728
+
+uint8_t cert[CERT_MAXLENGTH];
+uint16_t frameSizes[] = {0x0019, 0x0040, 0x0080, 0x00C0, DL_MAX_FRAME_SIZE};
+uint8_t sys_init = 0;
+
+void setup()
+{
+  /*
+   * Initialise a serial port for debug output
+   */
+  Serial.begin(115200, SERIAL_8N1);
+  delay(100);
+}
+
+void benchmark(uint16_t frameSize)
+{
+  uint32_t ret = 0;
+  uint16_t certLen = CERT_MAXLENGTH;
+  uint32_t frames = 0;
+  uint32_t ts = 0;
+
+  /*
+   * The frame size is negotiated while opening the protocol stack
+   */
+  if (sys_init) {
+    trustX.end();
+    sys_init = 0;
+  }
+  ifx_i2c_context_0.frame_size = frameSize;
+  ret = trustX.begin();
+  if (ret) {
+    Serial.println("Failed to initialize Trust X");
+    return;
+  }
+  sys_init = 1;
+
+  frames = ifx_i2c_context_0.dl.tx_frame_count + ifx_i2c_context_0.dl.rx_frame_count;
+  ts = micros();
+  ret = trustX.getCertificate(cert, certLen);
+  ts = micros() - ts;
+  frames = ifx_i2c_context_0.dl.tx_frame_count + ifx_i2c_context_0.dl.rx_frame_count - frames;
+  if (ret) {
+    Serial.println("Failed to read certificate");
+    return;
+  }
+
+  Serial.print("Frame size ");
+  Serial.print(ifx_i2c_context_0.frame_size);
+  Serial.print(" (requested ");
+  Serial.print(frameSize);
+  Serial.print("): ");
+  Serial.print(certLen);
+  Serial.print(" bytes, ");
+  Serial.print(frames);
+  Serial.print(" frames, ");
+  Serial.print(ts);
+  Serial.println(" us");
+}
+
+void loop()
+{
+  for (uint8_t i = 0; i < sizeof(frameSizes)/sizeof(frameSizes[0]); i++) {
+    benchmark(frameSizes[i]);
+  }
+
+  Serial.println("\r\nPress any key to run again...");
+  while (Serial.available()==0){} //Wait for user input
+  String input = Serial.readString();  //Reading the Input string from Serial port.
+}
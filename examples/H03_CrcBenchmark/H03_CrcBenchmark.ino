@@ -0,0 +1,111 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2018 Infineon Technologies AG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE
+ *
+ * Demonstrates use of the
+ * Infineon Technologies AG OPTIGA™ Trust X Arduino library
+ */
+
+#include "OPTIGATrustX.h"
+#include "optiga_trustx/ifx_i2c_crc.h"
+
+/*
+ * Compares the frame CRC implementations of the data link layer against the
+ * bit by bit reference, and reports the time each needs for a maximum size frame.
+ * The implementation used by the stack is selected with IFX_I2C_DL_CRC.
+ */
+#define FRAME_LENGTH     (DL_MAX_FRAME_SIZE - 2)
+#define ROUNDS           200
+
+typedef uint16_t (*crc_function_t)(uint16_t seed, const uint8_t* p_data, uint16_t data_len);
+
+const char* crcNames[] = {"bitwise", "nibble ", "table  ", "slice4 "};
+crc_function_t crcFunctions[] = {ifx_i2c_crc_calc_bitwise, ifx_i2c_crc_calc_nibble,
+                                 ifx_i2c_crc_calc_table, ifx_i2c_crc_calc_slice4};
+uint8_t frame[FRAME_LENGTH];
+
+void setup()
+{
+  /*
+   * Initialise a serial port for debug output
+   */
+  Serial.begin(115200, SERIAL_8N1);
+  delay(100);
+
+  randomSeed(analogRead(0));
+}
+
+/*
+ * Every length and a few seeds must give the same CRC as the reference
+ */
+uint8_t verify(crc_function_t crc)
+{
+  uint16_t len;
+  uint16_t seed;
+
+  for (len = 0; len <= FRAME_LENGTH; len++) {
+    seed = (uint16_t)random(0x10000);
+    if ((crc(0, frame, len) != ifx_i2c_crc_calc_bitwise(0, frame, len)) ||
+        (crc(seed, frame, len) != ifx_i2c_crc_calc_bitwise(seed, frame, len))) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+void loop()
+{
+  uint16_t i;
+  uint16_t j;
+  uint16_t crc;
+  uint32_t ts;
+
+  for (i = 0; i < FRAME_LENGTH; i++) {
+    frame[i] = (uint8_t)random(0x100);
+  }
+
+  Serial.print("CRC of ");
+  Serial.print(FRAME_LENGTH);
+  Serial.print(" bytes, ");
+  Serial.print(ROUNDS);
+  Serial.println(" rounds");
+  for (i = 0; i < sizeof(crcFunctions)/sizeof(crcFunctions[0]); i++) {
+    crc = 0;
+    ts = micros();
+    for (j = 0; j < ROUNDS; j++) {
+      // Chain the rounds so the calls can't be optimised away
+      crc = crcFunctions[i](crc, frame, FRAME_LENGTH);
+    }
+    ts = micros() - ts;
+
+    Serial.print(crcNames[i]);
+    Serial.print(": ");
+    Serial.print(ts);
+    Serial.print(" us, crc 0x");
+    Serial.print(crc, HEX);
+    Serial.println(verify(crcFunctions[i]) ? ", matches reference" : ", MISMATCH");
+  }
+
+  Serial.println("\r\nPress any key to run again...");
+  while (Serial.available()==0){} //Wait for user input
+  String input = Serial.readString();  //Reading the Input string from Serial port.
+}
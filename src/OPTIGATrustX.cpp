@@ -26,9 +26,12 @@
 #include "OPTIGATrustX.h"
 #include "optiga_trustx/CommandLib.h"
 #include "optiga_trustx/IntegrationLib.h"
+#include "optiga_trustx/CertificateIndex.h"
+#include "optiga_trustx/ObjectDump.h"
 #include "optiga_trustx/optiga_comms.h"
 #include "optiga_trustx/ifx_i2c_config.h"
 #include "optiga_trustx/pal_os_event.h"
+#include "optiga_trustx/pal_os_timer.h"
 #include "third_crypto/uECC.h"
 #include "aes/AES.h"
 
@@ -39,6 +42,10 @@
 #define     LENGTH_UID                          27
 ///Length of certificate
 #define     LENGTH_CERTIFICATE                  1728
+///Length of the chunks the certificate is read in to find the public key
+#define     LENGTH_CERTIFICATE_CHUNK            64
+///Length of the public key, BitString encoding and compression format followed by the key
+#define     LENGTH_PUBLIC_KEY                   68
 ///ASN Tag for sequence
 #define     ASN_TAG_SEQUENCE                    0x30
 ///ASN Tag for integer
@@ -60,6 +67,9 @@
 ///Length of Signature
 #define     LENGTH_SIGNATURE                    (LENGTH_RS_VECTOR + MAXLENGTH_SIGN_ENCODE)
 
+///Maximum length of metadata
+#define     LENGTH_METADATA                     0x1C
+
 
 // Members to use library in blocking mode
 static volatile uint8_t   m_ifx_i2c_busy = 0;
@@ -67,15 +77,46 @@ static volatile uint8_t   m_ifx_i2c_status;
 static volatile uint8_t* m_optiga_rx_buffer;
 static volatile uint16_t  m_optiga_rx_len;
 
+#if defined(PAL_TARGET_LINUX)
+//Arduino core objects replaced on host builds, see pal_linux_arduino_compat.h
+TwoWire Wire;
+HostSerial Serial;
+#endif
+
 //Preinstantiated object
 AES aes = AES();
 IFX_OPTIGA_TrustX trustX = IFX_OPTIGA_TrustX();
 optiga_comms_t optiga_comms = {static_cast<void*>(&ifx_i2c_context_0), NULL, NULL, 0};
-static host_lib_status_t optiga_comms_status;
 
-IFX_OPTIGA_TrustX::IFX_OPTIGA_TrustX(){ active = false;}
+IFX_OPTIGA_TrustX::IFX_OPTIGA_TrustX()
+{
+    active = false;
+    p_comms = &optiga_comms;
+    CmdLib_InitContext(&cmdlib_ctx, p_comms);
+    memset(&hash_stream, 0, sizeof(hash_stream));
+    memset(&hash_sessions, 0, sizeof(hash_sessions));
+    memset(cache, 0, sizeof(cache));
+    cache_hits = 0;
+    cache_misses = 0;
+}
 
-IFX_OPTIGA_TrustX::~IFX_OPTIGA_TrustX(){}
+IFX_OPTIGA_TrustX::IFX_OPTIGA_TrustX(optiga_comms_t* p_optiga_comms)
+{
+    active = false;
+    p_comms = p_optiga_comms;
+    CmdLib_InitContext(&cmdlib_ctx, p_comms);
+    memset(&hash_stream, 0, sizeof(hash_stream));
+    memset(&hash_sessions, 0, sizeof(hash_sessions));
+    memset(cache, 0, sizeof(cache));
+    cache_hits = 0;
+    cache_misses = 0;
+}
+
+IFX_OPTIGA_TrustX::~IFX_OPTIGA_TrustX()
+{
+    //Release the chunk buffers of a hash which was started but not finalized
+    CmdHash_Final(&hash_stream, NULL);
+}
 
 /*
  * Local Functions
@@ -97,9 +138,7 @@ int32_t IFX_OPTIGA_TrustX::checkChip(void)
 	int32_t err = CMD_LIB_ERROR;
 	uint8_t p_rnd[32];
 	uint16_t rlen = 32;
-	uint8_t p_cert[512];
-	uint16_t clen = 0;
-	uint8_t p_pubkey[68];
+	uint8_t p_pubkey[LENGTH_PUBLIC_KEY];
 	uint8_t p_sign[70];
 	uint8_t p_unformSign[66];
 	uint16_t slen = 0;
@@ -112,13 +151,11 @@ int32_t IFX_OPTIGA_TrustX::checkChip(void)
 			randomSeed(analogRead(0));
 		}
 
-		err = getCertificate(p_cert, clen);
+		err = getPublicKey(p_pubkey);
 
 		if (err)
 			break;
 
-		getPublicKey(p_pubkey);
-
 		Serial.println("Calling calculate Signature:");
 		err = calculateSignature(p_rnd, rlen, p_sign, slen);
 		DEBUG_PRINT(p_sign, slen);
@@ -177,24 +214,26 @@ int32_t IFX_OPTIGA_TrustX::checkChip(void)
 
 static void optiga_comms_event_handler(void* upper_layer_ctx, host_lib_status_t event)
 {
-    optiga_comms_status = event;
+    *static_cast<volatile host_lib_status_t*>(upper_layer_ctx) = event;
 }
 
 int32_t IFX_OPTIGA_TrustX::begin(TwoWire& CustomWire)
 {
 
     int32_t ret = CMD_LIB_ERROR;
+    volatile host_lib_status_t optiga_comms_status;
 
     sOpenApp_d openapp_opt;
 
     do {
         //Invoke optiga_comms_open to initialize the IFX I2C Protocol and security chip
         optiga_comms_status = OPTIGA_COMMS_BUSY;
-        optiga_comms.upper_layer_handler = optiga_comms_event_handler;
+        p_comms->upper_layer_ctx = const_cast<host_lib_status_t*>(&optiga_comms_status);
+        p_comms->upper_layer_handler = optiga_comms_event_handler;
 
         //Serial.println("calling optiga_comms_open()");
 
-        if(E_COMMS_SUCCESS != optiga_comms_open(&optiga_comms))
+        if(E_COMMS_SUCCESS != optiga_comms_open(p_comms))
         {
         	Serial.println("Error: optiga_comms_open() failed.");
             break;
@@ -202,19 +241,19 @@ int32_t IFX_OPTIGA_TrustX::begin(TwoWire& CustomWire)
 
         //Wait until IFX I2C initialization is complete
         while(optiga_comms_status == OPTIGA_COMMS_BUSY) {
-            // Push forward timer dependent actions.
-            pal_os_event_process();
+            // Sleep until the next timer dependent action is due.
+            pal_os_event_wait();
         }
 #if 0
-        if(E_COMMS_SUCCESS != optiga_comms_set_address(&optiga_comms, 0x30))
+        if(E_COMMS_SUCCESS != optiga_comms_set_address(p_comms, 0x30))
         {
         	Serial.println("Error: optiga_comms_set_address() failed.");
             break;
         }
 #endif
-        //Set OPTIGA comms context in Command library before invoking the use case APIs or command library APIs
-        //This context will be used by command library to communicate with OPTIGA using IFX I2C Protocol.
-        CmdLib_SetOptigaCommsContext(&optiga_comms);
+        //Select the command library context of this chip before invoking the use case APIs or command library APIs
+        //Its OPTIGA comms context will be used by command library to communicate with OPTIGA using IFX I2C Protocol.
+        CmdLib_SelectContext(&cmdlib_ctx);
 
         openapp_opt.eOpenType = eInit;
 
@@ -242,7 +281,7 @@ int32_t IFX_OPTIGA_TrustX::set_i2c_address(uint8_t address)
 
 	//Serial.println(">IFX_OPTIGA_TrustX::set_i2c_address");
 
-    if(E_COMMS_SUCCESS != optiga_comms_set_address(&optiga_comms, address))
+    if(E_COMMS_SUCCESS != optiga_comms_set_address(p_comms, address))
     {
     	Serial.println("Error: optiga_comms_set_address() failed.");
     	return ret;
@@ -258,7 +297,7 @@ int32_t IFX_OPTIGA_TrustX::restore(void)
 	int32_t ret = CMD_LIB_ERROR;
 
 	//Serial.println(">IFX_OPTIGA_TrustX::restore");
-    if(E_COMMS_SUCCESS != optiga_comms_set_address(&optiga_comms, 0x30))
+    if(E_COMMS_SUCCESS != optiga_comms_set_address(p_comms, 0x30))
     {
     	Serial.println("Error: optiga_comms_set_address() failed.");
     	return ret;
@@ -272,23 +311,62 @@ int32_t IFX_OPTIGA_TrustX::restore(void)
 int32_t IFX_OPTIGA_TrustX::reset(void)
 {
     // Soft reset
-    optiga_comms_reset(&optiga_comms, 1);
+    optiga_comms_reset(p_comms, 1);
     end();
     return begin(Wire);
 }
 
 void IFX_OPTIGA_TrustX::end(void)
 {
-    optiga_comms_close(&optiga_comms);
+    optiga_comms_close(p_comms);
 }
 
 
 
+int32_t IFX_OPTIGA_TrustX::getUsedSize(uint16_t oid, uint16_t& size)
+{
+    int32_t ret = 1;
+    uint8_t metadata[LENGTH_METADATA];
+    sGetData_d cmd_opt;
+    sCmdResponse_d resp;
+    sIntLibObjectInfo_d info;
+
+    do
+    {
+        cmd_opt.wOID = oid;
+        cmd_opt.wLength = sizeof(metadata);
+        cmd_opt.wOffset = 0;
+        cmd_opt.eDataOrMdata = eMETA_DATA;
+
+        resp.prgbBuffer = metadata;
+        resp.wBufferLength = sizeof(metadata);
+        resp.wRespLength = 0;
+
+        CmdLib_SelectContext(&cmdlib_ctx);
+        if (CMD_LIB_OK != CmdLib_GetDataObject(&cmd_opt, &resp))
+        {
+            break;
+        }
+
+        if ((INT_LIB_OK != IntLib_DecodeMetaData(metadata, resp.wRespLength, &info)) ||
+            !(info.bTags & INT_LIB_META_USED_SIZE))
+        {
+            break;
+        }
+
+        size = info.wUsedSize;
+        ret = 0;
+    }while(FALSE);
+
+    return ret;
+}
+
 int32_t IFX_OPTIGA_TrustX::getGenericData(uint16_t oid, uint8_t* p_data, uint16_t& hashLength)
 {
     int32_t ret = (int32_t)INT_LIB_ERROR;
     sReadGPData_d   data_opt;
     sbBlob_d        blob;
+    cacheEntry_t*   entry;
 
     do
     {
@@ -296,6 +374,16 @@ int32_t IFX_OPTIGA_TrustX::getGenericData(uint16_t oid, uint8_t* p_data, uint16_
             break;
         }
 
+        //Serve the read from the host side copy if it holds the requested data
+        entry = cacheLookup(oid);
+        if ((entry != NULL) && (cacheFetch(entry, hashLength) == 0)) {
+            if (hashLength > entry->len)
+                hashLength = entry->len;
+            memcpy(p_data, entry->p_buf, hashLength);
+            ret = 0;
+            break;
+        }
+
         //Read complete data structure
         data_opt.wOffset = 0x00;
         data_opt.wLength = hashLength;
@@ -304,6 +392,7 @@ int32_t IFX_OPTIGA_TrustX::getGenericData(uint16_t oid, uint8_t* p_data, uint16_
         //Reading available data
         blob.prgbStream = p_data;
         blob.wLen = hashLength;
+        CmdLib_SelectContext(&cmdlib_ctx);
         if(INT_LIB_OK == IntLib_ReadGPData(&data_opt,&blob))
         {
             ret = 0;
@@ -316,6 +405,32 @@ int32_t IFX_OPTIGA_TrustX::getGenericData(uint16_t oid, uint8_t* p_data, uint16_
     return ret;
 }
 
+int32_t IFX_OPTIGA_TrustX::getObjectSnapshot(const uint16_t oids[], uint8_t count, uint8_t snapshot[], uint16_t& snapshotLength)
+{
+    int32_t ret = 1;
+    sObjDump_d dump;
+    sObjDumpHeader_d header;
+
+    do
+    {
+        if (active == false) {
+            break;
+        }
+
+        //The objects are read from the chip, host side copies are not used
+        if ((INT_LIB_OK != ObjDump_Init(&dump, &cmdlib_ctx, oids, count, snapshot, snapshotLength)) ||
+            (INT_LIB_OK != ObjDump_Run(&dump)) ||
+            (INT_LIB_OK != ObjDump_GetHeader(snapshot, snapshotLength, &header))) {
+            break;
+        }
+
+        snapshotLength = header.wLength;
+        ret = 0;
+    }while(FALSE);
+
+    return ret;
+}
+
 int32_t IFX_OPTIGA_TrustX::getState(uint16_t oid, uint8_t& byte)
 {
     uint16_t length = 1;
@@ -333,6 +448,7 @@ int32_t IFX_OPTIGA_TrustX::getState(uint16_t oid, uint8_t& byte)
 	sCmdResponse.wBufferLength = 1;
 	sCmdResponse.wRespLength = 0;
 
+	CmdLib_SelectContext(&cmdlib_ctx);
 	ret = CmdLib_GetDataObject(&sGDVector,&sCmdResponse);
 	if(CMD_LIB_OK == ret)
 	{
@@ -357,7 +473,9 @@ int32_t IFX_OPTIGA_TrustX::setGenericData(uint16_t oid, uint8_t* p_data, uint16_
     setdata_opt.prgbData = p_data;
     setdata_opt.wLength = hashLength;
 
+    CmdLib_SelectContext(&cmdlib_ctx);
     ret = CmdLib_SetDataObject(&setdata_opt);
+    cacheWritten(oid, p_data, hashLength, (CMD_LIB_OK == ret));
 
     if(CMD_LIB_OK == ret)
     {
@@ -365,6 +483,124 @@ int32_t IFX_OPTIGA_TrustX::setGenericData(uint16_t oid, uint8_t* p_data, uint16_
     }
     return ret;
 }
+
+IFX_OPTIGA_TrustX::cacheEntry_t* IFX_OPTIGA_TrustX::cacheLookup(uint16_t oid)
+{
+    for (uint8_t i = 0; i < OPTIGA_OBJECT_CACHE_ENTRIES; i++) {
+        if ((cache[i].p_buf != NULL) && (cache[i].oid == oid))
+            return &cache[i];
+    }
+    return NULL;
+}
+
+int32_t IFX_OPTIGA_TrustX::cacheObject(uint16_t oid, uint8_t* p_buf, uint16_t blen, eCachePolicy_d policy, uint32_t ttl)
+{
+    int32_t ret = 1;
+    cacheEntry_t* entry = cacheLookup(oid);
+
+    do
+    {
+        if (p_buf == NULL) {
+            //Remove the object from the cache
+            if (entry != NULL)
+                memset(entry, 0, sizeof(cacheEntry_t));
+            ret = 0;
+            break;
+        }
+        if (blen == 0) {
+            break;
+        }
+        //Take a free entry if the object is not yet cached
+        for (uint8_t i = 0; (entry == NULL) && (i < OPTIGA_OBJECT_CACHE_ENTRIES); i++) {
+            if (cache[i].p_buf == NULL)
+                entry = &cache[i];
+        }
+        if (entry == NULL) {
+            break;
+        }
+
+        memset(entry, 0, sizeof(cacheEntry_t));
+        entry->p_buf = p_buf;
+        entry->oid = oid;
+        entry->blen = blen;
+        entry->policy = (uint8_t)policy;
+        entry->ttl = ttl;
+        ret = 0;
+    } while (FALSE);
+
+    return ret;
+}
+
+void IFX_OPTIGA_TrustX::invalidateCache(uint16_t oid)
+{
+    for (uint8_t i = 0; i < OPTIGA_OBJECT_CACHE_ENTRIES; i++) {
+        if ((oid == 0) || (cache[i].oid == oid))
+            cache[i].valid = false;
+    }
+}
+
+int32_t IFX_OPTIGA_TrustX::cacheFetch(cacheEntry_t* entry, uint16_t len)
+{
+    int32_t ret = 1;
+    sReadGPData_d data_opt;
+    sbBlob_d blob;
+    uint16_t size = 0;
+
+    do
+    {
+        if (entry->valid && ((entry->policy != eCACHE_TTL) ||
+            ((uint32_t)(pal_os_timer_get_time_in_milliseconds() - entry->time) < entry->ttl))) {
+            if (entry->complete || (len <= entry->len)) {
+                cache_hits++;
+                ret = 0;
+            } else {
+                cache_misses++;
+            }
+            break;
+        }
+
+        //Read the object into the copy
+        cache_misses++;
+        entry->valid = false;
+        data_opt.wOffset = 0x00;
+        data_opt.wLength = entry->blen;
+        data_opt.wOID = entry->oid;
+        blob.prgbStream = entry->p_buf;
+        blob.wLen = entry->blen;
+        CmdLib_SelectContext(&cmdlib_ctx);
+        if (INT_LIB_OK != IntLib_ReadGPData(&data_opt, &blob)) {
+            break;
+        }
+
+        entry->len = blob.wLen;
+        //A copy filling the whole buffer is complete only if the object has exactly this size
+        entry->complete = (entry->len < entry->blen) ||
+                          ((getUsedSize(entry->oid, size) == 0) && (size == entry->len));
+        entry->time = pal_os_timer_get_time_in_milliseconds();
+        entry->valid = true;
+        ret = (entry->complete || (len <= entry->len)) ? 0 : 1;
+    } while (FALSE);
+
+    return ret;
+}
+
+void IFX_OPTIGA_TrustX::cacheWritten(uint16_t oid, const uint8_t* p_data, uint16_t len, bool ok)
+{
+    cacheEntry_t* entry = cacheLookup(oid);
+
+    if (entry != NULL) {
+        //The data is written from offset 0 with erase, so it is the whole object afterwards
+        if (ok && (entry->policy == eCACHE_WRITE_THROUGH) && (len <= entry->blen)) {
+            memcpy(entry->p_buf, p_data, len);
+            entry->len = len;
+            entry->complete = true;
+            entry->time = pal_os_timer_get_time_in_milliseconds();
+            entry->valid = true;
+        } else {
+            entry->valid = false;
+        }
+    }
+}
 /*************************************************************************************
  *                              COMMANDS API TRUST E COMPATIBLE
  **************************************************************************************/
@@ -373,11 +609,9 @@ char * IFX_OPTIGA_TrustX::version(void)
     return VERSION_HOST_LIBRARY;
 }
 
-int32_t IFX_OPTIGA_TrustX::getCertificate(uint8_t* p_cert, uint16_t& clen)
+int32_t IFX_OPTIGA_TrustX::extractCertificate(uint8_t* p_cert, uint16_t len, uint16_t& clen)
 {
     int32_t ret  = CMD_LIB_ERROR;
-    sReadGPData_d data_opt;
-    sbBlob_d cert_blob;
     uint16_t tag_len;
     uint32_t cert_len = 0;
     do
@@ -387,24 +621,6 @@ int32_t IFX_OPTIGA_TrustX::getCertificate(uint8_t* p_cert, uint16_t& clen)
 #define LENGTH_TAGlEN_PLUS_TAG  3
 #define LENGTH_MINIMUM_DATA     10
 
-        if ((p_cert == NULL)  || (active == false)) {
-
-            break;
-        }
-        //Read complete certificate
-        data_opt.wOffset = 0x00;
-        data_opt.wLength = 0xFFFF;
-        data_opt.wOID = OID_IFX_CERTIFICATE;
-
-        //Reading available certificate data
-        cert_blob.prgbStream = p_cert;
-        cert_blob.wLen = LENGTH_CERTIFICATE;
-        ret = IntLib_ReadGPData(&data_opt,&cert_blob);
-        if(INT_LIB_OK != ret)
-        {
-            break;
-        }
-
         //Validate TLV
         if((TLS_TAG != p_cert[0]) && (ASN_TAG_SEQUENCE != p_cert[0]))
         {
@@ -414,14 +630,14 @@ int32_t IFX_OPTIGA_TrustX::getCertificate(uint8_t* p_cert, uint16_t& clen)
         if(TLS_TAG == p_cert[0])
         {
             //Check minimum length must be 10
-            if(cert_blob.wLen < LENGTH_MINIMUM_DATA)
+            if(len < LENGTH_MINIMUM_DATA)
             {
                 break;
             }
             tag_len = Utility_GetUint16 (&p_cert[1]);
             cert_len = Utility_GetUint24(&p_cert[6]);
             //Length checks
-            if((tag_len != (cert_blob.wLen - LENGTH_TAGlEN_PLUS_TAG)) ||           \
+            if((tag_len != (len - LENGTH_TAGlEN_PLUS_TAG)) ||           \
                 (Utility_GetUint24(&p_cert[3]) != (uint32_t)(tag_len - LENGTH_CERTLIST_LEN)) ||   \
                 ((cert_len > (uint32_t)(tag_len - (LENGTH_CERTLIST_LEN  + LENGTH_CERTLEN))) || (cert_len == 0x00)))
             {
@@ -437,30 +653,235 @@ int32_t IFX_OPTIGA_TrustX::getCertificate(uint8_t* p_cert, uint16_t& clen)
     return ret;
 }
 
-int32_t IFX_OPTIGA_TrustX::getPublicKey(uint8_t p_pubkey[64])
+int32_t IFX_OPTIGA_TrustX::getCertificate(uint8_t* p_cert, uint16_t& clen)
+{
+    int32_t ret  = CMD_LIB_ERROR;
+    sReadGPData_d data_opt;
+    sbBlob_d cert_blob;
+    cacheEntry_t* entry;
+    do
+    {
+        if ((p_cert == NULL)  || (active == false)) {
+
+            break;
+        }
+        //Take the certificate from the host side copy
+        entry = cacheLookup(OID_IFX_CERTIFICATE);
+        if ((entry != NULL) && (cacheFetch(entry, 0xFFFF) == 0)) {
+            //The buffer is sized for LENGTH_CERTIFICATE, as the uncached read below
+            if (entry->len > LENGTH_CERTIFICATE) {
+                break;
+            }
+            memcpy(p_cert, entry->p_buf, entry->len);
+            ret = extractCertificate(p_cert, entry->len, clen);
+            break;
+        }
+
+        //Read complete certificate
+        data_opt.wOffset = 0x00;
+        data_opt.wLength = 0xFFFF;
+        data_opt.wOID = OID_IFX_CERTIFICATE;
+
+        //Reading available certificate data
+        cert_blob.prgbStream = p_cert;
+        cert_blob.wLen = LENGTH_CERTIFICATE;
+        CmdLib_SelectContext(&cmdlib_ctx);
+        ret = IntLib_ReadGPData(&data_opt,&cert_blob);
+        if(INT_LIB_OK != ret)
+        {
+            break;
+        }
+
+        ret = extractCertificate(p_cert, cert_blob.wLen, clen);
+    } while (FALSE);
+
+    return ret;
+}
+
+//State of a certificate read by getCertificate() with a callback
+struct certificateStream_t
+{
+    IFX_OPTIGA_TrustX::certificateChunk_t callback;
+    void* ctx;
+    //Bytes of the data object ahead of the certificate
+    uint16_t skip;
+    //Length of the certificate, 0 if the header is invalid
+    uint16_t length;
+    uint16_t delivered;
+    bool stopped;
+};
+
+static bool_t certificateStreamChunk(void* p_ctx, uint16_t offset, const uint8_t* p_chunk, uint16_t len)
+{
+    certificateStream_t* stream = (certificateStream_t*)p_ctx;
+    uint16_t tag_len;
+    uint32_t cert_len = 0;
+    uint16_t skip;
+
+    //The header is within the first chunk, the chunk buffer is at least LENGTH_MINIMUM_DATA long
+    if (offset == 0)
+    {
+        if ((TLS_TAG == p_chunk[0]) && (len >= LENGTH_MINIMUM_DATA))
+        {
+            tag_len = Utility_GetUint16(&p_chunk[1]);
+            cert_len = Utility_GetUint24(&p_chunk[6]);
+            if ((tag_len > (LENGTH_CERTLIST_LEN + LENGTH_CERTLEN)) &&
+                (Utility_GetUint24(&p_chunk[3]) == (uint32_t)(tag_len - LENGTH_CERTLIST_LEN)) &&
+                (cert_len <= (uint32_t)(tag_len - (LENGTH_CERTLIST_LEN + LENGTH_CERTLEN))))
+                stream->skip = LENGTH_TAGlEN_PLUS_TAG + LENGTH_CERTLIST_LEN + LENGTH_CERTLEN;
+            else
+                cert_len = 0;
+        }
+        else if (ASN_TAG_SEQUENCE == p_chunk[0])
+        {
+            //Certificate without TLS identity header, the length is taken from the DER encoding
+            if (p_chunk[1] < MASK_MSB)
+                cert_len = 2 + (uint32_t)p_chunk[1];
+            else if (p_chunk[1] == (MASK_MSB | 0x01))
+                cert_len = 3 + (uint32_t)p_chunk[2];
+            else if (p_chunk[1] == (MASK_MSB | 0x02))
+                cert_len = 4 + (uint32_t)Utility_GetUint16(&p_chunk[2]);
+        }
+        //No certificate read by getCertificate() is longer than LENGTH_CERTIFICATE
+        if ((cert_len == 0) || (cert_len > LENGTH_CERTIFICATE))
+            return FALSE;
+        stream->length = (uint16_t)cert_len;
+    }
+
+    if (offset < stream->skip)
+    {
+        skip = ((stream->skip - offset) < len) ? (stream->skip - offset) : len;
+        p_chunk += skip;
+        len -= skip;
+    }
+    if (len > (stream->length - stream->delivered))
+        len = stream->length - stream->delivered;
+
+    if ((len != 0) && (false == stream->callback(stream->ctx, stream->delivered, p_chunk, len)))
+        stream->stopped = true;
+    stream->delivered += len;
+
+    return ((false == stream->stopped) && (stream->delivered < stream->length)) ? TRUE : FALSE;
+}
+
+int32_t IFX_OPTIGA_TrustX::getCertificate(certificateChunk_t callback, void* ctx, uint8_t* p_buf, uint16_t blen)
+{
+    int32_t ret  = CMD_LIB_ERROR;
+    sGetData_d data_opt;
+    certificateStream_t stream;
+    cacheEntry_t* entry;
+    uint16_t offset;
+    uint16_t chunk;
+    do
+    {
+        if ((callback == NULL) || (p_buf == NULL) || (blen < LENGTH_MINIMUM_DATA) || (active == false)) {
+
+            break;
+        }
+        //Read the certificate chunk by chunk until the end of the data object
+        data_opt.wOID = OID_IFX_CERTIFICATE;
+        data_opt.wOffset = 0x00;
+        data_opt.wLength = 0xFFFF;
+        data_opt.eDataOrMdata = eDATA;
+
+        memset(&stream, 0, sizeof(stream));
+        stream.callback = callback;
+        stream.ctx = ctx;
+        entry = cacheLookup(OID_IFX_CERTIFICATE);
+        if ((entry != NULL) && (cacheFetch(entry, 0xFFFF) == 0)) {
+            //Pass the host side copy on in chunks of the buffer size
+            for (offset = 0; offset < entry->len; offset += chunk) {
+                chunk = ((entry->len - offset) < blen) ? (entry->len - offset) : blen;
+                if (FALSE == certificateStreamChunk(&stream, offset, entry->p_buf + offset, chunk))
+                    break;
+            }
+            ret = CMD_LIB_OK;
+        } else {
+            CmdLib_SelectContext(&cmdlib_ctx);
+            ret = CmdLib_ReadDataObjectStream(&data_opt, p_buf, blen, certificateStreamChunk, &stream);
+        }
+        if (CMD_LIB_OK != ret)
+        {
+            break;
+        }
+
+        //Invalid header or the data object ended within the certificate
+        if ((stream.length == 0) || ((false == stream.stopped) && (stream.delivered != stream.length)))
+        {
+            ret = CMD_LIB_ERROR;
+            break;
+        }
+        ret = 0;
+    } while (FALSE);
+
+    return ret;
+}
+
+//State of the public key search of getPublicKey()
+struct publicKeySearch_t
+{
+    uint8_t* p_pubkey;
+    //Bytes of the public key found so far
+    uint16_t found;
+};
+
+static bool publicKeyChunk(void* ctx, uint16_t offset, const uint8_t chunk[], uint16_t clen)
+{
+    static const uint8_t prefix[] = {0x03, 0x42, 0x00, 0x04};
+    publicKeySearch_t* search = (publicKeySearch_t*)ctx;
+
+    //The prefix may span chunks, the bytes matched so far are kept in the output
+    for (uint16_t i = 0; (i < clen) && (search->found < LENGTH_PUBLIC_KEY); i++) {
+        if ((search->found >= sizeof(prefix)) || (chunk[i] == prefix[search->found])) {
+            search->p_pubkey[search->found++] = chunk[i];
+        } else {
+            //The bytes of the prefix differ, so a new match can only start at the current byte
+            search->found = 0;
+            if (chunk[i] == prefix[0])
+                search->p_pubkey[search->found++] = chunk[i];
+        }
+    }
+
+    return (search->found < LENGTH_PUBLIC_KEY);
+}
+
+int32_t IFX_OPTIGA_TrustX::getPublicKey(uint8_t p_pubkey[LENGTH_PUBLIC_KEY])
 {
 	int32_t ret = CMD_LIB_ERROR;
-	uint8_t p_cert[512];
-	uint16_t clen = 0;
+	uint8_t p_chunk[LENGTH_CERTIFICATE_CHUNK];
+	publicKeySearch_t search;
+	sCertIndex_d index;
+	sbBlob_d key;
+	cacheEntry_t* entry;
 
 	do{
-		ret = getCertificate(p_cert, clen);
-		if (ret)
+		if (p_pubkey == NULL)
 			break;
 
-		if ((p_cert != NULL) || (p_pubkey != NULL)) {
-			  for (uint16_t i=0; i < clen; i++) {
-				if (p_cert[i] != 0x03)
-				  continue;
-				if (p_cert[i+1] != 0x42)
-				  continue;
-				if (p_cert[i+2] != 0x00)
-				  continue;
-				if (p_cert[i+3] != 0x04)
-				  continue;
-
-				memcpy(p_pubkey, &p_cert[i], 68);
-			  }
+		search.p_pubkey = p_pubkey;
+		search.found = 0;
+
+		//Locate the key in the host side copy of the certificate, scan it only if it is no valid X.509 certificate
+		entry = cacheLookup(OID_IFX_CERTIFICATE);
+		if ((entry != NULL) && (cacheFetch(entry, 0xFFFF) == 0)) {
+			if ((CertIdx_Build(entry->p_buf, entry->len, &index) == INT_LIB_OK) &&
+				(CertIdx_GetField(&index, entry->p_buf, eCERT_PUBLIC_KEY, &key) == INT_LIB_OK) &&
+				(key.wLen == LENGTH_PUBLIC_KEY)) {
+				memcpy(p_pubkey, key.prgbStream, LENGTH_PUBLIC_KEY);
+				search.found = LENGTH_PUBLIC_KEY;
+			} else {
+				publicKeyChunk(&search, 0, entry->p_buf, entry->len);
+			}
+		} else {
+			ret = getCertificate(publicKeyChunk, &search, p_chunk, sizeof(p_chunk));
+			if (ret)
+				break;
+		}
+
+		if (search.found != LENGTH_PUBLIC_KEY)
+		{
+			ret = 1;
+			break;
 		}
 
 		ret = 0;
@@ -487,6 +908,7 @@ int32_t IFX_OPTIGA_TrustX::getRandom(uint16_t length, uint8_t* p_random)
             break;
         }
 
+        CmdLib_SelectContext(&cmdlib_ctx);
         ret = CmdLib_GetRandom(&rng_opt, &cmd_resp);
         if(CMD_LIB_OK == ret)
         {
@@ -506,6 +928,11 @@ int32_t IFX_OPTIGA_TrustX::sha256(uint8_t dataToHash[], uint16_t ilen, uint8_t o
     sCalcHash_d calchash_opt;
 
     do {
+        //The chunk size depends on the communication buffer size read by begin()
+        if ((dataToHash == NULL) || (out == NULL) || (active == false)) {
+            break;
+        }
+
         calchash_opt.eHashAlg = eSHA256;
         calchash_opt.eHashSequence  = eStartFinalizeHash;
         calchash_opt.eHashDataType = eDataStream;
@@ -518,11 +945,25 @@ int32_t IFX_OPTIGA_TrustX::sha256(uint8_t dataToHash[], uint16_t ilen, uint8_t o
         calchash_opt.sOutHash.wBufferLength = 32;
         calchash_opt.sOutHash.wRespLength = 0;
 
+        CmdLib_SelectContext(&cmdlib_ctx);
+        if ((ilen + CALC_HASH_FIXED_OVERHEAD_SIZE) > cmdlib_ctx.wMaxCommsBuffer)
+        {
+            //Too large for a single command, hash it in chunks
+            if (sha256Start() == 0)
+            {
+                ret = sha256Update(dataToHash, ilen);
+                ret |= sha256Final(out);
+            }
+            break;
+        }
+
         if (CMD_LIB_OK == CmdLib_CalcHash(&calchash_opt))
         {
             ret = 0;
-            break;
         }
+        //The command replaced the hash context of the session resident on the chip
+        CmdHash_Evict(&hash_sessions);
+        break;
 
 //      //eContinueHash - OID
 //      calchash_opt.eHashSequence  = eContinueHash;
@@ -688,6 +1129,125 @@ int32_t IFX_OPTIGA_TrustX::sha256(uint8_t dataToHash[], uint16_t ilen, uint8_t o
     return ret;
 }
 
+int32_t IFX_OPTIGA_TrustX::sha256Object(uint16_t oid, uint8_t out[32])
+{
+    uint16_t used_size = 0;
+
+    if (getUsedSize(oid, used_size) != 0)
+    {
+        return 1;
+    }
+
+    return sha256Object(oid, 0, used_size, out);
+}
+
+int32_t IFX_OPTIGA_TrustX::sha256Object(uint16_t oid, uint16_t offset, uint16_t length, uint8_t out[32])
+{
+    //SHA256 of the empty message
+    static const uint8_t empty_hash[32] = {
+        0xE3, 0xB0, 0xC4, 0x42, 0x98, 0xFC, 0x1C, 0x14, 0x9A, 0xFB, 0xF4, 0xC8, 0x99, 0x6F, 0xB9, 0x24,
+        0x27, 0xAE, 0x41, 0xE4, 0x64, 0x9B, 0x93, 0x4C, 0xA4, 0x95, 0x99, 0x1B, 0x78, 0x52, 0xB8, 0x55
+    };
+    int32_t ret = 1;
+    sCalcHash_d calchash_opt;
+
+    if ((out == NULL) || (active == false)) {
+        return 1;
+    }
+    //The chip does not hash an empty range of an object
+    if (length == 0) {
+        memcpy(out, empty_hash, sizeof(empty_hash));
+        return 0;
+    }
+
+    //The chip reads the object itself, only the hash is sent back
+    calchash_opt.eHashAlg = eSHA256;
+    calchash_opt.eHashSequence  = eStartFinalizeHash;
+    calchash_opt.eHashDataType = eOIDData;
+    calchash_opt.sDataStream.prgbStream = NULL;
+    calchash_opt.sDataStream.wLen = 0;
+    calchash_opt.sOIDData.wOID = oid;
+    calchash_opt.sOIDData.wOffset = offset;
+    calchash_opt.sOIDData.wLength = length;
+    calchash_opt.sContextInfo.dwContextLen = 0x00;
+    calchash_opt.sContextInfo.pbContextData = NULL;
+    calchash_opt.sContextInfo.eContextAction = eUnused;
+    calchash_opt.sOutHash.prgbBuffer = out;
+    calchash_opt.sOutHash.wBufferLength = 32;
+    calchash_opt.sOutHash.wRespLength = 0;
+
+    CmdLib_SelectContext(&cmdlib_ctx);
+    if (CMD_LIB_OK == CmdLib_CalcHash(&calchash_opt))
+    {
+        ret = 0;
+    }
+    //The command replaced the hash context of the session resident on the chip
+    CmdHash_Evict(&hash_sessions);
+
+    return ret;
+}
+
+int32_t IFX_OPTIGA_TrustX::sha256Start(void)
+{
+    //Abandon a calculation which was not finalized, the chip may still hash one of its chunks
+    CmdHash_Final(&hash_stream, NULL);
+    return (CMD_LIB_OK == CmdHash_Init(&hash_stream, &cmdlib_ctx, eSHA256)) ? 0 : 1;
+}
+
+int32_t IFX_OPTIGA_TrustX::sha256Update(uint8_t data[], uint32_t dlen)
+{
+    int32_t ret = CmdHash_Update(&hash_stream, data, dlen);
+
+    //Nothing is sent to the chip until the first chunk is full
+    if (hash_stream.bStarted == TRUE) {
+        CmdHash_Evict(&hash_sessions);
+    }
+    return (CMD_LIB_OK == ret) ? 0 : 1;
+}
+
+int32_t IFX_OPTIGA_TrustX::sha256Final(uint8_t out[32])
+{
+    int32_t ret = (int32_t)CMD_LIB_ERROR;
+    sCmdResponse_d hash;
+
+    hash.prgbBuffer = out;
+    hash.wBufferLength = 32;
+    hash.wRespLength = 0;
+
+    //The last chunk is sent to the chip, unless sha256Start was not called
+    if (hash_stream.rgprgbChunk[0] != NULL) {
+        ret = CmdHash_Final(&hash_stream, &hash);
+        CmdHash_Evict(&hash_sessions);
+    }
+    return (CMD_LIB_OK == ret) ? 0 : 1;
+}
+
+int32_t IFX_OPTIGA_TrustX::hashSessionsBegin(uint8_t pool[], uint16_t plen, uint16_t bufferLength)
+{
+    return (CMD_LIB_OK == CmdHash_InitManager(&hash_sessions, &cmdlib_ctx, pool, plen, bufferLength)) ? 0 : 1;
+}
+
+int32_t IFX_OPTIGA_TrustX::hashSessionOpen(sCmdHashSession_d& session)
+{
+    return (CMD_LIB_OK == CmdHash_OpenSession(&hash_sessions, &session)) ? 0 : 1;
+}
+
+int32_t IFX_OPTIGA_TrustX::hashSessionUpdate(sCmdHashSession_d& session, uint8_t data[], uint32_t dlen)
+{
+    return (CMD_LIB_OK == CmdHash_UpdateSession(&session, data, dlen)) ? 0 : 1;
+}
+
+int32_t IFX_OPTIGA_TrustX::hashSessionFinal(sCmdHashSession_d& session, uint8_t out[32])
+{
+    sCmdResponse_d hash;
+
+    hash.prgbBuffer = out;
+    hash.wBufferLength = 32;
+    hash.wRespLength = 0;
+
+    return (CMD_LIB_OK == CmdHash_FinalSession(&session, &hash)) ? 0 : 1;
+}
+
 int32_t IFX_OPTIGA_TrustX::calculateSignature(uint8_t dataToSign[], uint16_t ilen, uint16_t ctx, uint8_t* out, uint16_t& olen)
 {
     uint16_t ret = (int32_t)INT_LIB_ERROR;
@@ -717,6 +1277,7 @@ int32_t IFX_OPTIGA_TrustX::calculateSignature(uint8_t dataToSign[], uint16_t ile
         sign_blob.wLen = MAX_SIGN_LEN;
 
         //Initiate CmdLib API for the Calculation of signature
+        CmdLib_SelectContext(&cmdlib_ctx);
         if(CMD_LIB_OK == CmdLib_CalculateSign(&calsign_opt,&sign_blob))
         {
             olen = sign_blob.wLen;
@@ -820,6 +1381,7 @@ int32_t IFX_OPTIGA_TrustX::verifySignature( uint8_t* digest, uint16_t hashLength
     sign_blob.wLen = signatureLength;
 
     //Initiate CmdLib API for the Verification of signature
+    CmdLib_SelectContext(&cmdlib_ctx);
     ret = CmdLib_VerifySign(&versign_opt, &digest_blob, &sign_blob);
 
     if(CMD_LIB_OK == ret)
@@ -855,6 +1417,7 @@ int32_t IFX_OPTIGA_TrustX::verifySignature( uint8_t* digest, uint16_t hashLength
         sign_blob.wLen = signatureLength;
 
         //Initiate CmdLib API for the Verification of signature
+        CmdLib_SelectContext(&cmdlib_ctx);
         ret = CmdLib_VerifySign(&versign_opt, &digest_blob, &sign_blob);
 
         if(CMD_LIB_OK == ret)
@@ -906,6 +1469,7 @@ int32_t IFX_OPTIGA_TrustX::calculateSharedSecretGeneric(int32_t curveID,
     shsec.wLen = sizeof(ShareSecret);
 
     //Initiate CmdLib API for the Calculate shared secret
+    CmdLib_SelectContext(&cmdlib_ctx);
     ret = CmdLib_CalculateSharedSecret(&shsec_opt, &shsec);
     if(CMD_LIB_OK == ret)
     {
@@ -1010,6 +1574,7 @@ int32_t IFX_OPTIGA_TrustX::deriveKey(uint16_t ShareSecret_OID,
 	}
 
     //Initiate CmdLib API for the Calculate shared secret
+    CmdLib_SelectContext(&cmdlib_ctx);
     if(CMD_LIB_OK == CmdLib_DeriveKey(&key_opt, &key))
     {
 
@@ -1087,6 +1652,7 @@ int32_t IFX_OPTIGA_TrustX::generateKeypair(uint8_t* p_pubkey, uint16_t& plen, ui
 
         //Initiate CmdLib API for the generate the key pair. The private key gets stored in the-
         // session context OID 0xE101 and public key is exported out.
+        CmdLib_SelectContext(&cmdlib_ctx);
         ret = CmdLib_GenerateKeyPair(&keypair_opt,&keypair);
 
         if(CMD_LIB_OK == ret)
@@ -1130,6 +1696,7 @@ int32_t IFX_OPTIGA_TrustX::generateKeypair(uint8_t* p_pubkey, uint16_t& plen, ui
 
         //Initiate CmdLib API for the generate the key pair. The private key gets stored in the-
         // session context OID 0xE101 and public key is exported out.
+        CmdLib_SelectContext(&cmdlib_ctx);
         ret = CmdLib_GenerateKeyPair(&keypair_opt,&keypair);
 
         if(CMD_LIB_OK == ret)
@@ -1144,3 +1711,330 @@ int32_t IFX_OPTIGA_TrustX::generateKeypair(uint8_t* p_pubkey, uint16_t& plen, ui
 
     return ret;
 }
+
+#if defined(OPTIGA_TRUSTX_COROUTINES)
+/*************************************************************************************
+ *                              AWAITABLE OPERATIONS
+ **************************************************************************************/
+IFX_OPTIGA_TrustX::Awaitable::Awaitable(IFX_OPTIGA_TrustX* p_trustx, operation_t op)
+{
+    trustx = p_trustx;
+    operation = op;
+    status = 0;
+    p_len = NULL;
+    p_len2 = NULL;
+}
+
+bool IFX_OPTIGA_TrustX::Awaitable::await_suspend(std::coroutine_handle<> handle)
+{
+    int32_t ret = (int32_t)CMD_LIB_ERROR;
+
+    resume_handle = handle;
+    //The command library keeps pointers to the inputs, they live in this object until the coroutine is resumed
+    CmdLib_SelectContext(&trustx->cmdlib_ctx);
+    switch(operation)
+    {
+        case OP_RANDOM:
+            ret = CmdLib_GetRandomAsync(&random.opt, &random.resp, complete, this);
+            break;
+        case OP_SHA256:
+            ret = CmdLib_CalcHashAsync(&hash, complete, this);
+            break;
+        case OP_SIGN:
+            ret = CmdLib_CalculateSignAsync(&sign.opt, &sign.sign, complete, this);
+            break;
+        case OP_VERIFY:
+            ret = CmdLib_VerifySignAsync(&verify.opt, &verify.digest, &verify.sign, complete, this);
+            break;
+        case OP_KEYPAIR:
+            ret = CmdLib_GenerateKeyPairAsync(&keypair.opt, &keypair.keypair, complete, this);
+            break;
+        case OP_SHARED_SECRET:
+            ret = CmdLib_CalculateSharedSecretAsync(&secret.opt, &secret.secret, complete, this);
+            break;
+        case OP_CERTIFICATE:
+            ret = CmdLib_GetDataObjectAsync(&cert.opt, &cert.resp, complete, this);
+            break;
+    }
+
+    //Resume right away if the command could not be started
+    if(CMD_LIB_OK != ret)
+    {
+        status = ret;
+        return false;
+    }
+    return true;
+}
+
+void IFX_OPTIGA_TrustX::Awaitable::complete(void* p_ctx, int32_t ret)
+{
+    Awaitable* p_awaitable = (Awaitable*)p_ctx;
+
+    p_awaitable->status = p_awaitable->finish(ret);
+    //Invoked while the command library completes the command, the coroutine is resumed from the event loop once
+    //it is done. The coroutine may start the next command on the chip then.
+    pal_os_event_register_callback_oneshot(&p_awaitable->resume_event, resume, p_awaitable, 0);
+}
+
+void IFX_OPTIGA_TrustX::Awaitable::resume(void* p_ctx)
+{
+    Awaitable* p_awaitable = (Awaitable*)p_ctx;
+    sCmdLibContext_d* p_selected;
+
+    //The event loop may run inside a blocking call on another chip, keep the context selected for it
+    p_selected = CmdLib_SelectContext(&p_awaitable->trustx->cmdlib_ctx);
+    //The awaitable may be destroyed by the resumed coroutine
+    p_awaitable->resume_handle.resume();
+    CmdLib_SelectContext(p_selected);
+}
+
+int32_t IFX_OPTIGA_TrustX::Awaitable::finish(int32_t ret)
+{
+    if(OP_SHA256 == operation)
+    {
+        //The command replaced the hash context of the session resident on the chip
+        CmdHash_Evict(&trustx->hash_sessions);
+    }
+
+    do
+    {
+        if(CMD_LIB_OK != ret)
+        {
+            break;
+        }
+
+        ret = 0;
+        switch(operation)
+        {
+            case OP_SIGN:
+                *p_len = sign.sign.wLen;
+                break;
+            case OP_KEYPAIR:
+                *p_len = keypair.keypair.sPublicKey.wLen;
+                if(p_len2 != NULL)
+                {
+                    *p_len2 = keypair.keypair.sPrivateKey.wLen;
+                }
+                break;
+            case OP_CERTIFICATE:
+                ret = extractCertificate(cert.resp.prgbBuffer, cert.resp.wRespLength, *p_len);
+                break;
+            default:
+                break;
+        }
+    }while(FALSE);
+
+    return ret;
+}
+
+IFX_OPTIGA_TrustX::Awaitable IFX_OPTIGA_TrustX::getRandomAsync(uint16_t length, uint8_t* p_random)
+{
+    Awaitable op(this, Awaitable::OP_RANDOM);
+
+    op.random.opt.eRngType = eTRNG;
+    op.random.opt.wRandomDataLen = length;
+
+    op.random.resp.prgbBuffer = p_random;
+    op.random.resp.wBufferLength = length;
+    op.random.resp.wRespLength = 0;
+
+    if (p_random == NULL || (active == false)) {
+        op.status = (int32_t)CMD_LIB_ERROR;
+    }
+
+    return op;
+}
+
+IFX_OPTIGA_TrustX::Awaitable IFX_OPTIGA_TrustX::sha256Async(uint8_t dataToHash[], uint16_t ilen, uint8_t out[32])
+{
+    Awaitable op(this, Awaitable::OP_SHA256);
+
+    if ((dataToHash == NULL) || (out == NULL) || (active == false)) {
+        op.status = (int32_t)CMD_LIB_ERROR;
+        return op;
+    }
+
+    op.hash.eHashAlg = eSHA256;
+    op.hash.eHashSequence  = eStartFinalizeHash;
+    op.hash.eHashDataType = eDataStream;
+    op.hash.sDataStream.prgbStream = dataToHash;
+    op.hash.sDataStream.wLen = ilen;
+    op.hash.sContextInfo.dwContextLen = 0x00;
+    op.hash.sContextInfo.pbContextData = NULL;
+    op.hash.sContextInfo.eContextAction = eUnused;
+    op.hash.sOutHash.prgbBuffer = out;
+    op.hash.sOutHash.wBufferLength = 32;
+    op.hash.sOutHash.wRespLength = 0;
+
+    return op;
+}
+
+IFX_OPTIGA_TrustX::Awaitable IFX_OPTIGA_TrustX::calculateSignatureAsync(uint8_t dataToSign[], uint16_t ilen, uint16_t ctx, uint8_t* out, uint16_t& olen)
+{
+    Awaitable op(this, Awaitable::OP_SIGN);
+
+    op.sign.opt.eSignScheme = eECDSA_FIPS_186_3_WITHOUT_HASH;
+    op.sign.opt.sDigestToSign.prgbStream = dataToSign;
+    op.sign.opt.sDigestToSign.wLen = ilen;
+    op.sign.opt.wOIDSignKey = ctx;
+
+    op.sign.sign.prgbStream = out;
+    op.sign.sign.wLen = MAX_SIGN_LEN;
+    op.p_len = &olen;
+
+    if (dataToSign == NULL || out == NULL || (active == false)) {
+        op.status = (int32_t)INT_LIB_ERROR;
+    }
+
+    return op;
+}
+
+IFX_OPTIGA_TrustX::Awaitable IFX_OPTIGA_TrustX::verifySignatureAsync(uint8_t* digest, uint16_t hashLength,
+                                                                     uint8_t* sign, uint16_t signatureLength,
+                                                                     uint16_t publicKey_oid)
+{
+    Awaitable op(this, Awaitable::OP_VERIFY);
+
+    op.verify.opt.eSignScheme = eECDSA_FIPS_186_3_WITHOUT_HASH;
+    op.verify.opt.eVerifyDataType = eOIDData;
+    op.verify.opt.wOIDPubKey = publicKey_oid;
+
+    op.verify.digest.prgbStream = digest;
+    op.verify.digest.wLen = hashLength;
+
+    op.verify.sign.prgbStream = sign;
+    op.verify.sign.wLen = signatureLength;
+
+    if ((digest == NULL) || (sign == NULL) || (active == false)) {
+        op.status = (int32_t)CMD_LIB_ERROR;
+    }
+
+    return op;
+}
+
+IFX_OPTIGA_TrustX::Awaitable IFX_OPTIGA_TrustX::verifySignatureAsync(uint8_t* digest, uint16_t hashLength,
+                                                                     uint8_t* sign, uint16_t signatureLength,
+                                                                     uint8_t* pubKey, uint16_t plen)
+{
+    Awaitable op(this, Awaitable::OP_VERIFY);
+
+    op.verify.opt.eSignScheme = eECDSA_FIPS_186_3_WITHOUT_HASH;
+    op.verify.opt.eVerifyDataType = eDataStream;
+    op.verify.opt.sPubKeyInput.eAlgId = eECC_NIST_P256;
+    op.verify.opt.sPubKeyInput.sDataStream.prgbStream = pubKey;
+    op.verify.opt.sPubKeyInput.sDataStream.wLen = plen;
+
+    op.verify.digest.prgbStream = digest;
+    op.verify.digest.wLen = hashLength;
+
+    op.verify.sign.prgbStream = sign;
+    op.verify.sign.wLen = signatureLength;
+
+    if ((digest == NULL) || (sign == NULL) || (pubKey == NULL) || (active == false)) {
+        op.status = (int32_t)CMD_LIB_ERROR;
+    }
+
+    return op;
+}
+
+IFX_OPTIGA_TrustX::Awaitable IFX_OPTIGA_TrustX::generateKeypairAsync(uint8_t* p_pubkey, uint16_t& plen, uint16_t privkey_oid)
+{
+    Awaitable op(this, Awaitable::OP_KEYPAIR);
+
+    op.keypair.opt.eAlgId = eECC_NIST_P256;
+    op.keypair.opt.eKeyExport = eStorePrivKeyOnly;
+    op.keypair.opt.wOIDPrivKey = (privkey_oid == 0) ? (uint16_t)eSESSION_ID_2 : privkey_oid;
+    op.keypair.opt.eKeyUsage = (eKeyUsage_d)(eKeyAgreement | eAuthentication | eSign);
+
+    op.keypair.keypair.sPublicKey.prgbStream = p_pubkey;
+    op.keypair.keypair.sPublicKey.wLen = 80;
+    op.p_len = &plen;
+
+    if ((p_pubkey == NULL) || (active == false) ||
+        ((privkey_oid != 0) &&
+         (privkey_oid != eSESSION_ID_1) &&
+         (privkey_oid != eSESSION_ID_2) &&
+         (privkey_oid != eSESSION_ID_3) &&
+         (privkey_oid != eSESSION_ID_4) &&
+         (privkey_oid != eFIRST_DEVICE_PRIKEY_2) &&
+         (privkey_oid != eFIRST_DEVICE_PRIKEY_3) &&
+         (privkey_oid != eFIRST_DEVICE_PRIKEY_4)))
+    {
+        op.status = (int32_t)INT_LIB_ERROR;
+    }
+
+    return op;
+}
+
+IFX_OPTIGA_TrustX::Awaitable IFX_OPTIGA_TrustX::generateKeypairAsync(uint8_t* p_pubkey, uint16_t& plen, uint8_t* p_privkey, uint16_t& prlen)
+{
+    Awaitable op(this, Awaitable::OP_KEYPAIR);
+
+    op.keypair.opt.eAlgId = eECC_NIST_P256;
+    op.keypair.opt.eKeyExport = eExportKeyPair;
+    op.keypair.opt.wOIDPrivKey = (uint16_t)eSESSION_ID_2;
+    op.keypair.opt.eKeyUsage = (eKeyUsage_d)(eKeyAgreement | eAuthentication | eSign);
+
+    op.keypair.keypair.sPublicKey.prgbStream = p_pubkey;
+    op.keypair.keypair.sPublicKey.wLen = 80;
+    op.keypair.keypair.sPrivateKey.prgbStream = p_privkey;
+    op.keypair.keypair.sPrivateKey.wLen = 80;
+    op.p_len = &plen;
+    op.p_len2 = &prlen;
+
+    if (p_pubkey == NULL || p_privkey == NULL || (active == false)) {
+        op.status = (int32_t)INT_LIB_ERROR;
+    }
+
+    return op;
+}
+
+IFX_OPTIGA_TrustX::Awaitable IFX_OPTIGA_TrustX::sharedSecretAsync(uint16_t PrivateKey_OID,
+                                                                  uint8_t PublicKey[],
+                                                                  uint16_t PublicKey_Len,
+                                                                  uint16_t SharedSecret_OID,
+                                                                  uint8_t  ExportSharedSecret[],
+                                                                  uint16_t ExportSharedSecret_Len)
+{
+    Awaitable op(this, Awaitable::OP_SHARED_SECRET);
+
+    op.secret.opt.eKeyAgreementType = eECDH_NISTSP80056A;
+    op.secret.opt.ePubKeyAlgId = eECC_NIST_P256;
+    op.secret.opt.sPubKey.prgbStream = PublicKey;
+    op.secret.opt.sPubKey.wLen = PublicKey_Len;
+    op.secret.opt.wOIDPrivKey = PrivateKey_OID;
+    op.secret.opt.wOIDSharedSecret = SharedSecret_OID;
+
+    //The shared secret is exported straight into the user buffer if SharedSecret_OID is 0x0000
+    op.secret.secret.prgbStream = ExportSharedSecret;
+    op.secret.secret.wLen = ExportSharedSecret_Len;
+
+    if ((PublicKey == NULL) || ((SharedSecret_OID == 0x0000) && (ExportSharedSecret == NULL)) || (active == false)) {
+        op.status = (int32_t)CMD_LIB_ERROR;
+    }
+
+    return op;
+}
+
+IFX_OPTIGA_TrustX::Awaitable IFX_OPTIGA_TrustX::getCertificateAsync(uint8_t* p_cert, uint16_t& clen)
+{
+    Awaitable op(this, Awaitable::OP_CERTIFICATE);
+
+    //Read complete certificate
+    op.cert.opt.wOID = OID_IFX_CERTIFICATE;
+    op.cert.opt.wOffset = 0x00;
+    op.cert.opt.wLength = 0xFFFF;
+    op.cert.opt.eDataOrMdata = eDATA;
+
+    op.cert.resp.prgbBuffer = p_cert;
+    op.cert.resp.wBufferLength = LENGTH_CERTIFICATE;
+    op.cert.resp.wRespLength = 0;
+    op.p_len = &clen;
+
+    if ((p_cert == NULL) || (active == false)) {
+        op.status = (int32_t)CMD_LIB_ERROR;
+    }
+
+    return op;
+}
+#endif
@@ -27,10 +27,16 @@
 #ifndef IFXOPTIGATRUST_H_
 #define IFXOPTIGATRUST_H_
 
+#if defined(ARDUINO)
 #include <Arduino.h>
 #include <Wire.h>
+#else
+#include "optiga_trustx/pal_linux_arduino_compat.h"
+#endif
 #include "optiga_trustx/ifx_i2c_transport_layer.h"
 #include "optiga_trustx/pal_ifx_i2c_config.h"
+#include "optiga_trustx/CommandLib.h"
+#include "optiga_trustx/CommandHash.h"
 #include <string.h> // memcpy
 
 #include "optiga_trustx/ErrorCodes.h"
@@ -39,6 +45,12 @@
 #include "optiga_trustx/Util.h"
 #include "optiga_trustx/Version.h"
 
+#if defined(PAL_TARGET_LINUX) && defined(__cpp_impl_coroutine)
+#include <coroutine>
+///Awaitable operations are provided on host builds compiled as C++20
+#define OPTIGA_TRUSTX_COROUTINES
+#endif
+
 /*************************************************************************
 
  *  fundamental typedefs
@@ -142,6 +154,23 @@ typedef enum eArbitraryDataObject {
     arbitrary_data_object_type2_2 = 0xf1e1,
 } eArbitraryDataObject_d;
 
+/**
+ * \brief  Typedef for the policies of the host side object cache
+ */
+typedef enum eCachePolicy_d {
+    ///The object never changes, e.g. the UID or the device certificate. The copy is kept until invalidated.
+    eCACHE_IMMUTABLE,
+    ///The copy is updated with the data written by setGenericData()
+    eCACHE_WRITE_THROUGH,
+    ///The object is read again from the chip once the copy is older than its time to live
+    eCACHE_TTL
+} eCachePolicy_d;
+
+///Number of data objects the host side object cache can hold
+#ifndef OPTIGA_OBJECT_CACHE_ENTRIES
+#define OPTIGA_OBJECT_CACHE_ENTRIES 4
+#endif
+
 /**
  * @defgroup ifx_optiga_library Infineon OPTIGA Trust X Command Library
  * @{
@@ -155,6 +184,15 @@ public:
     //constructor
     IFX_OPTIGA_TrustX();
 
+    /**
+     *
+     * Creates an instance driving the security chip behind the given OPTIGA comms context.
+     * Use one instance per chip to work with several chips on different buses or addresses.
+     *
+     * @param[in]  p_optiga_comms   OPTIGA comms context of the chip. Must stay valid for the lifetime of the instance.
+     */
+    IFX_OPTIGA_TrustX(optiga_comms_t* p_optiga_comms);
+
     //deconstructor
     ~IFX_OPTIGA_TrustX();
 	
@@ -243,12 +281,45 @@ public:
      */
     int32_t getCertificate(uint8_t certificate[], uint16_t& certificateLength);
 
+    /**
+     * Callback receiving the device certificate in chunks, see getCertificate().
+     *
+     * @param[in] ctx               User context passed to getCertificate()
+     * @param[in] offset            Offset of the chunk within the certificate
+     * @param[in] chunk             Chunk of the certificate, valid only during the call
+     * @param[in] clen              Length of the chunk
+     *
+     * @retval  true  To continue reading the certificate.
+     * @retval  false To stop reading, e.g. once the needed field is found.
+     */
+    typedef bool (*certificateChunk_t)(void* ctx, uint16_t offset, const uint8_t chunk[], uint16_t clen);
+
+    /**
+     * @brief Stream the Infineon OPTIGA Trust X device certificate.
+     *
+     * The certificate is read from the device in chunks of the given buffer size and passed to the callback
+     * as DER encoded X.509 certificate without the TLS identity header. Certificates of any size can be
+     * processed with a small buffer and reading stops as soon as the callback returns false.
+     *
+     * @param[in] callback          Function receiving the chunks
+     * @param[in] ctx               User context passed to the callback
+     * @param[in] buffer            Buffer for the chunks, at least 10 bytes. A buffer of up to the
+     *                              communication buffer size of the device minus 4 bytes is read with one command.
+     * @param[in] blen              Length of the buffer
+     *
+     * @retval  0 If function was successful or stopped by the callback.
+     * @retval  1 If the operation failed.
+     */
+    int32_t getCertificate(certificateChunk_t callback, void* ctx, uint8_t buffer[], uint16_t blen);
+
 	/**
 	 * @brief Get the Infineon OPTIGA Trust X device certificate public key.
 	 *
 	 * The function retrieves the public X.509 certificate stored in the
 	 * Infineon OPTIGA Trust X device and extracts the public key from it.
 	 * Work for Certificates based on NIST P256 curve
+	 * The certificate is read in small chunks and reading stops once the public key is found.
+	 * If the certificate is cached with cacheObject(), the key is located in the cached copy by its X.509 structure.
 	 *
 	 * @param[out] publickey  	 Pointer to the buffer where the public key will be stored.
 	 *                           Should 68 bytes long. 64 bytes for the key and 4 bytes for the encoding
@@ -296,6 +367,60 @@ public:
     int32_t getArbitaryDataObject(uint16_t& oid, uint8_t arbitary_data_object_buffer[], uint16_t& arbitary_data_objectLength)
     { return arbitary_data_objectLength != 0?getGenericData(oid, arbitary_data_object_buffer, arbitary_data_objectLength):1; }
 
+    /**
+     * @brief Read the metadata and data of a set of data objects into one snapshot.
+     *
+     * The metadata of each object is read with one command, the data with one more command if the read access
+     * condition is met, sized by the used size in the metadata. Keys and session contexts are listed with their
+     * metadata only. The objects are read back to back without returning to the sketch in between.
+     * The snapshot starts with a header and a directory of offsets, see ObjDump_Init(). Use ObjDump_GetEntry()
+     * from optiga_trustx/ObjectDump.h to access the metadata and data of an object.
+     *
+     * @param[in]     oids            Object IDs, e.g. certificates, keys, arbitrary data objects and session contexts
+     * @param[in]     count           Number of object IDs
+     * @param[out]    snapshot        Buffer receiving the snapshot
+     * @param[in,out] snapshotLength  Length of the buffer, the length of the snapshot on return
+     *
+     * @retval  0 If function was successful. The status of each object is recorded in the snapshot.
+     * @retval  1 If the operation failed.
+     */
+    int32_t getObjectSnapshot(const uint16_t oids[], uint8_t count, uint8_t snapshot[], uint16_t& snapshotLength);
+
+    /**
+     * @brief Keep a host side copy of a data object.
+     *
+     * The object is read into the buffer on the first access. Later reads through getGenericData() and the
+     * functions based on it, e.g. getUniqueID(), are served from the copy without communication with the chip.
+     * For the device certificate (@ref eDEVICE_PUBKEY_CERT_IFX) this applies to getCertificate() and getPublicKey().
+     * A write of the object with setGenericData() updates the copy with @ref eCACHE_WRITE_THROUGH and drops it otherwise.
+     * Objects changed in other ways must be dropped with invalidateCache().
+     *
+     * @param[in] oid               Object ID of the data object
+     * @param[in] buffer            Buffer for the copy, at least the size of the data object. NULL removes the object from the cache.
+     * @param[in] blen              Length of the buffer
+     * @param[in] policy            @ref eCACHE_IMMUTABLE, @ref eCACHE_WRITE_THROUGH or @ref eCACHE_TTL
+     * @param[in] ttl               Time in milliseconds the copy is used with @ref eCACHE_TTL
+     *
+     * @retval  0 If function was successful.
+     * @retval  1 If all OPTIGA_OBJECT_CACHE_ENTRIES entries are in use.
+     */
+    int32_t cacheObject(uint16_t oid, uint8_t buffer[], uint16_t blen, eCachePolicy_d policy = eCACHE_IMMUTABLE, uint32_t ttl = 0);
+
+    /**
+     * @brief Drop the host side copy of a data object, it is read from the chip on the next access.
+     *
+     * @param[in] oid               Object ID of the data object, 0 drops the copies of all objects
+     */
+    void invalidateCache(uint16_t oid = 0);
+
+    /**
+     * @brief Get the number of reads served from the host side object cache and of reads which accessed the chip.
+     *
+     * @param[out] hits             Reads served from a copy
+     * @param[out] misses           Reads of a cached object which accessed the chip
+     */
+    void getCacheStatistics(uint32_t& hits, uint32_t& misses) { hits = cache_hits; misses = cache_misses; }
+
     /**
      * @brief Get a random number.
      *
@@ -357,6 +482,115 @@ public:
      */
     int32_t sha256(uint8_t dataToHash[], uint16_t dlen, uint8_t hash[32]);
 
+    /**
+     * This function starts a SHA256 hash calculation over input of any length, e.g. a firmware image.
+     * The input is passed with @ref sha256Update and the hash is read with @ref sha256Final.
+     * No other function of this object must be called until @ref sha256Final returns.
+     * Calling it again before @ref sha256Final restarts the calculation.
+     *
+     * @retval  0 If function was successful.
+     * @retval  1 If the operation failed.
+     */
+    int32_t sha256Start(void);
+
+    /**
+     * This function adds input to the hash calculation started with @ref sha256Start.
+     * The input is sent in chunks sized to the communication buffer of the chip, the next chunk
+     * is copied while the previous one is on the bus.
+     *
+     * @param[in] data              Pointer to the data
+     * @param[in] dlen              Length of the input data
+     *
+     * @retval  0 If function was successful.
+     * @retval  1 If the operation failed.
+     */
+    int32_t sha256Update(uint8_t data[], uint32_t dlen);
+
+    /**
+     * This function finishes the hash calculation started with @ref sha256Start.
+     * It must be called also if @ref sha256Update failed.
+     *
+     * @param[out] hash             Pointer to the data array where the final result should be stored.
+     *
+     * @retval  0 If function was successful.
+     * @retval  1 If the operation failed.
+     */
+    int32_t sha256Final(uint8_t hash[32]);
+
+    /**
+     * This function calculates SHA256 hash of a data object on the chip, only the hash is transferred.
+     * Use it e.g. to check the integrity of a certificate or to detect changes of a large object.
+     * The hash of an empty object is the SHA256 of the empty message (e3b0c442...), no hash command is sent.
+     *
+     * @param[in] oid               Object ID of the data object. The read access condition must be fulfilled.
+     * @param[out] hash             Pointer to the data array where the final result should be stored.
+     *
+     * @retval  0 If function was successful.
+     * @retval  1 If the operation failed.
+     */
+    int32_t sha256Object(uint16_t oid, uint8_t hash[32]);
+
+    /**
+     * This function calculates SHA256 hash of a slice of a data object on the chip.
+     * The hash of an empty slice is the SHA256 of the empty message (e3b0c442...), no hash command is sent.
+     *
+     * @param[in] oid               Object ID of the data object. The read access condition must be fulfilled.
+     * @param[in] offset            Offset of the slice within the data object
+     * @param[in] length            Length of the slice
+     * @param[out] hash             Pointer to the data array where the final result should be stored.
+     *
+     * @retval  0 If function was successful.
+     * @retval  1 If the operation failed.
+     */
+    int32_t sha256Object(uint16_t oid, uint16_t offset, uint16_t length, uint8_t hash[32]);
+
+    /**
+     * This function sets up concurrent SHA256 sessions, e.g. one per network connection.
+     * The chip keeps a single hash context, the context of each session is swapped out to a slot
+     * of the given pool. Updates of a session are collected in its slot and sent once it is full.
+     *
+     * @param[in] pool              Pool for the sessions, CMD_HASH_SESSION_SLOT_SIZE(bufferLength) bytes per session
+     * @param[in] plen              Length of the pool
+     * @param[in] bufferLength      [Optional] Size of the input buffer of a session. Default is the largest input of a command.
+     *
+     * @retval  0 If function was successful.
+     * @retval  1 If the operation failed.
+     */
+    int32_t hashSessionsBegin(uint8_t pool[], uint16_t plen, uint16_t bufferLength = 0);
+
+    /**
+     * This function opens a SHA256 session in the pool given to @ref hashSessionsBegin.
+     *
+     * @param[out] session          Session to open
+     *
+     * @retval  0 If function was successful.
+     * @retval  1 If the operation failed.
+     */
+    int32_t hashSessionOpen(sCmdHashSession_d& session);
+
+    /**
+     * This function adds input to a session opened with @ref hashSessionOpen.
+     *
+     * @param[in] session           Session
+     * @param[in] data              Pointer to the data
+     * @param[in] dlen              Length of the input data
+     *
+     * @retval  0 If function was successful.
+     * @retval  1 If the operation failed.
+     */
+    int32_t hashSessionUpdate(sCmdHashSession_d& session, uint8_t data[], uint32_t dlen);
+
+    /**
+     * This function finishes a session opened with @ref hashSessionOpen and releases its slot.
+     *
+     * @param[in] session           Session
+     * @param[out] hash             Pointer to the data array where the final result should be stored.
+     *
+     * @retval  0 If function was successful.
+     * @retval  1 If the operation failed.
+     */
+    int32_t hashSessionFinal(sCmdHashSession_d& session, uint8_t hash[32]);
+
     /**
      * This function generates an ECDSA FIPS 186-3 w/o hash signature.
      *
@@ -524,20 +758,127 @@ public:
     /*
      * Derive key
      */
-    int32_t IFX_OPTIGA_TrustX::deriveKey(uint16_t ShareSecret_OID,
+    int32_t deriveKey(uint16_t ShareSecret_OID,
     									 uint16_t ShareSecret_OID_Len,
     		                             uint16_t DeriveKey_OID,
     									 int8_t* ExportDeriveKey,
 										 int8_t ExportDeriveKey_Len
     									 );
 
+#if defined(OPTIGA_TRUSTX_COROUTINES)
+    /**
+     * Awaitable returned by the *Async functions of this class on host builds compiled as C++20.
+     *
+     * co_await starts the command on the chip and suspends the coroutine. The coroutine is resumed from the
+     * event loop (@ref pal_os_event_wait) after the command completed, so one thread can keep commands in flight
+     * on several chips. The result of co_await is 0 if the operation was successful, an error code otherwise.
+     * The buffers passed to the *Async function must stay valid until the coroutine is resumed.
+     * Only one command can be in flight per chip, CMD_LIB_BUSY is returned otherwise.
+     */
+    class Awaitable
+    {
+    public:
+        bool await_ready(void) const { return (0 != status); }
+        bool await_suspend(std::coroutine_handle<> handle);
+        int32_t await_resume(void) const { return status; }
+
+    private:
+        friend class IFX_OPTIGA_TrustX;
+
+        enum operation_t
+        {
+            OP_RANDOM,
+            OP_SHA256,
+            OP_SIGN,
+            OP_VERIFY,
+            OP_KEYPAIR,
+            OP_SHARED_SECRET,
+            OP_CERTIFICATE
+        };
+
+        Awaitable(IFX_OPTIGA_TrustX* p_trustx, operation_t op);
+        static void complete(void* p_ctx, int32_t ret);
+        static void resume(void* p_ctx);
+        int32_t finish(int32_t ret);
+
+        IFX_OPTIGA_TrustX* trustx;
+        operation_t operation;
+        std::coroutine_handle<> resume_handle;
+        //Event node resuming the coroutine from the event loop
+        pal_os_event_t resume_event;
+        int32_t status;
+        //Output lengths updated once completed
+        uint16_t* p_len;
+        uint16_t* p_len2;
+        //Command inputs, they are handed over to the command library once the coroutine is suspended
+        union
+        {
+            struct { sRngOptions_d opt; sCmdResponse_d resp; } random;
+            sCalcHash_d hash;
+            struct { sCalcSignOptions_d opt; sbBlob_d sign; } sign;
+            struct { sVerifyOption_d opt; sbBlob_d digest; sbBlob_d sign; } verify;
+            struct { sKeyPairOption_d opt; sOutKeyPair_d keypair; } keypair;
+            struct { sCalcSSecOptions_d opt; sbBlob_d secret; } secret;
+            struct { sGetData_d opt; sCmdResponse_d resp; } cert;
+        };
+    };
+
+    /**
+     * Awaitable variants of the functions above, see @ref Awaitable.
+     * The parameters are the same as for the blocking function of the same name.
+     */
+    Awaitable getRandomAsync(uint16_t length, uint8_t random[]);
+    Awaitable sha256Async(uint8_t dataToHash[], uint16_t dlen, uint8_t hash[32]);
+    Awaitable calculateSignatureAsync(uint8_t dataToSign[], uint16_t dlen, uint16_t privateKey_oid, uint8_t result[], uint16_t& rlen);
+    Awaitable calculateSignatureAsync(uint8_t dataToSign[], uint16_t dlen, uint8_t result[], uint16_t& rlen) {
+        return calculateSignatureAsync(dataToSign, dlen, eFIRST_DEVICE_PRIKEY_1, result, rlen);
+    }
+    Awaitable verifySignatureAsync(uint8_t hash[], uint16_t hashLength, uint8_t signature[], uint16_t signatureLength, uint16_t publicKey_oid = eDEVICE_PUBKEY_CERT_IFX);
+    Awaitable verifySignatureAsync(uint8_t hash[], uint16_t hashLength, uint8_t signature[], uint16_t signatureLength, uint8_t pubKey[], uint16_t plen);
+    Awaitable generateKeypairAsync(uint8_t publicKey[], uint16_t& plen, uint16_t privateKey_oid = 0);
+    Awaitable generateKeypairAsync(uint8_t publicKey[], uint16_t& plen, uint8_t privateKey[], uint16_t& prlen);
+    Awaitable sharedSecretAsync(uint16_t PrivateKey_OID,
+                                uint8_t PublicKey[],
+                                uint16_t PublicKey_Len,
+                                uint16_t SharedSecret_OID,
+                                uint8_t  ExportSharedSecret[],
+                                uint16_t ExportSharedSecret_Len);
+    Awaitable getCertificateAsync(uint8_t certificate[], uint16_t& certificateLength);
+#endif
+
 private:
+    friend class IFX_OPTIGA_RandomPool;
 	bool active;
+    optiga_comms_t* p_comms;
+    sCmdLibContext_d cmdlib_ctx;
+    sCmdHash_d hash_stream;
+    sCmdHashManager_d hash_sessions;
+    //Host side copy of a data object, see cacheObject()
+    struct cacheEntry_t
+    {
+        uint8_t* p_buf;
+        uint16_t oid;
+        uint16_t blen;
+        uint16_t len;
+        uint8_t policy;
+        bool valid;
+        //The copy holds the whole object, otherwise only its first len bytes
+        bool complete;
+        uint32_t ttl;
+        uint32_t time;
+    };
+    cacheEntry_t cache[OPTIGA_OBJECT_CACHE_ENTRIES];
+    uint32_t cache_hits;
+    uint32_t cache_misses;
+    cacheEntry_t* cacheLookup(uint16_t oid);
+    int32_t cacheFetch(cacheEntry_t* entry, uint16_t len);
+    void cacheWritten(uint16_t oid, const uint8_t* p_data, uint16_t len, bool ok);
     int32_t getGlobalSecurityStatus(uint8_t& status);
     int32_t setGlobalSecurityStatus(uint8_t status);
     int32_t getAppSecurityStatus(uint8_t* p_data, uint16_t& hashLength);
     int32_t setAppSecurityStatus(uint8_t status);
     int32_t getGenericData(uint16_t oid, uint8_t* p_data, uint16_t& hashLength);
+    int32_t getUsedSize(uint16_t oid, uint16_t& size);
     int32_t getState(uint16_t oid, uint8_t& p_data);
     int32_t setGenericData(uint16_t oid, uint8_t* p_data, uint16_t hashLength);
     int32_t str2cur(String curve_name);
@@ -546,6 +887,7 @@ private:
 		return calculateSharedSecretGeneric(0x03, priv_oid, p_pubkey, plen, out_oid, NULL, dummy_len);
 	}
     int32_t calculateSharedSecretGeneric( int32_t curveID, uint16_t priv_oid, uint8_t* p_pubkey, uint16_t plen, uint16_t out_oid, uint8_t* p_out, uint16_t& olen);
+    static int32_t extractCertificate(uint8_t* p_cert, uint16_t len, uint16_t& clen);
     int32_t ecp_gen_keypair_generic(uint8_t* p_pubkey, uint16_t& plen, uint16_t& ctx, uint8_t* p_privkey, uint16_t& prlen);
 
 };
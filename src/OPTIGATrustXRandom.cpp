@@ -0,0 +1,359 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018 Infineon Technologies AG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE
+ *
+ * Arduino library for OPTIGA™ Trust X.
+ */
+#include "OPTIGATrustXRandom.h"
+#include "optiga_trustx/pal_os_event.h"
+
+///Minimum length of a GetRandom command
+#define     RANDOM_MIN_LENGTH                   8
+///Maximum length of a GetRandom command
+#define     RANDOM_MAX_LENGTH                   256
+///Length of the DRBG seed (Key and V)
+#define     DRBG_SEED_LENGTH                    (2 * N_BLOCK)
+
+/*
+ * Local Functions
+ */
+
+static void incrementBlock(uint8_t block[N_BLOCK])
+{
+    int i;
+
+    for (i = N_BLOCK - 1; i >= 0; i--)
+    {
+        if (++block[i] != 0)
+        {
+            break;
+        }
+    }
+}
+
+/*
+ * Global Functions
+ */
+
+IFX_OPTIGA_RandomPool::IFX_OPTIGA_RandomPool(IFX_OPTIGA_TrustX& chip)
+{
+    trustx = &chip;
+    ring = NULL;
+    size = 0;
+    head = 0;
+    tail = 0;
+    count = 0;
+    refilling = false;
+    refill_status = CMD_LIB_OK;
+    refill_len = 0;
+    active = false;
+    drbg = false;
+    source = eTRNG;
+    reseed_counter = 0;
+    reseed_interval = 0;
+}
+
+IFX_OPTIGA_RandomPool::~IFX_OPTIGA_RandomPool()
+{
+    end();
+}
+
+int32_t IFX_OPTIGA_RandomPool::begin(uint8_t buffer[], uint16_t blen, bool use_drbg, eRngType_d rng_source, uint32_t reseedInterval)
+{
+    int32_t ret = 1;
+
+    do {
+        if ((buffer == NULL) || (trustx->active == false)) {
+            break;
+        }
+
+        end();
+
+        //Refills are multiples of the minimum GetRandom length, so the free space at the head is never smaller
+        ring = buffer;
+        size = blen - (blen % RANDOM_MIN_LENGTH);
+        if (size < (use_drbg ? DRBG_SEED_LENGTH : (2 * RANDOM_MIN_LENGTH))) {
+            break;
+        }
+        drbg = use_drbg;
+        source = rng_source;
+        reseed_interval = (reseedInterval == 0) ? 1 : reseedInterval;
+        active = true;
+
+        if ((drbg && (drbgSeed(true) != 0)) || (waitFor(size) != 0)) {
+            end();
+            break;
+        }
+        ret = 0;
+    }while(0);
+
+    return ret;
+}
+
+void IFX_OPTIGA_RandomPool::end(void)
+{
+    while (refilling) {
+        pal_os_event_wait();
+    }
+
+    if ((ring != NULL) && active) {
+        memset(ring, 0, size);
+    }
+    memset(key, 0, sizeof(key));
+    memset(v, 0, sizeof(v));
+    aes.clean();
+    active = false;
+    head = 0;
+    tail = 0;
+    count = 0;
+}
+
+int32_t IFX_OPTIGA_RandomPool::getRandom(uint16_t length, uint8_t random[])
+{
+    int32_t ret = 1;
+
+    do {
+        if ((random == NULL) || (active == false)) {
+            break;
+        }
+
+        if (drbg) {
+            if ((reseed_counter >= reseed_interval) && (drbgSeed(false) != 0)) {
+                break;
+            }
+            drbgGenerate(random, length);
+            ret = 0;
+        } else if (length > (size / 2)) {
+            ret = fetch(random, length);
+        } else if (waitFor(length) == 0) {
+            take(random, length);
+            ret = 0;
+        }
+    }while(0);
+
+    if (active && (count <= (size / 2))) {
+        startRefill();
+    }
+
+    return ret;
+}
+
+void IFX_OPTIGA_RandomPool::refillDone(void* ctx, int32_t status)
+{
+    IFX_OPTIGA_RandomPool* pool = static_cast<IFX_OPTIGA_RandomPool*>(ctx);
+
+    pool->refilling = false;
+    //A short answer leaves part of the batch unwritten, count it as a failed refill
+    if ((CMD_LIB_OK == status) && (pool->rng_resp.wRespLength != pool->refill_len)) {
+        status = (int32_t)CMD_LIB_ERROR;
+    }
+    pool->refill_status = status;
+    if (CMD_LIB_OK == status) {
+        pool->head = (pool->head + pool->refill_len) % pool->size;
+        pool->count = (uint16_t)(pool->count + pool->refill_len);
+        //Continue in batches until the ring is full
+        pool->startRefill();
+    }
+}
+
+int32_t IFX_OPTIGA_RandomPool::startRefill(void)
+{
+    int32_t ret = CMD_LIB_OK;
+    sCmdLibContext_d* selected;
+    uint16_t len = size - head;
+
+    do {
+        if (refilling || (active == false)) {
+            break;
+        }
+
+        //Contiguous free space at the head, the batch must not overwrite unread random numbers
+        if (len > (size - count)) {
+            len = size - count;
+        }
+        if (len > RANDOM_MAX_LENGTH) {
+            len = RANDOM_MAX_LENGTH;
+        }
+        len -= len % RANDOM_MIN_LENGTH;
+        if (len == 0) {
+            break;
+        }
+
+        rng_opt.eRngType = source;
+        rng_opt.wRandomDataLen = len;
+        rng_resp.prgbBuffer = ring + head;
+        rng_resp.wBufferLength = len;
+        rng_resp.wRespLength = 0;
+        refill_len = len;
+
+        refilling = true;
+        selected = CmdLib_SelectContext(&trustx->cmdlib_ctx);
+        ret = CmdLib_GetRandomAsync(&rng_opt, &rng_resp, refillDone, this);
+        CmdLib_SelectContext(selected);
+        if (CMD_LIB_OK != ret) {
+            refilling = false;
+        }
+    }while(0);
+
+    return ret;
+}
+
+int32_t IFX_OPTIGA_RandomPool::waitFor(uint16_t length)
+{
+    int32_t status;
+
+    refill_status = CMD_LIB_OK;
+    while (count < length)
+    {
+        if (!refilling)
+        {
+            if (CMD_LIB_OK != refill_status) {
+                return 1;
+            }
+            status = startRefill();
+            //Another asynchronous command is in progress, wait for it
+            if ((CMD_LIB_OK != status) && ((int32_t)CMD_LIB_BUSY != status)) {
+                return 1;
+            }
+        }
+        pal_os_event_wait();
+    }
+
+    return 0;
+}
+
+int32_t IFX_OPTIGA_RandomPool::fetch(uint8_t* p_out, uint16_t length)
+{
+    int32_t ret = 0;
+    uint8_t last[RANDOM_MIN_LENGTH];
+    sRngOptions_d opt;
+    sCmdResponse_d resp;
+    uint16_t len;
+    sCmdLibContext_d* selected;
+
+    opt.eRngType = source;
+    selected = CmdLib_SelectContext(&trustx->cmdlib_ctx);
+    while (length > 0)
+    {
+        len = (length > RANDOM_MAX_LENGTH) ? RANDOM_MAX_LENGTH : length;
+        //The chip returns at least RANDOM_MIN_LENGTH bytes
+        opt.wRandomDataLen = (len < RANDOM_MIN_LENGTH) ? RANDOM_MIN_LENGTH : len;
+        resp.prgbBuffer = (len < RANDOM_MIN_LENGTH) ? last : p_out;
+        resp.wBufferLength = opt.wRandomDataLen;
+        resp.wRespLength = 0;
+
+        if ((CMD_LIB_OK != CmdLib_GetRandom(&opt, &resp)) || (resp.wRespLength != opt.wRandomDataLen)) {
+            ret = 1;
+            break;
+        }
+        if (len < RANDOM_MIN_LENGTH) {
+            memcpy(p_out, last, len);
+            memset(last, 0, sizeof(last));
+        }
+        p_out += len;
+        length -= len;
+    }
+    CmdLib_SelectContext(selected);
+
+    return ret;
+}
+
+void IFX_OPTIGA_RandomPool::take(uint8_t* p_out, uint16_t length)
+{
+    uint16_t len;
+
+    while (length > 0)
+    {
+        len = size - tail;
+        if (len > length) {
+            len = length;
+        }
+        //Random numbers handed out are not kept
+        memcpy(p_out, ring + tail, len);
+        memset(ring + tail, 0, len);
+        tail = (tail + len) % size;
+        count = (uint16_t)(count - len);
+        p_out += len;
+        length -= len;
+    }
+}
+
+void IFX_OPTIGA_RandomPool::drbgUpdate(const uint8_t* p_provided)
+{
+    uint8_t temp[DRBG_SEED_LENGTH];
+    uint8_t i;
+
+    for (i = 0; i < DRBG_SEED_LENGTH; i += N_BLOCK)
+    {
+        incrementBlock(v);
+        aes.encrypt(v, temp + i);
+    }
+    if (p_provided != NULL) {
+        for (i = 0; i < DRBG_SEED_LENGTH; i++) {
+            temp[i] ^= p_provided[i];
+        }
+    }
+    memcpy(key, temp, N_BLOCK);
+    memcpy(v, temp + N_BLOCK, N_BLOCK);
+    aes.set_key(key, N_BLOCK);
+    memset(temp, 0, sizeof(temp));
+}
+
+int32_t IFX_OPTIGA_RandomPool::drbgSeed(bool instantiate)
+{
+    uint8_t seed[DRBG_SEED_LENGTH];
+
+    if (waitFor(DRBG_SEED_LENGTH) != 0) {
+        return 1;
+    }
+    take(seed, DRBG_SEED_LENGTH);
+
+    if (instantiate) {
+        memset(key, 0, sizeof(key));
+        memset(v, 0, sizeof(v));
+        aes.set_key(key, N_BLOCK);
+    }
+    drbgUpdate(seed);
+    memset(seed, 0, sizeof(seed));
+    reseed_counter = 0;
+
+    return 0;
+}
+
+void IFX_OPTIGA_RandomPool::drbgGenerate(uint8_t* p_out, uint16_t length)
+{
+    uint8_t block[N_BLOCK];
+    uint16_t len;
+
+    while (length > 0)
+    {
+        incrementBlock(v);
+        aes.encrypt(v, block);
+        len = (length > N_BLOCK) ? N_BLOCK : length;
+        memcpy(p_out, block, len);
+        p_out += len;
+        length -= len;
+    }
+    drbgUpdate(NULL);
+    reseed_counter++;
+    memset(block, 0, sizeof(block));
+}
@@ -0,0 +1,124 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2018 Infineon Technologies AG
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE
+ *
+ * Random number service for OPTIGA™ Trust X.
+ */
+
+#ifndef IFXOPTIGATRUSTRANDOM_H_
+#define IFXOPTIGATRUSTRANDOM_H_
+
+#include "OPTIGATrustX.h"
+#include "aes/AES.h"
+
+/**
+ * Serves random numbers from a host side ring buffer, so small requests like nonces do not
+ * issue a GetRandom command each. The ring is refilled from the chip in batches in the background,
+ * once it is half empty. The refill continues whenever the event loop runs, e.g. while other commands
+ * wait for the chip or when the application calls pal_os_event_process() in its idle time.
+ *
+ * Optionally a host CTR-DRBG (NIST SP 800-90A, AES-128 without derivation function) generates the output.
+ * It is seeded from the chip and reseeded periodically, the ring then buffers the seed material.
+ *
+ * Example:
+ * @code
+ * uint8_t pool[128];
+ * IFX_OPTIGA_RandomPool rng;
+ * rng.begin(pool, sizeof(pool));
+ * rng.getRandom(8, nonce);
+ * @endcode
+ */
+class IFX_OPTIGA_RandomPool
+{
+public:
+    IFX_OPTIGA_RandomPool(IFX_OPTIGA_TrustX& trustx = trustX);
+    ~IFX_OPTIGA_RandomPool();
+
+    /**
+     * This function starts the service and fills the ring buffer. The chip must be started with begin() before.
+     *
+     * @param[in] buffer            Ring buffer, at least 16 bytes or 32 bytes with the DRBG. It is used in multiples of 8 bytes.
+     * @param[in] blen              Length of the ring buffer
+     * @param[in] drbg              [Optional] Generate the output with a host CTR-DRBG seeded from the chip. Default is false.
+     * @param[in] source            [Optional] Random number generator of the chip, eTRNG (Default) or eDRNG
+     * @param[in] reseedInterval    [Optional] Number of requests served by the DRBG before it is reseeded. Default is 256.
+     *
+     * @retval  0 If function was successful.
+     * @retval  1 If the operation failed.
+     */
+    int32_t begin(uint8_t buffer[], uint16_t blen, bool drbg = false, eRngType_d source = eTRNG, uint32_t reseedInterval = 256);
+
+    /**
+     * This function stops the service. It waits for a refill in progress and wipes the buffered random numbers and the DRBG state.
+     */
+    void end(void);
+
+    /**
+     * This function returns random numbers. Requests which the ring buffer can serve do not touch the bus,
+     * requests larger than half of it are read from the chip directly.
+     *
+     * @param[in] length            Length of the random numbers
+     * @param[out] random           Pointer to the data array where the random numbers should be stored.
+     *
+     * @retval  0 If function was successful.
+     * @retval  1 If the operation failed.
+     */
+    int32_t getRandom(uint16_t length, uint8_t random[]);
+
+    /**
+     * This function returns the number of random bytes buffered in the ring.
+     */
+    uint16_t available(void) { return count; }
+
+private:
+    IFX_OPTIGA_TrustX* trustx;
+    uint8_t* ring;
+    uint16_t size;
+    uint16_t head;
+    uint16_t tail;
+    volatile uint16_t count;
+    volatile bool refilling;
+    volatile int32_t refill_status;
+    uint16_t refill_len;
+    bool active;
+    bool drbg;
+    eRngType_d source;
+    sRngOptions_d rng_opt;
+    sCmdResponse_d rng_resp;
+    // CTR-DRBG state
+    AES aes;
+    uint8_t key[N_BLOCK];
+    uint8_t v[N_BLOCK];
+    uint32_t reseed_counter;
+    uint32_t reseed_interval;
+
+    static void refillDone(void* ctx, int32_t status);
+    int32_t startRefill(void);
+    int32_t waitFor(uint16_t length);
+    int32_t fetch(uint8_t* p_out, uint16_t length);
+    void take(uint8_t* p_out, uint16_t length);
+    void drbgUpdate(const uint8_t* p_provided);
+    int32_t drbgSeed(bool instantiate);
+    void drbgGenerate(uint8_t* p_out, uint16_t length);
+};
+
+#endif /* IFXOPTIGATRUSTRANDOM_H_ */
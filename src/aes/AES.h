@@ -1,7 +1,12 @@
 #ifndef __AES_H__
 #define __AES_H__
 
+#if defined(ARDUINO)
 #include <avr/pgmspace.h>
+#else
+#define PROGMEM
+#define pgm_read_byte(p) (*(const unsigned char*)(p))
+#endif
 /*
  ---------------------------------------------------------------------------
  Copyright (c) 1998-2008, Brian Gladman, Worcester, UK. All rights reserved.
@@ -0,0 +1,295 @@
+/**
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+*
+*
+* \file
+*
+* \brief   This file implements the certificate index. The DER encoding of a X.509 certificate is walked once
+*          and the location of its fields is recorded, so they can be accessed later without parsing or copying.
+*
+* \ingroup  grIntLib
+* @{
+*/
+
+#include <stdint.h>
+#include "CertificateIndex.h"
+#include "MemoryMgmt.h"
+#include "Util.h"
+
+/// @cond hidden
+
+///ASN.1 tag of an integer
+#define DER_TAG_INTEGER                 0x02
+
+///ASN.1 tag of a bit string
+#define DER_TAG_BIT_STRING              0x03
+
+///ASN.1 tag of a sequence
+#define DER_TAG_SEQUENCE                0x30
+
+///ASN.1 tag of the explicit certificate version [0]
+#define DER_TAG_VERSION                 0xA0
+
+///Length field with one subsequent length byte
+#define DER_LENGTH_1_BYTE               0x81
+
+///Length field with two subsequent length bytes
+#define DER_LENGTH_2_BYTES              0x82
+
+///TLS Identity Tag
+#define TLS_TAG                         0xC0
+
+///Length of the TLS identity header, tag, length, certificate list length and certificate length
+#define LENGTH_TLS_IDENTITY_HEADER      9
+
+/**
+ * \brief Reads the DER header of the element at PwOffset, which must have the tag PbTag and end within PwEnd.
+ *        Returns the length of the tag and length bytes, 0 if the element is invalid.
+ */
+_STATIC_H uint16_t CertIdx_ReadHeader(const uint8_t* PprgbCert, uint16_t PwOffset, uint16_t PwEnd, uint8_t PbTag,
+                                      sCertField_d* PpsField)
+{
+    uint16_t wHeaderLen = 0;
+    uint16_t wValueLen = 0;
+
+    do
+    {
+        if(((uint32_t)PwOffset + 2 > PwEnd) || (PbTag != PprgbCert[PwOffset]))
+        {
+            break;
+        }
+        if(PprgbCert[PwOffset + 1] < DER_LENGTH_1_BYTE)
+        {
+            wValueLen = PprgbCert[PwOffset + 1];
+            wHeaderLen = 2;
+        }
+        else if((DER_LENGTH_1_BYTE == PprgbCert[PwOffset + 1]) && ((uint32_t)PwOffset + 3 <= PwEnd))
+        {
+            wValueLen = PprgbCert[PwOffset + 2];
+            wHeaderLen = 3;
+        }
+        else if((DER_LENGTH_2_BYTES == PprgbCert[PwOffset + 1]) && ((uint32_t)PwOffset + 4 <= PwEnd))
+        {
+            wValueLen = Utility_GetUint16(&PprgbCert[PwOffset + 2]);
+            wHeaderLen = 4;
+        }
+        else
+        {
+            //Indefinite or longer lengths are not used by certificates of the security chip
+            break;
+        }
+        if((uint32_t)PwOffset + wHeaderLen + wValueLen > PwEnd)
+        {
+            wHeaderLen = 0;
+            break;
+        }
+        PpsField->wOffset = PwOffset;
+        PpsField->wLen = wHeaderLen + wValueLen;
+    }while(FALSE);
+
+    return wHeaderLen;
+}
+
+/// @endcond
+
+/**
+* Locates the fields of a DER encoded X.509 certificate. The certificate is walked once, descending only into
+* the elements which contain indexed fields. Nothing is copied or allocated.
+*
+* <br>
+* Notes:
+* - The certificate can be preceded by the TLS identity header (tag 0xC0) as stored in the certificate data objects
+*   of the security chip. The offsets are relative to PprgbCert in any case.<br>
+* - The index only refers to the buffer by offsets. It stays valid as long as the certificate is not changed,
+*   even if the buffer is moved.<br>
+* - The structure is checked as far as it is walked. The contents of the fields, e.g. the algorithms or names,
+*   are not verified.<br>
+*
+* \param[in]  PprgbCert     Pointer to the certificate
+* \param[in]  PwCertLen     Length of the certificate
+* \param[out] PpsIndex      Pointer to the index, all fields are empty if the certificate is invalid
+*
+* \retval  #INT_LIB_OK
+* \retval  #INT_LIB_NULL_PARAM
+* \retval  #INT_LIB_INVALID_CERTIFICATE_FORMAT
+*/
+int32_t CertIdx_Build(const uint8_t* PprgbCert, uint16_t PwCertLen, sCertIndex_d* PpsIndex)
+{
+    //Elements of the TBSCertificate following the version, eCERT_FIELDS for elements which are not indexed
+    static const uint8_t rgbTbsTag[] = {DER_TAG_INTEGER, DER_TAG_SEQUENCE, DER_TAG_SEQUENCE,
+                                        DER_TAG_SEQUENCE, DER_TAG_SEQUENCE, DER_TAG_SEQUENCE};
+    static const uint8_t rgbTbsField[] = {eCERT_SERIAL, eCERT_FIELDS, eCERT_ISSUER,
+                                          eCERT_VALIDITY, eCERT_SUBJECT, eCERT_PUBLIC_KEY_INFO};
+
+    int32_t i4Status = (int32_t)INT_LIB_INVALID_CERTIFICATE_FORMAT;
+    sCertField_d* psField;
+    sCertField_d sSkipped;
+    uint16_t wOffset = 0;
+    uint16_t wEnd = PwCertLen;
+    uint16_t wTbsEnd;
+    uint16_t wHeader;
+    uint8_t bIndex;
+
+    do
+    {
+        if((NULL == PprgbCert) || (NULL == PpsIndex))
+        {
+            i4Status = (int32_t)INT_LIB_NULL_PARAM;
+            break;
+        }
+        OCP_MEMSET((uint8_t*)PpsIndex,0,sizeof(sCertIndex_d));
+        psField = PpsIndex->rgsField;
+
+        if((PwCertLen > LENGTH_TLS_IDENTITY_HEADER) && (TLS_TAG == PprgbCert[0]))
+        {
+            if(((uint32_t)Utility_GetUint16(&PprgbCert[1]) + 3 > PwCertLen) ||
+               (Utility_GetUint24(&PprgbCert[6]) + LENGTH_TLS_IDENTITY_HEADER > PwCertLen))
+            {
+                break;
+            }
+            wOffset = LENGTH_TLS_IDENTITY_HEADER;
+            wEnd = (uint16_t)(LENGTH_TLS_IDENTITY_HEADER + Utility_GetUint24(&PprgbCert[6]));
+        }
+
+        //Certificate, anything following it is ignored
+        wHeader = CertIdx_ReadHeader(PprgbCert,wOffset,wEnd,DER_TAG_SEQUENCE,&psField[eCERT_CERTIFICATE]);
+        if(0 == wHeader)
+        {
+            break;
+        }
+        wEnd = psField[eCERT_CERTIFICATE].wOffset + psField[eCERT_CERTIFICATE].wLen;
+        wOffset += wHeader;
+
+        //TBSCertificate
+        wHeader = CertIdx_ReadHeader(PprgbCert,wOffset,wEnd,DER_TAG_SEQUENCE,&psField[eCERT_TBS]);
+        if(0 == wHeader)
+        {
+            break;
+        }
+        wTbsEnd = psField[eCERT_TBS].wOffset + psField[eCERT_TBS].wLen;
+        wOffset += wHeader;
+        if((wOffset < wTbsEnd) && (DER_TAG_VERSION == PprgbCert[wOffset]))
+        {
+            if(0 == CertIdx_ReadHeader(PprgbCert,wOffset,wTbsEnd,DER_TAG_VERSION,&sSkipped))
+            {
+                break;
+            }
+            wOffset += sSkipped.wLen;
+        }
+        for(bIndex = 0; bIndex < sizeof(rgbTbsTag); bIndex++)
+        {
+            if(0 == CertIdx_ReadHeader(PprgbCert,wOffset,wTbsEnd,rgbTbsTag[bIndex],
+                                       (eCERT_FIELDS == rgbTbsField[bIndex]) ? &sSkipped : &psField[rgbTbsField[bIndex]]))
+            {
+                break;
+            }
+            wOffset += (eCERT_FIELDS == rgbTbsField[bIndex]) ? sSkipped.wLen : psField[rgbTbsField[bIndex]].wLen;
+        }
+        if(bIndex < sizeof(rgbTbsTag))
+        {
+            break;
+        }
+
+        //Public key following the algorithm in the SubjectPublicKeyInfo
+        wOffset = psField[eCERT_PUBLIC_KEY_INFO].wOffset;
+        wHeader = CertIdx_ReadHeader(PprgbCert,wOffset,wTbsEnd,DER_TAG_SEQUENCE,&sSkipped);
+        wOffset += wHeader;
+        wHeader = CertIdx_ReadHeader(PprgbCert,wOffset,wTbsEnd,DER_TAG_SEQUENCE,&sSkipped);
+        if(0 == wHeader)
+        {
+            break;
+        }
+        wOffset += sSkipped.wLen;
+        if(0 == CertIdx_ReadHeader(PprgbCert,wOffset,psField[eCERT_PUBLIC_KEY_INFO].wOffset + psField[eCERT_PUBLIC_KEY_INFO].wLen,
+                                   DER_TAG_BIT_STRING,&psField[eCERT_PUBLIC_KEY]))
+        {
+            break;
+        }
+
+        //Signature algorithm and signature following the TBSCertificate
+        if(0 == CertIdx_ReadHeader(PprgbCert,wTbsEnd,wEnd,DER_TAG_SEQUENCE,&psField[eCERT_SIGNATURE_ALG]))
+        {
+            break;
+        }
+        wOffset = wTbsEnd + psField[eCERT_SIGNATURE_ALG].wLen;
+        if(0 == CertIdx_ReadHeader(PprgbCert,wOffset,wEnd,DER_TAG_BIT_STRING,&psField[eCERT_SIGNATURE]))
+        {
+            break;
+        }
+        i4Status = INT_LIB_OK;
+    }while(FALSE);
+
+    if((INT_LIB_OK != i4Status) && (NULL != PpsIndex))
+    {
+        OCP_MEMSET((uint8_t*)PpsIndex,0,sizeof(sCertIndex_d));
+    }
+    return i4Status;
+}
+
+/**
+* Returns a field of a certificate indexed with #CertIdx_Build. The field refers to the certificate buffer,
+* it includes the DER tag and length.
+*
+* \param[in]  PpsIndex      Pointer to the index
+* \param[in]  PprgbCert     Pointer to the certificate the index was built for
+* \param[in]  PeField       Field to return
+* \param[out] PpsField      Pointer to the field within PprgbCert
+*
+* \retval  #INT_LIB_OK
+* \retval  #INT_LIB_NULL_PARAM
+* \retval  #INT_LIB_INVALID_PARAM
+* \retval  #INT_LIB_ERROR          The field is not indexed
+*/
+int32_t CertIdx_GetField(const sCertIndex_d* PpsIndex, const uint8_t* PprgbCert, eCertField_d PeField,
+                         sbBlob_d* PpsField)
+{
+    int32_t i4Status = (int32_t)INT_LIB_ERROR;
+
+    do
+    {
+        if((NULL == PpsIndex) || (NULL == PprgbCert) || (NULL == PpsField))
+        {
+            i4Status = (int32_t)INT_LIB_NULL_PARAM;
+            break;
+        }
+        if(PeField >= eCERT_FIELDS)
+        {
+            i4Status = (int32_t)INT_LIB_INVALID_PARAM;
+            break;
+        }
+        if(0 == PpsIndex->rgsField[PeField].wLen)
+        {
+            break;
+        }
+        PpsField->prgbStream = (uint8_t*)PprgbCert + PpsIndex->rgsField[PeField].wOffset;
+        PpsField->wLen = PpsIndex->rgsField[PeField].wLen;
+        i4Status = INT_LIB_OK;
+    }while(FALSE);
+
+    return i4Status;
+}
+
+/**
+* @}
+*/
@@ -0,0 +1,128 @@
+/**
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+*
+* \file
+*
+* \brief   This file defines APIs, types and data structures used in the
+*          Certificate Index implementation.
+*
+* \ingroup  grIntLib
+* @{
+*/
+#ifndef _CERT_INDEX_H_
+#define _CERT_INDEX_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "Datatypes.h"
+#include "IntegrationLib.h"
+
+/****************************************************************************
+ *
+ * Definitions related to the certificate index.
+ *
+ ****************************************************************************/
+
+/**
+ * \brief Fields of a X.509 certificate located by #CertIdx_Build.
+ */
+typedef enum eCertField_d
+{
+    ///Certificate without TLS identity header
+    eCERT_CERTIFICATE,
+
+    ///TBSCertificate, the signed part of the certificate
+    eCERT_TBS,
+
+    ///Serial number
+    eCERT_SERIAL,
+
+    ///Issuer name
+    eCERT_ISSUER,
+
+    ///Validity period
+    eCERT_VALIDITY,
+
+    ///Subject name
+    eCERT_SUBJECT,
+
+    ///SubjectPublicKeyInfo, algorithm and public key
+    eCERT_PUBLIC_KEY_INFO,
+
+    ///Public key BIT STRING, for NIST P256 0x03 0x42 0x00 0x04 followed by the 64 byte key
+    eCERT_PUBLIC_KEY,
+
+    ///Signature algorithm
+    eCERT_SIGNATURE_ALG,
+
+    ///Signature value BIT STRING
+    eCERT_SIGNATURE,
+
+    ///Number of fields
+    eCERT_FIELDS
+}eCertField_d;
+
+/**
+ * \brief Location of a field within the certificate buffer, including the DER tag and length.
+ */
+typedef struct sCertField_d
+{
+    ///Offset of the tag
+    uint16_t wOffset;
+
+    ///Length of tag, length and value
+    uint16_t wLen;
+}sCertField_d;
+
+/**
+ * \brief Index of the fields of a certificate. Build it with #CertIdx_Build.
+ */
+typedef struct sCertIndex_d
+{
+    ///Fields in the order of #eCertField_d
+    sCertField_d rgsField[eCERT_FIELDS];
+}sCertIndex_d;
+
+/**
+ * \brief Locates the fields of a DER encoded X.509 certificate in one pass.
+ */
+LIBRARY_EXPORTS int32_t CertIdx_Build(const uint8_t* PprgbCert, uint16_t PwCertLen, sCertIndex_d* PpsIndex);
+
+/**
+ * \brief Returns a field of an indexed certificate without copying it.
+ */
+LIBRARY_EXPORTS int32_t CertIdx_GetField(const sCertIndex_d* PpsIndex, const uint8_t* PprgbCert, eCertField_d PeField,
+                                         sbBlob_d* PpsField);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _CERT_INDEX_H_*/
+
+/**
+* @}
+*/
@@ -0,0 +1,642 @@
+/**
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+*
+*
+* \file
+*
+* \brief   This file implements the streaming hash calculation. Input of any length is split into chunks
+*          which fit the communication buffer of the security chip and hashed with a sequence of CalcHash commands.
+*          Several sessions can be hashed concurrently by swapping their hash contexts in and out of the security chip.
+*
+* \ingroup  grCmdLib
+* @{
+*/
+
+#include <stdint.h>
+#include "CommandHash.h"
+#include "MemoryMgmt.h"
+#include "pal_os_event.h"
+
+/// @cond hidden
+
+/**
+ * \brief Invoked by the command library once a chunk is hashed.
+ */
+_STATIC_H void CmdHash_ChunkDone(void* PpvHash, int32_t Pi4Status)
+{
+    sCmdHash_d* psHash = (sCmdHash_d*)PpvHash;
+
+    if((CMD_LIB_OK != Pi4Status) && (CMD_LIB_OK == psHash->i4Status))
+    {
+        psHash->i4Status = Pi4Status;
+    }
+    psHash->bInFlight = FALSE;
+}
+
+/**
+ * \brief Waits in the event loop until the chunk on the bus is hashed and returns the status of the stream.
+ */
+_STATIC_H int32_t CmdHash_Wait(sCmdHash_d* PpsHash)
+{
+    while(TRUE == PpsHash->bInFlight)
+    {
+        pal_os_event_wait();
+    }
+    return PpsHash->i4Status;
+}
+
+/**
+ * \brief Sends the chunk being filled and switches to the other chunk buffer. The previous chunk must be completed first.
+ */
+_STATIC_H int32_t CmdHash_SendChunk(sCmdHash_d* PpsHash, eHashSequence_d PeHashSequence, sCmdResponse_d* PpsOutHash)
+{
+    int32_t i4Status = CmdHash_Wait(PpsHash);
+    sCmdLibContext_d* psSelected;
+
+    do
+    {
+        if(CMD_LIB_OK != i4Status)
+        {
+            break;
+        }
+
+        PpsHash->sCalcHash.eHashSequence = PeHashSequence;
+        PpsHash->sCalcHash.sDataStream.prgbStream = PpsHash->rgprgbChunk[PpsHash->bFill];
+        PpsHash->sCalcHash.sDataStream.wLen = PpsHash->wFillLen;
+        if(NULL != PpsOutHash)
+        {
+            PpsHash->sCalcHash.sOutHash = *PpsOutHash;
+        }
+
+        PpsHash->bInFlight = TRUE;
+        psSelected = CmdLib_SelectContext(PpsHash->psContext);
+        i4Status = CmdLib_CalcHashAsync(&PpsHash->sCalcHash,CmdHash_ChunkDone,PpsHash);
+        CmdLib_SelectContext(psSelected);
+        if(CMD_LIB_OK != i4Status)
+        {
+            PpsHash->bInFlight = FALSE;
+            PpsHash->i4Status = i4Status;
+            break;
+        }
+
+        PpsHash->bStarted = TRUE;
+        PpsHash->bFill ^= 1;
+        PpsHash->wFillLen = 0;
+    }while(FALSE);
+
+    return i4Status;
+}
+
+/**
+ * \brief Sends input of a session to the security chip. The hash context of the session is imported if it is not
+ * active on the security chip and exported after every command which does not finalize the hash.
+ */
+_STATIC_H int32_t CmdHash_SessionCommand(sCmdHashSession_d* PpsSession, eHashSequence_d PeHashSequence,
+                                         const uint8_t* PprgbData, uint16_t PwDataLen, sCmdResponse_d* PpsOutHash)
+{
+    sCmdHashManager_d* psManager = PpsSession->psManager;
+    bool_t bImport = ((TRUE == PpsSession->bStarted) && (psManager->psResident != PpsSession)) ? TRUE : FALSE;
+    sCmdLibContext_d* psSelected;
+    sCalcHash_d sCalcHash;
+    int32_t i4Status;
+
+    OCP_MEMSET((uint8_t*)&sCalcHash,0,sizeof(sCalcHash_d));
+    sCalcHash.eHashAlg = eSHA256;
+    sCalcHash.eHashSequence = PeHashSequence;
+    sCalcHash.eHashDataType = eDataStream;
+    sCalcHash.sDataStream.prgbStream = (uint8_t*)PprgbData;
+    sCalcHash.sDataStream.wLen = PwDataLen;
+    sCalcHash.sContextInfo.pbContextData = PpsSession->prgbContext;
+    if(NULL != PpsOutHash)
+    {
+        sCalcHash.sOutHash = *PpsOutHash;
+        sCalcHash.sContextInfo.eContextAction = (TRUE == bImport) ? eImport : eUnused;
+        sCalcHash.sContextInfo.dwContextLen = PpsSession->wContextLen;
+    }
+    else
+    {
+        sCalcHash.sContextInfo.eContextAction = (TRUE == bImport) ? eImportExport : eExport;
+        sCalcHash.sContextInfo.dwContextLen = CALC_HASH_SHA256_CONTEXT_SIZE;
+    }
+
+    psSelected = CmdLib_SelectContext(psManager->psContext);
+    i4Status = CmdLib_CalcHash(&sCalcHash);
+    CmdLib_SelectContext(psSelected);
+
+    if(TRUE == bImport)
+    {
+        psManager->dwImports++;
+    }
+    if(CMD_LIB_OK != i4Status)
+    {
+        //The hash context on the security chip is unknown
+        psManager->psResident = NULL;
+        PpsSession->i4Status = i4Status;
+    }
+    else if(NULL != PpsOutHash)
+    {
+        psManager->psResident = NULL;
+        PpsOutHash->wRespLength = sCalcHash.sOutHash.wRespLength;
+    }
+    else
+    {
+        psManager->psResident = PpsSession;
+        PpsSession->wContextLen = sCalcHash.sContextInfo.dwContextLen;
+        PpsSession->bStarted = TRUE;
+    }
+    return i4Status;
+}
+
+/**
+ * \brief Returns the slot of a session to the pool.
+ */
+_STATIC_H void CmdHash_CloseSession(sCmdHashSession_d* PpsSession)
+{
+    sCmdHashManager_d* psManager = PpsSession->psManager;
+    uint16_t wSlot = (uint16_t)((PpsSession->prgbContext - psManager->prgbPool) / CMD_HASH_SESSION_SLOT_SIZE(psManager->wBufferSize));
+
+    psManager->dwSlotsInUse &= ~((uint32_t)1 << wSlot);
+    if(psManager->psResident == PpsSession)
+    {
+        psManager->psResident = NULL;
+    }
+    PpsSession->psManager = NULL;
+}
+
+/// @endcond
+
+/**
+* Starts a hash calculation on the security chip of the given command library context.
+*
+* <br>
+* Notes:
+* - Two chunk buffers of (wMaxCommsBuffer - #CALC_HASH_FIXED_OVERHEAD_SIZE) bytes are allocated with #OCP_MALLOC.
+*   They fit the blocks of a pool set up with #MemMgmt_InitPool, which then needs two blocks in addition to the ones
+*   of the commands. The buffers are released by #CmdHash_Final, which must be called also if an update failed.<br>
+* - The stream must be zero initialized before it is used the first time. Calling this function again on a stream
+*   which was not finalized restarts the calculation and reuses its chunk buffers. It fails with #CMD_LIB_BUSY while a
+*   chunk of the stream is hashed, i.e. if called from the event loop during an update.<br>
+* - Application on security chip must be opened using #CmdLib_OpenApplication before using this API.<br>
+* - The security chip keeps one hash context. Until #CmdHash_Final returns, no other command must be sent to the
+*   security chip. A command started meanwhile fails with #CMD_LIB_BUSY or interrupts the hash sequence.<br>
+*
+* \param[in,out] PpsHash  Pointer to the hash stream
+* \param[in]  PpsContext  Pointer to the command library context of the security chip, NULL for the default context
+* \param[in]  PeHashAlg   Hash algorithm
+*
+* \retval  #CMD_LIB_OK
+* \retval  #CMD_LIB_NULL_PARAM
+* \retval  #CMD_LIB_BUSY
+* \retval  #CMD_LIB_ERROR                The communication buffer size of the security chip is not known
+* \retval  #CMD_LIB_INSUFFICIENT_MEMORY
+*/
+int32_t CmdHash_Init(sCmdHash_d* PpsHash, sCmdLibContext_d* PpsContext, eHashAlg_d PeHashAlg)
+{
+    int32_t i4Status = (int32_t)CMD_LIB_ERROR;
+    sCmdLibContext_d* psSelected;
+    uint8_t* rgprgbChunk[2];
+    uint16_t wChunkSize;
+
+    do
+    {
+        if(NULL == PpsHash)
+        {
+            i4Status = (int32_t)CMD_LIB_NULL_PARAM;
+            break;
+        }
+        //The security chip still reads a chunk buffer of the stream
+        if(TRUE == PpsHash->bInFlight)
+        {
+            i4Status = (int32_t)CMD_LIB_BUSY;
+            break;
+        }
+
+        //Chunk buffers of a calculation which was not finalized
+        rgprgbChunk[0] = PpsHash->rgprgbChunk[0];
+        rgprgbChunk[1] = PpsHash->rgprgbChunk[1];
+        wChunkSize = PpsHash->wChunkSize;
+
+        OCP_MEMSET((uint8_t*)PpsHash,0,sizeof(sCmdHash_d));
+        //Resolve the default context
+        psSelected = CmdLib_SelectContext(PpsContext);
+        PpsHash->psContext = CmdLib_SelectContext(psSelected);
+        if(PpsHash->psContext->wMaxCommsBuffer <= CALC_HASH_FIXED_OVERHEAD_SIZE)
+        {
+            OCP_FREE(rgprgbChunk[0]);
+            OCP_FREE(rgprgbChunk[1]);
+            break;
+        }
+
+        PpsHash->wChunkSize = PpsHash->psContext->wMaxCommsBuffer - CALC_HASH_FIXED_OVERHEAD_SIZE;
+        if((NULL != rgprgbChunk[0]) && (NULL != rgprgbChunk[1]) && (wChunkSize == PpsHash->wChunkSize))
+        {
+            PpsHash->rgprgbChunk[0] = rgprgbChunk[0];
+            PpsHash->rgprgbChunk[1] = rgprgbChunk[1];
+        }
+        else
+        {
+            OCP_FREE(rgprgbChunk[0]);
+            OCP_FREE(rgprgbChunk[1]);
+            PpsHash->rgprgbChunk[0] = (uint8_t*)OCP_MALLOC(PpsHash->wChunkSize);
+            PpsHash->rgprgbChunk[1] = (uint8_t*)OCP_MALLOC(PpsHash->wChunkSize);
+        }
+        if((NULL == PpsHash->rgprgbChunk[0]) || (NULL == PpsHash->rgprgbChunk[1]))
+        {
+            OCP_FREE(PpsHash->rgprgbChunk[0]);
+            OCP_FREE(PpsHash->rgprgbChunk[1]);
+            PpsHash->rgprgbChunk[0] = NULL;
+            PpsHash->rgprgbChunk[1] = NULL;
+            i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
+            break;
+        }
+
+        PpsHash->sCalcHash.eHashAlg = PeHashAlg;
+        PpsHash->sCalcHash.eHashDataType = eDataStream;
+        PpsHash->sCalcHash.sContextInfo.eContextAction = eUnused;
+        PpsHash->i4Status = (int32_t)CMD_LIB_OK;
+        i4Status = (int32_t)CMD_LIB_OK;
+    }while(FALSE);
+
+    return i4Status;
+}
+
+/**
+* Adds input to the hash calculation. The input is copied into the chunk being filled. Once the chunk is full and
+* more input follows, it is sent to the security chip and the input is copied into the other chunk meanwhile.
+*
+* <br>
+* Notes:
+* - The function returns while the last full chunk may still be on the bus, so the next input can be prepared
+*   in parallel. It waits in the event loop only if both chunks are full.<br>
+* - A chunk is sent only once more input follows, so the last chunk is always left for #CmdHash_Final.<br>
+* - Once a chunk failed, the function returns the status of the failed chunk.<br>
+*
+* \param[in,out] PpsHash      Pointer to the hash stream initialized with #CmdHash_Init
+* \param[in]     PprgbData    Pointer to the input
+* \param[in]     PdwDataLen   Length of the input
+*
+* \retval  #CMD_LIB_OK
+* \retval  #CMD_LIB_NULL_PARAM
+* \retval  #CMD_LIB_BUSY
+* \retval  #CMD_LIB_ERROR
+* \retval  #CMD_DEV_ERROR
+*/
+int32_t CmdHash_Update(sCmdHash_d* PpsHash, const uint8_t* PprgbData, uint32_t PdwDataLen)
+{
+    int32_t i4Status = (int32_t)CMD_LIB_NULL_PARAM;
+    uint16_t wCopyLen;
+
+    do
+    {
+        if((NULL == PpsHash) || (NULL == PpsHash->rgprgbChunk[0]) || ((NULL == PprgbData) && (0 != PdwDataLen)))
+        {
+            break;
+        }
+
+        i4Status = PpsHash->i4Status;
+        while((CMD_LIB_OK == i4Status) && (0 != PdwDataLen))
+        {
+            if(PpsHash->wFillLen == PpsHash->wChunkSize)
+            {
+                i4Status = CmdHash_SendChunk(PpsHash,(TRUE == PpsHash->bStarted) ? eContinueHash : eStartHash,NULL);
+                continue;
+            }
+
+            wCopyLen = PpsHash->wChunkSize - PpsHash->wFillLen;
+            if(PdwDataLen < wCopyLen)
+            {
+                wCopyLen = (uint16_t)PdwDataLen;
+            }
+            OCP_MEMCPY(PpsHash->rgprgbChunk[PpsHash->bFill] + PpsHash->wFillLen,PprgbData,wCopyLen);
+            PpsHash->wFillLen += wCopyLen;
+            PprgbData += wCopyLen;
+            PdwDataLen -= wCopyLen;
+        }
+    }while(FALSE);
+
+    return i4Status;
+}
+
+/**
+* Sends the remaining input to the security chip and reads the hash. The chunk buffers are released also if the
+* hash calculation failed.
+*
+* <br>
+* Notes:
+* - If all input fits one chunk, it is hashed with a single #eStartFinalizeHash command.<br>
+* - PpsOutHash->wRespLength is set to the length of the hash.<br>
+* - If PpsOutHash is NULL, the hash calculation is abandoned and only the chunk buffers are released.<br>
+*
+* \param[in,out] PpsHash      Pointer to the hash stream initialized with #CmdHash_Init
+* \param[in,out] PpsOutHash   Pointer to the buffer to store the hash
+*
+* \retval  #CMD_LIB_OK
+* \retval  #CMD_LIB_NULL_PARAM
+* \retval  #CMD_LIB_BUSY
+* \retval  #CMD_LIB_ERROR
+* \retval  #CMD_LIB_INSUFFICIENT_MEMORY   The buffer is too small for the hash
+* \retval  #CMD_DEV_ERROR
+*/
+int32_t CmdHash_Final(sCmdHash_d* PpsHash, sCmdResponse_d* PpsOutHash)
+{
+    int32_t i4Status = (int32_t)CMD_LIB_NULL_PARAM;
+
+    do
+    {
+        if((NULL == PpsHash) || (NULL == PpsHash->rgprgbChunk[0]))
+        {
+            break;
+        }
+
+        if((NULL == PpsOutHash) || (NULL == PpsOutHash->prgbBuffer))
+        {
+            //Let the chunk on the bus complete before the buffers are released
+            (void)CmdHash_Wait(PpsHash);
+        }
+        else
+        {
+            i4Status = CmdHash_SendChunk(PpsHash,(TRUE == PpsHash->bStarted) ? eFinalizeHash : eStartFinalizeHash,PpsOutHash);
+            if(CMD_LIB_OK == i4Status)
+            {
+                i4Status = CmdHash_Wait(PpsHash);
+                PpsOutHash->wRespLength = PpsHash->sCalcHash.sOutHash.wRespLength;
+            }
+        }
+
+        OCP_FREE(PpsHash->rgprgbChunk[0]);
+        OCP_FREE(PpsHash->rgprgbChunk[1]);
+        PpsHash->rgprgbChunk[0] = NULL;
+        PpsHash->rgprgbChunk[1] = NULL;
+    }while(FALSE);
+
+    return i4Status;
+}
+
+/**
+* Initializes a manager of concurrent SHA256 sessions, e.g. one per network connection. The security chip keeps a
+* single hash context, so the context of a session is exported to a slot of a host side pool after each command and
+* imported again when the session continues after another one.
+*
+* <br>
+* Notes:
+* - Each slot holds the exported hash context and a buffer for the pending input of the session. Updates are collected
+*   in the buffer and sent only once it is full, so the commands and context swaps are grouped per session.
+*   A larger buffer means fewer swaps, a smaller one more sessions per pool.<br>
+* - Consecutive commands of the same session do not import its context again.<br>
+* - Application on security chip must be opened using #CmdLib_OpenApplication before using this API.<br>
+* - While sessions are open, hash calculations outside the manager destroy the hash context on the security chip.
+*   Call #CmdHash_Evict after them.<br>
+*
+* \param[out] PpsManager    Pointer to the manager
+* \param[in]  PpsContext    Pointer to the command library context of the security chip, NULL for the default context
+* \param[in]  PprgbPool     Pool for the session slots, see #CMD_HASH_SESSION_SLOT_SIZE
+* \param[in]  PwPoolLen     Length of the pool
+* \param[in]  PwBufferSize  Size of the pending input buffer of a session, 0 for the largest input of a command
+*
+* \retval  #CMD_LIB_OK
+* \retval  #CMD_LIB_NULL_PARAM
+* \retval  #CMD_LIB_ERROR                The communication buffer size of the security chip is not known
+* \retval  #CMD_LIB_INSUFFICIENT_MEMORY  The pool is too small for a slot or the buffer size exceeds a command
+*/
+int32_t CmdHash_InitManager(sCmdHashManager_d* PpsManager, sCmdLibContext_d* PpsContext,
+                            uint8_t* PprgbPool, uint16_t PwPoolLen, uint16_t PwBufferSize)
+{
+    int32_t i4Status = (int32_t)CMD_LIB_ERROR;
+    sCmdLibContext_d* psSelected;
+    uint16_t wOverhead = CALC_HASH_FIXED_OVERHEAD_SIZE + CALC_HASH_IMPORT_AND_EXPORT_OVERHEAD_SIZE + CALC_HASH_SHA256_CONTEXT_SIZE;
+    uint16_t wSlots;
+
+    do
+    {
+        if((NULL == PpsManager) || (NULL == PprgbPool))
+        {
+            i4Status = (int32_t)CMD_LIB_NULL_PARAM;
+            break;
+        }
+
+        OCP_MEMSET((uint8_t*)PpsManager,0,sizeof(sCmdHashManager_d));
+        //Resolve the default context
+        psSelected = CmdLib_SelectContext(PpsContext);
+        PpsManager->psContext = CmdLib_SelectContext(psSelected);
+        if(PpsManager->psContext->wMaxCommsBuffer <= wOverhead)
+        {
+            break;
+        }
+
+        PpsManager->wChunkSize = PpsManager->psContext->wMaxCommsBuffer - wOverhead;
+        PpsManager->wBufferSize = (0 == PwBufferSize) ? PpsManager->wChunkSize : PwBufferSize;
+        wSlots = PwPoolLen / CMD_HASH_SESSION_SLOT_SIZE(PpsManager->wBufferSize);
+        if((PpsManager->wBufferSize > PpsManager->wChunkSize) || (0 == wSlots))
+        {
+            i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
+            break;
+        }
+
+        PpsManager->prgbPool = PprgbPool;
+        PpsManager->bSlots = (uint8_t)((wSlots > CMD_HASH_MAX_SESSIONS) ? CMD_HASH_MAX_SESSIONS : wSlots);
+        i4Status = (int32_t)CMD_LIB_OK;
+    }while(FALSE);
+
+    return i4Status;
+}
+
+/**
+* Marks the hash context on the security chip as lost. The next command of each session imports its context again.
+*
+* \param[in,out] PpsManager    Pointer to the manager
+*/
+void CmdHash_Evict(sCmdHashManager_d* PpsManager)
+{
+    if(NULL != PpsManager)
+    {
+        PpsManager->psResident = NULL;
+    }
+}
+
+/**
+* Opens a SHA256 session and assigns it a slot of the pool. Nothing is sent to the security chip until the pending
+* input buffer of the session is full or the session is finalized.
+*
+* \param[in,out] PpsManager    Pointer to the manager initialized with #CmdHash_InitManager
+* \param[out]    PpsSession    Pointer to the session
+*
+* \retval  #CMD_LIB_OK
+* \retval  #CMD_LIB_NULL_PARAM
+* \retval  #CMD_LIB_INSUFFICIENT_MEMORY  All slots of the pool are in use
+*/
+int32_t CmdHash_OpenSession(sCmdHashManager_d* PpsManager, sCmdHashSession_d* PpsSession)
+{
+    int32_t i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
+    uint8_t bSlot;
+
+    do
+    {
+        if((NULL == PpsManager) || (NULL == PpsManager->prgbPool) || (NULL == PpsSession))
+        {
+            i4Status = (int32_t)CMD_LIB_NULL_PARAM;
+            break;
+        }
+
+        for(bSlot = 0; bSlot < PpsManager->bSlots; bSlot++)
+        {
+            if(0 == (PpsManager->dwSlotsInUse & ((uint32_t)1 << bSlot)))
+            {
+                break;
+            }
+        }
+        if(bSlot == PpsManager->bSlots)
+        {
+            break;
+        }
+
+        PpsManager->dwSlotsInUse |= ((uint32_t)1 << bSlot);
+        OCP_MEMSET((uint8_t*)PpsSession,0,sizeof(sCmdHashSession_d));
+        PpsSession->psManager = PpsManager;
+        PpsSession->prgbContext = PpsManager->prgbPool + (bSlot * CMD_HASH_SESSION_SLOT_SIZE(PpsManager->wBufferSize));
+        PpsSession->prgbPending = PpsSession->prgbContext + CALC_HASH_SHA256_CONTEXT_SIZE;
+        PpsSession->i4Status = (int32_t)CMD_LIB_OK;
+        i4Status = (int32_t)CMD_LIB_OK;
+    }while(FALSE);
+
+    return i4Status;
+}
+
+/**
+* Adds input to a session. The input is collected in the pending input buffer of the session, which is sent to the
+* security chip once it is full and more input follows. Input larger than the buffer is sent directly from PprgbData.
+*
+* <br>
+* Notes:
+* - Once a command failed, the function returns the status of the failed command.<br>
+*
+* \param[in,out] PpsSession    Pointer to the session opened with #CmdHash_OpenSession
+* \param[in]     PprgbData     Pointer to the input
+* \param[in]     PdwDataLen    Length of the input
+*
+* \retval  #CMD_LIB_OK
+* \retval  #CMD_LIB_NULL_PARAM
+* \retval  #CMD_LIB_BUSY
+* \retval  #CMD_LIB_ERROR
+* \retval  #CMD_DEV_ERROR
+*/
+int32_t CmdHash_UpdateSession(sCmdHashSession_d* PpsSession, const uint8_t* PprgbData, uint32_t PdwDataLen)
+{
+    int32_t i4Status = (int32_t)CMD_LIB_NULL_PARAM;
+    sCmdHashManager_d* psManager;
+    uint16_t wCopyLen;
+    uint16_t wSendLen;
+
+    do
+    {
+        if((NULL == PpsSession) || (NULL == PpsSession->psManager) || ((NULL == PprgbData) && (0 != PdwDataLen)))
+        {
+            break;
+        }
+        psManager = PpsSession->psManager;
+
+        i4Status = PpsSession->i4Status;
+        while((CMD_LIB_OK == i4Status) && (0 != PdwDataLen))
+        {
+            if(PpsSession->wPendingLen == psManager->wBufferSize)
+            {
+                i4Status = CmdHash_SessionCommand(PpsSession,(TRUE == PpsSession->bStarted) ? eContinueHash : eStartHash,
+                                                  PpsSession->prgbPending,PpsSession->wPendingLen,NULL);
+                PpsSession->wPendingLen = 0;
+                continue;
+            }
+
+            //Send input which does not fit the buffer directly, at least one byte is left for the buffer
+            if((0 == PpsSession->wPendingLen) && (PdwDataLen > psManager->wBufferSize))
+            {
+                wSendLen = (PdwDataLen > psManager->wChunkSize) ? psManager->wChunkSize : (uint16_t)(PdwDataLen - 1);
+                i4Status = CmdHash_SessionCommand(PpsSession,(TRUE == PpsSession->bStarted) ? eContinueHash : eStartHash,
+                                                  PprgbData,wSendLen,NULL);
+                PprgbData += wSendLen;
+                PdwDataLen -= wSendLen;
+                continue;
+            }
+
+            wCopyLen = psManager->wBufferSize - PpsSession->wPendingLen;
+            if(PdwDataLen < wCopyLen)
+            {
+                wCopyLen = (uint16_t)PdwDataLen;
+            }
+            OCP_MEMCPY(PpsSession->prgbPending + PpsSession->wPendingLen,PprgbData,wCopyLen);
+            PpsSession->wPendingLen += wCopyLen;
+            PprgbData += wCopyLen;
+            PdwDataLen -= wCopyLen;
+        }
+    }while(FALSE);
+
+    return i4Status;
+}
+
+/**
+* Sends the pending input of a session to the security chip and reads the hash. The slot of the session is returned
+* to the pool also if the hash calculation failed.
+*
+* <br>
+* Notes:
+* - A session which never filled its buffer is hashed with a single #eStartFinalizeHash command.<br>
+* - If PpsOutHash is NULL, the session is abandoned and only its slot is released.<br>
+*
+* \param[in,out] PpsSession    Pointer to the session opened with #CmdHash_OpenSession
+* \param[in,out] PpsOutHash    Pointer to the buffer to store the hash
+*
+* \retval  #CMD_LIB_OK
+* \retval  #CMD_LIB_NULL_PARAM
+* \retval  #CMD_LIB_BUSY
+* \retval  #CMD_LIB_ERROR
+* \retval  #CMD_LIB_INSUFFICIENT_MEMORY   The buffer is too small for the hash
+* \retval  #CMD_DEV_ERROR
+*/
+int32_t CmdHash_FinalSession(sCmdHashSession_d* PpsSession, sCmdResponse_d* PpsOutHash)
+{
+    int32_t i4Status = (int32_t)CMD_LIB_NULL_PARAM;
+
+    do
+    {
+        if((NULL == PpsSession) || (NULL == PpsSession->psManager))
+        {
+            break;
+        }
+
+        if((NULL != PpsOutHash) && (NULL != PpsOutHash->prgbBuffer))
+        {
+            i4Status = PpsSession->i4Status;
+            if(CMD_LIB_OK == i4Status)
+            {
+                i4Status = CmdHash_SessionCommand(PpsSession,(TRUE == PpsSession->bStarted) ? eFinalizeHash : eStartFinalizeHash,
+                                                  PpsSession->prgbPending,PpsSession->wPendingLen,PpsOutHash);
+            }
+        }
+        CmdHash_CloseSession(PpsSession);
+    }while(FALSE);
+
+    return i4Status;
+}
+
+/**
+* @}
+*/
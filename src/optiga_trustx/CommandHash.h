@@ -0,0 +1,199 @@
+/**
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+*
+* \file
+*
+* \brief   This file defines APIs, types and data structures used in the
+*          Command Hash Stream implementation.
+*
+* \ingroup  grCmdLib
+* @{
+*/
+#ifndef _CMD_HASH_H_
+#define _CMD_HASH_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "Datatypes.h"
+#include "CommandLib.h"
+
+/****************************************************************************
+ *
+ * Definitions related to the streaming hash calculation.
+ *
+ ****************************************************************************/
+
+///Length of a SHA256 digest
+#define CMD_HASH_SHA256_LEN             32
+
+/**
+ * \brief Hash calculation on the security chip over input of any length. Initialize it with #CmdHash_Init.
+ */
+typedef struct sCmdHash_d
+{
+    ///Command library context of the security chip
+    sCmdLibContext_d* psContext;
+
+    ///Command of the chunk in progress
+    sCalcHash_d sCalcHash;
+
+    ///Chunk buffers, one is filled while the other one is sent to the security chip
+    uint8_t* rgprgbChunk[2];
+
+    ///Size of a chunk
+    uint16_t wChunkSize;
+
+    ///Number of bytes in the chunk being filled
+    uint16_t wFillLen;
+
+    ///Index of the chunk being filled
+    uint8_t bFill;
+
+    ///TRUE once the first chunk was sent
+    bool_t bStarted;
+
+    ///TRUE while a chunk is sent
+    volatile bool_t bInFlight;
+
+    ///Status of the first failed chunk
+    int32_t i4Status;
+}sCmdHash_d;
+
+struct sCmdHashSession_d;
+
+/**
+ * \brief Manager of concurrent SHA256 sessions on one security chip. Initialize it with #CmdHash_InitManager.
+ */
+typedef struct sCmdHashManager_d
+{
+    ///Command library context of the security chip
+    sCmdLibContext_d* psContext;
+
+    ///Session whose hash context is active on the security chip, NULL if none
+    struct sCmdHashSession_d* psResident;
+
+    ///Host side pool of session slots, each holding an exported hash context and the pending input of the session
+    uint8_t* prgbPool;
+
+    ///Size of the pending input buffer of a session
+    uint16_t wBufferSize;
+
+    ///Maximum input of a command which imports and exports the hash context
+    uint16_t wChunkSize;
+
+    ///Number of slots in the pool
+    uint8_t bSlots;
+
+    ///Bit mask of the slots in use
+    uint32_t dwSlotsInUse;
+
+    ///Number of hash contexts imported into the security chip
+    uint32_t dwImports;
+}sCmdHashManager_d;
+
+/**
+ * \brief SHA256 session of a hash manager. Open it with #CmdHash_OpenSession.
+ */
+typedef struct sCmdHashSession_d
+{
+    ///Manager the session belongs to
+    sCmdHashManager_d* psManager;
+
+    ///Hash context exported from the security chip
+    uint8_t* prgbContext;
+
+    ///Input not sent to the security chip yet
+    uint8_t* prgbPending;
+
+    ///Length of the exported hash context
+    uint16_t wContextLen;
+
+    ///Length of the pending input
+    uint16_t wPendingLen;
+
+    ///TRUE once the hash sequence was started on the security chip
+    bool_t bStarted;
+
+    ///Status of the first failed command
+    int32_t i4Status;
+}sCmdHashSession_d;
+
+///Maximum number of sessions of a hash manager
+#define CMD_HASH_MAX_SESSIONS           32
+
+///Size of a session slot in the pool of a hash manager, for a given pending input buffer size
+#define CMD_HASH_SESSION_SLOT_SIZE(buffer_size)  (CALC_HASH_SHA256_CONTEXT_SIZE + (buffer_size))
+
+/**
+ * \brief Starts a hash calculation on the security chip of the given command library context.
+ */
+LIBRARY_EXPORTS int32_t CmdHash_Init(sCmdHash_d* PpsHash, sCmdLibContext_d* PpsContext, eHashAlg_d PeHashAlg);
+
+/**
+ * \brief Adds input to the hash calculation, full chunks are sent to the security chip in the background.
+ */
+LIBRARY_EXPORTS int32_t CmdHash_Update(sCmdHash_d* PpsHash, const uint8_t* PprgbData, uint32_t PdwDataLen);
+
+/**
+ * \brief Sends the remaining input, reads the hash and releases the chunk buffers.
+ */
+LIBRARY_EXPORTS int32_t CmdHash_Final(sCmdHash_d* PpsHash, sCmdResponse_d* PpsOutHash);
+
+/**
+ * \brief Initializes a manager of concurrent hash sessions with a host side pool for their hash contexts.
+ */
+LIBRARY_EXPORTS int32_t CmdHash_InitManager(sCmdHashManager_d* PpsManager, sCmdLibContext_d* PpsContext,
+                                            uint8_t* PprgbPool, uint16_t PwPoolLen, uint16_t PwBufferSize);
+
+/**
+ * \brief Marks the hash context on the security chip as lost, e.g. after another hash calculation ran on it.
+ */
+LIBRARY_EXPORTS void CmdHash_Evict(sCmdHashManager_d* PpsManager);
+
+/**
+ * \brief Opens a SHA256 session and assigns it a slot of the pool.
+ */
+LIBRARY_EXPORTS int32_t CmdHash_OpenSession(sCmdHashManager_d* PpsManager, sCmdHashSession_d* PpsSession);
+
+/**
+ * \brief Adds input to a session, it is sent to the security chip once the pending input buffer of the session is full.
+ */
+LIBRARY_EXPORTS int32_t CmdHash_UpdateSession(sCmdHashSession_d* PpsSession, const uint8_t* PprgbData, uint32_t PdwDataLen);
+
+/**
+ * \brief Sends the pending input of a session, reads the hash and releases the slot.
+ */
+LIBRARY_EXPORTS int32_t CmdHash_FinalSession(sCmdHashSession_d* PpsSession, sCmdResponse_d* PpsOutHash);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _CMD_HASH_H_*/
+
+/**
+* @}
+*/
@@ -34,13 +34,12 @@
 #include "Util.h"
 #include "CommandLib.h"
 #include "MemoryMgmt.h"
+#include "pal_os_event.h"
 
 #include "debug.h"
 
 /// @cond hidden
 
-static optiga_comms_t* p_optiga_comms;
-
 ///Maximum size of buffer, considering Maximum size of arbitrary data (1500) and header bytes
 #define MAX_APDU_BUFF_LEN           	1558
 	
@@ -269,9 +268,20 @@ static optiga_comms_t* p_optiga_comms;
 ///Error in security chip indicating data out of boundary
 #define ERR_DATA_OUT_OF_BOUND           0x00000008    
 
-//Maximum size of the communication buffer
-/*lint --e{552} suppress "Temporary" */
-uint16_t wMaxCommsBuffer = INVALID_MAX_COMMS_BUFF_SIZE;
+///Returned by a response handler that has sent the next APDU of a chained command
+#define CMD_LIB_CONTINUE                0x75E96B02
+
+///OID of the global life cycle state
+#define OID_LCSG                        0xE0C0
+
+///OID of the application life cycle state
+#define OID_LCSA                        0xF1C0
+
+//Context used until the application selects one with CmdLib_SelectContext
+static sCmdLibContext_d sDefaultContext = {NULL, INVALID_MAX_COMMS_BUFF_SIZE, {NULL}, 0, NULL, {0}};
+
+//Context of the security chip the commands are sent to
+static sCmdLibContext_d* psCmdLibContext = &sDefaultContext;
 
 //Finds minimum amongst the given 2 value
 #define MIN(a,b) ((a<b)?a:b)
@@ -289,18 +299,16 @@ uint16_t wMaxCommsBuffer = INVALID_MAX_COMMS_BUFF_SIZE;
  * Initializes the APDU buffer in stack.<br>
  **/
 #define INIT_STACK_APDUBUFFER(pbBuffer,wLen)\
-{											\
 	/*lint --e{733,830} suppress "Used only within Command Lib Block" */\
 	uint8_t rgbAPDUBuffer[wLen];			\
-	pbBuffer = rgbAPDUBuffer;				\
-}
+	pbBuffer = rgbAPDUBuffer;
 
 /**
  * Initializes the APDU buffer in heap.<br>
  **/
 #define INIT_HEAP_APDUBUFFER(pbBuffer,wLen)					\
 {															\
-	if(INVALID_MAX_COMMS_BUFF_SIZE == wMaxCommsBuffer)		\
+	if(INVALID_MAX_COMMS_BUFF_SIZE == psCmdLibContext->wMaxCommsBuffer)		\
 	{														\
 		i4Status = (int32_t)CMD_DEV_EXEC_ERROR;				\
         break;                                              \
@@ -390,65 +398,264 @@ typedef enum eFragSeq_d
     eContinue = 0x02
 }eFragSeq_d;
 
-volatile static host_lib_status_t optiga_comms_status;
+//Command reading the last error code
+static const uint8_t rgbErrorCmd[] = {CMD_GETDATA,0x00,0x00,0x02,(uint8_t)(OID_ERROR>>8),(uint8_t)OID_ERROR};
+
+_STATIC_H void CmdLib_CommandStep(void* PpvContext);
 
-//lint --e{715, 818} suppress "This is ignored as app_event_handler_t handler function prototype requires this argument.This will be used for object based implementation"
+//lint --e{818} suppress "This is ignored as app_event_handler_t handler function prototype requires this argument"
 static void optiga_comms_event_handler(void* upper_layer_ctx, host_lib_status_t event)
 {
-    optiga_comms_status = event;
+    ((sCmdLibContext_d*)upper_layer_ctx)->sCommand.wCommsStatus = event;
+    //The OPTIGA comms context is released once the handler returns, the command continues from the event loop
+    pal_os_event_register_callback_oneshot(&((sCmdLibContext_d*)upper_layer_ctx)->sStepEvent,CmdLib_CommandStep,
+                                           upper_layer_ctx,0);
 }
 
 /**
- *
- * Gets the device error code by reading the Error code object id.<br>
- * If there is an internal error in function, then #CMD_DEV_ERROR is returned.<br>
- * Otherwise,the device error code is ORed with #CMD_DEV_ERROR and returned.<br>
- *   
- *   
- * \retval    #CMD_DEV_ERROR    
- * \retval    #CMD_LIB_ERROR    
- * \retval    #CMD_DEV_EXEC_ERROR   
- *
+ * \brief Claims the context for a command. An asynchronous command fails if a command is already in progress on the
+ * security chip, a blocking one (no callback) waits in the event loop until it is completed, e.g. a background refill.
  */
-_STATIC_H int32_t CmdLib_GetDeviceError(void)
+_STATIC_H int32_t CmdLib_ClaimContext(sCmdLibContext_d* PpsContext, pFCmdLibCallback_d PpfCallback, void* PpvCallbackCtx)
 {
-    int32_t i4Status  = (int32_t)CMD_DEV_ERROR;
-    uint8_t rgbErrorCmd[] = {CMD_GETDATA,0x00,0x00,0x02,(uint8_t)(OID_ERROR>>8),(uint8_t)OID_ERROR};
-    uint16_t wBufferLength = sizeof(rgbErrorCmd);
+    int32_t i4Status = (int32_t)CMD_LIB_OK;
+    sCmdLibCommand_d* psCommand = &PpsContext->sCommand;
 
     do
     {
-        p_optiga_comms->upper_layer_handler = optiga_comms_event_handler;
-        optiga_comms_status  = OPTIGA_COMMS_BUSY;
-        i4Status  =  optiga_comms_transceive(p_optiga_comms,rgbErrorCmd,&wBufferLength,
-                                                 rgbErrorCmd,&wBufferLength);
-        if(OPTIGA_COMMS_SUCCESS != i4Status)
+        if(NULL == PpsContext->psOptigaComms)
         {
-            i4Status = (int32_t)CMD_DEV_EXEC_ERROR;
+            i4Status = (int32_t)CMD_LIB_NULL_PARAM;
+            break;
+        }
+        if(NULL == PpfCallback)
+        {
+            while(TRUE == psCommand->bBusy)
+            {
+                pal_os_event_wait();
+            }
+        }
+        if(TRUE == psCommand->bBusy)
+        {
+            i4Status = (int32_t)CMD_LIB_BUSY;
             break;
         }
+        OCP_MEMSET((uint8_t*)psCommand,0,sizeof(sCmdLibCommand_d));
+        psCommand->pfCallback = PpfCallback;
+        psCommand->pvCallbackCtx = PpvCallbackCtx;
+        psCommand->prgbResponse = psCommand->rgbResponse;
+        psCommand->wResponseLength = LEN_APDUHEADER;
+        psCommand->bSegments = 1;
+        psCommand->bGetError = TRUE;
+        psCommand->bBusy = TRUE;
+    }while(FALSE);
+
+    return i4Status;
+}
+
+/**
+ * \brief Formats the APDU header in the first segment. The payload length is the sum of the other segment lengths.
+ */
+_STATIC_H void CmdLib_SetHeader(sCmdLibCommand_d* PpsCommand, uint8_t PbCmd, uint8_t PbParam)
+{
+    uint16_t wPayloadLength = 0;
+    uint8_t bCount;
+
+    for(bCount = 1; bCount < PpsCommand->bSegments; bCount++)
+    {
+        wPayloadLength += PpsCommand->rgsSegments[bCount].wLen;
+    }
+    PpsCommand->rgbHeader[OFFSET_CMD] = PbCmd;
+    PpsCommand->rgbHeader[OFFSET_PARAM] = PbParam;
+    PpsCommand->rgbHeader[OFFSET_LENGTH] = (uint8_t)(wPayloadLength >> BITS_PER_BYTE);
+    PpsCommand->rgbHeader[OFFSET_LENGTH+1] = (uint8_t)wPayloadLength;
+
+    PpsCommand->rgsSegments[0].prgbStream = PpsCommand->rgbHeader;
+    PpsCommand->rgsSegments[0].wLen = LEN_APDUHEADER;
+}
+
+/**
+ * \brief Sends the segments of the command APDU. The response is received in the event loop.
+ */
+_STATIC_H int32_t CmdLib_Transceive(sCmdLibContext_d* PpsContext, const sTxSegment_d *PpsSegments, uint8_t PbSegmentCount,
+                                    uint8_t* PprgbResponse, uint16_t* PpwResponseLength)
+{
+    int32_t i4Status = (int32_t)CMD_LIB_OK;
+
+    PpsContext->psOptigaComms->upper_layer_ctx = PpsContext;
+    PpsContext->psOptigaComms->upper_layer_handler = optiga_comms_event_handler;
+    PpsContext->sCommand.wCommsStatus = OPTIGA_COMMS_BUSY;
+    if(OPTIGA_COMMS_SUCCESS != optiga_comms_transceive_segments(PpsContext->psOptigaComms,PpsSegments,PbSegmentCount,
+                                                                PprgbResponse,PpwResponseLength))
+    {
+        i4Status = (int32_t)CMD_DEV_EXEC_ERROR;
+    }
+    return i4Status;
+}
+
+/**
+ * \brief Sends the formatted command. If the command could not be formatted or sent, the context is released.
+ */
+_STATIC_H int32_t CmdLib_StartCommand(sCmdLibContext_d* PpsContext, int32_t Pi4Status)
+{
+    int32_t i4Status = Pi4Status;
+    sCmdLibCommand_d* psCommand = &PpsContext->sCommand;
+
+    if(CMD_LIB_OK == i4Status)
+    {
+        i4Status = CmdLib_Transceive(PpsContext,psCommand->rgsSegments,psCommand->bSegments,
+                                     psCommand->prgbResponse,&psCommand->wResponseLength);
+    }
+    if(CMD_LIB_OK != i4Status)
+    {
+        FREE_HEAP_APDUBUFFER(psCommand->prgbHeap);
+        psCommand->bBusy = FALSE;
+    }
+    return i4Status;
+}
+
+/**
+ * \brief Sends the next APDU of a chained command from a response handler.
+ */
+_STATIC_H int32_t CmdLib_ContinueCommand(sCmdLibContext_d* PpsContext)
+{
+    sCmdLibCommand_d* psCommand = &PpsContext->sCommand;
+    int32_t i4Status;
+
+    i4Status = CmdLib_Transceive(PpsContext,psCommand->rgsSegments,psCommand->bSegments,
+                                 psCommand->prgbResponse,&psCommand->wResponseLength);
+    if(CMD_LIB_OK == i4Status)
+    {
+        i4Status = (int32_t)CMD_LIB_CONTINUE;
+    }
+    return i4Status;
+}
+
+/**
+ * \brief Waits in the event loop until the started command is completed and returns its status. The response length
+ * is returned in PpwResponseLength if not NULL.
+ */
+_STATIC_H int32_t CmdLib_WaitForCommand(sCmdLibContext_d* PpsContext, uint16_t* PpwResponseLength, int32_t Pi4Status)
+{
+    int32_t i4Status = Pi4Status;
+    sCmdLibResult_d sResult = {FALSE, (int32_t)CMD_LIB_ERROR, 0};
+
+    if(CMD_LIB_OK == i4Status)
+    {
+        //The command completes from the event loop only, so it can't have completed before the result is attached.
+        //A callback run by the loop may claim the context for the next command once this one is completed.
+        PpsContext->sCommand.psResult = &sResult;
+        while(TRUE != sResult.bDone)
+        {
+            pal_os_event_wait();
+        }
+        i4Status = sResult.i4Status;
+        if(NULL != PpwResponseLength)
+        {
+            *PpwResponseLength = sResult.wResponseLength;
+        }
+    }
+    return i4Status;
+}
+
+/**
+ *
+ * Checks the response of the command APDU.<br>
+ * If the security chip reports a failure, the last error code is read by sending a GetDataObject command
+ * and #CMD_LIB_CONTINUE is returned. Once it is received, the error code is ORed with #CMD_DEV_ERROR and returned.<br>
+ *
+ * \retval    #CMD_LIB_OK
+ * \retval    #CMD_LIB_CONTINUE
+ * \retval    #CMD_DEV_ERROR
+ * \retval    #CMD_LIB_ERROR
+ * \retval    #CMD_DEV_EXEC_ERROR
+ *
+ */
+_STATIC_H int32_t CmdLib_CheckResponse(sCmdLibContext_d* PpsContext)
+{
+    int32_t i4Status = (int32_t)CMD_LIB_OK;
+    sCmdLibCommand_d* psCommand = &PpsContext->sCommand;
+    sTxSegment_d sSegment;
 
-        //wait for completion
-        while(optiga_comms_status == OPTIGA_COMMS_BUSY){pal_os_event_process();};
-        if(optiga_comms_status != OPTIGA_COMMS_SUCCESS)
+    do
+    {
+        if(OPTIGA_COMMS_SUCCESS != psCommand->wCommsStatus)
         {
             i4Status = (int32_t)CMD_DEV_EXEC_ERROR;
             break;
         }
-        
-        if(0 == rgbErrorCmd[OFFSET_RESP_STATUS])
-        {   //If response Header
-            i4Status = (int32_t)(CMD_DEV_ERROR | rgbErrorCmd[OFFSET_PAYLOAD]);
+        if(TRUE == psCommand->bReadError)
+        {
+            if(0 == psCommand->rgbResponse[OFFSET_RESP_STATUS])
+            {
+                i4Status = (int32_t)(CMD_DEV_ERROR | psCommand->rgbResponse[OFFSET_PAYLOAD]);
+            }
+            else
+            {
+                //In this case, execution error is returned.
+                i4Status = (int32_t)CMD_DEV_EXEC_ERROR;
+            }
+            break;
         }
-        else
+        //return device error if not success
+        if(0 != psCommand->prgbResponse[OFFSET_RESP_STATUS])
         {
-            //In this case, execution error is returned.
-            i4Status  = (int32_t)CMD_DEV_EXEC_ERROR;
+            if(TRUE != psCommand->bGetError)
+            {
+                i4Status = (int32_t)CMD_LIB_ERROR;
+                break;
+            }
+            psCommand->bReadError = TRUE;
+            psCommand->wResponseLength = sizeof(psCommand->rgbResponse);
+            sSegment.prgbStream = rgbErrorCmd;
+            sSegment.wLen = sizeof(rgbErrorCmd);
+            i4Status = CmdLib_Transceive(PpsContext,&sSegment,1,psCommand->rgbResponse,&psCommand->wResponseLength);
+            if(CMD_LIB_OK == i4Status)
+            {
+                i4Status = (int32_t)CMD_LIB_CONTINUE;
+            }
         }
     }while(FALSE);
+
     return i4Status;
 }
 
+/**
+ * \brief Processes the response of the command in progress and completes the command, invoked from the event loop.
+ */
+_STATIC_H void CmdLib_CommandStep(void* PpvContext)
+{
+    sCmdLibContext_d* psContext = (sCmdLibContext_d*)PpvContext;
+    sCmdLibCommand_d* psCommand = &psContext->sCommand;
+    sCmdLibContext_d* psSelected;
+    int32_t i4Status;
+
+    i4Status = CmdLib_CheckResponse(psContext);
+    if((CMD_LIB_CONTINUE != i4Status) && (NULL != psCommand->pfResponse))
+    {
+        i4Status = psCommand->pfResponse(psContext,i4Status);
+    }
+
+    if(CMD_LIB_CONTINUE != i4Status)
+    {
+        FREE_HEAP_APDUBUFFER(psCommand->prgbHeap);
+        if(NULL != psCommand->psResult)
+        {
+            psCommand->psResult->i4Status = i4Status;
+            psCommand->psResult->wResponseLength = psCommand->wResponseLength;
+            psCommand->psResult->bDone = TRUE;
+        }
+        psCommand->bBusy = FALSE;
+        //The callback may start the next command on the security chip
+        //The step may run while a blocking call waits for another chip, keep the selected context for it
+        if(NULL != psCommand->pfCallback)
+        {
+            psSelected = psCmdLibContext;
+            psCommand->pfCallback(psCommand->pvCallbackCtx,i4Status);
+            psCmdLibContext = psSelected;
+        }
+    }
+}
 
 /**
  * \brief Formats data as per Security Chip application and send using the communication functions.
@@ -457,14 +664,20 @@ _STATIC_H int32_t TransceiveAPDU(sApduData_d *PpsApduData,uint8_t bGetError)
 {  
     //lint --e{818} suppress "PpsResponse is out parameter"
     int32_t i4Status = (int32_t)CMD_LIB_ERROR;
-    uint16_t wTotalLength;
+    sCmdLibContext_d* psContext = psCmdLibContext;
+    sCmdLibCommand_d* psCommand = &psContext->sCommand;
     do
     {
-        if(NULL == PpsApduData || NULL == p_optiga_comms)
+        if(NULL == PpsApduData)
         { 
             i4Status = (int32_t)CMD_LIB_NULL_PARAM;
             break;
         }
+        i4Status = CmdLib_ClaimContext(psContext,NULL,NULL);
+        if(CMD_LIB_OK != i4Status)
+        {
+            break;
+        }
         PpsApduData->prgbAPDUBuffer[OFFSET_CMD] = PpsApduData->bCmd;
         PpsApduData->prgbAPDUBuffer[OFFSET_PARAM] = PpsApduData->bParam;
 
@@ -473,43 +686,14 @@ _STATIC_H int32_t TransceiveAPDU(sApduData_d *PpsApduData,uint8_t bGetError)
         PpsApduData->prgbAPDUBuffer[OFFSET_LENGTH+1] = (uint8_t)PpsApduData->wPayloadLength;
 
         //update total length to consider total header length
-        wTotalLength = PpsApduData->wPayloadLength + LEN_APDUHEADER;
-
-        p_optiga_comms->upper_layer_handler = optiga_comms_event_handler;
-        optiga_comms_status  = OPTIGA_COMMS_BUSY;
-        i4Status  =  optiga_comms_transceive(p_optiga_comms,PpsApduData->prgbAPDUBuffer,&wTotalLength,
-                                                PpsApduData->prgbRespBuffer,&PpsApduData->wResponseLength);
-        if(OPTIGA_COMMS_SUCCESS != i4Status)
-        {
-            i4Status = (int32_t)CMD_DEV_EXEC_ERROR;
-            break;
-        }
-        //wait for completion
-        do
-        {
-        	pal_os_event_process();
-        }while(optiga_comms_status == OPTIGA_COMMS_BUSY);
-        
-        if(optiga_comms_status != OPTIGA_COMMS_SUCCESS)
-        {
-            i4Status = (int32_t)CMD_DEV_EXEC_ERROR;
-            break;
-        }
-        //return device error if not success       
-        if(0 != PpsApduData->prgbRespBuffer[OFFSET_RESP_STATUS])
-        {
-            if(TRUE == bGetError)
-            {
-                i4Status = CmdLib_GetDeviceError();
-            }
-            else
-            {
-                i4Status = (int32_t)CMD_LIB_ERROR;
-            }
-            break;
-        }
-        i4Status = CMD_LIB_OK;
-
+        psCommand->rgsSegments[0].prgbStream = PpsApduData->prgbAPDUBuffer;
+        psCommand->rgsSegments[0].wLen = PpsApduData->wPayloadLength + LEN_APDUHEADER;
+        psCommand->bGetError = bGetError;
+        psCommand->prgbResponse = PpsApduData->prgbRespBuffer;
+        psCommand->wResponseLength = PpsApduData->wResponseLength;
+
+        i4Status = CmdLib_WaitForCommand(psContext,&PpsApduData->wResponseLength,
+                                         CmdLib_StartCommand(psContext,CMD_LIB_OK));
     }while(FALSE);
 
     return i4Status;
@@ -548,7 +732,7 @@ _STATIC_H int32_t GetMaxCommsBuffer()
         }
         
         //Assign value to MaxCommsBuffer
-        wMaxCommsBuffer = (uint16_t )((sApduData.prgbRespBuffer[LEN_APDUHEADER] << 8) | (sApduData.prgbRespBuffer[LEN_APDUHEADER+1]));
+        psCmdLibContext->wMaxCommsBuffer = (uint16_t )((sApduData.prgbRespBuffer[LEN_APDUHEADER] << 8) | (sApduData.prgbRespBuffer[LEN_APDUHEADER+1]));
     }while(FALSE);
 	
 #undef GETDATA_MAX_COMMS_SIZE  
@@ -634,7 +818,7 @@ _STATIC_H int32_t CmdLib_EncDecHelper(sProcCryptoData_d *PpsCryptoVector, uint8_
         sApduData.bCmd = PbCmd;
         sApduData.bParam = PbParam;
 
-		wMaxPlaintText = wMaxCommsBuffer - OVERHEAD_UPDOWNLINK;
+		wMaxPlaintText = psCmdLibContext->wMaxCommsBuffer - OVERHEAD_UPDOWNLINK;
 
         //Data that is yet to be encrypted/decrypted
         wDataRemaining = PpsCryptoVector->wInDataLength;
@@ -797,7 +981,7 @@ _STATIC_H int32_t Get_KeySize(eAlgId_d PeAlgoIden,uint8_t* pbKeySize )
 /// @endcond
 
 /**
-* Sets the OPTIGA Comms context provided by user application in the command libary.
+* Sets the OPTIGA Comms context provided by user application in the selected command library context.
 * 
 * <br>
 * \param[in] p_input_optiga_comms Pointer to OPTIGA comms context
@@ -807,7 +991,49 @@ _STATIC_H int32_t Get_KeySize(eAlgId_d PeAlgoIden,uint8_t* pbKeySize )
 */
 void CmdLib_SetOptigaCommsContext(const optiga_comms_t *p_input_optiga_comms)
 {
-	p_optiga_comms = (optiga_comms_t*)p_input_optiga_comms;
+	psCmdLibContext->psOptigaComms = (optiga_comms_t*)p_input_optiga_comms;
+}
+
+/**
+* Initializes a command library context for one security chip.
+* 
+* <br>
+* Notes:
+* - Each security chip driven by the host needs its own context and OPTIGA comms context.<br>
+* - The context must stay valid as long as it is selected.<br>
+*
+* \param[out] PpsContext       Pointer to the command library context
+* \param[in]  PpsOptigaComms   Pointer to the OPTIGA comms context of the security chip
+*/
+void CmdLib_InitContext(sCmdLibContext_d* PpsContext, const optiga_comms_t *PpsOptigaComms)
+{
+    PpsContext->psOptigaComms = (optiga_comms_t*)PpsOptigaComms;
+    PpsContext->wMaxCommsBuffer = INVALID_MAX_COMMS_BUFF_SIZE;
+    OCP_MEMSET((uint8_t*)&PpsContext->sCommand,0,sizeof(sCmdLibCommand_d));
+    PpsContext->wStateVersion = 0;
+    PpsContext->psIntLibCache = NULL;
+}
+
+/**
+* Selects the command library context used by the subsequent command library and integration library calls.
+* 
+* <br>
+* Notes:
+* - If PpsContext is NULL, the default context is selected. The default context is used by applications driving a
+*   single security chip with #CmdLib_SetOptigaCommsContext.<br>
+* - The selected context is captured when a command is started, another context can be selected while an
+*   asynchronous command is in progress.<br>
+*
+* \param[in] PpsContext   Pointer to the command library context initialized with #CmdLib_InitContext
+*
+* \retval  Pointer to the previously selected context
+*/
+sCmdLibContext_d* CmdLib_SelectContext(sCmdLibContext_d* PpsContext)
+{
+    sCmdLibContext_d* psPrevious = psCmdLibContext;
+
+    psCmdLibContext = (NULL != PpsContext) ? PpsContext : &sDefaultContext;
+    return psPrevious;
 }
 
 /**
@@ -858,6 +1084,8 @@ int32_t CmdLib_OpenApplication(const sOpenApp_d* PpsOpenApp)
         sApduData.wPayloadLength = sizeof(rgbUID);
 		sApduData.wResponseLength = OPEN_APDU_BUF_LEN;
         OCP_MEMCPY(sApduData.prgbAPDUBuffer+OFFSET_PAYLOAD, rgbUID, sizeof(rgbUID));
+        //A new application context may follow a reset, the life cycle states are read again
+        psCmdLibContext->wStateVersion++;
         i4Status = TransceiveAPDU(&sApduData,FALSE);
         if(CMD_LIB_OK != i4Status)
         {
@@ -865,7 +1093,7 @@ int32_t CmdLib_OpenApplication(const sOpenApp_d* PpsOpenApp)
         }
 
         //Read Max comms buffer size if not already read
-        if(INVALID_MAX_COMMS_BUFF_SIZE == wMaxCommsBuffer)
+        if(INVALID_MAX_COMMS_BUFF_SIZE == psCmdLibContext->wMaxCommsBuffer)
         {
             //Get Maximum Comms buffer size
             i4Status = GetMaxCommsBuffer();
@@ -881,44 +1109,98 @@ int32_t CmdLib_OpenApplication(const sOpenApp_d* PpsOpenApp)
 
 #ifdef MODULE_ENABLE_READ_WRITE
 /**
-* Reads data or metadata of the specified data object by issuing GetDataObject command based on input parameters.
-* 
-* <br>
-* Notes:
-* - Application on security chip must be opened using #CmdLib_OpenApplication before using this API.<br>
-* - The function does not verify if the read access is permitted for the data object.<br>
-* 
-*\param[in] PpsGDVector Pointer to Get Data Object inputs
-*\param[in,out] PpsResponse Pointer to Response structure
-*
-* \retval  #CMD_LIB_OK
-* \retval  #CMD_LIB_ERROR 
-* \retval  #CMD_LIB_INSUFFICIENT_MEMORY
-* \retval  #CMD_DEV_ERROR
-* \retval  #CMD_LIB_NULL_PARAM
-*/
-int32_t CmdLib_GetDataObject(const sGetData_d *PpsGDVector, sCmdResponse_d *PpsResponse)
+ * \brief Formats the GetDataObject command APDU reading the next chunk of the data object.
+ */
+_STATIC_H void CmdLib_FormatGetDataChunk(sCmdLibContext_d* PpsContext)
 {
-/// @cond hidden
-#define ALLOCATE_ADDITIONAL_BYTES	6		// hdr(4) + oid(2)
-/// @endcond 
+    sCmdLibCommand_d* psCommand = &PpsContext->sCommand;
+    const sGetData_d* psGDVector = (const sGetData_d*)psCommand->pvInput;
 
-    //lint --e{818} suppress "PpsResponse is out parameter"
+    if(eDATA == psGDVector->eDataOrMdata)
+    {
+        psCommand->rgbTags[BYTES_OID] = (uint8_t)(psCommand->wOffset >> BITS_PER_BYTE);
+        psCommand->rgbTags[BYTES_OID + 1] = (uint8_t)psCommand->wOffset;
+
+        //copy read length
+        psCommand->wChunkLen = MIN((PpsContext->wMaxCommsBuffer-LEN_APDUHEADER),(psGDVector->wLength-psCommand->wTotalLen));
+        psCommand->rgbTags[BYTES_OID + BYTES_OFFSET] = (uint8_t)(psCommand->wChunkLen >> BITS_PER_BYTE);
+        psCommand->rgbTags[BYTES_OID + BYTES_OFFSET + 1] = (uint8_t)psCommand->wChunkLen;
+    }
+    psCommand->wResponseLength = PpsContext->wMaxCommsBuffer;
+}
+
+/**
+ * \brief Copies the data read by the GetDataObject command and reads the next chunk until the requested data is read.
+ */
+_STATIC_H int32_t CmdLib_GetDataObjectResponse(sCmdLibContext_d* PpsContext, int32_t Pi4Status)
+{
+    int32_t i4Status = Pi4Status;
+    sCmdLibCommand_d* psCommand = &PpsContext->sCommand;
+    const sGetData_d* psGDVector = (const sGetData_d*)psCommand->pvInput;
+    sCmdResponse_d* psResponse = (sCmdResponse_d*)psCommand->pvOutput;
+    uint16_t wRespLen;
+
+    do
+    {
+        if(CMD_LIB_OK != i4Status)
+        {
+            break;
+        }
+        //strip 4 byte apdu header
+        wRespLen = psCommand->wResponseLength - LEN_APDUHEADER;
+
+        //Copy read data
+        if((psResponse->wBufferLength-psCommand->wTotalLen) < wRespLen)
+        {
+            i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
+            break;
+        }
+        OCP_MEMCPY(psResponse->prgbBuffer+psCommand->wTotalLen,psCommand->prgbResponse+LEN_APDUHEADER,wRespLen);
+        //Update total received data
+        psCommand->wTotalLen += wRespLen;
+        //increment the offset to get data from
+        psCommand->wOffset += wRespLen;
+
+        //continue, if total requested data not yet received and more data available for reading
+        if((psCommand->wTotalLen != psGDVector->wLength) && (psCommand->wChunkLen == wRespLen))
+        {
+            CmdLib_FormatGetDataChunk(PpsContext);
+            i4Status = CmdLib_ContinueCommand(PpsContext);
+        }
+    }while(FALSE);
+
+    if(CMD_LIB_CONTINUE != i4Status)
+    {
+        if((CMD_LIB_OK != i4Status)&&((psCommand->wTotalLen == 0)||
+        (ERR_DATA_OUT_OF_BOUND != (i4Status^(int32_t)CMD_DEV_ERROR))))
+        {
+            //Clear existing data
+            OCP_MEMSET(psResponse->prgbBuffer,0,psCommand->wTotalLen);
+            psResponse->wRespLength = 0;
+        }
+        else
+        {
+            psResponse->wRespLength = psCommand->wTotalLen;
+            i4Status = (int32_t)CMD_LIB_OK;
+        }
+    }
+    return i4Status;
+}
+
+/**
+ * \brief Validates the GetDataObject inputs and formats the command APDU reading the first chunk.
+ */
+_STATIC_H int32_t CmdLib_FormatGetDataObject(sCmdLibContext_d* PpsContext, const sGetData_d *PpsGDVector,
+                                             sCmdResponse_d *PpsResponse)
+{
     int32_t i4Status = (int32_t)CMD_LIB_ERROR;
-    uint16_t wTotalRecvLen = 0;
-    uint16_t wReadLen = 0;
-    uint16_t wOffset = 0;
-    sApduData_d sApduData;
-    sApduData.prgbAPDUBuffer = NULL;
+    sCmdLibCommand_d* psCommand = &PpsContext->sCommand;
+    uint8_t bParam;
+
     do
     {
-//To use stack memory for APDU buffer, define STACK_ALLOC macro locally and else heap memory is used
-#ifdef STACK_ALLOC
-        #error "Implement the inilization of stack memory for the required buffer"
-		//INIT_STACK_APDUBUFFER(sApduData.prgbAPDUBuffer, wLen);    //wLen to be replaced with the required const length
-#else
-		INIT_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer,wMaxCommsBuffer + ALLOCATE_ADDITIONAL_BYTES);
-#endif
+        //The response of each chunk is received in the heap buffer and copied to the user buffer
+        INIT_HEAP_APDUBUFFER(psCommand->prgbHeap,PpsContext->wMaxCommsBuffer);
 
         if((NULL == PpsGDVector)||(NULL == PpsResponse)||(NULL == PpsResponse->prgbBuffer))
         {
@@ -930,151 +1212,268 @@ int32_t CmdLib_GetDataObject(const sGetData_d *PpsGDVector, sCmdResponse_d *PpsR
             i4Status = (int32_t)CMD_LIB_LENZERO_ERROR;
             break;
         }
-        //Set the pointer to the response buffer
-        sApduData.prgbRespBuffer = sApduData.prgbAPDUBuffer+ALLOCATE_ADDITIONAL_BYTES;      
-        sApduData.bCmd = CMD_GETDATA; 
         //copy OID
-        sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD] = (uint8_t)(PpsGDVector->wOID >> BITS_PER_BYTE);
-        sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD +1] = (uint8_t)PpsGDVector->wOID; 
+        psCommand->rgbTags[0] = (uint8_t)(PpsGDVector->wOID >> BITS_PER_BYTE);
+        psCommand->rgbTags[1] = (uint8_t)PpsGDVector->wOID; 
+        psCommand->rgsSegments[1].prgbStream = psCommand->rgbTags;
         //set param, payload length and offset ,if reading data
         if(eDATA == PpsGDVector->eDataOrMdata)
         {
-            sApduData.bParam = PARAM_GET_DATA;
-            sApduData.wPayloadLength = LEN_PL_OIDDATA;
-            wOffset = PpsGDVector->wOffset;
+            bParam = PARAM_GET_DATA;
+            psCommand->rgsSegments[1].wLen = LEN_PL_OIDDATA;
+            psCommand->wOffset = PpsGDVector->wOffset;
         }
         //set param and payload length ,if reading metadata
         else if(eMETA_DATA == PpsGDVector->eDataOrMdata)
         {
-            sApduData.bParam = PARAM_GET_METADATA;
-            sApduData.wPayloadLength = LEN_PL_OID;
+            bParam = PARAM_GET_METADATA;
+            psCommand->rgsSegments[1].wLen = LEN_PL_OID;
         }
         else
         {
             i4Status = (int32_t)CMD_LIB_INVALID_PARAM;
             break;
         }
+        psCommand->bSegments = 2;
+        CmdLib_SetHeader(psCommand,CMD_GETDATA,bParam);
 
-        do
-        {     
-            if(eDATA == PpsGDVector->eDataOrMdata)
-            {
-                sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD + BYTES_OID] = (uint8_t)(wOffset >> BITS_PER_BYTE);
-                sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD + BYTES_OID +1] = (uint8_t)wOffset;
+        //Set the pointer to the response buffer
+        psCommand->prgbResponse = psCommand->prgbHeap;
+        psCommand->pvInput = PpsGDVector;
+        psCommand->pvOutput = PpsResponse;
+        psCommand->pfResponse = CmdLib_GetDataObjectResponse;
+        CmdLib_FormatGetDataChunk(PpsContext);
+        i4Status = (int32_t)CMD_LIB_OK;
+    }while(FALSE);
 
-                //copy read length
-                wReadLen = MIN((wMaxCommsBuffer-LEN_APDUHEADER),(PpsGDVector->wLength-wTotalRecvLen));
-                sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD + BYTES_OID + BYTES_OFFSET] = (uint8_t)(wReadLen >> BITS_PER_BYTE);
-                sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD + BYTES_OID + BYTES_OFFSET +1] = (uint8_t)wReadLen;
-            }
+    return i4Status;
+}
 
-            sApduData.wResponseLength = wMaxCommsBuffer;
+/**
+* Reads data or metadata of the specified data object by issuing GetDataObject command based on input parameters.
+* 
+* <br>
+* Notes:
+* - Application on security chip must be opened using #CmdLib_OpenApplication before using this API.<br>
+* - The function does not verify if the read access is permitted for the data object.<br>
+* 
+*\param[in] PpsGDVector Pointer to Get Data Object inputs
+*\param[in,out] PpsResponse Pointer to Response structure
+*
+* \retval  #CMD_LIB_OK
+* \retval  #CMD_LIB_ERROR 
+* \retval  #CMD_LIB_INSUFFICIENT_MEMORY
+* \retval  #CMD_DEV_ERROR
+* \retval  #CMD_LIB_NULL_PARAM
+*/
+int32_t CmdLib_GetDataObject(const sGetData_d *PpsGDVector, sCmdResponse_d *PpsResponse)
+{
+    sCmdLibContext_d* psContext = psCmdLibContext;
 
-            i4Status = TransceiveAPDU(&sApduData,TRUE);
-            if(CMD_LIB_OK != i4Status)
-            {
-                break;
-            }
-            //strip 4 byte apdu header
-            sApduData.wResponseLength -= LEN_APDUHEADER;
+    return CmdLib_WaitForCommand(psContext,NULL,CmdLib_GetDataObjectAsync(PpsGDVector,PpsResponse,NULL,NULL));
+}
 
-            //Copy read data
-            if(((PpsResponse->wBufferLength-wTotalRecvLen) < sApduData.wResponseLength))
-            {
-                i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
-                break;
-            }
-            OCP_MEMCPY(PpsResponse->prgbBuffer+wTotalRecvLen,sApduData.prgbRespBuffer+LEN_APDUHEADER,sApduData.wResponseLength);
-            //Update total received data
-            wTotalRecvLen += sApduData.wResponseLength;
-            //increment the offset to get data from
-            wOffset += sApduData.wResponseLength;
-
-            //If requested data is read  
-            if(wTotalRecvLen == PpsGDVector->wLength)
-            {
-                break;
-            }
-        //continue, if total requested data not yet received and more data available for reading
-        }while(wReadLen == sApduData.wResponseLength);
-
-        if((CMD_LIB_OK != i4Status)&&((wTotalRecvLen == 0)||
-        (ERR_DATA_OUT_OF_BOUND != (i4Status^(int32_t)CMD_DEV_ERROR))))
-        {
-            //Clear existing data
-            OCP_MEMSET(PpsResponse->prgbBuffer,0,wTotalRecvLen);
-            PpsResponse->wRespLength = 0;
-            break;
-        }
-
-        PpsResponse->wRespLength = wTotalRecvLen;
-        i4Status = (int32_t)CMD_LIB_OK;
-    }while(FALSE);  
-
-#ifndef STACK_ALLOC
-	FREE_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer);
-#else
-	#undef STACK_ALLOC
-#endif
-
-///@cond hidden
-#undef ALLOCATE_ADDITIONAL_BYTES
-///@endcond
+/**
+* Starts reading data or metadata of the specified data object, see #CmdLib_GetDataObject.
+* 
+* <br>
+* Notes:
+* - The function returns once the first command APDU is sent. The response is processed in the event loop and
+*   the data object is read in chunks as by #CmdLib_GetDataObject.<br>
+* - Once completed, PpfCallback is invoked from the event loop with the status #CmdLib_GetDataObject would return.
+*   The callback may start the next command on the security chip.<br>
+* - If the function does not return #CMD_LIB_OK, the command is not started and PpfCallback is not invoked.<br>
+* - Only one command can be in progress on a security chip, #CMD_LIB_BUSY is returned otherwise. Without callback,
+*   as used by the blocking functions, the function waits in the event loop for the command in progress instead.<br>
+* - PpsGDVector and PpsResponse must stay valid until the callback is invoked.<br>
+* 
+*\param[in] PpsGDVector Pointer to Get Data Object inputs
+*\param[in,out] PpsResponse Pointer to Response structure
+*\param[in] PpfCallback Callback invoked once the command is completed, can be NULL
+*\param[in] PpvCallbackCtx User context passed to PpfCallback
+*
+* \retval  #CMD_LIB_OK
+* \retval  #CMD_LIB_BUSY
+* \retval  #CMD_LIB_INSUFFICIENT_MEMORY
+* \retval  #CMD_LIB_NULL_PARAM
+* \retval  #CMD_LIB_LENZERO_ERROR
+* \retval  #CMD_LIB_INVALID_PARAM
+* \retval  #CMD_DEV_EXEC_ERROR
+*/
+int32_t CmdLib_GetDataObjectAsync(const sGetData_d *PpsGDVector, sCmdResponse_d *PpsResponse,
+                                  pFCmdLibCallback_d PpfCallback, void* PpvCallbackCtx)
+{
+    sCmdLibContext_d* psContext = psCmdLibContext;
+    int32_t i4Status = CmdLib_ClaimContext(psContext,PpfCallback,PpvCallbackCtx);
 
+    if(CMD_LIB_OK == i4Status)
+    {
+        i4Status = CmdLib_StartCommand(psContext,CmdLib_FormatGetDataObject(psContext,PpsGDVector,PpsResponse));
+    }
     return i4Status;
 }
 
 /**
-* Writes data or metadata to the specified data object by issuing SetDataObject command based on input parameters.
+* Reads data of the specified data object in chunks of the given buffer size and passes each chunk to PpfChunk.
+* The data can be processed with constant memory, independent of the size of the data object.
 *
 * <br>
-* Notes: <br>
+* Notes:
 * - Application on security chip must be opened using #CmdLib_OpenApplication before using this API.<br>
-*
-* - The function does not verify if the write access permitted for the data object.
-* 
-* - While writing metadata, the metadata must be specified in an already TLV encoded 
-*   byte array format. For example, to set LcsO to operational the value passed by 
-*   the user must be 0x20 0x03 0xC0, 0x01, 0x07. <br>
-*
-* - The function does not validate if the provided input data bytes are correctly 
-*   formatted. For example, while setting LcsO to operational, function does not 
-*   verify if the value is indeed 0x07. <br>
-*
-* - In case of failure,it is possible that partial data is written into the data object.<br>
-*   In such a case, the user should decide if the data has to be re-written.
-*
-*\param[in] PpsSDVector Pointer to Set Data Object inputs
+* - The function reads up to PpsGDVector->wLength bytes from PpsGDVector->wOffset, 0xFFFF reads until the end
+*   of the data object. Reading stops once the end of the data object is reached or PpfChunk returns FALSE.<br>
+* - The offset passed to PpfChunk is the offset of the chunk within the data object. The chunk buffer is
+*   overwritten with the next chunk once PpfChunk returns.<br>
+* - Each chunk is read with #CmdLib_GetDataObject, a chunk buffer of up to #CmdLib_GetMaxCommsBufferSize - 4 bytes
+*   is read with one command APDU.<br>
+*
+*\param[in] PpsGDVector Pointer to Get Data Object inputs, only data can be read
+*\param[in] PprgbChunk Buffer receiving the chunks
+*\param[in] PwChunkLen Length of the chunk buffer
+*\param[in] PpfChunk Function invoked with each chunk read
+*\param[in] PpvChunkCtx User context passed to PpfChunk
 *
 * \retval  #CMD_LIB_OK
-* \retval  #CMD_LIB_ERROR 
-* \retval  #CMD_LIB_INVALID_PARAM 
+* \retval  #CMD_LIB_ERROR
 * \retval  #CMD_LIB_INSUFFICIENT_MEMORY
 * \retval  #CMD_DEV_ERROR
 * \retval  #CMD_LIB_NULL_PARAM
+* \retval  #CMD_LIB_LENZERO_ERROR
+* \retval  #CMD_LIB_INVALID_PARAM
 */
-int32_t CmdLib_SetDataObject(const sSetData_d *PpsSDVector)
+int32_t CmdLib_ReadDataObjectStream(const sGetData_d *PpsGDVector, uint8_t* PprgbChunk, uint16_t PwChunkLen,
+                                    pFCmdLibChunk_d PpfChunk, void* PpvChunkCtx)
+{
+    int32_t i4Status = (int32_t)CMD_LIB_ERROR;
+    sGetData_d sChunk;
+    sCmdResponse_d sResponse;
+    uint16_t wRemaining;
+
+    do
+    {
+        if((NULL == PpsGDVector)||(NULL == PprgbChunk)||(NULL == PpfChunk))
+        {
+            i4Status = (int32_t)CMD_LIB_NULL_PARAM;
+            break;
+        }
+        if(eDATA != PpsGDVector->eDataOrMdata)
+        {
+            i4Status = (int32_t)CMD_LIB_INVALID_PARAM;
+            break;
+        }
+        if((0x00 == PwChunkLen)||(0x00 == PpsGDVector->wLength))
+        {
+            i4Status = (int32_t)CMD_LIB_LENZERO_ERROR;
+            break;
+        }
+
+        sChunk = *PpsGDVector;
+        sResponse.prgbBuffer = PprgbChunk;
+        wRemaining = PpsGDVector->wLength;
+        //Read until the requested length is read, a short chunk is the end of the data object
+        do
+        {
+            sChunk.wLength = MIN(PwChunkLen,wRemaining);
+            sResponse.wBufferLength = sChunk.wLength;
+            sResponse.wRespLength = 0;
+            i4Status = CmdLib_GetDataObject(&sChunk,&sResponse);
+            if(CMD_LIB_OK != i4Status)
+            {
+                //The previous chunk ended exactly at the end of the data object
+                if((sChunk.wOffset != PpsGDVector->wOffset) &&
+                   (ERR_DATA_OUT_OF_BOUND == (i4Status^(int32_t)CMD_DEV_ERROR)))
+                {
+                    i4Status = (int32_t)CMD_LIB_OK;
+                }
+                break;
+            }
+            wRemaining -= sResponse.wRespLength;
+            if(FALSE == PpfChunk(PpvChunkCtx,sChunk.wOffset,PprgbChunk,sResponse.wRespLength))
+            {
+                break;
+            }
+            sChunk.wOffset += sResponse.wRespLength;
+        }while((0x00 != wRemaining) && (sResponse.wRespLength == sChunk.wLength));
+    }while(FALSE);
+
+    return i4Status;
+}
+
+/**
+ * \brief Formats the SetDataObject command APDU writing the next chunk of the data.
+ */
+_STATIC_H void CmdLib_FormatSetDataChunk(sCmdLibContext_d* PpsContext)
 {
 /// @cond hidden
-#define BUFFER_SIZE (wMaxCommsBuffer)
+#define OVERHEAD (OFFSET_PAYLOAD+BYTES_OID+BYTES_OFFSET)
+/// @endcond
+
+    sCmdLibCommand_d* psCommand = &PpsContext->sCommand;
+    const sSetData_d* psSDVector = (const sSetData_d*)psCommand->pvInput;
+    uint8_t bParam = psCommand->rgbHeader[OFFSET_PARAM];
+
+    //While chaining for erase & write option, all subsequent write must be only write operation
+    if((bParam == PARAM_SET_DATA_ERASE)&&
+    (psCommand->wTotalLen != 0))
+    {
+        bParam = PARAM_SET_DATA;
+    }
+
+    psCommand->wChunkLen = MIN((PpsContext->wMaxCommsBuffer-OVERHEAD),(psSDVector->wLength-psCommand->wTotalLen));
+
+    //copy offset
+    psCommand->rgbTags[BYTES_OID] = (uint8_t)(psCommand->wOffset >> BITS_PER_BYTE);
+    psCommand->rgbTags[BYTES_OID + 1] = (uint8_t)psCommand->wOffset;                
+    //the data is sent from the user buffer
+    psCommand->rgsSegments[2].prgbStream = psSDVector->prgbData+psCommand->wTotalLen;
+    psCommand->rgsSegments[2].wLen = psCommand->wChunkLen;
+    CmdLib_SetHeader(psCommand,CMD_SETDATA,bParam);
+
+    //Set Response buffer length
+    psCommand->wResponseLength = LEN_APDUHEADER;
+
+/// @cond hidden
+#undef OVERHEAD
 /// @endcond
+}
+
+/**
+ * \brief Writes the next chunk of the data until all the data is written.
+ */
+_STATIC_H int32_t CmdLib_SetDataObjectResponse(sCmdLibContext_d* PpsContext, int32_t Pi4Status)
+{
+    int32_t i4Status = Pi4Status;
+    sCmdLibCommand_d* psCommand = &PpsContext->sCommand;
+    const sSetData_d* psSDVector = (const sSetData_d*)psCommand->pvInput;
 
+    if(CMD_LIB_OK == i4Status)
+    {
+        psCommand->wTotalLen += psCommand->wChunkLen;
+        psCommand->wOffset += psCommand->wChunkLen;
+        if(psCommand->wTotalLen != psSDVector->wLength)
+        {
+            CmdLib_FormatSetDataChunk(PpsContext);
+            i4Status = CmdLib_ContinueCommand(PpsContext);
+        }
+    }
+    return i4Status;
+}
+
+/**
+ * \brief Validates the SetDataObject inputs and formats the command APDU writing the first chunk.
+ */
+_STATIC_H int32_t CmdLib_FormatSetDataObject(sCmdLibContext_d* PpsContext, const sSetData_d *PpsSDVector)
+{
     int32_t i4Status = (int32_t)CMD_LIB_ERROR;
-    uint16_t wTotalWriteLen = 0;
-    uint16_t wWriteLen = 0;
-    uint16_t wOffset;
-    sApduData_d sApduData;
-    sApduData.prgbAPDUBuffer = NULL;
+    sCmdLibCommand_d* psCommand = &PpsContext->sCommand;
 
     do
     {
-//To use stack memory for APDU buffer, define STACK_ALLOC macro locally and else heap memory is used
-#ifdef STACK_ALLOC
-        #error "Implement the inilization of stack memory for the required buffer"
-		//INIT_STACK_APDUBUFFER(sApduData.prgbAPDUBuffer, wLen);    //wLen to be replaced with the required const length
-#else
-		INIT_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer,BUFFER_SIZE);
-#endif
+        if(INVALID_MAX_COMMS_BUFF_SIZE == PpsContext->wMaxCommsBuffer)
+        {
+            i4Status = (int32_t)CMD_DEV_EXEC_ERROR;
+            break;
+        }
 
         if((NULL == PpsSDVector)||(NULL == PpsSDVector->prgbData))
         {
@@ -1087,84 +1486,115 @@ int32_t CmdLib_SetDataObject(const sSetData_d *PpsSDVector)
             break;
         }
 
-        sApduData.bCmd = CMD_SETDATA;
-
         if((eDATA == PpsSDVector->eDataOrMdata)&&
         (eWRITE == PpsSDVector->eWriteOption))
         {
-            sApduData.bParam = PARAM_SET_DATA;
+            psCommand->rgbHeader[OFFSET_PARAM] = PARAM_SET_DATA;
         }
         else if((eDATA == PpsSDVector->eDataOrMdata)&&
         (eERASE_AND_WRITE == PpsSDVector->eWriteOption))
         {
-            sApduData.bParam = PARAM_SET_DATA_ERASE;
+            psCommand->rgbHeader[OFFSET_PARAM] = PARAM_SET_DATA_ERASE;
         }
         else if((eMETA_DATA == PpsSDVector->eDataOrMdata)&&
         (eWRITE == PpsSDVector->eWriteOption))
         {
-            sApduData.bParam = PARAM_SET_METADATA; 
+            psCommand->rgbHeader[OFFSET_PARAM] = PARAM_SET_METADATA; 
         }
         else
         {
             i4Status = (int32_t)CMD_LIB_INVALID_PARAM;
             break;
         }
-
-        //Set the pointer to the response buffer
-        sApduData.prgbRespBuffer = sApduData.prgbAPDUBuffer+7;
-        //copy OID
-        sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD] = (uint8_t)(PpsSDVector->wOID >> BITS_PER_BYTE);
-        sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD + 1] = (uint8_t)PpsSDVector->wOID;
-        wOffset = PpsSDVector->wOffset;
-        do
+        //Invalidate the caches of metadata and life cycle states before they may change
+        if((eMETA_DATA == PpsSDVector->eDataOrMdata)||
+        (OID_LCSG == PpsSDVector->wOID)||(OID_LCSA == PpsSDVector->wOID))
         {
-            //While chaining for erase & write option, all subsequent write must be only write operation
-            if((sApduData.bParam == PARAM_SET_DATA_ERASE)&&
-            (wTotalWriteLen != 0))
-            {
-                sApduData.bParam = PARAM_SET_DATA;
-            }
-/// @cond hidden
-#define OVERHEAD (OFFSET_PAYLOAD+BYTES_OID+BYTES_OFFSET)
-/// @endcond
-
-            wWriteLen = MIN((wMaxCommsBuffer-OVERHEAD),(PpsSDVector->wLength-wTotalWriteLen));
-           
-            //set data payload length is 4(OID length + offset length) plus length of data to write
-            sApduData.wPayloadLength = BYTES_OID + BYTES_OFFSET + wWriteLen;
-
-            //copy offset
-            sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD + BYTES_OID] = (uint8_t)(wOffset >> BITS_PER_BYTE);
-            sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD + BYTES_OID + 1] = (uint8_t)wOffset;                
-            //copy the data
+            PpsContext->wStateVersion++;
+        }
 
-            OCP_MEMCPY(sApduData.prgbAPDUBuffer+OVERHEAD,PpsSDVector->prgbData+wTotalWriteLen,wWriteLen);
+        //copy OID
+        psCommand->rgbTags[0] = (uint8_t)(PpsSDVector->wOID >> BITS_PER_BYTE);
+        psCommand->rgbTags[1] = (uint8_t)PpsSDVector->wOID;
+        //APDU header, OID and offset, data to write
+        psCommand->rgsSegments[1].prgbStream = psCommand->rgbTags;
+        psCommand->rgsSegments[1].wLen = BYTES_OID + BYTES_OFFSET;
+        psCommand->bSegments = 3;
+        psCommand->wOffset = PpsSDVector->wOffset;
+        psCommand->pvInput = PpsSDVector;
+        psCommand->pfResponse = CmdLib_SetDataObjectResponse;
+        CmdLib_FormatSetDataChunk(PpsContext);
+        i4Status = (int32_t)CMD_LIB_OK;
+    }while(FALSE);
 
-			//Set Response buffer length
-			sApduData.wResponseLength = BUFFER_SIZE;
+    return i4Status;
+}
 
-            i4Status = TransceiveAPDU(&sApduData,TRUE);
-            if(CMD_LIB_OK != i4Status)
-            {
-                break;
-            } 
+/**
+* Writes data or metadata to the specified data object by issuing SetDataObject command based on input parameters.
+*
+* <br>
+* Notes: <br>
+* - Application on security chip must be opened using #CmdLib_OpenApplication before using this API.<br>
+*
+* - The function does not verify if the write access permitted for the data object.
+* 
+* - While writing metadata, the metadata must be specified in an already TLV encoded 
+*   byte array format. For example, to set LcsO to operational the value passed by 
+*   the user must be 0x20 0x03 0xC0, 0x01, 0x07. <br>
+*
+* - The function does not validate if the provided input data bytes are correctly 
+*   formatted. For example, while setting LcsO to operational, function does not 
+*   verify if the value is indeed 0x07. <br>
+*
+* - In case of failure,it is possible that partial data is written into the data object.<br>
+*   In such a case, the user should decide if the data has to be re-written.
+*
+*\param[in] PpsSDVector Pointer to Set Data Object inputs
+*
+* \retval  #CMD_LIB_OK
+* \retval  #CMD_LIB_ERROR 
+* \retval  #CMD_LIB_INVALID_PARAM 
+* \retval  #CMD_LIB_INSUFFICIENT_MEMORY
+* \retval  #CMD_DEV_ERROR
+* \retval  #CMD_LIB_NULL_PARAM
+*/
+int32_t CmdLib_SetDataObject(const sSetData_d *PpsSDVector)
+{
+    sCmdLibContext_d* psContext = psCmdLibContext;
 
-            wTotalWriteLen += wWriteLen;
-			wOffset += wWriteLen;
-        }while(wTotalWriteLen != PpsSDVector->wLength);        
-    }while(FALSE);  
+    return CmdLib_WaitForCommand(psContext,NULL,CmdLib_SetDataObjectAsync(PpsSDVector,NULL,NULL));
+}
 
-#ifndef STACK_ALLOC
-	FREE_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer);
-#else
-	#undef STACK_ALLOC
-#endif
-	
-/// @cond hidden
-#undef OVERHEAD
-#undef BUFFER_SIZE
-/// @endcond
+/**
+* Starts writing data or metadata to the specified data object, see #CmdLib_SetDataObject.
+*
+* <br>
+* Notes: <br>
+* - The data is written in chunks from the event loop. The command is completed as described for
+*   #CmdLib_GetDataObjectAsync.<br>
+* - PpsSDVector and the data to write must stay valid until the callback is invoked.<br>
+*
+*\param[in] PpsSDVector Pointer to Set Data Object inputs
+*\param[in] PpfCallback Callback invoked once the command is completed, can be NULL
+*\param[in] PpvCallbackCtx User context passed to PpfCallback
+*
+* \retval  #CMD_LIB_OK
+* \retval  #CMD_LIB_BUSY
+* \retval  #CMD_LIB_INVALID_PARAM 
+* \retval  #CMD_LIB_NULL_PARAM
+* \retval  #CMD_LIB_LENZERO_ERROR
+* \retval  #CMD_DEV_EXEC_ERROR
+*/
+int32_t CmdLib_SetDataObjectAsync(const sSetData_d *PpsSDVector, pFCmdLibCallback_d PpfCallback, void* PpvCallbackCtx)
+{
+    sCmdLibContext_d* psContext = psCmdLibContext;
+    int32_t i4Status = CmdLib_ClaimContext(psContext,PpfCallback,PpvCallbackCtx);
 
+    if(CMD_LIB_OK == i4Status)
+    {
+        i4Status = CmdLib_StartCommand(psContext,CmdLib_FormatSetDataObject(psContext,PpsSDVector));
+    }
     return i4Status;
 }
 
@@ -1181,7 +1611,7 @@ int32_t CmdLib_SetDataObject(const sSetData_d *PpsSDVector)
 */
 uint16_t CmdLib_GetMaxCommsBufferSize(Void)
 {
-	return wMaxCommsBuffer;
+	return psCmdLibContext->wMaxCommsBuffer;
 }
 #endif /* MODULE_ENABLE_READ_WRITE */
 
@@ -1307,34 +1737,46 @@ int32_t CmdLib_GetSignature(const sAuthMsg_d *PpsAuthMsg, sCmdResponse_d *PpsRes
 }
 
 /**
- * Gets random bytes generated by the Security Chip.<br>
- *
- * <br>
- * Notes: <br>
- * - Command chaining is not supported in this API.<br>
- * - If the requested length of random bytes is either more than communication buffer size or more than the buffer size in PpsResponse,#CMD_LIB_INSUFFICIENT_MEMORY error is returned.<br>
- * 
- *\param[in]		PpsRng		Pointer to sRngOptions_d to specify random number generation
- *\param[in,out]	PpsResponse Pointer to sCmdResponse_d to store random number
- *
- * \retval  #CMD_LIB_OK
- * \retval  #CMD_LIB_ERROR 
- * \retval  #CMD_LIB_INSUFFICIENT_MEMORY 
- * \retval  #CMD_LIB_LENZERO_ERROR
- * \retval  #CMD_DEV_ERROR
- * \retval  #CMD_LIB_NULL_PARAM
+ * \brief Copies the random bytes received from the security chip.
  */
-int32_t CmdLib_GetRandom(const sRngOptions_d *PpsRng, sCmdResponse_d *PpsResponse)
+_STATIC_H int32_t CmdLib_GetRandomResponse(sCmdLibContext_d* PpsContext, int32_t Pi4Status)
 {
-    //lint --e{818} suppress "PpsResponse is out parameter"
-    int32_t i4Status = (int32_t)CMD_LIB_ERROR;
-    sApduData_d sApduData;
+    int32_t i4Status = Pi4Status;
+    sCmdLibCommand_d* psCommand = &PpsContext->sCommand;
+    sCmdResponse_d* psResponse = (sCmdResponse_d*)psCommand->pvOutput;
+    uint16_t wRespLen;
 
     do
     {
-        //Initial value set it to NULL
-        sApduData.prgbAPDUBuffer = NULL;
+        if(CMD_LIB_OK != i4Status)
+        {
+            break;
+        }
+        //strip 4 byte apdu header
+        wRespLen = psCommand->wResponseLength - LEN_APDUHEADER;
+        if(psResponse->wBufferLength < wRespLen)
+        {
+            i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
+            break;
+        }
+        OCP_MEMCPY(psResponse->prgbBuffer,psCommand->prgbResponse+LEN_APDUHEADER,wRespLen);
+        psResponse->wRespLength = wRespLen;
+    }while(FALSE);
+
+    return i4Status;
+}
 
+/**
+ * \brief Validates the GetRandom inputs and formats the command APDU.
+ */
+_STATIC_H int32_t CmdLib_FormatGetRandom(sCmdLibContext_d* PpsContext, const sRngOptions_d *PpsRng,
+                                         sCmdResponse_d *PpsResponse)
+{
+    int32_t i4Status = (int32_t)CMD_LIB_ERROR;
+    sCmdLibCommand_d* psCommand = &PpsContext->sCommand;
+
+    do
+    {
         if((NULL == PpsRng)||(NULL == PpsResponse)||(NULL == PpsResponse->prgbBuffer))
         {
             i4Status = (int32_t)CMD_LIB_NULL_PARAM;
@@ -1347,44 +1789,88 @@ int32_t CmdLib_GetRandom(const sRngOptions_d *PpsRng, sCmdResponse_d *PpsRespons
         }
 
         //If the length of requested random bytes is more than the maximum comms buffer size
-        if((wMaxCommsBuffer) < (LEN_APDUHEADER + PpsRng->wRandomDataLen))
+        if((PpsContext->wMaxCommsBuffer) < (LEN_APDUHEADER + PpsRng->wRandomDataLen))
         {
             i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
             break;
         }
         PpsResponse->wRespLength = 0;
-        sApduData.bCmd = CMD_GET_RND; 
-        sApduData.bParam = (uint8_t)PpsRng->eRngType;        
-        sApduData.wPayloadLength = LEN_PL_OID;
 
-        INIT_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer, (LEN_APDUHEADER + PpsRng->wRandomDataLen));
+        INIT_HEAP_APDUBUFFER(psCommand->prgbHeap, (LEN_APDUHEADER + PpsRng->wRandomDataLen));
 
-        sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD] = (uint8_t)(PpsRng->wRandomDataLen >> BITS_PER_BYTE);
-        sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD + 1] = (uint8_t)PpsRng->wRandomDataLen;
-        sApduData.wResponseLength = (LEN_APDUHEADER + PpsRng->wRandomDataLen);
+        psCommand->rgbTags[0] = (uint8_t)(PpsRng->wRandomDataLen >> BITS_PER_BYTE);
+        psCommand->rgbTags[1] = (uint8_t)PpsRng->wRandomDataLen;
+        psCommand->rgsSegments[1].prgbStream = psCommand->rgbTags;
+        psCommand->rgsSegments[1].wLen = LEN_PL_OID;
+        psCommand->bSegments = 2;
+        CmdLib_SetHeader(psCommand,CMD_GET_RND,(uint8_t)PpsRng->eRngType);
 
         //Set the pointer to the response buffer
-        sApduData.prgbRespBuffer = sApduData.prgbAPDUBuffer;
+        psCommand->prgbResponse = psCommand->prgbHeap;
+        psCommand->wResponseLength = (LEN_APDUHEADER + PpsRng->wRandomDataLen);
+        psCommand->pvOutput = PpsResponse;
+        psCommand->pfResponse = CmdLib_GetRandomResponse;
+        i4Status = (int32_t)CMD_LIB_OK;
+    }while(FALSE);
 
-        i4Status = TransceiveAPDU(&sApduData,TRUE);
-        if(CMD_LIB_OK != i4Status)
-        {
-            break;
-        }   
-        //strip 4 byte apdu header
-        sApduData.wResponseLength -= LEN_APDUHEADER;
-        if(PpsResponse->wBufferLength < sApduData.wResponseLength)
-        {
-            i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
-            break;
-        }
-        OCP_MEMCPY(PpsResponse->prgbBuffer,sApduData.prgbAPDUBuffer+LEN_APDUHEADER,sApduData.wResponseLength);
-        PpsResponse->wRespLength = sApduData.wResponseLength;
+    return i4Status;
+}
 
-    }while(FALSE);
+/**
+ * Gets random bytes generated by the Security Chip.<br>
+ *
+ * <br>
+ * Notes: <br>
+ * - Command chaining is not supported in this API.<br>
+ * - If the requested length of random bytes is either more than communication buffer size or more than the buffer size in PpsResponse,#CMD_LIB_INSUFFICIENT_MEMORY error is returned.<br>
+ * 
+ *\param[in]		PpsRng		Pointer to sRngOptions_d to specify random number generation
+ *\param[in,out]	PpsResponse Pointer to sCmdResponse_d to store random number
+ *
+ * \retval  #CMD_LIB_OK
+ * \retval  #CMD_LIB_ERROR 
+ * \retval  #CMD_LIB_INSUFFICIENT_MEMORY 
+ * \retval  #CMD_LIB_LENZERO_ERROR
+ * \retval  #CMD_DEV_ERROR
+ * \retval  #CMD_LIB_NULL_PARAM
+ */
+int32_t CmdLib_GetRandom(const sRngOptions_d *PpsRng, sCmdResponse_d *PpsResponse)
+{
+    sCmdLibContext_d* psContext = psCmdLibContext;
 
-    FREE_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer);
+    return CmdLib_WaitForCommand(psContext,NULL,CmdLib_GetRandomAsync(PpsRng,PpsResponse,NULL,NULL));
+}
+
+/**
+ * Starts generating random bytes by the Security Chip, see #CmdLib_GetRandom.<br>
+ *
+ * <br>
+ * Notes: <br>
+ * - The command is completed as described for #CmdLib_GetDataObjectAsync.<br>
+ * - PpsResponse must stay valid until the callback is invoked.<br>
+ * 
+ *\param[in]		PpsRng		Pointer to sRngOptions_d to specify random number generation
+ *\param[in,out]	PpsResponse Pointer to sCmdResponse_d to store random number
+ *\param[in]		PpfCallback Callback invoked once the command is completed, can be NULL
+ *\param[in]		PpvCallbackCtx User context passed to PpfCallback
+ *
+ * \retval  #CMD_LIB_OK
+ * \retval  #CMD_LIB_BUSY
+ * \retval  #CMD_LIB_INSUFFICIENT_MEMORY 
+ * \retval  #CMD_LIB_LENZERO_ERROR
+ * \retval  #CMD_LIB_NULL_PARAM
+ * \retval  #CMD_DEV_EXEC_ERROR
+ */
+int32_t CmdLib_GetRandomAsync(const sRngOptions_d *PpsRng, sCmdResponse_d *PpsResponse,
+                              pFCmdLibCallback_d PpfCallback, void* PpvCallbackCtx)
+{
+    sCmdLibContext_d* psContext = psCmdLibContext;
+    int32_t i4Status = CmdLib_ClaimContext(psContext,PpfCallback,PpvCallbackCtx);
 
+    if(CMD_LIB_OK == i4Status)
+    {
+        i4Status = CmdLib_StartCommand(psContext,CmdLib_FormatGetRandom(psContext,PpsRng,PpsResponse));
+    }
     return i4Status;
 }
 
@@ -1491,79 +1977,100 @@ int32_t CmdLib_SetAuthScheme(const sAuthScheme_d *PpsAuthVector)
 
 #ifdef MODULE_ENABLE_TOOLBOX
 /**
-* Calculates the hash of input data by using the Security Chip.<br>
-*
-* Input:<br>
-* - Provide the required type of input data for hashing. Use \ref sCalcHash_d.eHashDataType with the following options,
-*   - eDataStream : Indicates, sDataStream is considered as hash input.
-*   - eOIDData : Indicates, sOIDData is considered for hash input.
-* 
-* - Provide the input to import/export the hash context. Use \ref sContextInfo_d.eContextAction with the following options,
-*   - #eImport : Import hash context to perform the hash.
-*   - #eExport : Export current active hash context.
-*   - #eImportExport : Import hash context and Export back the context after hashing. 
-*   - #eUnused : Context data import/export feature is not used. This option is also recommended for #eHashSequence_d as #eStartFinalizeHash or #eTerminateHash.
-*
-* Output:<br>
-* - Successful API execution,
-*   - Hash is returned in sOutHash only if #eHashSequence_d is #eStartFinalizeHash,#eIntermediateHash or #eFinalizeHash.<br>
-*   - Hash context data is returned only if \ref sContextInfo_d.eContextAction is #eExport or #eImportExport.<br> 
-*
-* Notes: <br>
-* - Application on security chip must be opened using #CmdLib_OpenApplication before using this API.<br>
-* - #eTerminateHash in #eHashSequence_d is used to terminate any existing hash session. Any input data or hash context options supplied with this sequence is ignored.
-* - Sequences for generating a hash successfully can be as follows:<br>
-*     - #eStartHash,#eFinalizeHash<br>
-*     - #eStartHash,#eContinueHash (single or multiple),#eFinalizeHash<br>
-*     - #eStartFinalizeHash<br>
-*     - #eStartHash,#eIntermediateHash,#eContinueHash,#eFinalizeHash<br>
-*
-* - If the memory buffer is not sufficient to store output hash/hash context or the data to be sent to security chip is more than communication buffer,#CMD_LIB_INSUFFICIENT_MEMORY error is retured.
-* - This API does not maintain any state of hashing operations.<br>
-* - There is no support for chaining while sending data therefore in order to avoid communication buffer overflow, the user must take care of fragmenting the data for hashing.<br>
-*   Use the API #CmdLib_GetMaxCommsBufferSize to check the maximum communication buffer size supported by the security chip. In addition, the overhead for command APDU header and 
-*   TLV encoding must be considered as explained below.<br> 
-*
-*   Read the maximum communication buffer size using the API #CmdLib_GetMaxCommsBufferSize() and store in a variable <b>"wMaxCommsBuffer"</b><br>
-*   Substract the header overheads and hash context size(depends on applicable Hash algorithm) respectively from wMaxCommsBuffer. The result gives the Available_Size to frame the hash data input.<br>
-*
-*   - Only hash calculation : <br>
-*   &nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp; Available_Size = (wMaxCommsBuffer - #CALC_HASH_FIXED_OVERHEAD_SIZE)<br>
-*   - Import context to security chip and calculate hash  : <br>
-*   &nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp; Available_Size = (wMaxCommsBuffer - #CALC_HASH_FIXED_OVERHEAD_SIZE - #CALC_HASH_IMPORT_OR_EXPORT_OVERHEAD_SIZE - #CALC_HASH_SHA256_CONTEXT_SIZE)<br>
-*   - Calulate hash and export context out of security chip : <br>  
-*   &nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp; Available_Size = (wMaxCommsBuffer - #CALC_HASH_FIXED_OVERHEAD_SIZE - #CALC_HASH_IMPORT_OR_EXPORT_OVERHEAD_SIZE)<br> 
-*   - Import context to security chip, calculate hash and export context out of security chip :<br>
-*   &nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp; Available_Size = (wMaxCommsBuffer - #CALC_HASH_FIXED_OVERHEAD_SIZE - #CALC_HASH_IMPORT_AND_EXPORT_OVERHEAD_SIZE - #CALC_HASH_SHA256_CONTEXT_SIZE)<br>
-*
-*
-* \param[in,out] PpsCalcHash Pointer to #sCalcHash_d that contains information to calculate hash
-*
-* \retval  #CMD_LIB_OK
-* \retval  #CMD_LIB_ERROR
-* \retval  #CMD_LIB_NULL_PARAM
-* \retval  #CMD_LIB_INSUFFICIENT_MEMORY
-* \retval  #CMD_DEV_EXEC_ERROR
-* \retval  #CMD_DEV_ERROR
-*/
-int32_t CmdLib_CalcHash(sCalcHash_d* PpsCalcHash)
+ * \brief Copies the hash or the hash context received from the security chip.
+ */
+_STATIC_H int32_t CmdLib_CalcHashResponse(sCmdLibContext_d* PpsContext, int32_t Pi4Status)
+{
+/// @cond hidden
+#define TAG_HASH_OUTPUT         0x01
+#define TAG_CONTEXT_OUTPUT      0x06
+/// @endcond
+
+    int32_t i4Status = Pi4Status;
+    sCmdLibCommand_d* psCommand = &PpsContext->sCommand;
+    sCalcHash_d* psCalcHash = (sCalcHash_d*)psCommand->pvOutput;
+    sHashinfo_d* psHashinfo;
+    uint16_t wRespLen;
+
+    do
+    {
+        if(CMD_LIB_OK != i4Status)
+        {
+            break;
+        }
+        i4Status = Get_HashInfo(psCalcHash->eHashAlg, &psHashinfo);
+        if(CMD_LIB_OK != i4Status)
+        {
+            break;
+        }
+
+        wRespLen = psCommand->wResponseLength - LEN_APDUHEADER;
+        
+        //Validate the output buffer size if tag received on reponse is 0x01 and 
+        //copy the hash data to sOutput buffer 
+        if((TAG_HASH_OUTPUT == (*(psCommand->prgbResponse + LEN_APDUHEADER))) && (wRespLen != 0))
+        {
+            //Length check for sOutData
+            if((psHashinfo->bHashLen) > psCalcHash->sOutHash.wBufferLength)
+            {
+                i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
+                break;
+            }
+
+            psCalcHash->sOutHash.wRespLength = Utility_GetUint16(psCommand->prgbResponse + LEN_APDUHEADER + BYTES_SEQ);
+            OCP_MEMCPY(psCalcHash->sOutHash.prgbBuffer, (psCommand->prgbResponse + CALC_HASH_FIXED_OVERHEAD_SIZE), psCalcHash->sOutHash.wRespLength);
+        }
+
+        //Validate the Context buffer size if the 0x06 context data tag is there in response and 
+        //copy the context data to pbContextData buffer
+        if((TAG_CONTEXT_OUTPUT == (*(psCommand->prgbResponse + LEN_APDUHEADER))) && (wRespLen != 0))
+        {
+            //Length check for Context Data
+            if((psHashinfo->wHashCntx) > psCalcHash->sContextInfo.dwContextLen)
+            {
+                i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
+                break;
+            }
+
+            psCalcHash->sContextInfo.dwContextLen = Utility_GetUint16(psCommand->prgbResponse + LEN_APDUHEADER + BYTES_SEQ);
+            OCP_MEMCPY(psCalcHash->sContextInfo.pbContextData, (psCommand->prgbResponse + CALC_HASH_FIXED_OVERHEAD_SIZE), psCalcHash->sContextInfo.dwContextLen);
+        }
+    }while(FALSE);
+
+/// @cond hidden
+#undef TAG_HASH_OUTPUT   
+#undef TAG_CONTEXT_OUTPUT
+/// @endcond
+
+    return i4Status;
+}
+
+/**
+ * \brief Validates the CalcHash inputs and formats the command APDU.
+ */
+_STATIC_H int32_t CmdLib_FormatCalcHash(sCmdLibContext_d* PpsContext, sCalcHash_d* PpsCalcHash)
 {
+/// @cond hidden    
+#define INDATA_LEN_OID     (BYTES_OID + BYTES_LENGTH + BYTES_OFFSET)
+#define NIBBLE_LEN      4
+/// @endcond
+
     int32_t i4Status = (int32_t)CMD_LIB_ERROR;
-	sApduData_d sApduData;
+    sCmdLibCommand_d* psCommand = &PpsContext->sCommand;
+    sTxSegment_d* psSegments = psCommand->rgsSegments;
 	eDataType_d eHashDataType;
-    uint16_t wMemoryAllocLen;
     uint16_t wInDataLen;
 	sHashinfo_d* psHashinfo;
     uint16_t wOptTagLen = 0;
-    uint16_t wOptTagOffset = 0;
-    uint16_t wOffset;
     uint16_t wBufferLen;
+    //Sequence, length and OID data of the data tag, tag and length of the import and export context tags
+    uint8_t* prgbDataTag = psCommand->rgbTags;
+    uint8_t* prgbImportTag = prgbDataTag + BYTES_SEQ + BYTES_LENGTH + INDATA_LEN_OID;
+    uint8_t* prgbExportTag = prgbImportTag + BYTES_SEQ + BYTES_LENGTH;
+    uint8_t bSegments = 1;
        
     do
     {
-        //Initial value set it to NULL
-        sApduData.prgbAPDUBuffer = NULL;
-
         //Check for NULL inputs
         if(NULL == PpsCalcHash)
         {
@@ -1592,11 +2099,6 @@ int32_t CmdLib_CalcHash(sCalcHash_d* PpsCalcHash)
             break;
         }
 
-/// @cond hidden    
-#define INDATA_LEN_OID     (BYTES_OID + BYTES_LENGTH + BYTES_OFFSET)
-#define NIBBLE_LEN      4
-/// @endcond
-        
         eHashDataType = PpsCalcHash->eHashDataType;
         
         //For eHashDataType_d as eDataStream, validate psDataStream
@@ -1630,23 +2132,15 @@ int32_t CmdLib_CalcHash(sCalcHash_d* PpsCalcHash)
             {
                 wOptTagLen += CALC_HASH_IMPORT_OR_EXPORT_OVERHEAD_SIZE;
             }
-            wOptTagOffset = (eDataStream == PpsCalcHash->eHashDataType)? (OFFSET_PAYLOAD + BYTES_SEQ + BYTES_LENGTH + wInDataLen) : 
-                                (OFFSET_PAYLOAD + BYTES_SEQ + BYTES_LENGTH + INDATA_LEN_OID);
         }
         
         //Validate the size of input data with the Communication buffer
-        if((wInDataLen + wOptTagLen + CALC_HASH_FIXED_OVERHEAD_SIZE) > wMaxCommsBuffer)
+        if((wInDataLen + wOptTagLen + CALC_HASH_FIXED_OVERHEAD_SIZE) > PpsContext->wMaxCommsBuffer)
         {
             i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
             break;
         }
         
-        //Form data
-        sApduData.bCmd = CMD_CALCHASH;
-        sApduData.bParam = (uint8_t)PpsCalcHash->eHashAlg;
-        
-        wMemoryAllocLen = CALC_HASH_FIXED_OVERHEAD_SIZE + wInDataLen + wOptTagLen;
-        
         wBufferLen = CALC_HASH_FIXED_OVERHEAD_SIZE;
         
         //Check to validate sufficient memory to store the output
@@ -1662,162 +2156,175 @@ int32_t CmdLib_CalcHash(sCalcHash_d* PpsCalcHash)
             wBufferLen += psHashinfo->wHashCntx;
         }
         
-        if(wBufferLen > wMemoryAllocLen)
-        {
-            wMemoryAllocLen = wBufferLen;
-        }
-        
-        // Allocate the memory        
-        INIT_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer, wMemoryAllocLen);
+        // Allocate the memory for the response only, the data and the context are sent from the user buffers
+        INIT_HEAP_APDUBUFFER(psCommand->prgbHeap, wBufferLen);
                 
-        sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD] = (uint8_t)(((uint8_t)eHashDataType << NIBBLE_LEN) | (uint8_t) PpsCalcHash->eHashSequence);
-        sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD + BYTES_SEQ] = (uint8_t)(wInDataLen >> 8);
-        sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD + BYTES_SEQ + 1] = (uint8_t)wInDataLen ;
+        prgbDataTag[0] = (uint8_t)(((uint8_t)eHashDataType << NIBBLE_LEN) | (uint8_t) PpsCalcHash->eHashSequence);
+        prgbDataTag[BYTES_SEQ] = (uint8_t)(wInDataLen >> 8);
+        prgbDataTag[BYTES_SEQ + 1] = (uint8_t)wInDataLen ;
+        psSegments[bSegments].prgbStream = prgbDataTag;
+        psSegments[bSegments++].wLen = BYTES_SEQ + BYTES_LENGTH;
             
         if(eTerminateHash != PpsCalcHash->eHashSequence)
         {
-			//If the DataType is Data stream, copy the input data to the buffer
+			//If the DataType is Data stream, the input data is sent from the user buffer
             if(eDataStream == eHashDataType)
             {
-                OCP_MEMCPY(&sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD + BYTES_SEQ + BYTES_LENGTH], PpsCalcHash->sDataStream.prgbStream, 
-                wInDataLen);
+                psSegments[bSegments].prgbStream = PpsCalcHash->sDataStream.prgbStream;
+                psSegments[bSegments++].wLen = wInDataLen;
             }
             else
             {
-                //If the Data type is OID, copy the OID information to the buffer 
-                sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD + BYTES_SEQ + BYTES_LENGTH] = (uint8_t)(PpsCalcHash->sOIDData.wOID >> 8);
-                sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD + BYTES_SEQ + BYTES_LENGTH + 1] = (uint8_t)PpsCalcHash->sOIDData.wOID;
-                sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD + BYTES_SEQ + BYTES_LENGTH + BYTES_OID] = (uint8_t)(PpsCalcHash->sOIDData.wOffset >> 8);
-                sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD + BYTES_SEQ + BYTES_LENGTH + BYTES_OID + 1] = (uint8_t)PpsCalcHash->sOIDData.wOffset;
-                sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD + BYTES_SEQ + INDATA_LEN_OID] = (uint8_t)(PpsCalcHash->sOIDData.wLength >> 8);
-                sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD + BYTES_SEQ + INDATA_LEN_OID + 1] = (uint8_t)(PpsCalcHash->sOIDData.wLength);
+                //If the Data type is OID, add the OID information to the data tag
+                prgbDataTag[BYTES_SEQ + BYTES_LENGTH] = (uint8_t)(PpsCalcHash->sOIDData.wOID >> 8);
+                prgbDataTag[BYTES_SEQ + BYTES_LENGTH + 1] = (uint8_t)PpsCalcHash->sOIDData.wOID;
+                prgbDataTag[BYTES_SEQ + BYTES_LENGTH + BYTES_OID] = (uint8_t)(PpsCalcHash->sOIDData.wOffset >> 8);
+                prgbDataTag[BYTES_SEQ + BYTES_LENGTH + BYTES_OID + 1] = (uint8_t)PpsCalcHash->sOIDData.wOffset;
+                prgbDataTag[BYTES_SEQ + INDATA_LEN_OID] = (uint8_t)(PpsCalcHash->sOIDData.wLength >> 8);
+                prgbDataTag[BYTES_SEQ + INDATA_LEN_OID + 1] = (uint8_t)(PpsCalcHash->sOIDData.wLength);
+                psSegments[bSegments - 1].wLen += INDATA_LEN_OID;
             }
 
-/// @cond hidden
-#define OFFSET_EXPORT_CNTXTAG   (wOptTagOffset + BYTES_SEQ+ BYTES_LENGTH + PpsCalcHash->sContextInfo.dwContextLen)
-/// @endcond
-
             //If the optional tag is either eImport or eImportAndExport, 0x06 tag is sent as part of command APDU       
             if((eImportExport == PpsCalcHash->sContextInfo.eContextAction) || 
             (eImport == PpsCalcHash->sContextInfo.eContextAction))
             {
-                sApduData.prgbAPDUBuffer[wOptTagOffset] = (uint8_t)eImport;
-                sApduData.prgbAPDUBuffer[wOptTagOffset + BYTES_SEQ] = (uint8_t)(PpsCalcHash->sContextInfo.dwContextLen >> 8);
-                sApduData.prgbAPDUBuffer[wOptTagOffset + BYTES_SEQ + 1] = (uint8_t)(PpsCalcHash->sContextInfo.dwContextLen);
-                OCP_MEMCPY(&sApduData.prgbAPDUBuffer[wOptTagOffset + BYTES_SEQ + BYTES_LENGTH], PpsCalcHash->sContextInfo.pbContextData, 
-                            PpsCalcHash->sContextInfo.dwContextLen);
+                prgbImportTag[0] = (uint8_t)eImport;
+                prgbImportTag[BYTES_SEQ] = (uint8_t)(PpsCalcHash->sContextInfo.dwContextLen >> 8);
+                prgbImportTag[BYTES_SEQ + 1] = (uint8_t)(PpsCalcHash->sContextInfo.dwContextLen);
+                psSegments[bSegments].prgbStream = prgbImportTag;
+                psSegments[bSegments++].wLen = BYTES_SEQ + BYTES_LENGTH;
+                psSegments[bSegments].prgbStream = PpsCalcHash->sContextInfo.pbContextData;
+                psSegments[bSegments++].wLen = PpsCalcHash->sContextInfo.dwContextLen;
             }
 
             //If the optional tag is either eExport or eImportAndeExport, 0x07 tag is sent as part of command APDU
             if((eImportExport == PpsCalcHash->sContextInfo.eContextAction) || 
             (eExport == PpsCalcHash->sContextInfo.eContextAction))
             {
-                wOffset = (eExport == PpsCalcHash->sContextInfo.eContextAction)?wOptTagOffset : OFFSET_EXPORT_CNTXTAG;
-                sApduData.prgbAPDUBuffer[wOffset] = (uint8_t)eExport;
-                sApduData.prgbAPDUBuffer[wOffset + BYTES_SEQ] = 0x00;
-                sApduData.prgbAPDUBuffer[wOffset + BYTES_SEQ + 1] =0x00;
-            }
-        }
-        
-        //set data payload length is 3(BYTES_SEQ + BYTES_LENGTH) plus length of data to write
-        sApduData.wPayloadLength = BYTES_SEQ + BYTES_LENGTH + wInDataLen + wOptTagLen;
-
-        sApduData.prgbRespBuffer = sApduData.prgbAPDUBuffer;
-        
-        sApduData.wResponseLength = wMemoryAllocLen;
-        
-        i4Status = TransceiveAPDU(&sApduData,TRUE);
-        if(CMD_LIB_OK != i4Status)
-        {
-            break;
-        } 
-
-/// @cond hidden
-#define TAG_HASH_OUTPUT         0x01
-#define TAG_CONTEXT_OUTPUT      0x06
-/// @endcond
-        
-        sApduData.wResponseLength -= LEN_APDUHEADER;
-        
-        //Validate the output buffer size if tag received on reponse is 0x01 and 
-        //copy the hash data to sOutput buffer 
-        if((TAG_HASH_OUTPUT == (*(sApduData.prgbRespBuffer + LEN_APDUHEADER))) && (sApduData.wResponseLength != 0))
-        {
-            //Length check for sOutData
-            if((psHashinfo->bHashLen) > PpsCalcHash->sOutHash.wBufferLength)
-            {
-                i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
-                break;
+                prgbExportTag[0] = (uint8_t)eExport;
+                prgbExportTag[BYTES_SEQ] = 0x00;
+                prgbExportTag[BYTES_SEQ + 1] =0x00;
+                psSegments[bSegments].prgbStream = prgbExportTag;
+                psSegments[bSegments++].wLen = BYTES_SEQ + BYTES_LENGTH;
             }
-
-            PpsCalcHash->sOutHash.wRespLength = Utility_GetUint16(sApduData.prgbRespBuffer + LEN_APDUHEADER + BYTES_SEQ);
-            OCP_MEMCPY(PpsCalcHash->sOutHash.prgbBuffer, (sApduData.prgbRespBuffer + CALC_HASH_FIXED_OVERHEAD_SIZE), PpsCalcHash->sOutHash.wRespLength);
         }
+        psCommand->bSegments = bSegments;
+        CmdLib_SetHeader(psCommand,CMD_CALCHASH,(uint8_t)PpsCalcHash->eHashAlg);
 
-        //Validate the Context buffer size if the 0x06 context data tag is there in response and 
-        //copy the context data to pbContextData buffer
-        if((TAG_CONTEXT_OUTPUT == (*(sApduData.prgbRespBuffer + LEN_APDUHEADER))) && (sApduData.wResponseLength != 0))
-        {
-            //Length check for Context Data
-            if((psHashinfo->wHashCntx) > PpsCalcHash->sContextInfo.dwContextLen)
-            {
-                i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
-                break;
-            }
-
-            PpsCalcHash->sContextInfo.dwContextLen = Utility_GetUint16(sApduData.prgbRespBuffer + LEN_APDUHEADER + BYTES_SEQ);
-            OCP_MEMCPY(PpsCalcHash->sContextInfo.pbContextData, (sApduData.prgbRespBuffer + CALC_HASH_FIXED_OVERHEAD_SIZE), PpsCalcHash->sContextInfo.dwContextLen);
-        }
-        
+        psCommand->prgbResponse = psCommand->prgbHeap;
+        psCommand->wResponseLength = wBufferLen;
+        psCommand->pvOutput = PpsCalcHash;
+        psCommand->pfResponse = CmdLib_CalcHashResponse;
     }while(FALSE);
-    
-	FREE_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer);
 
 /// @cond hidden
 #undef INDATA_LEN_OID
 #undef NIBBLE_LEN
-#undef OFFSET_EXPORT_CNTXTAG
-#undef TAG_HASH_OUTPUT   
-#undef TAG_CONTEXT_OUTPUT
 /// @endcond
 
     return i4Status;
 }
 
 /**
-* Verifies the signature over the input digest by using the Security Chip.<br>
+* Calculates the hash of input data by using the Security Chip.<br>
 *
 * Input:<br>
-* - For eVerifyDataType
-*   - #eDataStream indicates that sPubKeyInput is considered for signature verification.<br>
-*   - #eOIDData indicates that wOIDPubKey is considered for signature verification.<br>
+* - Provide the required type of input data for hashing. Use \ref sCalcHash_d.eHashDataType with the following options,
+*   - eDataStream : Indicates, sDataStream is considered as hash input.
+*   - eOIDData : Indicates, sOIDData is considered for hash input.
+* 
+* - Provide the input to import/export the hash context. Use \ref sContextInfo_d.eContextAction with the following options,
+*   - #eImport : Import hash context to perform the hash.
+*   - #eExport : Export current active hash context.
+*   - #eImportExport : Import hash context and Export back the context after hashing. 
+*   - #eUnused : Context data import/export feature is not used. This option is also recommended for #eHashSequence_d as #eStartFinalizeHash or #eTerminateHash.
 *
 * Output:<br>
-* - Successful signature verification returns #CMD_LIB_OK.<br> 
+* - Successful API execution,
+*   - Hash is returned in sOutHash only if #eHashSequence_d is #eStartFinalizeHash,#eIntermediateHash or #eFinalizeHash.<br>
+*   - Hash context data is returned only if \ref sContextInfo_d.eContextAction is #eExport or #eImportExport.<br> 
 *
 * Notes: <br>
 * - Application on security chip must be opened using #CmdLib_OpenApplication before using this API.<br>
-* - If the the data to be sent to security chip is more than communication buffer,#CMD_LIB_INSUFFICIENT_MEMORY is returned. Refer OPTIGA_Trust_X_SolutionReferenceManual_v1.x.pdf for more details.
+* - #eTerminateHash in #eHashSequence_d is used to terminate any existing hash session. Any input data or hash context options supplied with this sequence is ignored.
+* - Sequences for generating a hash successfully can be as follows:<br>
+*     - #eStartHash,#eFinalizeHash<br>
+*     - #eStartHash,#eContinueHash (single or multiple),#eFinalizeHash<br>
+*     - #eStartFinalizeHash<br>
+*     - #eStartHash,#eIntermediateHash,#eContinueHash,#eFinalizeHash<br>
 *
-* \param[in]     PpsVerifySign  Pointer to information for verifying signature
-* \param[in,out] PpsDigest      pointer to a blob which holds the Digest
-* \param[in,out] PpsSignature   pointer to a blob which holds the Signature to be verified
+* - If the memory buffer is not sufficient to store output hash/hash context or the data to be sent to security chip is more than communication buffer,#CMD_LIB_INSUFFICIENT_MEMORY error is retured.
+* - This API does not maintain any state of hashing operations.<br>
+* - There is no support for chaining while sending data therefore in order to avoid communication buffer overflow, the user must take care of fragmenting the data for hashing.<br>
+*   Use the API #CmdLib_GetMaxCommsBufferSize to check the maximum communication buffer size supported by the security chip. In addition, the overhead for command APDU header and 
+*   TLV encoding must be considered as explained below.<br> 
 *
-* \retval  #CMD_LIB_OK
-* \retval  #CMD_LIB_ERROR
+*   Read the maximum communication buffer size using the API #CmdLib_GetMaxCommsBufferSize() and store in a variable <b>"wMaxCommsBuffer"</b><br>
+*   Substract the header overheads and hash context size(depends on applicable Hash algorithm) respectively from wMaxCommsBuffer. The result gives the Available_Size to frame the hash data input.<br>
+*
+*   - Only hash calculation : <br>
+*   &nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp; Available_Size = (wMaxCommsBuffer - #CALC_HASH_FIXED_OVERHEAD_SIZE)<br>
+*   - Import context to security chip and calculate hash  : <br>
+*   &nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp; Available_Size = (wMaxCommsBuffer - #CALC_HASH_FIXED_OVERHEAD_SIZE - #CALC_HASH_IMPORT_OR_EXPORT_OVERHEAD_SIZE - #CALC_HASH_SHA256_CONTEXT_SIZE)<br>
+*   - Calulate hash and export context out of security chip : <br>  
+*   &nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp; Available_Size = (wMaxCommsBuffer - #CALC_HASH_FIXED_OVERHEAD_SIZE - #CALC_HASH_IMPORT_OR_EXPORT_OVERHEAD_SIZE)<br> 
+*   - Import context to security chip, calculate hash and export context out of security chip :<br>
+*   &nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp; Available_Size = (wMaxCommsBuffer - #CALC_HASH_FIXED_OVERHEAD_SIZE - #CALC_HASH_IMPORT_AND_EXPORT_OVERHEAD_SIZE - #CALC_HASH_SHA256_CONTEXT_SIZE)<br>
+*
+*
+* \param[in,out] PpsCalcHash Pointer to #sCalcHash_d that contains information to calculate hash
+*
+* \retval  #CMD_LIB_OK
+* \retval  #CMD_LIB_ERROR
 * \retval  #CMD_LIB_NULL_PARAM
 * \retval  #CMD_LIB_INSUFFICIENT_MEMORY
 * \retval  #CMD_DEV_EXEC_ERROR
 * \retval  #CMD_DEV_ERROR
 */
-int32_t CmdLib_VerifySign(const sVerifyOption_d* PpsVerifySign,const sbBlob_d * PpsDigest,const sbBlob_d * PpsSignature)
+int32_t CmdLib_CalcHash(sCalcHash_d* PpsCalcHash)
 {
+    sCmdLibContext_d* psContext = psCmdLibContext;
 
-    int32_t i4Status = (int32_t)CMD_LIB_ERROR;
-	sApduData_d sApduData = {0};
-    uint16_t wWritePosition = OFFSET_PAYLOAD;
-    uint16_t wCalApduLen = 0;
-    
+    return CmdLib_WaitForCommand(psContext,NULL,CmdLib_CalcHashAsync(PpsCalcHash,NULL,NULL));
+}
+
+/**
+* Starts the hash calculation on input data by using the Security Chip, see #CmdLib_CalcHash.<br>
+*
+* Notes: <br>
+* - The command is completed as described for #CmdLib_GetDataObjectAsync.<br>
+* - PpsCalcHash and the buffers it points to must stay valid until the callback is invoked.<br>
+*
+* \param[in,out] PpsCalcHash Pointer to #sCalcHash_d that contains information to calculate hash
+* \param[in] PpfCallback Callback invoked once the command is completed, can be NULL
+* \param[in] PpvCallbackCtx User context passed to PpfCallback
+*
+* \retval  #CMD_LIB_OK
+* \retval  #CMD_LIB_BUSY
+* \retval  #CMD_LIB_ERROR
+* \retval  #CMD_LIB_NULL_PARAM
+* \retval  #CMD_LIB_INSUFFICIENT_MEMORY
+* \retval  #CMD_DEV_EXEC_ERROR
+*/
+int32_t CmdLib_CalcHashAsync(sCalcHash_d* PpsCalcHash, pFCmdLibCallback_d PpfCallback, void* PpvCallbackCtx)
+{
+    sCmdLibContext_d* psContext = psCmdLibContext;
+    int32_t i4Status = CmdLib_ClaimContext(psContext,PpfCallback,PpvCallbackCtx);
+
+    if(CMD_LIB_OK == i4Status)
+    {
+        i4Status = CmdLib_StartCommand(psContext,CmdLib_FormatCalcHash(psContext,PpsCalcHash));
+    }
+    return i4Status;
+}
+
+/**
+ * \brief Validates the VerifySign inputs and formats the command APDU.
+ */
+_STATIC_H int32_t CmdLib_FormatVerifySign(sCmdLibContext_d* PpsContext, const sVerifyOption_d* PpsVerifySign,
+                                          const sbBlob_d * PpsDigest,const sbBlob_d * PpsSignature)
+{
 /// @cond hidden
 	///Minimum length of APDU InData in case of Public Key from Host. [TLV Header(3) for Digest + TLV Header (3) for Signature + TLV Header(3) for Public Key + TLV for Algo (4)]
 	#define DATA_STREAM_APDU_INDATA_LEN		13
@@ -1825,7 +2332,15 @@ int32_t CmdLib_VerifySign(const sVerifyOption_d* PpsVerifySign,const sbBlob_d *
 	#define OID_APDU_INDATA_LEN				11
 /// @endcond	
 
-    print_debug(">CmdLib_VerifySign");
+    int32_t i4Status = (int32_t)CMD_LIB_ERROR;
+    sCmdLibCommand_d* psCommand = &PpsContext->sCommand;
+    sTxSegment_d* psSegments = psCommand->rgsSegments;
+    uint16_t wCalApduLen = 0;
+    //Tag and length of digest and signature, public key tags or public key OID TLV
+    uint8_t* prgbDigestTag = psCommand->rgbTags;
+    uint8_t* prgbSignatureTag = prgbDigestTag + TAG_VALUE_OFFSET;
+    uint8_t* prgbKeyTags = prgbSignatureTag + TAG_VALUE_OFFSET;
+    uint8_t bSegments = 1;
 
     do
 	{
@@ -1850,73 +2365,66 @@ int32_t CmdLib_VerifySign(const sVerifyOption_d* PpsVerifySign,const sbBlob_d *
         {
             wCalApduLen = OFFSET_PAYLOAD + OID_APDU_INDATA_LEN + PpsDigest->wLen + PpsSignature->wLen;
         }
-        if((wMaxCommsBuffer) < wCalApduLen)
+        if((PpsContext->wMaxCommsBuffer) < wCalApduLen)
         {
             i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
             break;
         }
 
-        //Allocating Heap memory 
-        INIT_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer,wCalApduLen);
-
-        //Set the pointer to the response buffer
-        sApduData.prgbRespBuffer = sApduData.prgbAPDUBuffer;
-				sApduData.wResponseLength = wMaxCommsBuffer;
-        //Set digest tag, length, data
-        sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD] = TAG_DIGEST;
-        Utility_SetUint16(&sApduData.prgbAPDUBuffer[wWritePosition + TAG_LENGTH_OFFSET], PpsDigest->wLen);
-        OCP_MEMCPY(&sApduData.prgbAPDUBuffer[wWritePosition + TAG_VALUE_OFFSET],PpsDigest->prgbStream,PpsDigest->wLen);
-        wWritePosition += TAG_VALUE_OFFSET+ PpsDigest->wLen;
+        if(INVALID_MAX_COMMS_BUFF_SIZE == PpsContext->wMaxCommsBuffer)
+        {
+            i4Status = (int32_t)CMD_DEV_EXEC_ERROR;
+            break;
+        }
 
-        //Set signature tag, length, data
-        sApduData.prgbAPDUBuffer[wWritePosition] = TAG_SIGNATURE;
-        Utility_SetUint16(&sApduData.prgbAPDUBuffer[wWritePosition + TAG_LENGTH_OFFSET], PpsSignature->wLen);
-        OCP_MEMCPY(&sApduData.prgbAPDUBuffer[wWritePosition + TAG_VALUE_OFFSET],PpsSignature->prgbStream,PpsSignature->wLen);
-        wWritePosition += TAG_VALUE_OFFSET + PpsSignature->wLen;
+        //Digest, signature and public key are sent from the user buffers
+        //Set digest tag, length
+        prgbDigestTag[0] = TAG_DIGEST;
+        Utility_SetUint16(&prgbDigestTag[TAG_LENGTH_OFFSET], PpsDigest->wLen);
+        psSegments[bSegments].prgbStream = prgbDigestTag;
+        psSegments[bSegments++].wLen = TAG_VALUE_OFFSET;
+        psSegments[bSegments].prgbStream = PpsDigest->prgbStream;
+        psSegments[bSegments++].wLen = PpsDigest->wLen;
 
+        //Set signature tag, length
+        prgbSignatureTag[0] = TAG_SIGNATURE;
+        Utility_SetUint16(&prgbSignatureTag[TAG_LENGTH_OFFSET], PpsSignature->wLen);
+        psSegments[bSegments].prgbStream = prgbSignatureTag;
+        psSegments[bSegments++].wLen = TAG_VALUE_OFFSET;
+        psSegments[bSegments].prgbStream = PpsSignature->prgbStream;
+        psSegments[bSegments++].wLen = PpsSignature->wLen;
 
         if(eDataStream == PpsVerifySign->eVerifyDataType)
         {
             //Set TLV values for external public key
-            sApduData.prgbAPDUBuffer[wWritePosition] = TAG_ALGO_IDENTIFIER;
+            prgbKeyTags[0] = TAG_ALGO_IDENTIFIER;
 
-            Utility_SetUint16(&sApduData.prgbAPDUBuffer[wWritePosition + TAG_LENGTH_OFFSET], LEN_ALGO_IDENTIFIER);
-            sApduData.prgbAPDUBuffer[wWritePosition + TAG_VALUE_OFFSET] = (uint8_t)PpsVerifySign->sPubKeyInput.eAlgId;
+            Utility_SetUint16(&prgbKeyTags[TAG_LENGTH_OFFSET], LEN_ALGO_IDENTIFIER);
+            prgbKeyTags[TAG_VALUE_OFFSET] = (uint8_t)PpsVerifySign->sPubKeyInput.eAlgId;
 
-            sApduData.prgbAPDUBuffer[wWritePosition + TAG_VALUE_OFFSET + BYTES_SEQ] = (uint8_t)TAG_PUB_KEY;
-            Utility_SetUint16(&sApduData.prgbAPDUBuffer[wWritePosition + TAG_VALUE_OFFSET + BYTES_OFFSET], PpsVerifySign->sPubKeyInput.sDataStream.wLen);
-            wWritePosition += TAG_VALUE_OFFSET + BYTES_OFFSET + BYTES_OFFSET;
-            OCP_MEMCPY(&sApduData.prgbAPDUBuffer[wWritePosition],PpsVerifySign->sPubKeyInput.sDataStream.prgbStream ,PpsVerifySign->sPubKeyInput.sDataStream.wLen);
-            //Total payload length
-            sApduData.wPayloadLength = (uint16_t)(wWritePosition + PpsVerifySign->sPubKeyInput.sDataStream.wLen - OFFSET_PAYLOAD);
+            prgbKeyTags[TAG_VALUE_OFFSET + BYTES_SEQ] = (uint8_t)TAG_PUB_KEY;
+            Utility_SetUint16(&prgbKeyTags[TAG_VALUE_OFFSET + BYTES_OFFSET], PpsVerifySign->sPubKeyInput.sDataStream.wLen);
+            psSegments[bSegments].prgbStream = prgbKeyTags;
+            psSegments[bSegments++].wLen = TAG_VALUE_OFFSET + BYTES_OFFSET + BYTES_OFFSET;
+            psSegments[bSegments].prgbStream = PpsVerifySign->sPubKeyInput.sDataStream.prgbStream;
+            psSegments[bSegments++].wLen = PpsVerifySign->sPubKeyInput.sDataStream.wLen;
         }
 
         if(eOIDData == PpsVerifySign->eVerifyDataType)
         {
             //Set TLV values for public key OID
-            sApduData.prgbAPDUBuffer[wWritePosition] = TAG_PUB_KEY_OID;
-            Utility_SetUint16(&sApduData.prgbAPDUBuffer[wWritePosition + TAG_LENGTH_OFFSET], LEN_PUB_KEY);
-            Utility_SetUint16(&sApduData.prgbAPDUBuffer[wWritePosition + TAG_VALUE_OFFSET], PpsVerifySign->wOIDPubKey);
-            //Total payload length 
-            sApduData.wPayloadLength = (uint16_t)(wWritePosition + TAG_VALUE_OFFSET + BYTES_OFFSET - OFFSET_PAYLOAD);
+            prgbKeyTags[0] = TAG_PUB_KEY_OID;
+            Utility_SetUint16(&prgbKeyTags[TAG_LENGTH_OFFSET], LEN_PUB_KEY);
+            Utility_SetUint16(&prgbKeyTags[TAG_VALUE_OFFSET], PpsVerifySign->wOIDPubKey);
+            psSegments[bSegments].prgbStream = prgbKeyTags;
+            psSegments[bSegments++].wLen = TAG_VALUE_OFFSET + BYTES_OFFSET;
         }
 
-        //Form Command
-        sApduData.bCmd = CMD_VERIFYSIGN;
-        sApduData.bParam = (uint8_t)PpsVerifySign->eSignScheme;
-
-
-        //Transmit data
-        i4Status = TransceiveAPDU(&sApduData,TRUE);
-        if(CMD_LIB_OK != i4Status)
-        {
-        	print_debug("CmdLib_VerifySign: Error transceive");
-            break;
-        }
+        //Form Command, the response carries no data
+        psCommand->bSegments = bSegments;
+        CmdLib_SetHeader(psCommand,CMD_VERIFYSIGN,(uint8_t)PpsVerifySign->eSignScheme);
+        i4Status = (int32_t)CMD_LIB_OK;
     }while(FALSE);
-
-    //Free the allocated memory for buffer
-    FREE_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer);
  
 /// @cond hidden
 	#undef DATA_STREAM_APDU_INDATA_LEN
@@ -1927,25 +2435,23 @@ int32_t CmdLib_VerifySign(const sVerifyOption_d* PpsVerifySign,const sbBlob_d *
 }
 
 /**
-* Generates a key pair by using the Security Chip.<br>
+* Verifies the signature over the input digest by using the Security Chip.<br>
 *
-* Input:
-* - Provide the required option for exporting the generated keys. Use \ref sKeyPairOption_d.eKeyExport
-*   - #eStorePrivKeyOnly indicates that only private key is stored in the OID and public key is exported.
-*   - #eExportKeyPair indicates that both public and private keys are exported.
+* Input:<br>
+* - For eVerifyDataType
+*   - #eDataStream indicates that sPubKeyInput is considered for signature verification.<br>
+*   - #eOIDData indicates that wOIDPubKey is considered for signature verification.<br>
 *
-* Output:
-* - Successful API execution,
-*   - Public key is returned in \ref sOutKeyPair_d.sPublicKey.
-*   - Private key is returned in \ref sOutKeyPair_d.sPrivateKey , if input is #eExportKeyPair.
+* Output:<br>
+* - Successful signature verification returns #CMD_LIB_OK.<br> 
 *
-* Notes:
-* - Application on security chip must be opened using #CmdLib_OpenApplication before using this API.
-* - Values of #eKeyUsage_d can be logically 'ORed' and passed to \ref sKeyPairOption_d.eKeyUsage.
-* - If the memory buffers in #sOutKeyPair_d is not sufficient to store the generated keys,#CMD_LIB_INSUFFICIENT_MEMORY is returned. Refer OPTIGA_Trust_X_SolutionReferenceManual_v1.x.pdf for more details.
+* Notes: <br>
+* - Application on security chip must be opened using #CmdLib_OpenApplication before using this API.<br>
+* - If the the data to be sent to security chip is more than communication buffer,#CMD_LIB_INSUFFICIENT_MEMORY is returned. Refer OPTIGA_Trust_X_SolutionReferenceManual_v1.x.pdf for more details.
 *
-* \param[in] PpsKeyPairOption Pointer to #sKeyPairOption_d to provide input for key pair generation
-* \param[in,out] PpsOutKeyPair Pointer to #sOutKeyPair_d that contains generated key pair
+* \param[in]     PpsVerifySign  Pointer to information for verifying signature
+* \param[in,out] PpsDigest      pointer to a blob which holds the Digest
+* \param[in,out] PpsSignature   pointer to a blob which holds the Signature to be verified
 *
 * \retval  #CMD_LIB_OK
 * \retval  #CMD_LIB_ERROR
@@ -1954,27 +2460,122 @@ int32_t CmdLib_VerifySign(const sVerifyOption_d* PpsVerifySign,const sbBlob_d *
 * \retval  #CMD_DEV_EXEC_ERROR
 * \retval  #CMD_DEV_ERROR
 */
-int32_t CmdLib_GenerateKeyPair(const sKeyPairOption_d* PpsKeyPairOption,sOutKeyPair_d* PpsOutKeyPair)
+int32_t CmdLib_VerifySign(const sVerifyOption_d* PpsVerifySign,const sbBlob_d * PpsDigest,const sbBlob_d * PpsSignature)
 {
-	int32_t i4Status = (int32_t)CMD_LIB_ERROR;
-	uint16_t wWritePosition = LEN_APDUHEADER;
-	uint16_t wCalApduLen;
+    sCmdLibContext_d* psContext = psCmdLibContext;
+
+    print_debug(">CmdLib_VerifySign");
+
+    return CmdLib_WaitForCommand(psContext,NULL,CmdLib_VerifySignAsync(PpsVerifySign,PpsDigest,PpsSignature,NULL,NULL));
+}
+
+/**
+* Starts the signature verification over the input digest by using the Security Chip, see #CmdLib_VerifySign.<br>
+*
+* Notes: <br>
+* - The command is completed as described for #CmdLib_GetDataObjectAsync.<br>
+* - The digest, the signature and the public key are sent from the user buffers, they must stay valid until the
+*   callback is invoked.<br>
+*
+* \param[in] PpsVerifySign  Pointer to #sVerifyOption_d which specifies input options
+* \param[in] PpsDigest      Pointer to a blob which holds the digest
+* \param[in] PpsSignature   Pointer to a blob which holds the Signature to be verified
+* \param[in] PpfCallback    Callback invoked once the command is completed, can be NULL
+* \param[in] PpvCallbackCtx User context passed to PpfCallback
+*
+* \retval  #CMD_LIB_OK
+* \retval  #CMD_LIB_BUSY
+* \retval  #CMD_LIB_NULL_PARAM
+* \retval  #CMD_LIB_INSUFFICIENT_MEMORY
+* \retval  #CMD_DEV_EXEC_ERROR
+*/
+int32_t CmdLib_VerifySignAsync(const sVerifyOption_d* PpsVerifySign,const sbBlob_d * PpsDigest,const sbBlob_d * PpsSignature,
+                               pFCmdLibCallback_d PpfCallback, void* PpvCallbackCtx)
+{
+    sCmdLibContext_d* psContext = psCmdLibContext;
+    int32_t i4Status = CmdLib_ClaimContext(psContext,PpfCallback,PpvCallbackCtx);
+
+    if(CMD_LIB_OK == i4Status)
+    {
+        i4Status = CmdLib_StartCommand(psContext,CmdLib_FormatVerifySign(psContext,PpsVerifySign,PpsDigest,PpsSignature));
+        if(CMD_LIB_OK != i4Status)
+        {
+            print_debug("CmdLib_VerifySign: Error starting command");
+        }
+    }
+    return i4Status;
+}
+
+/**
+ * \brief Copies the generated public key and the exported private key to the output buffers.
+ */
+_STATIC_H int32_t CmdLib_GenerateKeyPairResponse(sCmdLibContext_d* PpsContext, int32_t Pi4Status)
+{
+/// @cond hidden
+	///Tag for public key
+	#define TAG_PUBLIC_KEY                  0x02
+/// @endcond	
+
+	int32_t i4Status = Pi4Status;
+	sCmdLibCommand_d* psCommand = &PpsContext->sCommand;
+	sOutKeyPair_d* psOutKeyPair = (sOutKeyPair_d*)psCommand->pvOutput;
 	uint16_t wLen;
 	uint16_t wParsLen;
-	uint8_t bMultiplier;
-	sApduData_d sApduData = {0};
-	uint8_t wAlgoLen;
 	sbBlob_d * psBlobKey = NULL;
 
+	do
+	{
+		if(CMD_LIB_OK != i4Status)
+		{
+			break;
+		}
+
+		wParsLen = LEN_APDUHEADER;
+
+		do
+		{
+			wLen = Utility_GetUint16(&psCommand->prgbResponse[wParsLen+BYTES_SEQ]);
+			psBlobKey = (TAG_PUBLIC_KEY == psCommand->prgbResponse[wParsLen])?&(psOutKeyPair->sPublicKey):&(psOutKeyPair->sPrivateKey);			
+			if(wLen > psBlobKey->wLen)
+			{
+				i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
+				break;
+			}
+			//Copy public key to output buffer
+			OCP_MEMCPY(psBlobKey->prgbStream,&psCommand->prgbResponse[TAG_VALUE_OFFSET + wParsLen] ,wLen);
+			psBlobKey->wLen = wLen;
+			wParsLen += (wLen + TAG_VALUE_OFFSET);
+
+		}while(wParsLen != psCommand->wResponseLength);
+	}while(FALSE);
+
+/// @cond hidden
+	#undef TAG_PUBLIC_KEY
+/// @endcond
+
+	return i4Status;
+}
+
+/**
+ * \brief Validates the GenerateKeyPair inputs and formats the command APDU.
+ */
+_STATIC_H int32_t CmdLib_FormatGenerateKeyPair(sCmdLibContext_d* PpsContext, const sKeyPairOption_d* PpsKeyPairOption,
+                                               sOutKeyPair_d* PpsOutKeyPair)
+{
 /// @cond hidden
-	///Tag for public key
-	#define TAG_PUBLIC_KEY                  0x02
 	///Minimum length of APDU InData in case of Private key store. [TLV Header(3) of OID + OID (2) + TLV Header(3) for key usage identifier  + Identifier (1)]
 	#define PRIV_KEY_APDU_INDATA_LEN		9
 	/// Encoding bytes for private and public key
 	#define KEY_PAIR_INDATA_LEN				4
 /// @endcond	
 
+	int32_t i4Status = (int32_t)CMD_LIB_ERROR;
+	sCmdLibCommand_d* psCommand = &PpsContext->sCommand;
+	uint16_t wWritePosition = 0;
+	uint16_t wCalApduLen;
+	uint8_t bMultiplier;
+	uint8_t wAlgoLen;
+
 	do
 	{
 		//NULL checks
@@ -2005,72 +2606,45 @@ int32_t CmdLib_GenerateKeyPair(const sKeyPairOption_d* PpsKeyPairOption,sOutKeyP
 		}
 
 		wCalApduLen += ((wAlgoLen * bMultiplier) + 2);
-		//Allocating Heap memory 
-		INIT_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer,wCalApduLen);
+		//Allocating Heap memory for the response
+		INIT_HEAP_APDUBUFFER(psCommand->prgbHeap,wCalApduLen);
 
 		//Set the pointer to the response buffer
-		sApduData.prgbRespBuffer = sApduData.prgbAPDUBuffer;
-		sApduData.wResponseLength = wCalApduLen;
+		psCommand->prgbResponse = psCommand->prgbHeap;
+		psCommand->wResponseLength = wCalApduLen;
 		if(eStorePrivKeyOnly == PpsKeyPairOption->eKeyExport)
 		{		
 			//Set private key OID tag, length, data
-			sApduData.prgbAPDUBuffer[LEN_APDUHEADER] = TAG_OID;
-			Utility_SetUint16(&sApduData.prgbAPDUBuffer[wWritePosition + TAG_LENGTH_OFFSET], LEN_PRI_KEY);
-			Utility_SetUint16(&sApduData.prgbAPDUBuffer[wWritePosition + TAG_VALUE_OFFSET], PpsKeyPairOption->wOIDPrivKey);
+			psCommand->rgbTags[wWritePosition] = TAG_OID;
+			Utility_SetUint16(&psCommand->rgbTags[wWritePosition + TAG_LENGTH_OFFSET], LEN_PRI_KEY);
+			Utility_SetUint16(&psCommand->rgbTags[wWritePosition + TAG_VALUE_OFFSET], PpsKeyPairOption->wOIDPrivKey);
 
 			wWritePosition += TAG_VALUE_OFFSET+ BYTES_OFFSET;
 
 			//Set key usage identifier tag, length, data
-			sApduData.prgbAPDUBuffer[wWritePosition] = TAG_KEY_USAGE_IDENTIFIER;
-			Utility_SetUint16(&sApduData.prgbAPDUBuffer[wWritePosition + TAG_LENGTH_OFFSET], LEN_KEY_USAGE_IDENTIFIER);
-			sApduData.prgbAPDUBuffer[wWritePosition + TAG_VALUE_OFFSET] = (uint8_t)PpsKeyPairOption->eKeyUsage;
+			psCommand->rgbTags[wWritePosition] = TAG_KEY_USAGE_IDENTIFIER;
+			Utility_SetUint16(&psCommand->rgbTags[wWritePosition + TAG_LENGTH_OFFSET], LEN_KEY_USAGE_IDENTIFIER);
+			psCommand->rgbTags[wWritePosition + TAG_VALUE_OFFSET] = (uint8_t)PpsKeyPairOption->eKeyUsage;
 			wWritePosition += TAG_VALUE_OFFSET + BYTES_SEQ;
 		}
 
 		if(eExportKeyPair == PpsKeyPairOption->eKeyExport)
 		{
 			//Set TLV values for extract key pair
-			sApduData.prgbAPDUBuffer[wWritePosition] = TAG_EXPORT_KEY_PAIR;
-			Utility_SetUint16(&sApduData.prgbAPDUBuffer[wWritePosition + TAG_LENGTH_OFFSET], LEN_EXPORT_KEY_PAIR);
+			psCommand->rgbTags[wWritePosition] = TAG_EXPORT_KEY_PAIR;
+			Utility_SetUint16(&psCommand->rgbTags[wWritePosition + TAG_LENGTH_OFFSET], LEN_EXPORT_KEY_PAIR);
 			wWritePosition += TAG_VALUE_OFFSET;
 		}
-		sApduData.wPayloadLength = (uint16_t)(wWritePosition - LEN_APDUHEADER);
+		psCommand->rgsSegments[1].prgbStream = psCommand->rgbTags;
+		psCommand->rgsSegments[1].wLen = wWritePosition;
+		psCommand->bSegments = 2;
 		//Form Command
-		sApduData.bCmd = CMD_GENERATE_KEY_PAIR;
-		sApduData.bParam = (uint8_t)PpsKeyPairOption->eAlgId;
-
-		//Transmit data
-		i4Status = TransceiveAPDU(&sApduData,TRUE);
-		if(CMD_LIB_OK != i4Status)
-		{
-			break;
-		}
-
-		wParsLen = LEN_APDUHEADER;
-
-		do
-		{
-			wLen = Utility_GetUint16(&sApduData.prgbRespBuffer[wParsLen+BYTES_SEQ]);
-			psBlobKey = (TAG_PUBLIC_KEY == sApduData.prgbRespBuffer[wParsLen])?&(PpsOutKeyPair->sPublicKey):&(PpsOutKeyPair->sPrivateKey);			
-			if(wLen > psBlobKey->wLen)
-			{
-				i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
-				break;
-			}
-			//Copy public key to output buffer
-			OCP_MEMCPY(psBlobKey->prgbStream,&sApduData.prgbRespBuffer[TAG_VALUE_OFFSET + wParsLen] ,wLen);
-			psBlobKey->wLen = wLen;
-			wParsLen += (wLen + TAG_VALUE_OFFSET);
-
-		}while(wParsLen != sApduData.wResponseLength);
-
+		CmdLib_SetHeader(psCommand,CMD_GENERATE_KEY_PAIR,(uint8_t)PpsKeyPairOption->eAlgId);
+		psCommand->pvOutput = PpsOutKeyPair;
+		psCommand->pfResponse = CmdLib_GenerateKeyPairResponse;
 	}while(FALSE);
 
-	//Free the allocated memory for buffer
-	FREE_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer);
-
 /// @cond hidden
-	#undef TAG_PUBLIC_KEY
 	#undef PRIV_KEY_APDU_INDATA_LEN
 	#undef KEY_PAIR_INDATA_LEN
 /// @endcond
@@ -2079,25 +2653,25 @@ int32_t CmdLib_GenerateKeyPair(const sKeyPairOption_d* PpsKeyPairOption,sOutKeyP
 }
 
 /**
-* Calculates signature on a digest by using the Security Chip.<br>
+* Generates a key pair by using the Security Chip.<br>
 *
 * Input:
-* - Provide the signature scheme. Use \ref sCalcSignOptions_d.eSignScheme.
-* - Provide the digest to be signed. Use \ref sCalcSignOptions_d.sDigestToSign.
-* - Provide the OID of the private key. Use \ref sCalcSignOptions_d.wOIDSignKey.
+* - Provide the required option for exporting the generated keys. Use \ref sKeyPairOption_d.eKeyExport
+*   - #eStorePrivKeyOnly indicates that only private key is stored in the OID and public key is exported.
+*   - #eExportKeyPair indicates that both public and private keys are exported.
 *
 * Output:
 * - Successful API execution,
-*   - Signature is returned in PpsSignature.<br>
+*   - Public key is returned in \ref sOutKeyPair_d.sPublicKey.
+*   - Private key is returned in \ref sOutKeyPair_d.sPrivateKey , if input is #eExportKeyPair.
 *
 * Notes:
 * - Application on security chip must be opened using #CmdLib_OpenApplication before using this API.
-* - If the the data to be sent to security chip is more than communication buffer,#CMD_LIB_INSUFFICIENT_MEMORY is returned. Refer OPTIGA_Trust_X_SolutionReferenceManual_v1.x.pdf for more details.
-* - If the memory buffer in PpsSignature is not sufficient to store the generated signature,#CMD_LIB_INSUFFICIENT_MEMORY is returned.
-
+* - Values of #eKeyUsage_d can be logically 'ORed' and passed to \ref sKeyPairOption_d.eKeyUsage.
+* - If the memory buffers in #sOutKeyPair_d is not sufficient to store the generated keys,#CMD_LIB_INSUFFICIENT_MEMORY is returned. Refer OPTIGA_Trust_X_SolutionReferenceManual_v1.x.pdf for more details.
 *
-* \param[in] PpsCalcSign Pointer to #sCalcSignOptions_d to provide input for signature generation
-* \param[in,out] PpsSignature Pointer to #sbBlob_d that contains generated signature
+* \param[in] PpsKeyPairOption Pointer to #sKeyPairOption_d to provide input for key pair generation
+* \param[in,out] PpsOutKeyPair Pointer to #sOutKeyPair_d that contains generated key pair
 *
 * \retval  #CMD_LIB_OK
 * \retval  #CMD_LIB_ERROR
@@ -2106,22 +2680,96 @@ int32_t CmdLib_GenerateKeyPair(const sKeyPairOption_d* PpsKeyPairOption,sOutKeyP
 * \retval  #CMD_DEV_EXEC_ERROR
 * \retval  #CMD_DEV_ERROR
 */
-int32_t CmdLib_CalculateSign(const sCalcSignOptions_d *PpsCalcSign,sbBlob_d *PpsSignature)
+int32_t CmdLib_GenerateKeyPair(const sKeyPairOption_d* PpsKeyPairOption,sOutKeyPair_d* PpsOutKeyPair)
 {
-	int32_t i4Status = (int32_t)CMD_LIB_ERROR;
-	uint16_t wWritePosition = LEN_APDUHEADER;
-	uint16_t wCalApduLen;
-	sApduData_d sApduData = {0};
+	sCmdLibContext_d* psContext = psCmdLibContext;
+
+	return CmdLib_WaitForCommand(psContext,NULL,CmdLib_GenerateKeyPairAsync(PpsKeyPairOption,PpsOutKeyPair,NULL,NULL));
+}
+
+/**
+* Starts the key pair generation by using the Security Chip, see #CmdLib_GenerateKeyPair.<br>
+*
+* Notes:
+* - The command is completed as described for #CmdLib_GetDataObjectAsync.<br>
+* - PpsOutKeyPair must stay valid until the callback is invoked.<br>
+*
+* \param[in] PpsKeyPairOption Pointer to #sKeyPairOption_d to provide input for key pair generation
+* \param[in,out] PpsOutKeyPair Pointer to #sOutKeyPair_d that contains generated key pair
+* \param[in] PpfCallback Callback invoked once the command is completed, can be NULL
+* \param[in] PpvCallbackCtx User context passed to PpfCallback
+*
+* \retval  #CMD_LIB_OK
+* \retval  #CMD_LIB_BUSY
+* \retval  #CMD_LIB_ERROR
+* \retval  #CMD_LIB_NULL_PARAM
+* \retval  #CMD_LIB_INSUFFICIENT_MEMORY
+* \retval  #CMD_DEV_EXEC_ERROR
+*/
+int32_t CmdLib_GenerateKeyPairAsync(const sKeyPairOption_d* PpsKeyPairOption,sOutKeyPair_d* PpsOutKeyPair,
+                                    pFCmdLibCallback_d PpfCallback, void* PpvCallbackCtx)
+{
+	sCmdLibContext_d* psContext = psCmdLibContext;
+	int32_t i4Status = CmdLib_ClaimContext(psContext,PpfCallback,PpvCallbackCtx);
+
+	if(CMD_LIB_OK == i4Status)
+	{
+		i4Status = CmdLib_StartCommand(psContext,CmdLib_FormatGenerateKeyPair(psContext,PpsKeyPairOption,PpsOutKeyPair));
+	}
+	return i4Status;
+}
 
+/**
+ * \brief Copies the signature received from the security chip.
+ */
+_STATIC_H int32_t CmdLib_CalculateSignResponse(sCmdLibContext_d* PpsContext, int32_t Pi4Status)
+{
+	int32_t i4Status = Pi4Status;
+	sCmdLibCommand_d* psCommand = &PpsContext->sCommand;
+	sbBlob_d* psSignature = (sbBlob_d*)psCommand->pvOutput;
+	uint16_t wRespLen;
 
     do
     {
-        //NULL checks
-        if((NULL == PpsCalcSign) || (NULL == PpsSignature->prgbStream) || (NULL == PpsCalcSign->sDigestToSign.prgbStream))
+        if(CMD_LIB_OK != i4Status)
         {
-            i4Status = (int32_t)CMD_LIB_NULL_PARAM;
             break;
-        }   
+        }
+        wRespLen = psCommand->wResponseLength - LEN_APDUHEADER;		
+        if(wRespLen > psSignature->wLen)
+        {
+            i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
+            break;
+        }
+        //Copy signature to output buffer
+        OCP_MEMCPY(psSignature->prgbStream,&psCommand->prgbResponse[LEN_APDUHEADER],wRespLen);
+        psSignature->wLen = wRespLen;
+    }while(FALSE);
+
+    return i4Status;
+}
+
+/**
+ * \brief Validates the CalculateSign inputs and formats the command APDU.
+ */
+_STATIC_H int32_t CmdLib_FormatCalculateSign(sCmdLibContext_d* PpsContext, const sCalcSignOptions_d *PpsCalcSign,
+                                             sbBlob_d *PpsSignature)
+{
+	int32_t i4Status = (int32_t)CMD_LIB_ERROR;
+	sCmdLibCommand_d* psCommand = &PpsContext->sCommand;
+	uint16_t wCalApduLen;
+	//Tag and length of the digest, TLV of the signature key OID
+	uint8_t* prgbDigestTag = psCommand->rgbTags;
+	uint8_t* prgbKeyTag = prgbDigestTag + TAG_VALUE_OFFSET;
+
+    do
+    {
+        //NULL checks
+        if((NULL == PpsCalcSign) || (NULL == PpsSignature->prgbStream) || (NULL == PpsCalcSign->sDigestToSign.prgbStream))
+        {
+            i4Status = (int32_t)CMD_LIB_NULL_PARAM;
+            break;
+        }   
 
 		
 /// @cond hidden
@@ -2133,61 +2781,44 @@ int32_t CmdLib_CalculateSign(const sCalcSignOptions_d *PpsCalcSign,sbBlob_d *Pps
 #define TX_LEN					(CALSIGN_APDU_LEN + PpsCalcSign->sDigestToSign.wLen)
 /// @endcond	
 		
-        //Calculate the size of memory to be allocated
-        wCalApduLen = LEN_APDUHEADER + (TX_LEN > SIGNATURE_LEN ? TX_LEN : SIGNATURE_LEN);
-        if((wMaxCommsBuffer) < wCalApduLen)
+        //Check the command fits in the communication buffer
+        wCalApduLen = LEN_APDUHEADER + TX_LEN;
+        if((PpsContext->wMaxCommsBuffer) < wCalApduLen)
         {
             i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
             break;
         }
 
-        //Allocating Heap memory 
-        INIT_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer,wCalApduLen);
+        //Allocating Heap memory for the response only, the digest is sent from the user buffer
+        INIT_HEAP_APDUBUFFER(psCommand->prgbHeap,LEN_APDUHEADER + SIGNATURE_LEN);
 
         //Set the pointer to the response buffer
-        sApduData.prgbRespBuffer = sApduData.prgbAPDUBuffer;
-        sApduData.wResponseLength = wCalApduLen;
+        psCommand->prgbResponse = psCommand->prgbHeap;
+        psCommand->wResponseLength = LEN_APDUHEADER + SIGNATURE_LEN;
 
         //Set digest tag, length, data
-        sApduData.prgbAPDUBuffer[LEN_APDUHEADER] = TAG_DIGEST;
-        Utility_SetUint16(&sApduData.prgbAPDUBuffer[wWritePosition + TAG_LENGTH_OFFSET], PpsCalcSign->sDigestToSign.wLen);
-        OCP_MEMCPY(&sApduData.prgbRespBuffer[TAG_VALUE_OFFSET + wWritePosition],PpsCalcSign->sDigestToSign.prgbStream,PpsCalcSign->sDigestToSign.wLen);
-        wWritePosition += TAG_VALUE_OFFSET + PpsCalcSign->sDigestToSign.wLen;
+        prgbDigestTag[0] = TAG_DIGEST;
+        Utility_SetUint16(&prgbDigestTag[TAG_LENGTH_OFFSET], PpsCalcSign->sDigestToSign.wLen);
+        psCommand->rgsSegments[1].prgbStream = prgbDigestTag;
+        psCommand->rgsSegments[1].wLen = TAG_VALUE_OFFSET;
+        psCommand->rgsSegments[2].prgbStream = PpsCalcSign->sDigestToSign.prgbStream;
+        psCommand->rgsSegments[2].wLen = PpsCalcSign->sDigestToSign.wLen;
 
         //Set OID of signature key tag, length, data
-        sApduData.prgbAPDUBuffer[wWritePosition] = TAG_OID_SIG_KEY;
-        Utility_SetUint16(&sApduData.prgbAPDUBuffer[wWritePosition + TAG_LENGTH_OFFSET], LEN_OID_SIG_KEY);
-        Utility_SetUint16(&sApduData.prgbAPDUBuffer[wWritePosition + TAG_VALUE_OFFSET], PpsCalcSign->wOIDSignKey);
-
-        wWritePosition += TAG_VALUE_OFFSET + LEN_OID_SIG_KEY;
+        prgbKeyTag[0] = TAG_OID_SIG_KEY;
+        Utility_SetUint16(&prgbKeyTag[TAG_LENGTH_OFFSET], LEN_OID_SIG_KEY);
+        Utility_SetUint16(&prgbKeyTag[TAG_VALUE_OFFSET], PpsCalcSign->wOIDSignKey);
+        psCommand->rgsSegments[3].prgbStream = prgbKeyTag;
+        psCommand->rgsSegments[3].wLen = TAG_VALUE_OFFSET + LEN_OID_SIG_KEY;
+        psCommand->bSegments = 4;
 
-        sApduData.wPayloadLength = (uint16_t)(wWritePosition - LEN_APDUHEADER);
         //Form Command
-        sApduData.bCmd = CMD_CALC_SIGN;
-        sApduData.bParam = (uint8_t)PpsCalcSign->eSignScheme;
-
-        //Transmit data
-        i4Status = TransceiveAPDU(&sApduData,TRUE);
-        if(CMD_LIB_OK != i4Status)
-        {
-            break;
-        }
-        sApduData.wResponseLength -= LEN_APDUHEADER;		
-        if(sApduData.wResponseLength > PpsSignature->wLen)
-        {
-            i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
-            break;
-        }
-        //Copy signature to output buffer
-        OCP_MEMCPY(PpsSignature->prgbStream,&sApduData.prgbRespBuffer[LEN_APDUHEADER],sApduData.wResponseLength);
-        PpsSignature->wLen = sApduData.wResponseLength;
-
+        CmdLib_SetHeader(psCommand,CMD_CALC_SIGN,(uint8_t)PpsCalcSign->eSignScheme);
+        psCommand->pvOutput = PpsSignature;
+        psCommand->pfResponse = CmdLib_CalculateSignResponse;
+        i4Status = (int32_t)CMD_LIB_OK;
     }while(FALSE);
 
-    //Free the allocated memory for buffer
-    FREE_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer);
-
-
 /// @cond hidden
 #undef CALSIGN_APDU_LEN
 #undef SIGNATURE_LEN
@@ -2197,28 +2828,25 @@ int32_t CmdLib_CalculateSign(const sCalcSignOptions_d *PpsCalcSign,sbBlob_d *Pps
 }
 
 /**
-* Generates a shared secret by using the Security Chip.<br>
+* Calculates signature on a digest by using the Security Chip.<br>
 *
 * Input:
-* - Provide the key agreement algorithm for generating shared secret. Use \ref sCalcSSecOptions_d.eKeyAgreementType.
-* - Provide the OID of private key. Use \ref sCalcSSecOptions_d.wOIDPrivKey.
-* - Provide the algorithm identifier of the public key. Use \ref sCalcSSecOptions_d.ePubKeyAlgId.
-* - Provide the public key. Use \ref sCalcSSecOptions_d.sPubKey.
-* - Provide the OID to store the shared secret. Use \ref sCalcSSecOptions_d.wOIDSharedSecret.
-*   - 0x0000 indicates that the shared secret is exported.
+* - Provide the signature scheme. Use \ref sCalcSignOptions_d.eSignScheme.
+* - Provide the digest to be signed. Use \ref sCalcSignOptions_d.sDigestToSign.
+* - Provide the OID of the private key. Use \ref sCalcSignOptions_d.wOIDSignKey.
 *
 * Output:
 * - Successful API execution,
-*   - Calculated shared secret is returned in PpsSecret if \ref sCalcSSecOptions_d.wOIDSharedSecret is 0x0000.
+*   - Signature is returned in PpsSignature.<br>
 *
 * Notes:
 * - Application on security chip must be opened using #CmdLib_OpenApplication before using this API.
 * - If the the data to be sent to security chip is more than communication buffer,#CMD_LIB_INSUFFICIENT_MEMORY is returned. Refer OPTIGA_Trust_X_SolutionReferenceManual_v1.x.pdf for more details.
-* - If the memory buffer in PpsSecret is not sufficient to store the calculated secret,#CMD_LIB_INSUFFICIENT_MEMORY is returned.
+* - If the memory buffer in PpsSignature is not sufficient to store the generated signature,#CMD_LIB_INSUFFICIENT_MEMORY is returned.
 
 *
-* \param[in] PpsCalcSSec Pointer to #sCalcSSecOptions_d to provide input for shared secret calculation
-* \param[in,out] PpsSecret Pointer to #sbBlob_d that contains calculated shared secret
+* \param[in] PpsCalcSign Pointer to #sCalcSignOptions_d to provide input for signature generation
+* \param[in,out] PpsSignature Pointer to #sbBlob_d that contains generated signature
 *
 * \retval  #CMD_LIB_OK
 * \retval  #CMD_LIB_ERROR
@@ -2227,12 +2855,109 @@ int32_t CmdLib_CalculateSign(const sCalcSignOptions_d *PpsCalcSign,sbBlob_d *Pps
 * \retval  #CMD_DEV_EXEC_ERROR
 * \retval  #CMD_DEV_ERROR
 */
-int32_t CmdLib_CalculateSharedSecret(const sCalcSSecOptions_d *PpsCalcSSec,sbBlob_d *PpsSecret)
+int32_t CmdLib_CalculateSign(const sCalcSignOptions_d *PpsCalcSign,sbBlob_d *PpsSignature)
+{
+	sCmdLibContext_d* psContext = psCmdLibContext;
+
+	return CmdLib_WaitForCommand(psContext,NULL,CmdLib_CalculateSignAsync(PpsCalcSign,PpsSignature,NULL,NULL));
+}
+
+/**
+* Starts the signature calculation on a digest by using the Security Chip, see #CmdLib_CalculateSign.<br>
+*
+* Notes:
+* - The command is completed as described for #CmdLib_GetDataObjectAsync.<br>
+* - The digest is sent from the user buffer. PpsCalcSign, the digest and PpsSignature must stay valid until the
+*   callback is invoked.<br>
+*
+* \param[in] PpsCalcSign Pointer to #sCalcSignOptions_d to provide input for signature generation
+* \param[in,out] PpsSignature Pointer to #sbBlob_d that contains generated signature
+* \param[in] PpfCallback Callback invoked once the command is completed, can be NULL
+* \param[in] PpvCallbackCtx User context passed to PpfCallback
+*
+* \retval  #CMD_LIB_OK
+* \retval  #CMD_LIB_BUSY
+* \retval  #CMD_LIB_NULL_PARAM
+* \retval  #CMD_LIB_INSUFFICIENT_MEMORY
+* \retval  #CMD_DEV_EXEC_ERROR
+*/
+int32_t CmdLib_CalculateSignAsync(const sCalcSignOptions_d *PpsCalcSign,sbBlob_d *PpsSignature,
+                                  pFCmdLibCallback_d PpfCallback, void* PpvCallbackCtx)
+{
+	sCmdLibContext_d* psContext = psCmdLibContext;
+	int32_t i4Status = CmdLib_ClaimContext(psContext,PpfCallback,PpvCallbackCtx);
+
+	if(CMD_LIB_OK == i4Status)
+	{
+		i4Status = CmdLib_StartCommand(psContext,CmdLib_FormatCalculateSign(psContext,PpsCalcSign,PpsSignature));
+	}
+	return i4Status;
+}
+
+/// @cond hidden
+///Minimum length of APDU InData in case of calculate shared secret. 
+///[TLV Header(3) of OID Private key + OID Private key (2) + TLV Header(3) for public key algoId + algoId (1) + TLV Header(3) for public key + TLV Header(3) for alternative ]
+#define CALCSSEC_APDU_LEN		15
+///Tag for public key
+#define TAG_PUBLIC_KEY			0x06
+///Len for privet key oid
+#define LEN_EXPORT_SHAR_SEC     0x0000
+///Len for share sec oid
+#define	LEN_OID_SHARE_SEC		0x0002
+///Share sec OID zero value
+#define	OID_SHARE_SEC_ZERO	    0x0000
+///Tag for export share secret
+#define TAG_EXPORT_SHARE_SEC    0x07
+///Tag for share secret oid
+#define TAG_OID_SHARE_SEC		0x08
+///Minimum length of APDU
+#define TX_LEN					(CALCSSEC_APDU_LEN + PpsCalcSSec->sPubKey.wLen + 2)
+/// @endcond	
+
+/**
+ * \brief Copies the shared secret received from the security chip, if it is exported.
+ */
+_STATIC_H int32_t CmdLib_CalculateSharedSecretResponse(sCmdLibContext_d* PpsContext, int32_t Pi4Status)
+{
+	int32_t i4Status = Pi4Status;
+	sCmdLibCommand_d* psCommand = &PpsContext->sCommand;
+	const sCalcSSecOptions_d* psCalcSSec = (const sCalcSSecOptions_d*)psCommand->pvInput;
+	sbBlob_d* psSecret = (sbBlob_d*)psCommand->pvOutput;
+	uint16_t wRespLen;
+
+    do
+    {
+        if(CMD_LIB_OK != i4Status)
+        {
+            break;
+        }
+        wRespLen = psCommand->wResponseLength - LEN_APDUHEADER;		
+        if(OID_SHARE_SEC_ZERO == psCalcSSec->wOIDSharedSecret)
+        {
+            if(wRespLen > psSecret->wLen)
+            {
+                i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
+                break;
+            }
+            //Copy signature to output buffer
+            OCP_MEMCPY(psSecret->prgbStream,&psCommand->prgbResponse[LEN_APDUHEADER],wRespLen);
+            psSecret->wLen = wRespLen;
+        }
+    }while(FALSE);
+
+    return i4Status;
+}
+
+/**
+ * \brief Validates the CalculateSharedSecret inputs and formats the command APDU.
+ */
+_STATIC_H int32_t CmdLib_FormatCalculateSharedSecret(sCmdLibContext_d* PpsContext, const sCalcSSecOptions_d *PpsCalcSSec,
+                                                     sbBlob_d *PpsSecret)
 {
 	int32_t i4Status = (int32_t)CMD_LIB_ERROR;
-	uint16_t wWritePosition = LEN_APDUHEADER;
+	sCmdLibCommand_d* psCommand = &PpsContext->sCommand;
+	uint16_t wWritePosition = 0;
 	uint16_t wCalApduLen = 0;
-	sApduData_d sApduData = {0};
 
     do
     {
@@ -2243,26 +2968,6 @@ int32_t CmdLib_CalculateSharedSecret(const sCalcSSecOptions_d *PpsCalcSSec,sbBlo
             break;
         }   
 
-        /// @cond hidden
-        ///Minimum length of APDU InData in case of calculate shared secret. 
-		///[TLV Header(3) of OID Private key + OID Private key (2) + TLV Header(3) for public key algoId + algoId (1) + TLV Header(3) for public key + TLV Header(3) for alternative ]
-        #define CALCSSEC_APDU_LEN		15
-        ///Tag for public key
-        #define TAG_PUBLIC_KEY			0x06
-        ///Len for privet key oid
-        #define LEN_EXPORT_SHAR_SEC     0x0000
-        ///Len for share sec oid
-        #define	LEN_OID_SHARE_SEC		0x0002
-        ///Share sec OID zero value
-        #define	OID_SHARE_SEC_ZERO	    0x0000
-		///Tag for export share secret
-		#define TAG_EXPORT_SHARE_SEC    0x07
-		///Tag for share secret oid
-		#define TAG_OID_SHARE_SEC		0x08
-        ///Minimum length of APDU
-        #define TX_LEN					(CALCSSEC_APDU_LEN + PpsCalcSSec->sPubKey.wLen + 2)
-        /// @endcond	
-
 		//Considering the size of Indata for allocating memory as this size is also sufficient for storing the response
         wCalApduLen = LEN_APDUHEADER + TX_LEN;
         //NULL checks
@@ -2277,118 +2982,103 @@ int32_t CmdLib_CalculateSharedSecret(const sCalcSSecOptions_d *PpsCalcSSec,sbBlo
         }
 
 		//Check max comms buffer size
-        if((wMaxCommsBuffer) < wCalApduLen)
+        if((PpsContext->wMaxCommsBuffer) < wCalApduLen)
         {
             i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
             break;
         }
 
-        //Allocating Heap memory 
-        INIT_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer,wCalApduLen);
+        //Allocating Heap memory for the response, the public key is sent from the user buffer
+        INIT_HEAP_APDUBUFFER(psCommand->prgbHeap,wCalApduLen);
 
         //Set the pointer to the response buffer
-        sApduData.prgbRespBuffer = sApduData.prgbAPDUBuffer;
-        sApduData.wResponseLength = wCalApduLen;
+        psCommand->prgbResponse = psCommand->prgbHeap;
+        psCommand->wResponseLength = wCalApduLen;
 
         //Set privet key tag, length, data
-        sApduData.prgbAPDUBuffer[LEN_APDUHEADER] = TAG_OID;
-        Utility_SetUint16(&sApduData.prgbAPDUBuffer[wWritePosition + TAG_LENGTH_OFFSET],LEN_PRI_KEY);
-        Utility_SetUint16(&sApduData.prgbAPDUBuffer[wWritePosition + TAG_VALUE_OFFSET],PpsCalcSSec->wOIDPrivKey);
+        psCommand->rgbTags[wWritePosition] = TAG_OID;
+        Utility_SetUint16(&psCommand->rgbTags[wWritePosition + TAG_LENGTH_OFFSET],LEN_PRI_KEY);
+        Utility_SetUint16(&psCommand->rgbTags[wWritePosition + TAG_VALUE_OFFSET],PpsCalcSSec->wOIDPrivKey);
         wWritePosition += TAG_VALUE_OFFSET + LEN_PRI_KEY;
 
         //Set public key algoId tag, length, data
-        sApduData.prgbAPDUBuffer[wWritePosition] = TAG_ALGO_IDENTIFIER;
-        Utility_SetUint16(&sApduData.prgbAPDUBuffer[wWritePosition + TAG_LENGTH_OFFSET],LEN_ALGO_IDENTIFIER);
-        sApduData.prgbAPDUBuffer[wWritePosition + TAG_VALUE_OFFSET] = (uint8_t)PpsCalcSSec->ePubKeyAlgId;
+        psCommand->rgbTags[wWritePosition] = TAG_ALGO_IDENTIFIER;
+        Utility_SetUint16(&psCommand->rgbTags[wWritePosition + TAG_LENGTH_OFFSET],LEN_ALGO_IDENTIFIER);
+        psCommand->rgbTags[wWritePosition + TAG_VALUE_OFFSET] = (uint8_t)PpsCalcSSec->ePubKeyAlgId;
         wWritePosition += TAG_VALUE_OFFSET + LEN_ALGO_IDENTIFIER;
 
         //Set public key tag, length, data
-        sApduData.prgbAPDUBuffer[wWritePosition] = TAG_PUBLIC_KEY;
-        Utility_SetUint16(&sApduData.prgbAPDUBuffer[wWritePosition + TAG_LENGTH_OFFSET],PpsCalcSSec->sPubKey.wLen);
-        OCP_MEMCPY(&sApduData.prgbRespBuffer[TAG_VALUE_OFFSET + wWritePosition],PpsCalcSSec->sPubKey.prgbStream,PpsCalcSSec->sPubKey.wLen);
-        wWritePosition += TAG_VALUE_OFFSET + PpsCalcSSec->sPubKey.wLen;
-
+        psCommand->rgbTags[wWritePosition] = TAG_PUBLIC_KEY;
+        Utility_SetUint16(&psCommand->rgbTags[wWritePosition + TAG_LENGTH_OFFSET],PpsCalcSSec->sPubKey.wLen);
+        wWritePosition += TAG_VALUE_OFFSET;
+        psCommand->rgsSegments[1].prgbStream = psCommand->rgbTags;
+        psCommand->rgsSegments[1].wLen = wWritePosition;
+        psCommand->rgsSegments[2].prgbStream = PpsCalcSSec->sPubKey.prgbStream;
+        psCommand->rgsSegments[2].wLen = PpsCalcSSec->sPubKey.wLen;
+
+        psCommand->rgsSegments[3].prgbStream = &psCommand->rgbTags[wWritePosition];
         if(OID_SHARE_SEC_ZERO == PpsCalcSSec->wOIDSharedSecret)
         {
             //Set export share sec tag, length, data
-            sApduData.prgbAPDUBuffer[wWritePosition] = TAG_EXPORT_SHARE_SEC;
-            Utility_SetUint16(&sApduData.prgbAPDUBuffer[wWritePosition + TAG_LENGTH_OFFSET], LEN_EXPORT_SHAR_SEC);
-            wWritePosition += TAG_VALUE_OFFSET;
+            psCommand->rgbTags[wWritePosition] = TAG_EXPORT_SHARE_SEC;
+            Utility_SetUint16(&psCommand->rgbTags[wWritePosition + TAG_LENGTH_OFFSET], LEN_EXPORT_SHAR_SEC);
+            psCommand->rgsSegments[3].wLen = TAG_VALUE_OFFSET;
         }
         else
         {
             //Set OID of signature key tag, length, data
-            sApduData.prgbAPDUBuffer[wWritePosition] = TAG_OID_SHARE_SEC;
-            Utility_SetUint16(&sApduData.prgbAPDUBuffer[wWritePosition + TAG_LENGTH_OFFSET], LEN_OID_SHARE_SEC);
-            Utility_SetUint16(&sApduData.prgbAPDUBuffer[wWritePosition + TAG_VALUE_OFFSET], PpsCalcSSec->wOIDSharedSecret);
-            wWritePosition += TAG_VALUE_OFFSET + LEN_OID_SHARE_SEC;
+            psCommand->rgbTags[wWritePosition] = TAG_OID_SHARE_SEC;
+            Utility_SetUint16(&psCommand->rgbTags[wWritePosition + TAG_LENGTH_OFFSET], LEN_OID_SHARE_SEC);
+            Utility_SetUint16(&psCommand->rgbTags[wWritePosition + TAG_VALUE_OFFSET], PpsCalcSSec->wOIDSharedSecret);
+            psCommand->rgsSegments[3].wLen = TAG_VALUE_OFFSET + LEN_OID_SHARE_SEC;
         }
+        psCommand->bSegments = 4;
 
-        sApduData.wPayloadLength = (uint16_t)(wWritePosition - LEN_APDUHEADER);
         //Form Command
-        sApduData.bCmd = CMD_CALC_SHARED_SEC;
-        sApduData.bParam = (uint8_t)PpsCalcSSec->eKeyAgreementType;
-
-        //Transmit data
-        i4Status = TransceiveAPDU(&sApduData,TRUE);
-        if(CMD_LIB_OK != i4Status)
-        {
-            break;
-        }
-
-        sApduData.wResponseLength -= LEN_APDUHEADER;		
-        if(OID_SHARE_SEC_ZERO == PpsCalcSSec->wOIDSharedSecret)
-        {
-            if(sApduData.wResponseLength > PpsSecret->wLen)
-            {
-                i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
-                break;
-            }
-            //Copy signature to output buffer
-            OCP_MEMCPY(PpsSecret->prgbStream,&sApduData.prgbRespBuffer[LEN_APDUHEADER],sApduData.wResponseLength);
-            PpsSecret->wLen = sApduData.wResponseLength;
-        }
+        CmdLib_SetHeader(psCommand,CMD_CALC_SHARED_SEC,(uint8_t)PpsCalcSSec->eKeyAgreementType);
+        psCommand->pvInput = PpsCalcSSec;
+        psCommand->pvOutput = PpsSecret;
+        psCommand->pfResponse = CmdLib_CalculateSharedSecretResponse;
+        i4Status = (int32_t)CMD_LIB_OK;
     }while(FALSE);
 
-    //Free the allocated memory for buffer
-    FREE_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer);
-
-    /// @cond hidden
-	#undef CALCSSEC_APDU_LEN
-	#undef TAG_PUBLIC_KEY
-	#undef LEN_EXPORT_SHAR_SEC
-	#undef LEN_OID_SHARE_SEC
-	#undef OID_SHARE_SEC_ZERO
-	#undef TAG_EXPORT_SHARE_SEC
-	#undef TAG_OID_SHARE_SEC
-    #undef TX_LEN
-    /// @endcond
     return i4Status;	
 }
 
+/// @cond hidden
+#undef CALCSSEC_APDU_LEN
+#undef TAG_PUBLIC_KEY
+#undef LEN_EXPORT_SHAR_SEC
+#undef LEN_OID_SHARE_SEC
+#undef OID_SHARE_SEC_ZERO
+#undef TAG_EXPORT_SHARE_SEC
+#undef TAG_OID_SHARE_SEC
+#undef TX_LEN
+/// @endcond
+
 /**
-* Derives a session key by using the Security Chip.<br>
+* Generates a shared secret by using the Security Chip.<br>
 *
 * Input:
-* - Provide the key derivation method. Use \ref sDeriveKeyOptions_d.eKDM.
-* - Provide the OID of the shared secret. Use \ref sDeriveKeyOptions_d.wOIDSharedSecret.
-* - Provide the input seed. Use \ref sDeriveKeyOptions_d.sSeed.
-* - Provide the length for derived key. Use \ref sDeriveKeyOptions_d.wDerivedKeyLen.
-* - Provide the OID to store the derived key. Use \ref sDeriveKeyOptions_d.wOIDDerivedKey.
-*   - 0x0000 indicates that the derived key is exported.
+* - Provide the key agreement algorithm for generating shared secret. Use \ref sCalcSSecOptions_d.eKeyAgreementType.
+* - Provide the OID of private key. Use \ref sCalcSSecOptions_d.wOIDPrivKey.
+* - Provide the algorithm identifier of the public key. Use \ref sCalcSSecOptions_d.ePubKeyAlgId.
+* - Provide the public key. Use \ref sCalcSSecOptions_d.sPubKey.
+* - Provide the OID to store the shared secret. Use \ref sCalcSSecOptions_d.wOIDSharedSecret.
+*   - 0x0000 indicates that the shared secret is exported.
 *
 * Output:
 * - Successful API execution,
-*   - Derived key is returned in PpsKey if \ref sDeriveKeyOptions_d.wOIDDerivedKey is 0x0000.
+*   - Calculated shared secret is returned in PpsSecret if \ref sCalcSSecOptions_d.wOIDSharedSecret is 0x0000.
 *
 * Notes:
 * - Application on security chip must be opened using #CmdLib_OpenApplication before using this API.
 * - If the the data to be sent to security chip is more than communication buffer,#CMD_LIB_INSUFFICIENT_MEMORY is returned. Refer OPTIGA_Trust_X_SolutionReferenceManual_v1.x.pdf for more details.
-* - If the memory buffer in PpsKey is not sufficient to store the derived key,#CMD_LIB_INSUFFICIENT_MEMORY is returned.
+* - If the memory buffer in PpsSecret is not sufficient to store the calculated secret,#CMD_LIB_INSUFFICIENT_MEMORY is returned.
 
 *
-* \param[in] PpsDeriveKey	Pointer to #sDeriveKeyOptions_d to provide input for session key generation
-* \param[in,out] PpsKey		Pointer to #sbBlob_d that contains the derived key
+* \param[in] PpsCalcSSec Pointer to #sCalcSSecOptions_d to provide input for shared secret calculation
+* \param[in,out] PpsSecret Pointer to #sbBlob_d that contains calculated shared secret
 *
 * \retval  #CMD_LIB_OK
 * \retval  #CMD_LIB_ERROR
@@ -2397,14 +3087,111 @@ int32_t CmdLib_CalculateSharedSecret(const sCalcSSecOptions_d *PpsCalcSSec,sbBlo
 * \retval  #CMD_DEV_EXEC_ERROR
 * \retval  #CMD_DEV_ERROR
 */
-int32_t CmdLib_DeriveKey(const sDeriveKeyOptions_d *PpsDeriveKey,sbBlob_d *PpsKey)
+int32_t CmdLib_CalculateSharedSecret(const sCalcSSecOptions_d *PpsCalcSSec,sbBlob_d *PpsSecret)
+{
+	sCmdLibContext_d* psContext = psCmdLibContext;
+
+	return CmdLib_WaitForCommand(psContext,NULL,CmdLib_CalculateSharedSecretAsync(PpsCalcSSec,PpsSecret,NULL,NULL));
+}
+
+/**
+* Starts the shared secret calculation by using the Security Chip, see #CmdLib_CalculateSharedSecret.<br>
+*
+* Notes:
+* - The command is completed as described for #CmdLib_GetDataObjectAsync.<br>
+* - The public key is sent from the user buffer. PpsCalcSSec, the public key and PpsSecret must stay valid until
+*   the callback is invoked.<br>
+*
+* \param[in] PpsCalcSSec Pointer to #sCalcSSecOptions_d to provide input for shared secret calculation
+* \param[in,out] PpsSecret Pointer to #sbBlob_d that contains calculated shared secret
+* \param[in] PpfCallback Callback invoked once the command is completed, can be NULL
+* \param[in] PpvCallbackCtx User context passed to PpfCallback
+*
+* \retval  #CMD_LIB_OK
+* \retval  #CMD_LIB_BUSY
+* \retval  #CMD_LIB_NULL_PARAM
+* \retval  #CMD_LIB_INSUFFICIENT_MEMORY
+* \retval  #CMD_DEV_EXEC_ERROR
+*/
+int32_t CmdLib_CalculateSharedSecretAsync(const sCalcSSecOptions_d *PpsCalcSSec,sbBlob_d *PpsSecret,
+                                          pFCmdLibCallback_d PpfCallback, void* PpvCallbackCtx)
+{
+	sCmdLibContext_d* psContext = psCmdLibContext;
+	int32_t i4Status = CmdLib_ClaimContext(psContext,PpfCallback,PpvCallbackCtx);
+
+	if(CMD_LIB_OK == i4Status)
+	{
+		i4Status = CmdLib_StartCommand(psContext,CmdLib_FormatCalculateSharedSecret(psContext,PpsCalcSSec,PpsSecret));
+	}
+	return i4Status;
+}
+
+/// @cond hidden
+///Minimum length of APDU InData in case of calculate shared secret. 
+///[TLV Header(3) of OID share secret + OID share secret (2) + TLV Header(3) for seed + TLV Header(3) for derive secret length + derive secret length(2) + TLV Header(3) for alternative ]
+#define DERIVEKEY_APDU_LEN		16
+///Tag for derive key
+#define TAG_DERIVE_KEY			0x03
+///Len for export derive key
+#define LEN_EXPORT_DERIVE_KEY   0x0000
+///Len for share sec oid
+#define	LEN_DERIVE_KEY			0x0002
+///Derive key OID zero value
+#define	OID_DERIVE_SEC_ZERO	    0x0000
+///Tag for export derive share secret
+#define TAG_EXPORT_DERIVE_KEY   0x07
+///Tag for derive key oid
+#define TAG_OID_DERIVE_KEY		0x08
+///Minimum length of APDU
+#define TX_LEN					(DERIVEKEY_APDU_LEN + 2)
+/// @endcond	
+
+/**
+ * \brief Copies the derived key received from the security chip, if it is exported.
+ */
+_STATIC_H int32_t CmdLib_DeriveKeyResponse(sCmdLibContext_d* PpsContext, int32_t Pi4Status)
+{
+	int32_t i4Status = Pi4Status;
+	sCmdLibCommand_d* psCommand = &PpsContext->sCommand;
+	const sDeriveKeyOptions_d* psDeriveKey = (const sDeriveKeyOptions_d*)psCommand->pvInput;
+	sbBlob_d* psKey = (sbBlob_d*)psCommand->pvOutput;
+	uint16_t wRespLen;
+
+    do
+    {
+        if(CMD_LIB_OK != i4Status)
+        {
+            print_debug("Error: transceive APDU");
+            break;
+        }
+        wRespLen = psCommand->wResponseLength - LEN_APDUHEADER;		
+        if(OID_DERIVE_SEC_ZERO == psDeriveKey->wOIDDerivedKey)
+        {
+            if(wRespLen > psKey->wLen)
+            {
+                i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
+                print_debug("Got response but insufficient memory");
+                break;
+            }
+            //Copy signature to output buffer
+            OCP_MEMCPY(psKey->prgbStream,&psCommand->prgbResponse[LEN_APDUHEADER],wRespLen);
+            psKey->wLen = wRespLen;
+        }
+    }while(FALSE);
+
+    return i4Status;
+}
+
+/**
+ * \brief Validates the DeriveKey inputs and formats the command APDU.
+ */
+_STATIC_H int32_t CmdLib_FormatDeriveKey(sCmdLibContext_d* PpsContext, const sDeriveKeyOptions_d *PpsDeriveKey,
+                                         sbBlob_d *PpsKey)
 {
 	int32_t i4Status = (int32_t)CMD_LIB_ERROR;
-	uint16_t wWritePosition = LEN_APDUHEADER;
+	sCmdLibCommand_d* psCommand = &PpsContext->sCommand;
+	uint16_t wWritePosition = 0;
 	uint16_t wCalApduLen = 0;
-	sApduData_d sApduData = {0};
-
-	//print_debug(">CmdLib_DeriveKey");
 
     do
     {
@@ -2416,26 +3203,6 @@ int32_t CmdLib_DeriveKey(const sDeriveKeyOptions_d *PpsDeriveKey,sbBlob_d *PpsKe
             break;
         }   
 
-        /// @cond hidden
-        ///Minimum length of APDU InData in case of calculate shared secret. 
-		///[TLV Header(3) of OID share secret + OID share secret (2) + TLV Header(3) for seed + TLV Header(3) for derive secret length + derive secret length(2) + TLV Header(3) for alternative ]
-        #define DERIVEKEY_APDU_LEN		16
-        ///Tag for derive key
-        #define TAG_DERIVE_KEY			0x03
-        ///Len for export derive key
-        #define LEN_EXPORT_DERIVE_KEY   0x0000
-        ///Len for share sec oid
-        #define	LEN_DERIVE_KEY			0x0002
-        ///Derive key OID zero value
-        #define	OID_DERIVE_SEC_ZERO	    0x0000
-		///Tag for export derive share secret
-		#define TAG_EXPORT_DERIVE_KEY   0x07
-		///Tag for derive key oid
-		#define TAG_OID_DERIVE_KEY		0x08
-        ///Minimum length of APDU
-        #define TX_LEN					(DERIVEKEY_APDU_LEN + 2)
-        /// @endcond	
-
         //Considering the size of Indata for allocating memory as this size is also sufficient for storing the response
         wCalApduLen = LEN_APDUHEADER + TX_LEN + (PpsDeriveKey->sSeed.wLen > PpsDeriveKey->wDerivedKeyLen ? PpsDeriveKey->sSeed.wLen : PpsDeriveKey->wDerivedKeyLen);
         //NULL checks
@@ -2451,99 +3218,152 @@ int32_t CmdLib_DeriveKey(const sDeriveKeyOptions_d *PpsDeriveKey,sbBlob_d *PpsKe
         }
 
         //Check max comms buffer size
-        if((wMaxCommsBuffer) < wCalApduLen)
+        if((PpsContext->wMaxCommsBuffer) < wCalApduLen)
         {
             i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
             print_debug("Error: Insufficient memory");
             break;
         }
 
-        //Allocating Heap memory 
-        INIT_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer,wCalApduLen);
+        //Allocating Heap memory for the response, the seed is sent from the user buffer
+        INIT_HEAP_APDUBUFFER(psCommand->prgbHeap,wCalApduLen);
 
         //Set the pointer to the response buffer
-        sApduData.prgbRespBuffer = sApduData.prgbAPDUBuffer;
-        sApduData.wResponseLength = wCalApduLen;
+        psCommand->prgbResponse = psCommand->prgbHeap;
+        psCommand->wResponseLength = wCalApduLen;
 
         //Set share secret key tag, length, data
-        sApduData.prgbAPDUBuffer[LEN_APDUHEADER] = TAG_OID;
-        Utility_SetUint16(&sApduData.prgbAPDUBuffer[wWritePosition + TAG_LENGTH_OFFSET],LEN_SHARED_SECRET_OID);
-        Utility_SetUint16(&sApduData.prgbAPDUBuffer[wWritePosition + TAG_VALUE_OFFSET],PpsDeriveKey->wOIDSharedSecret);
+        psCommand->rgbTags[wWritePosition] = TAG_OID;
+        Utility_SetUint16(&psCommand->rgbTags[wWritePosition + TAG_LENGTH_OFFSET],LEN_SHARED_SECRET_OID);
+        Utility_SetUint16(&psCommand->rgbTags[wWritePosition + TAG_VALUE_OFFSET],PpsDeriveKey->wOIDSharedSecret);
         wWritePosition += TAG_VALUE_OFFSET + LEN_PRI_KEY;
 
-        //Set public key algoId tag, length, data
-        sApduData.prgbAPDUBuffer[wWritePosition] = TAG_SEED;
-        Utility_SetUint16(&sApduData.prgbAPDUBuffer[wWritePosition + TAG_LENGTH_OFFSET],PpsDeriveKey->sSeed.wLen);
-        OCP_MEMCPY(&sApduData.prgbRespBuffer[TAG_VALUE_OFFSET + wWritePosition],PpsDeriveKey->sSeed.prgbStream,PpsDeriveKey->sSeed.wLen);
-        wWritePosition += TAG_VALUE_OFFSET + PpsDeriveKey->sSeed.wLen;
-
-        //Set public key tag, length, data
-        sApduData.prgbAPDUBuffer[wWritePosition] = TAG_DERIVE_KEY;
-        Utility_SetUint16(&sApduData.prgbAPDUBuffer[wWritePosition + TAG_LENGTH_OFFSET],LEN_DERIVE_KEY);
-        Utility_SetUint16(&sApduData.prgbAPDUBuffer[wWritePosition + TAG_VALUE_OFFSET],PpsDeriveKey->wDerivedKeyLen);
+        //Set seed tag, length, data
+        psCommand->rgbTags[wWritePosition] = TAG_SEED;
+        Utility_SetUint16(&psCommand->rgbTags[wWritePosition + TAG_LENGTH_OFFSET],PpsDeriveKey->sSeed.wLen);
+        wWritePosition += TAG_VALUE_OFFSET;
+        psCommand->rgsSegments[1].prgbStream = psCommand->rgbTags;
+        psCommand->rgsSegments[1].wLen = wWritePosition;
+        psCommand->rgsSegments[2].prgbStream = PpsDeriveKey->sSeed.prgbStream;
+        psCommand->rgsSegments[2].wLen = PpsDeriveKey->sSeed.wLen;
+        psCommand->rgsSegments[3].prgbStream = &psCommand->rgbTags[wWritePosition];
+
+        //Set derived key length tag, length, data
+        psCommand->rgbTags[wWritePosition] = TAG_DERIVE_KEY;
+        Utility_SetUint16(&psCommand->rgbTags[wWritePosition + TAG_LENGTH_OFFSET],LEN_DERIVE_KEY);
+        Utility_SetUint16(&psCommand->rgbTags[wWritePosition + TAG_VALUE_OFFSET],PpsDeriveKey->wDerivedKeyLen);
+        psCommand->rgsSegments[3].wLen = TAG_VALUE_OFFSET + LEN_DERIVE_KEY;
         wWritePosition += TAG_VALUE_OFFSET + LEN_DERIVE_KEY;
 
         if(OID_DERIVE_SEC_ZERO == PpsDeriveKey->wOIDDerivedKey)
         {
             //Set export share sec tag, length, data
-            sApduData.prgbAPDUBuffer[wWritePosition] = TAG_EXPORT_DERIVE_KEY;
-            Utility_SetUint16(&sApduData.prgbAPDUBuffer[wWritePosition + TAG_LENGTH_OFFSET], LEN_EXPORT_DERIVE_KEY);
-            wWritePosition += TAG_VALUE_OFFSET;
-            //print_debug("Exporting Derive data");
+            psCommand->rgbTags[wWritePosition] = TAG_EXPORT_DERIVE_KEY;
+            Utility_SetUint16(&psCommand->rgbTags[wWritePosition + TAG_LENGTH_OFFSET], LEN_EXPORT_DERIVE_KEY);
+            psCommand->rgsSegments[3].wLen += TAG_VALUE_OFFSET;
         }
         else
         {
             //Set OID of signature key tag, length, data
-            sApduData.prgbAPDUBuffer[wWritePosition] = TAG_OID_DERIVE_KEY;
-            Utility_SetUint16(&sApduData.prgbAPDUBuffer[wWritePosition + TAG_LENGTH_OFFSET], LEN_DERIVE_KEY);
-			Utility_SetUint16(&sApduData.prgbAPDUBuffer[wWritePosition + TAG_VALUE_OFFSET], PpsDeriveKey->wOIDDerivedKey);
-            wWritePosition += TAG_VALUE_OFFSET + LEN_DERIVE_KEY;
+            psCommand->rgbTags[wWritePosition] = TAG_OID_DERIVE_KEY;
+            Utility_SetUint16(&psCommand->rgbTags[wWritePosition + TAG_LENGTH_OFFSET], LEN_DERIVE_KEY);
+			Utility_SetUint16(&psCommand->rgbTags[wWritePosition + TAG_VALUE_OFFSET], PpsDeriveKey->wOIDDerivedKey);
+            psCommand->rgsSegments[3].wLen += TAG_VALUE_OFFSET + LEN_DERIVE_KEY;
         }
+        psCommand->bSegments = 4;
 
-        sApduData.wPayloadLength = (uint16_t)(wWritePosition - LEN_APDUHEADER);
         //Form Command
-        sApduData.bCmd = CMD_DERIVE_KEY;
-        sApduData.bParam = (uint8_t)PpsDeriveKey->eKDM;
-
-        //Transmit data
-        i4Status = TransceiveAPDU(&sApduData,TRUE);
-        if(CMD_LIB_OK != i4Status)
-        {
-        	print_debug("Error: transceive APDU");
-            break;
-        }
-
-        sApduData.wResponseLength -= LEN_APDUHEADER;		
-        if(OID_DERIVE_SEC_ZERO == PpsDeriveKey->wOIDDerivedKey)
-        {
-            if(sApduData.wResponseLength > PpsKey->wLen)
-            {
-                i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
-                print_debug("Got response but insufficient memory");
-                break;
-            }
-            //Copy signature to output buffer
-            OCP_MEMCPY(PpsKey->prgbStream,&sApduData.prgbRespBuffer[LEN_APDUHEADER],sApduData.wResponseLength);
-            PpsKey->wLen = sApduData.wResponseLength;
-        }
+        CmdLib_SetHeader(psCommand,CMD_DERIVE_KEY,(uint8_t)PpsDeriveKey->eKDM);
+        psCommand->pvInput = PpsDeriveKey;
+        psCommand->pvOutput = PpsKey;
+        psCommand->pfResponse = CmdLib_DeriveKeyResponse;
+        i4Status = (int32_t)CMD_LIB_OK;
     }while(FALSE);
 
-    //Free the allocated memory for buffer
-    FREE_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer);
-
-    /// @cond hidden
-	#undef DERIVEKEY_APDU_LEN
-	#undef TAG_DERIVE_KEY
-	#undef LEN_EXPORT_DERIVE_KEY
-	#undef LEN_DERIVE_KEY
-	#undef OID_DERIVE_SEC_ZERO
-	#undef TAG_EXPORT_DERIVE_KEY
-	#undef TAG_OID_DERIVE_KEY
-    #undef TX_LEN
-    /// @endcond
     return i4Status;
 }
 
+/// @cond hidden
+#undef DERIVEKEY_APDU_LEN
+#undef TAG_DERIVE_KEY
+#undef LEN_EXPORT_DERIVE_KEY
+#undef LEN_DERIVE_KEY
+#undef OID_DERIVE_SEC_ZERO
+#undef TAG_EXPORT_DERIVE_KEY
+#undef TAG_OID_DERIVE_KEY
+#undef TX_LEN
+/// @endcond
+
+/**
+* Derives a session key by using the Security Chip.<br>
+*
+* Input:
+* - Provide the key derivation method. Use \ref sDeriveKeyOptions_d.eKDM.
+* - Provide the OID of the shared secret. Use \ref sDeriveKeyOptions_d.wOIDSharedSecret.
+* - Provide the input seed. Use \ref sDeriveKeyOptions_d.sSeed.
+* - Provide the length for derived key. Use \ref sDeriveKeyOptions_d.wDerivedKeyLen.
+* - Provide the OID to store the derived key. Use \ref sDeriveKeyOptions_d.wOIDDerivedKey.
+*   - 0x0000 indicates that the derived key is exported.
+*
+* Output:
+* - Successful API execution,
+*   - Derived key is returned in PpsKey if \ref sDeriveKeyOptions_d.wOIDDerivedKey is 0x0000.
+*
+* Notes:
+* - Application on security chip must be opened using #CmdLib_OpenApplication before using this API.
+* - If the the data to be sent to security chip is more than communication buffer,#CMD_LIB_INSUFFICIENT_MEMORY is returned. Refer OPTIGA_Trust_X_SolutionReferenceManual_v1.x.pdf for more details.
+* - If the memory buffer in PpsKey is not sufficient to store the derived key,#CMD_LIB_INSUFFICIENT_MEMORY is returned.
+
+*
+* \param[in] PpsDeriveKey	Pointer to #sDeriveKeyOptions_d to provide input for session key generation
+* \param[in,out] PpsKey		Pointer to #sbBlob_d that contains the derived key
+*
+* \retval  #CMD_LIB_OK
+* \retval  #CMD_LIB_ERROR
+* \retval  #CMD_LIB_NULL_PARAM
+* \retval  #CMD_LIB_INSUFFICIENT_MEMORY
+* \retval  #CMD_DEV_EXEC_ERROR
+* \retval  #CMD_DEV_ERROR
+*/
+int32_t CmdLib_DeriveKey(const sDeriveKeyOptions_d *PpsDeriveKey,sbBlob_d *PpsKey)
+{
+	sCmdLibContext_d* psContext = psCmdLibContext;
+
+	return CmdLib_WaitForCommand(psContext,NULL,CmdLib_DeriveKeyAsync(PpsDeriveKey,PpsKey,NULL,NULL));
+}
+
+/**
+* Starts the session key derivation by using the Security Chip, see #CmdLib_DeriveKey.<br>
+*
+* Notes:
+* - The command is completed as described for #CmdLib_GetDataObjectAsync.<br>
+* - The seed is sent from the user buffer. PpsDeriveKey, the seed and PpsKey must stay valid until the callback
+*   is invoked.<br>
+*
+* \param[in] PpsDeriveKey	Pointer to #sDeriveKeyOptions_d to provide input for session key generation
+* \param[in,out] PpsKey		Pointer to #sbBlob_d that contains the derived key
+* \param[in] PpfCallback	Callback invoked once the command is completed, can be NULL
+* \param[in] PpvCallbackCtx	User context passed to PpfCallback
+*
+* \retval  #CMD_LIB_OK
+* \retval  #CMD_LIB_BUSY
+* \retval  #CMD_LIB_NULL_PARAM
+* \retval  #CMD_LIB_INSUFFICIENT_MEMORY
+* \retval  #CMD_DEV_EXEC_ERROR
+*/
+int32_t CmdLib_DeriveKeyAsync(const sDeriveKeyOptions_d *PpsDeriveKey,sbBlob_d *PpsKey,
+                              pFCmdLibCallback_d PpfCallback, void* PpvCallbackCtx)
+{
+	sCmdLibContext_d* psContext = psCmdLibContext;
+	int32_t i4Status = CmdLib_ClaimContext(psContext,PpfCallback,PpvCallbackCtx);
+
+	if(CMD_LIB_OK == i4Status)
+	{
+		i4Status = CmdLib_StartCommand(psContext,CmdLib_FormatDeriveKey(psContext,PpsDeriveKey,PpsKey));
+	}
+	return i4Status;
+}
+
 
 #endif/*MODULE_ENABLE_TOOLBOX*/
 
@@ -2786,7 +3606,7 @@ int32_t CmdLib_PutMessage(const sProcMsgData_d *PpsPMsgVector)
 
         //Length of data + OverHeadLen should not to be more than wMaxCommsBuffer
         //Currently, chaining is not supported by Command library and security chip.Hence, this length check is performed.
-        if(PpsPMsgVector->psBlobInBuffer->wLen > (wMaxCommsBuffer) )
+        if(PpsPMsgVector->psBlobInBuffer->wLen > (psCmdLibContext->wMaxCommsBuffer) )
         {
             i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
             break;
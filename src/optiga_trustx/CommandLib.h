@@ -42,6 +42,7 @@ extern "C" {
 #include "ErrorCodes.h"
 #include "AuthLibSettings.h"
 #include "optiga_comms.h"
+#include "pal_os_event.h"
 
 /****************************************************************************
  *
@@ -87,6 +88,12 @@ extern "C" {
 ///Invalid OID
 #define CMD_LIB_INVALID_OID						(CMD_LIB_NULL_PARAM + 9)
 
+///A command is already in progress on the security chip
+#define CMD_LIB_BUSY							(CMD_LIB_NULL_PARAM + 10)
+
+///The deadline of a scheduled command expired before the command could be started
+#define CMD_LIB_DEADLINE_MISSED					(CMD_LIB_NULL_PARAM + 11)
+
 ///Generic error condition
 #define CMD_LIB_ERROR                            0xF87ECF01
 
@@ -124,6 +131,129 @@ typedef struct sCmdResponse_d
     uint16_t    wRespLength;
 }sCmdResponse_d;
 
+///Maximum number of segments of a command APDU including the APDU header
+#define CMD_LIB_MAX_TX_SEGMENTS                 7
+
+///Size of the tags and fixed size values of a command APDU (DeriveKey has the largest)
+#define CMD_LIB_TAG_BUFFER_LEN                  18
+
+/**
+ * \brief Function invoked from the event loop when an asynchronous command is completed.
+ */
+typedef void (*pFCmdLibCallback_d)(void* PpvCallbackCtx, int32_t Pi4Status);
+
+struct sCmdLibContext_d;
+struct sIntLibCache_d;
+
+/**
+ * \brief Result of a blocking command. Filled in before the command releases the security chip, the command state may
+ * belong to the next command by the time the blocked caller runs again.
+ */
+typedef struct sCmdLibResult_d
+{
+    ///TRUE once the command is completed
+    volatile uint8_t bDone;
+
+    ///Status of the command
+    int32_t i4Status;
+
+    ///Length of the response
+    uint16_t wResponseLength;
+}sCmdLibResult_d;
+
+/**
+ * \brief State of the command in progress on a security chip. Used only by the command library.
+ */
+typedef struct sCmdLibCommand_d
+{
+    ///Completion callback, NULL if the caller waits for the command
+    pFCmdLibCallback_d pfCallback;
+
+    ///User context passed to the completion callback
+    void* pvCallbackCtx;
+
+    ///Processes the response and returns the status of the command, or sends the next APDU of a chained command
+    int32_t (*pfResponse)(struct sCmdLibContext_d* PpsContext, int32_t Pi4Status);
+
+    ///Inputs of the command
+    const void* pvInput;
+
+    ///Outputs of the command
+    void* pvOutput;
+
+    ///Segments of the command APDU, the first one is the APDU header
+    sTxSegment_d rgsSegments[CMD_LIB_MAX_TX_SEGMENTS];
+
+    ///Number of segments in rgsSegments
+    uint8_t bSegments;
+
+    ///APDU header
+    uint8_t rgbHeader[4];
+
+    ///Tags and fixed size values of the command APDU
+    uint8_t rgbTags[CMD_LIB_TAG_BUFFER_LEN];
+
+    ///Buffer for a response without data or for the last error code
+    uint8_t rgbResponse[6];
+
+    ///Response buffer
+    uint8_t* prgbResponse;
+
+    ///Size of the response buffer, length of the response once received
+    uint16_t wResponseLength;
+
+    ///Heap buffer freed once the command is completed
+    uint8_t* prgbHeap;
+
+    ///Offset of the current chunk of a chained command
+    uint16_t wOffset;
+
+    ///Length transferred by the previous chunks of a chained command
+    uint16_t wTotalLen;
+
+    ///Length of the current chunk of a chained command
+    uint16_t wChunkLen;
+
+    ///Read the last error code if the command fails
+    uint8_t bGetError;
+
+    ///TRUE while the last error code is read
+    uint8_t bReadError;
+
+    ///Status reported by the OPTIGA comms event handler
+    volatile host_lib_status_t wCommsStatus;
+
+    ///Result of a blocking command, NULL for an asynchronous one
+    sCmdLibResult_d* psResult;
+
+    ///TRUE while the command is in progress
+    volatile uint8_t bBusy;
+}sCmdLibCommand_d;
+
+/**
+ * \brief Command library state of one security chip.
+ */
+typedef struct sCmdLibContext_d
+{
+    ///OPTIGA comms context used to communicate with the security chip
+    optiga_comms_t* psOptigaComms;
+
+    ///Maximum size of the communication buffer of the security chip
+    uint16_t wMaxCommsBuffer;
+
+    ///Command in progress
+    sCmdLibCommand_d sCommand;
+
+    ///Incremented whenever a command may change metadata or life cycle states, invalidates the caches of them
+    uint16_t wStateVersion;
+
+    ///Metadata and life cycle state cache of the integration library, NULL if not enabled
+    struct sIntLibCache_d* psIntLibCache;
+
+    ///Event node continuing the command in progress from the event loop
+    pal_os_event_t sStepEvent;
+}sCmdLibContext_d;
+
 /**
  * \brief Function to send a command and receive response for the command.
  */
@@ -166,6 +296,16 @@ LIBRARY_EXPORTS int32_t CmdLib_MaxCommsBufferSize(uint16_t* PpwMaxCommBufferSize
 /// @cond hidden
 LIBRARY_EXPORTS void CmdLib_SetOptigaCommsContext(const optiga_comms_t *p_input_optiga_comms);
 /// @endcond 
+
+/**
+ * \brief Initializes a command library context for one security chip.
+ */
+LIBRARY_EXPORTS void CmdLib_InitContext(sCmdLibContext_d* PpsContext, const optiga_comms_t *PpsOptigaComms);
+
+/**
+ * \brief Selects the command library context used by the subsequent calls.
+ */
+LIBRARY_EXPORTS sCmdLibContext_d* CmdLib_SelectContext(sCmdLibContext_d* PpsContext);
 /****************************************************************************
  *
  * Definitions related to GetDataObject and SetDataObject commands.
@@ -246,11 +386,32 @@ typedef struct sSetData_d
  */
 LIBRARY_EXPORTS int32_t CmdLib_GetDataObject(const sGetData_d *PpsGDVector, sCmdResponse_d *PpsResponse);
 
+/**
+ * \brief Starts reading the specified data object, the callback is invoked once completed.
+ */
+LIBRARY_EXPORTS int32_t CmdLib_GetDataObjectAsync(const sGetData_d *PpsGDVector, sCmdResponse_d *PpsResponse,pFCmdLibCallback_d PpfCallback,void* PpvCallbackCtx);
+
+/**
+ * \brief Function receiving a chunk of a data object read by #CmdLib_ReadDataObjectStream, returns FALSE to stop reading.
+ */
+typedef bool_t (*pFCmdLibChunk_d)(void* PpvChunkCtx, uint16_t PwOffset, const uint8_t* PprgbChunk, uint16_t PwChunkLen);
+
+/**
+ * \brief Reads the specified data object in chunks and passes each chunk to the given function.
+ */
+LIBRARY_EXPORTS int32_t CmdLib_ReadDataObjectStream(const sGetData_d *PpsGDVector, uint8_t* PprgbChunk, uint16_t PwChunkLen,
+                                                    pFCmdLibChunk_d PpfChunk, void* PpvChunkCtx);
+
 /**
  * \brief Writes to the specified data object by issuing SetDataObject command. 
  */
 LIBRARY_EXPORTS int32_t CmdLib_SetDataObject(const sSetData_d *PpsSDVector);
 
+/**
+ * \brief Starts writing to the specified data object, the callback is invoked once completed.
+ */
+LIBRARY_EXPORTS int32_t CmdLib_SetDataObjectAsync(const sSetData_d *PpsSDVector,pFCmdLibCallback_d PpfCallback,void* PpvCallbackCtx);
+
 /**
  * \brief Reads maximum communication buffer size supported by the security chip. 
  */
@@ -347,6 +508,11 @@ LIBRARY_EXPORTS int32_t CmdLib_GetSignature(const sAuthMsg_d *PpsAuthMsg, sCmdRe
  */
 LIBRARY_EXPORTS int32_t CmdLib_GetRandom(const sRngOptions_d *PpsRng, sCmdResponse_d *PpsResponse);
 
+/**
+ * \brief Starts generating random bytes, the callback is invoked once completed.
+ */
+LIBRARY_EXPORTS int32_t CmdLib_GetRandomAsync(const sRngOptions_d *PpsRng, sCmdResponse_d *PpsResponse,pFCmdLibCallback_d PpfCallback,void* PpvCallbackCtx);
+
 /**
  * \brief Sets the Authentication Scheme by issuing SetAuthScheme command to Security Chip. 
  */
@@ -687,30 +853,60 @@ typedef struct sDeriveKeyOptions_d
  */
 LIBRARY_EXPORTS int32_t CmdLib_CalcHash(sCalcHash_d* PpsCalcHash);
 
+/**
+ * \brief Starts the hash calculation, the callback is invoked once completed.
+ */
+LIBRARY_EXPORTS int32_t CmdLib_CalcHashAsync(sCalcHash_d* PpsCalcHash,pFCmdLibCallback_d PpfCallback,void* PpvCallbackCtx);
+
 /**
  * \brief Verify the signature on digest by issuing VerifySign command to Security Chip. 
  */
 LIBRARY_EXPORTS int32_t CmdLib_VerifySign(const sVerifyOption_d* PpsVerifySign,const sbBlob_d * PpsDigest,const sbBlob_d * PpsSignature);
 
+/**
+ * \brief Starts the signature verification, the callback is invoked once completed.
+ */
+LIBRARY_EXPORTS int32_t CmdLib_VerifySignAsync(const sVerifyOption_d* PpsVerifySign,const sbBlob_d * PpsDigest,const sbBlob_d * PpsSignature,pFCmdLibCallback_d PpfCallback,void* PpvCallbackCtx);
+
 /**
  * \brief Generate a key pair by issuing GenKeyPair command to Security Chip. 
  */
 LIBRARY_EXPORTS int32_t CmdLib_GenerateKeyPair(const sKeyPairOption_d* PpsKeyPairOption,sOutKeyPair_d* PpsOutKeyPair);
 
+/**
+ * \brief Starts the key pair generation, the callback is invoked once completed.
+ */
+LIBRARY_EXPORTS int32_t CmdLib_GenerateKeyPairAsync(const sKeyPairOption_d* PpsKeyPairOption,sOutKeyPair_d* PpsOutKeyPair,pFCmdLibCallback_d PpfCallback,void* PpvCallbackCtx);
+
 /**
  * \brief  Calculate signature on a digest by issuing CalcSign command to the Security Chip.
  */
 LIBRARY_EXPORTS int32_t CmdLib_CalculateSign(const sCalcSignOptions_d *PpsCalcSign,sbBlob_d *PpsSignature);
 
+/**
+ * \brief Starts the signature calculation, the callback is invoked once completed.
+ */
+LIBRARY_EXPORTS int32_t CmdLib_CalculateSignAsync(const sCalcSignOptions_d *PpsCalcSign,sbBlob_d *PpsSignature,pFCmdLibCallback_d PpfCallback,void* PpvCallbackCtx);
+
 /**
  * \brief  Calculate shared secret by issuing CalcSSec command to the Security Chip.
  */
 LIBRARY_EXPORTS int32_t CmdLib_CalculateSharedSecret(const sCalcSSecOptions_d *PpsCalcSSec,sbBlob_d *PpsSecret);
 
+/**
+ * \brief Starts the shared secret calculation, the callback is invoked once completed.
+ */
+LIBRARY_EXPORTS int32_t CmdLib_CalculateSharedSecretAsync(const sCalcSSecOptions_d *PpsCalcSSec,sbBlob_d *PpsSecret,pFCmdLibCallback_d PpfCallback,void* PpvCallbackCtx);
+
 /**
  * \brief  Derive session key by issuing DeriveKey command to the Security Chip.
  */
 LIBRARY_EXPORTS int32_t CmdLib_DeriveKey(const sDeriveKeyOptions_d *PpsDeriveKey,sbBlob_d *PpsKey);
+
+/**
+ * \brief Starts the session key derivation, the callback is invoked once completed.
+ */
+LIBRARY_EXPORTS int32_t CmdLib_DeriveKeyAsync(const sDeriveKeyOptions_d *PpsDeriveKey,sbBlob_d *PpsKey,pFCmdLibCallback_d PpfCallback,void* PpvCallbackCtx);
 #endif/*MODULE_ENABLE_TOOLBOX*/
 
 /****************************************************************************
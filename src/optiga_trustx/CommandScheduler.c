@@ -0,0 +1,299 @@
+/**
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+*
+* \file
+*
+* \brief   This file implements the command scheduler. It queues the commands of a security chip
+*          and dispatches them one at a time in priority and earliest deadline order.
+*
+* \ingroup  grCmdLib
+* @{
+*/
+
+#include <stdint.h>
+#include "CommandScheduler.h"
+#include "MemoryMgmt.h"
+#include "pal_os_event.h"
+#include "pal_os_timer.h"
+
+/// @cond hidden
+
+///Checks if time stamp a is before time stamp b, the microsecond timer wraps around
+#define TIME_BEFORE(a,b)            ((int32_t)((uint32_t)(a) - (uint32_t)(b)) < 0)
+
+_STATIC_H void CmdSched_Dispatch(void* PpvScheduler);
+
+/**
+ * \brief Checks if request a is dispatched before request b.
+ */
+_STATIC_H bool_t CmdSched_IsBefore(const sCmdSchedRequest_d* PpsA, const sCmdSchedRequest_d* PpsB)
+{
+    bool_t bBefore = FALSE;
+
+    do
+    {
+        if(PpsA->ePriority != PpsB->ePriority)
+        {
+            bBefore = (PpsA->ePriority < PpsB->ePriority) ? TRUE : FALSE;
+            break;
+        }
+        //Within a priority class the earliest deadline first, requests without deadline last in submission order
+        if((0 != PpsA->dwDeadlineUs) &&
+           ((0 == PpsB->dwDeadlineUs) ||
+            TIME_BEFORE(PpsA->dwSubmitTime + PpsA->dwDeadlineUs, PpsB->dwSubmitTime + PpsB->dwDeadlineUs)))
+        {
+            bBefore = TRUE;
+        }
+    }while(FALSE);
+
+    return bBefore;
+}
+
+/**
+ * \brief Completes a request and invokes its callback.
+ */
+_STATIC_H void CmdSched_Complete(sCmdSchedRequest_d* PpsRequest, int32_t Pi4Status)
+{
+    PpsRequest->psScheduler = NULL;
+    if(NULL != PpsRequest->pfCallback)
+    {
+        PpsRequest->pfCallback(PpsRequest->pvCallbackCtx,Pi4Status);
+    }
+}
+
+/**
+ * \brief Invoked by the command library once the dispatched command is completed.
+ */
+_STATIC_H void CmdSched_CommandDone(void* PpvRequest, int32_t Pi4Status)
+{
+    sCmdSchedRequest_d* psRequest = (sCmdSchedRequest_d*)PpvRequest;
+    sCmdScheduler_d* psScheduler = psRequest->psScheduler;
+
+    psRequest->dwExecTime = pal_os_timer_get_time_in_microseconds() - psRequest->dwStartTime;
+    psScheduler->psActive = NULL;
+    CmdSched_Complete(psRequest,Pi4Status);
+    //The security chip is free, start the next request right away
+    CmdSched_Dispatch(psScheduler);
+}
+
+/**
+ * \brief Starts the next queued request if the security chip is free. Requests which missed their deadline are dropped.
+ */
+_STATIC_H void CmdSched_Dispatch(void* PpvScheduler)
+{
+    sCmdScheduler_d* psScheduler = (sCmdScheduler_d*)PpvScheduler;
+    sCmdSchedRequest_d* psRequest;
+    sCmdLibContext_d* psSelected;
+    int32_t i4Status;
+
+    while((NULL == psScheduler->psActive) && (NULL != psScheduler->psQueue))
+    {
+        psRequest = psScheduler->psQueue;
+        psScheduler->psQueue = psRequest->psNext;
+        psRequest->psNext = NULL;
+        psRequest->dwStartTime = pal_os_timer_get_time_in_microseconds();
+        psRequest->dwQueueTime = psRequest->dwStartTime - psRequest->dwSubmitTime;
+        psRequest->dwExecTime = 0;
+
+        if((0 != psRequest->dwDeadlineUs) && (psRequest->dwQueueTime >= psRequest->dwDeadlineUs))
+        {
+            CmdSched_Complete(psRequest,(int32_t)CMD_LIB_DEADLINE_MISSED);
+            continue;
+        }
+
+        psScheduler->psActive = psRequest;
+        psSelected = CmdLib_SelectContext(psScheduler->psContext);
+        i4Status = psRequest->pfStart(psRequest->pvStartCtx,CmdSched_CommandDone,psRequest);
+        CmdLib_SelectContext(psSelected);
+        if(CMD_LIB_OK != i4Status)
+        {
+            psScheduler->psActive = NULL;
+            CmdSched_Complete(psRequest,i4Status);
+        }
+    }
+}
+
+/// @endcond
+
+/**
+* Initializes a scheduler for the security chip of the given command library context.
+*
+* <br>
+* Notes:
+* - Only one scheduler must be used per security chip and all commands to the security chip must be run
+*   through it. A command started outside the scheduler makes the next scheduled command fail with #CMD_LIB_BUSY.<br>
+*
+* \param[out] PpsScheduler  Pointer to the scheduler
+* \param[in]  PpsContext    Pointer to the command library context of the security chip, NULL for the default context
+*/
+void CmdSched_Init(sCmdScheduler_d* PpsScheduler, sCmdLibContext_d* PpsContext)
+{
+    PpsScheduler->psContext = PpsContext;
+    PpsScheduler->psQueue = NULL;
+    PpsScheduler->psActive = NULL;
+}
+
+/**
+* Initializes a request.
+*
+* <br>
+* Notes:
+* - PpfStart is invoked from the event loop with the context of the security chip selected. It must start exactly one
+*   command with one of the CmdLib_*Async functions, passing on PpfCallback and PpvCallbackCtx.<br>
+* - The deadline is relative to the submission. A request which could not be started within it is dropped and
+*   completed with #CMD_LIB_DEADLINE_MISSED. A command already started is never aborted.<br>
+*
+* \param[out] PpsRequest      Pointer to the request
+* \param[in]  PpfStart        Function starting the command
+* \param[in]  PpvStartCtx     User context passed to PpfStart, e.g. the inputs of the command
+* \param[in]  PePriority      Priority class
+* \param[in]  PdwDeadlineUs   Time in microseconds from submission until the command must be started, 0 for no deadline
+* \param[in]  PpfCallback     Callback invoked once the request is completed, can be NULL
+* \param[in]  PpvCallbackCtx  User context passed to PpfCallback
+*/
+void CmdSched_InitRequest(sCmdSchedRequest_d* PpsRequest, pFCmdSchedStart_d PpfStart, void* PpvStartCtx,
+                          eCmdPriority_d PePriority, uint32_t PdwDeadlineUs,
+                          pFCmdLibCallback_d PpfCallback, void* PpvCallbackCtx)
+{
+    OCP_MEMSET((uint8_t*)PpsRequest,0,sizeof(sCmdSchedRequest_d));
+    PpsRequest->pfStart = PpfStart;
+    PpsRequest->pvStartCtx = PpvStartCtx;
+    PpsRequest->ePriority = PePriority;
+    PpsRequest->dwDeadlineUs = PdwDeadlineUs;
+    PpsRequest->pfCallback = PpfCallback;
+    PpsRequest->pvCallbackCtx = PpvCallbackCtx;
+}
+
+/**
+* Queues a request. The requests are dispatched to the security chip one at a time from the event loop, in
+* the order of their priority class and within a class earliest deadline first. Requests without deadline
+* follow in submission order.
+*
+* <br>
+* Notes:
+* - The function returns once the request is queued. Requests submitted before the event loop runs the next time
+*   are ordered together, so a burst of background requests does not delay a latency critical one.<br>
+* - Once completed, the callback of the request is invoked from the event loop with the status of the command.
+*   dwQueueTime and dwExecTime of the request report the time spent in the queue and on the security chip.<br>
+* - If the function does not return #CMD_LIB_OK, the request is not queued and its callback is not invoked.<br>
+* - The request and the inputs and outputs of its command must stay valid until the callback is invoked. A request
+*   can be submitted again from its callback.<br>
+*
+* \param[in]     PpsScheduler  Pointer to the scheduler
+* \param[in,out] PpsRequest    Pointer to the request initialized with #CmdSched_InitRequest
+*
+* \retval  #CMD_LIB_OK
+* \retval  #CMD_LIB_NULL_PARAM
+* \retval  #CMD_LIB_BUSY
+*/
+int32_t CmdSched_Submit(sCmdScheduler_d* PpsScheduler, sCmdSchedRequest_d* PpsRequest)
+{
+    int32_t i4Status = (int32_t)CMD_LIB_ERROR;
+    sCmdSchedRequest_d** ppsEntry;
+
+    do
+    {
+        if((NULL == PpsScheduler) || (NULL == PpsRequest) || (NULL == PpsRequest->pfStart))
+        {
+            i4Status = (int32_t)CMD_LIB_NULL_PARAM;
+            break;
+        }
+        //The request is already queued or in progress
+        if(NULL != PpsRequest->psScheduler)
+        {
+            i4Status = (int32_t)CMD_LIB_BUSY;
+            break;
+        }
+
+        PpsRequest->psScheduler = PpsScheduler;
+        PpsRequest->dwSubmitTime = pal_os_timer_get_time_in_microseconds();
+        PpsRequest->dwQueueTime = 0;
+        PpsRequest->dwExecTime = 0;
+
+        ppsEntry = &PpsScheduler->psQueue;
+        while((NULL != *ppsEntry) && (FALSE == CmdSched_IsBefore(PpsRequest,*ppsEntry)))
+        {
+            ppsEntry = &(*ppsEntry)->psNext;
+        }
+        PpsRequest->psNext = *ppsEntry;
+        *ppsEntry = PpsRequest;
+
+        if(NULL == PpsScheduler->psActive)
+        {
+            pal_os_event_register_callback_oneshot(&PpsScheduler->sDispatchEvent,CmdSched_Dispatch,PpsScheduler,0);
+        }
+        i4Status = (int32_t)CMD_LIB_OK;
+    }while(FALSE);
+
+    return i4Status;
+}
+
+/**
+* Removes a request from the queue if it was not started yet. The callback of the request is not invoked.
+*
+* \param[in]     PpsScheduler  Pointer to the scheduler
+* \param[in,out] PpsRequest    Pointer to the request
+*
+* \retval  #CMD_LIB_OK
+* \retval  #CMD_LIB_NULL_PARAM
+* \retval  #CMD_LIB_BUSY          The command of the request is in progress
+* \retval  #CMD_LIB_INVALID_PARAM The request is not queued
+*/
+int32_t CmdSched_Cancel(sCmdScheduler_d* PpsScheduler, sCmdSchedRequest_d* PpsRequest)
+{
+    int32_t i4Status = (int32_t)CMD_LIB_INVALID_PARAM;
+    sCmdSchedRequest_d** ppsEntry;
+
+    do
+    {
+        if((NULL == PpsScheduler) || (NULL == PpsRequest))
+        {
+            i4Status = (int32_t)CMD_LIB_NULL_PARAM;
+            break;
+        }
+        if(PpsScheduler->psActive == PpsRequest)
+        {
+            i4Status = (int32_t)CMD_LIB_BUSY;
+            break;
+        }
+
+        for(ppsEntry = &PpsScheduler->psQueue; NULL != *ppsEntry; ppsEntry = &(*ppsEntry)->psNext)
+        {
+            if(*ppsEntry == PpsRequest)
+            {
+                *ppsEntry = PpsRequest->psNext;
+                PpsRequest->psNext = NULL;
+                PpsRequest->psScheduler = NULL;
+                i4Status = (int32_t)CMD_LIB_OK;
+                break;
+            }
+        }
+    }while(FALSE);
+
+    return i4Status;
+}
+
+/**
+* @}
+*/
@@ -0,0 +1,156 @@
+/**
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+*
+* \file
+*
+* \brief   This file defines APIs, types and data structures used in the
+*          Command Scheduler implementation.
+*
+* \ingroup  grCmdLib
+* @{
+*/
+#ifndef _CMD_SCHEDULER_H_
+#define _CMD_SCHEDULER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "Datatypes.h"
+#include "CommandLib.h"
+#include "pal_os_event.h"
+
+/****************************************************************************
+ *
+ * Definitions related to the command scheduler.
+ *
+ ****************************************************************************/
+
+/**
+ * \brief Priority classes of scheduled commands, a lower value is dispatched first.
+ */
+typedef enum eCmdPriority_d
+{
+    ///Latency critical commands, e.g. signatures of a handshake
+    eCMD_PRIO_HIGH = 0,
+
+    ///Regular commands
+    eCMD_PRIO_NORMAL = 1,
+
+    ///Background work, e.g. random prefetch, certificate reads or object writes
+    eCMD_PRIO_BACKGROUND = 2
+}eCmdPriority_d;
+
+/**
+ * \brief Function starting a scheduled command by calling one of the CmdLib_*Async functions with the given callback.
+ */
+typedef int32_t (*pFCmdSchedStart_d)(void* PpvStartCtx, pFCmdLibCallback_d PpfCallback, void* PpvCallbackCtx);
+
+struct sCmdScheduler_d;
+
+/**
+ * \brief Request to run a command through the scheduler. Initialize it with #CmdSched_InitRequest.
+ */
+typedef struct sCmdSchedRequest_d
+{
+    ///Starts the command
+    pFCmdSchedStart_d pfStart;
+
+    ///User context passed to pfStart
+    void* pvStartCtx;
+
+    ///Callback invoked once the command is completed or dropped
+    pFCmdLibCallback_d pfCallback;
+
+    ///User context passed to pfCallback
+    void* pvCallbackCtx;
+
+    ///Priority class
+    eCmdPriority_d ePriority;
+
+    ///Time in microseconds from submission until the command must be started, 0 for no deadline
+    uint32_t dwDeadlineUs;
+
+    ///Time in microseconds the request waited in the queue, valid in the callback
+    uint32_t dwQueueTime;
+
+    ///Time in microseconds the command took on the security chip, valid in the callback
+    uint32_t dwExecTime;
+
+    ///Used only by the scheduler
+    struct sCmdScheduler_d* psScheduler;
+    struct sCmdSchedRequest_d* psNext;
+    uint32_t dwSubmitTime;
+    uint32_t dwStartTime;
+}sCmdSchedRequest_d;
+
+/**
+ * \brief Scheduler queueing the commands of one security chip. Initialize it with #CmdSched_Init.
+ */
+typedef struct sCmdScheduler_d
+{
+    ///Command library context of the security chip
+    sCmdLibContext_d* psContext;
+
+    ///Queued requests in dispatch order
+    sCmdSchedRequest_d* psQueue;
+
+    ///Request in progress on the security chip
+    sCmdSchedRequest_d* psActive;
+
+    ///Event node dispatching the queue from the event loop
+    pal_os_event_t sDispatchEvent;
+}sCmdScheduler_d;
+
+/**
+ * \brief Initializes a scheduler for the security chip of the given command library context.
+ */
+LIBRARY_EXPORTS void CmdSched_Init(sCmdScheduler_d* PpsScheduler, sCmdLibContext_d* PpsContext);
+
+/**
+ * \brief Initializes a request.
+ */
+LIBRARY_EXPORTS void CmdSched_InitRequest(sCmdSchedRequest_d* PpsRequest, pFCmdSchedStart_d PpfStart, void* PpvStartCtx,
+                                          eCmdPriority_d PePriority, uint32_t PdwDeadlineUs,
+                                          pFCmdLibCallback_d PpfCallback, void* PpvCallbackCtx);
+
+/**
+ * \brief Queues a request, it is dispatched from the event loop in priority and deadline order.
+ */
+LIBRARY_EXPORTS int32_t CmdSched_Submit(sCmdScheduler_d* PpsScheduler, sCmdSchedRequest_d* PpsRequest);
+
+/**
+ * \brief Removes a request from the queue if it was not started yet.
+ */
+LIBRARY_EXPORTS int32_t CmdSched_Cancel(sCmdScheduler_d* PpsScheduler, sCmdSchedRequest_d* PpsRequest);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _CMD_SCHEDULER_H_*/
+
+/**
+* @}
+*/
@@ -130,6 +130,19 @@ typedef struct sbBlob_d
     uint8_t *prgbStream;
 } sbBlob_d;
 
+/**
+ * \brief Structure to specify one segment of a transmit buffer that is scattered
+ *        over several memory locations.
+ */
+typedef struct sTxSegment_d
+{
+    /// Length of the segment
+    uint16_t wLen;
+
+    /// Pointer to the segment data
+    const uint8_t *prgbStream;
+} sTxSegment_d;
+
 /// typedef for application event handler
 typedef void (*app_event_handler_t)(void* upper_layer_ctx, host_lib_status_t event);
 
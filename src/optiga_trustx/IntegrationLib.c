@@ -57,33 +57,18 @@
 ///size of public key for NIST-P256
 #define LENGTH_PUB_KEY_NISTP256     0x41
 
-///Position of data field in metadata
-#define METADATA_MAX_LEN            0x001C
-
-///Offset of Length in the metadata
-#define OFFSET_TLV_LENGTH		    0x01
+///Metadata Tag
+#define METADATA_TAG                0x20
 
 ///Size of TLV Format Header
 #define TLV_HEADER_SIZE             0x02
 
-///Length of metadata header
-#define METADATA_HEADER_SIZE        TLV_HEADER_SIZE
-
-///Value for parsig failure
-#define PARSE_FAILURE               0xFF
-
 ///TLV position for Length
 #define POS_LEN                     0x01
 
 ///TLV position for Value
 #define POS_VAL                     0x02
 
-///Already Found
-#define VALUE_TAG_FOUND             0x9B
-
-///Length of R and S vector
-#define VALUE_TAG_NOTFOUND          0x31
-
 ///ASN Tag for sequence
 #define ASN_TAG_SEQUENCE          	0x30
 
@@ -108,19 +93,15 @@ typedef enum eObjectId_d
 }eObjectId_d;
 
 /**
- * \brief Structure to specify general purpose data object parameters for read
+ * \brief Life cycle states the access conditions are verified against
  */
 typedef struct sACVector_d
 {
-    ///OID of data object
+    ///Application life cycle state
     uint8_t bLcsA;
-    
-    uint8_t bLcsG;
-    
-    uint8_t bLcsO;
 
-    sbBlob_d *psMetaData;
-    
+    ///Global life cycle state
+    uint8_t bLcsG;
 }sACVector_d;
 
 /**
@@ -147,10 +128,16 @@ typedef enum eMetaDataTag_d
 {
 	/// Object Life Cycle
     eLCSO =     0xC0,
+	/// Maximum size
+    eMAX_SIZE = 0xC4,
+	/// Used size
+    eUSED_SIZE = 0xC5,
 	/// Change AC
     eCHANGE_AC = 0xD0,
 	/// Read AC
-    eREAD_AC =  0xD1
+    eREAD_AC =  0xD1,
+	/// Data object type
+    eDATA_TYPE = 0xE8
 } eMetaDataTag_d;
 
 /**
@@ -175,328 +162,156 @@ typedef enum eAccessConditionID_d
 #ifdef MODULE_ENABLE_READ_WRITE
 /**
  *
- * Implementation to get the metadata tag position.<br>
- * Returns error if metadata is not correct<br>
- * (if duplication of tag, metadata length / Tag length more than max length of metadata).<br> <br>
+ * Adds a comparison with LcsA or LcsG to the ranges of a term.<br>
  *
- * PpbPos contains the actual position of the tag if found.<br>
- * PpbPos contains 0xFF if tag not found.This is considering that metatdata length is 28 bytes.
- * The return value in this case is #INT_LIB_OK.<br>
- *   
- * \param[in]  Pprgbmetadata   Pointer to the buffer that contains metadata
- * \param[in]  PbTag           Tag type.
- * \param[in]  PpbPos          Pointer to tag position in metadata
- *   
- * \retval    #INT_LIB_OK      Successful execution
- * \retval    #INT_LIB_ERROR   Failure in execution
+ * \param[in,out]  PpbMin    Pointer to the lowest permitted life cycle state
+ * \param[in,out]  PpbMax    Pointer to the highest permitted life cycle state
+ * \param[in]      PeOp      Comparison operator
+ * \param[in]      PbVal     Value compared with
+ *
+ * \retval    TRUE     The term can still be met
+ * \retval    FALSE    The term is never met
  *
  */
-static int32_t IntLib_GetTagPos (const uint8_t* Pprgbmetadata, uint8_t PbTag, puint8_t PpbPos)
+static bool_t IntLib_NarrowRange(uint8_t *PpbMin, uint8_t *PpbMax, eOperator_d PeOp, uint8_t PbVal)
 {
-    int32_t i4Status = (int32_t)INT_LIB_ERROR;
-    uint8_t bMetadataSize, bAcLen;
-    uint8_t bTempPos, bAlreadyFound=VALUE_TAG_NOTFOUND;
-
+    bool_t bPossible = FALSE;
     do
     {
-        if (NULL == Pprgbmetadata || NULL == PpbPos)
-        {
-            break;
-        }
-
-        bMetadataSize = Pprgbmetadata[OFFSET_TLV_LENGTH];
-
-        *PpbPos = 0xFF;
-        
-        if (METADATA_MAX_LEN < (bMetadataSize + METADATA_HEADER_SIZE))        
-        {
-            //Metadata Corrupted [Length field in Metadata is more than METADATA_MAX_SIZE]
-            break;
-        }
-
-        bTempPos = METADATA_HEADER_SIZE;
-
-        for(;;)
+        if(eOP_EQUAL == PeOp)
         {
-            if (Pprgbmetadata[bTempPos] == PbTag)
-            {
-                if (VALUE_TAG_FOUND == bAlreadyFound)
-                {
-                    i4Status = (int32_t)INT_LIB_ERROR;
-                    break;
-                }
-                i4Status = INT_LIB_OK;
-                *PpbPos = bTempPos;
-                bAlreadyFound = VALUE_TAG_FOUND;
-            }
-
-            if(0xFF == Pprgbmetadata[bTempPos])
-            {
-                //Length field in Metadata is not correct
-                break;
-            }
-            bAcLen = Pprgbmetadata[bTempPos+1];
-
-            //Is metadata Corrupted?
-            if (METADATA_MAX_LEN <= (bAcLen+bTempPos+1))
+            if((PbVal < *PpbMin) || (PbVal > *PpbMax))
             {
-                //Metadata Corrupted
                 break;
             }
-
-            bTempPos += (bAcLen+2);
-
-            if(bMetadataSize <= (bTempPos-METADATA_HEADER_SIZE))
+            *PpbMin = PbVal;
+            *PpbMax = PbVal;
+        }
+        else if(eOP_GREATER_THAN == PeOp)
+        {
+            if(PbVal >= *PpbMax)
             {
-                i4Status = INT_LIB_OK;
                 break;
             }
-        }
-    } while(0);
-
-    return i4Status;
-}
-
-/**
- *
- * Implementation to verify expressions related to LCSA, LCSG, LCSO.<br>
- * 
- * \param[in]     PpsACVal             Pointer to the access condition vector
- * \param[in]     PprgbAC              Pointer to the AC expression
- * \param[in,out] PpwVerifyOver        Pointer to verification status
- *   
- * \retval    #INT_LIB_OK       Successful execution
- * \retval    #INT_LIB_ERROR    Failure in execution
- *
- */
-static int32_t IntLib_VerifyLcsAGO(const sACVector_d* PpsACVal, const uint8_t* PprgbAC,puint16_t PpwVerifyOver)
-{
-    int32_t i4Status = (int32_t)INT_LIB_ERROR;
-    uint8_t bVal, bLcs = 0x00;
-    eOperator_d eOp ;
-    
-	// Life cycle state of object
-    #define LCS_O_VAL			(PpsACVal->bLcsO)
-	// Life cycle state of application
-    #define LCS_A_VAL			(PpsACVal->bLcsA)
-	// Life cycle state of Global
-    #define LCS_G_VAL			(PpsACVal->bLcsG)
-    
-    do
-    {
-        if((NULL == PpwVerifyOver) 
-            || (NULL == PpsACVal) || (NULL == PprgbAC))
-        {
-            break;
-        }
-
-        bLcs = LCS_A_VAL;
-        if ((uint8_t)eACID_LCSG == *PprgbAC)
-        {
-            bLcs = LCS_G_VAL;
-        }
-        else if((uint8_t)eACID_LCSO == *PprgbAC)
-        {
-            bLcs = LCS_O_VAL;
-        }
-       
-        eOp = (eOperator_d)(*(PprgbAC+1));
-        bVal = *(PprgbAC+2);
-
-        if(eOp == eOP_GREATER_THAN)
-        {
-            if(bLcs > bVal)
+            if(PbVal >= *PpbMin)
             {
-                i4Status = INT_LIB_OK;
+                *PpbMin = PbVal + 1;
             }
         }
-        else if(eOp == eOP_LESS_THAN)
+        else
         {
-            if(bLcs < bVal)
+            if(PbVal <= *PpbMin)
             {
-                i4Status = INT_LIB_OK;
+                break;
             }
-        } 
-        else if(eOp == eOP_EQUAL)
-        {
-            if(bLcs == bVal)
+            if(PbVal <= *PpbMax)
             {
-                i4Status = INT_LIB_OK;
+                *PpbMax = PbVal - 1;
             }
         }
-        else
-        {
-            i4Status = (int32_t)INT_LIB_ERROR;
-            *PpwVerifyOver = TRUE;
-            break;
-        }
-    } while(0);
-    return i4Status;
-#undef LCS_O_VAL
-#undef LCS_A_VAL
-#undef LCS_G_VAL    
+        bPossible = TRUE;
+    }while(FALSE);
+    return bPossible;
 }
 
 /**
  *
- * Implementation to validate the access conditions.<br>
- *   
- * \param[in]  PpsACVal   Pointer to the buffer that contains metadata
- *   
- * \retval    #INT_LIB_OK       Successful execution
- * \retval    #INT_LIB_ERROR    Failure in execution
+ * Decodes an access condition into alternative terms of LcsA and LcsG ranges.<br>
+ * Simple and complex access conditions are supported, AND binds stronger than OR.
+ * Comparisons with LcsO are resolved with the life cycle state of the data object.<br>
+ * Decoding stops at an invalid or unsupported coding, e.g. a condition on authorization or integrity,
+ * or an operator which is not followed by a complete condition. The term in progress is dropped and the terms
+ * completed before it are kept, as the evaluation of the raw metadata stopped at the first met term.<br>
+ * An access condition with more than #INT_LIB_AC_MAX_TERMS satisfiable terms is decoded without terms,
+ * i.e. it is never met on the host and the data object is not accessed.<br>
+ *
+ * \param[in]   PprgbAC      Pointer to the value of the access condition
+ * \param[in]   PbLen        Length of the access condition
+ * \param[in]   PbLcsO       Life cycle state of the data object
+ * \param[out]  PpsAC        Pointer to the decoded access condition
  *
  */
-static int32_t IntLib_CheckAccessCondition(const sACVector_d *PpsACVal)
+static void IntLib_DecodeAC(const uint8_t *PprgbAC, uint8_t PbLen, uint8_t PbLcsO, sIntLibAC_d *PpsAC)
 {
-    int32_t i4Status = (int32_t)INT_LIB_ERROR;
-    int32_t i4StatusCurr = (int32_t)INT_LIB_ERROR;
-    int32_t i4StatusPrev = (int32_t)INT_LIB_OK;
-    uint16_t wIndex = 0, wLen, wIDCount = 0;
-    uint16_t wVerificationOver = 0;
-    uint8_t bComplexAcOP = 0x00;
-    puint8_t prgbAccessCode;
-
-	// Remaining bytes of the access condition
-    #define REMAINING_BYTES (wLen - wIndex)
+    sIntLibACTerm_d sTerm = {0x00,0xFF,0x00,0xFF};
+    bool_t bPossible = TRUE;
+    eOperator_d eOp;
+    uint8_t bID;
+    uint8_t bLcsOMin;
+    uint8_t bLcsOMax;
+    uint8_t bIndex = 0;
 
+    PpsAC->bTerms = 0;
     do
     {
-        if((NULL == PpsACVal) || (NULL == PpsACVal->psMetaData) 
-                    || (NULL == PpsACVal->psMetaData->prgbStream))
+        if((1 == PbLen) && (((uint8_t)eACID_ALW == PprgbAC[0]) || ((uint8_t)eACID_NEV == PprgbAC[0])))
         {
+            if((uint8_t)eACID_ALW == PprgbAC[0])
+            {
+                PpsAC->rgsTerm[0] = sTerm;
+                PpsAC->bTerms = 1;
+            }
             break;
         }
 
-        wLen = PpsACVal->psMetaData->wLen;
-        prgbAccessCode = PpsACVal->psMetaData->prgbStream;
- 
-        while(wIndex < wLen)
+        while((bIndex + 3) <= PbLen)
         {
-            switch((eAccessConditionID_d)*(prgbAccessCode+wIndex))
-            {
-                case  eACID_ALW:
-                case  eACID_NEV:
-                    if((REMAINING_BYTES > 1) || (wIDCount > 0))
-                    {
-                        wVerificationOver = TRUE;
-                        break;
-                    }
-                    i4StatusCurr = INT_LIB_OK;
-                    if((uint8_t)eACID_NEV == *(prgbAccessCode+wIndex))
-                    {
-                        i4StatusCurr = (int32_t)INT_LIB_ERROR;
-                    }
-                    wIndex++;
-                    wIDCount++;
-                    break;
-
-                case  eACID_LCSO:
-                case  eACID_LCSA:
-                case  eACID_LCSG:
-                    //including access id
-                    if(REMAINING_BYTES < 3)
-                    {
-                        //because of invalid access coding
-                        wVerificationOver = TRUE;
-                        break;
-                    }
-
-                    i4StatusCurr = IntLib_VerifyLcsAGO(PpsACVal, prgbAccessCode+wIndex, &wVerificationOver);
-                    if(TRUE == wVerificationOver)
-                    {
-                        //because of invalid access coding
-                        break;
-                    }
-
-                    wIndex+=3;
-                    wIDCount++;
-                    break;
-
-                default:
-                    //because of invalid access coding
-                    i4StatusPrev = (int32_t)INT_LIB_ERROR;
-                    i4StatusCurr = (int32_t)INT_LIB_ERROR;
-                    wVerificationOver = TRUE;
-                    break;
-            }//switch
-
-            if(wVerificationOver)
+            bID = PprgbAC[bIndex];
+            eOp = (eOperator_d)PprgbAC[bIndex + 1];
+            if((((uint8_t)eACID_LCSA != bID) && ((uint8_t)eACID_LCSG != bID) && ((uint8_t)eACID_LCSO != bID)) ||
+               ((eOP_EQUAL != eOp) && (eOP_GREATER_THAN != eOp) && (eOP_LESS_THAN != eOp)))
             {
+                //because of invalid access coding
                 break;
             }
-
-            if(bComplexAcOP == (uint8_t)eOP_AND)
+            if((uint8_t)eACID_LCSA == bID)
             {
-                if(i4StatusCurr != i4StatusPrev)
-                {
-                    i4StatusCurr = (int32_t)INT_LIB_ERROR;
-                }
+                bPossible &= IntLib_NarrowRange(&sTerm.bLcsAMin,&sTerm.bLcsAMax,eOp,PprgbAC[bIndex + 2]);
             }
-
-            if(wIndex == wLen)
+            else if((uint8_t)eACID_LCSG == bID)
             {
-                break;
+                bPossible &= IntLib_NarrowRange(&sTerm.bLcsGMin,&sTerm.bLcsGMax,eOp,PprgbAC[bIndex + 2]);
             }
-
-            // for operator
-            if(REMAINING_BYTES < 3)
+            else
             {
-                i4StatusPrev = (int32_t)INT_LIB_ERROR;
-                i4StatusCurr = (int32_t)INT_LIB_ERROR;
-                //wVerificationOver = TRUE;
-                break;
+                bLcsOMin = PbLcsO;
+                bLcsOMax = PbLcsO;
+                bPossible &= IntLib_NarrowRange(&bLcsOMin,&bLcsOMax,eOp,PprgbAC[bIndex + 2]);
             }
+            bIndex += 3;
 
-            bComplexAcOP = *(prgbAccessCode+wIndex);
-            switch(bComplexAcOP)
-            { 
-                case  eOP_AND:
-                    i4StatusPrev = i4StatusCurr;
-                    i4StatusCurr = (int32_t)INT_LIB_ERROR;    				
-                    break;
-
-                case  eOP_OR:
-                    i4StatusPrev = INT_LIB_OK;
-                    if(i4StatusCurr == INT_LIB_OK)
+            //Close the term at the end or at an OR followed by a complete condition
+            if((bIndex == PbLen) || (((uint8_t)eOP_OR == PprgbAC[bIndex]) && ((bIndex + 4) <= PbLen)))
+            {
+                if(TRUE == bPossible)
+                {
+                    if(INT_LIB_AC_MAX_TERMS == PpsAC->bTerms)
                     {
-                        //Note: further validation not required 
-                        //because the metadata itself is protected by checksum 
-                        wVerificationOver = TRUE;
+                        //Fail closed rather than drop a term
+                        PpsAC->bTerms = 0;
+                        break;
                     }
+                    PpsAC->rgsTerm[PpsAC->bTerms++] = sTerm;
+                }
+                if(bIndex == PbLen)
+                {
                     break;
-
-                default:
-                    //because of invalid access coding
-					i4StatusPrev = (int32_t)INT_LIB_ERROR;
-                    i4StatusCurr = (int32_t)INT_LIB_ERROR; 
-                    wVerificationOver = TRUE;
-                    break;
-            }//switch
-
-            if(wVerificationOver)
+                }
+                sTerm.bLcsAMin = 0x00;
+                sTerm.bLcsAMax = 0xFF;
+                sTerm.bLcsGMin = 0x00;
+                sTerm.bLcsGMax = 0xFF;
+                bPossible = TRUE;
+            }
+            else if(((uint8_t)eOP_AND != PprgbAC[bIndex]) || ((bIndex + 4) > PbLen))
             {
                 break;
             }
-
-            wIndex++;
-            wIDCount++; //indication of complex AC
-        }//while
-
-        if((i4StatusPrev == INT_LIB_OK) &&
-        (i4StatusCurr == INT_LIB_OK))
-        {
-            i4Status = INT_LIB_OK;
+            bIndex++;
         }
-
-    }while(0);
-
-    return i4Status; 
-#undef REMAINING_BYTES
+    }while(FALSE);
 }
 
-
-
 /**
  *
  * Reads either LcsA or LcsG based on request.<br>
@@ -552,70 +367,235 @@ static int32_t IntLib_ReadLcs(eObjectId_d PeLcsType,uint8_t *PpbValue)
 
 /**
  *
- * Verifies the requested access condition in the metadata.<br>
- *   
- * \param[in]  PeMetaDataTag     Type of access condition
- * \param[in]  PpsACVal         Pointer to metadata.
- *   
+ * Returns the command library context selected for the subsequent calls.<br>
+ *
+ * \retval    Pointer to the selected context
+ *
+ */
+static sCmdLibContext_d* IntLib_GetContext(void)
+{
+    sCmdLibContext_d* psContext = CmdLib_SelectContext(NULL);
+
+    CmdLib_SelectContext(psContext);
+    return psContext;
+}
+
+/**
+ *
+ * Drops all cached values.<br>
+ *
+ * \param[in,out]  PpsCache    Pointer to the cache
+ *
+ */
+static void IntLib_ClearCache(sIntLibCache_d *PpsCache)
+{
+    uint8_t bIndex;
+
+    PpsCache->bLcsValid = FALSE;
+    PpsCache->bNext = 0;
+    for(bIndex = 0; bIndex < PpsCache->bEntries; bIndex++)
+    {
+        PpsCache->psEntries[bIndex].wOID = 0x0000;
+    }
+}
+
+/**
+ *
+ * Returns the cache of the selected security chip.<br>
+ * The cached values are dropped, if a command may have changed metadata or life cycle states since they were read.<br>
+ *
+ * \retval    Pointer to the cache, NULL if the cache is not enabled
+ *
+ */
+static sIntLibCache_d* IntLib_GetCache(void)
+{
+    sCmdLibContext_d* psContext = IntLib_GetContext();
+    sIntLibCache_d* psCache = psContext->psIntLibCache;
+
+    if((NULL != psCache) && (psCache->wStateVersion != psContext->wStateVersion))
+    {
+        IntLib_ClearCache(psCache);
+        psCache->wStateVersion = psContext->wStateVersion;
+    }
+    return psCache;
+}
+
+/**
+ *
+ * Gets LcsA and LcsG from the cache or reads them from the security chip.<br>
+ *
+ * \param[in,out]  PpsCache    Pointer to the cache, NULL if not enabled
+ * \param[in,out]  PpsACVal    Pointer for returning the life cycle states
+ *
  * \retval    #INT_LIB_OK       Successful execution
  * \retval    #INT_LIB_ERROR    Failure in execution
  *
  */
-static int32_t IntLib_VerifyAC(eMetaDataTag_d PeMetaDataTag, sACVector_d *PpsACVal)
+static int32_t IntLib_GetLcs(sIntLibCache_d *PpsCache, sACVector_d *PpsACVal)
 {
     int32_t i4Status  = (int32_t)INT_LIB_ERROR;
-    uint8_t bTagLocation = 0;
     do
     {
-        if((NULL == PpsACVal)||(NULL == PpsACVal->psMetaData)||
-            (NULL == PpsACVal->psMetaData->prgbStream))
+        if((NULL != PpsCache) && (TRUE == PpsCache->bLcsValid))
         {
-            i4Status = (int32_t)INT_LIB_NULL_PARAM;
+            PpsACVal->bLcsA = PpsCache->bLcsA;
+            PpsACVal->bLcsG = PpsCache->bLcsG;
+            i4Status = INT_LIB_OK;
             break;
         }
-        
-        //get tag position of lcsO and read lcsO.
-        //LCO may not be found for all object.It is not an error
-        i4Status = IntLib_GetTagPos(PpsACVal->psMetaData->prgbStream,(uint8_t)eLCSO,&bTagLocation);
-        if(INT_LIB_OK == i4Status)
+        //Read lcsA
+        i4Status = IntLib_ReadLcs(eLCSA,&(PpsACVal->bLcsA));
+        if(INT_LIB_OK != i4Status)
         {
-        	if(LENGTH_METADATA<=(bTagLocation+2))
-        	{
-        		i4Status = (int32_t)INT_LIB_ERROR;
-        		//Serial.println("Assert: Array out of bound!");
-        		//Serial.println(bTagLocation,HEX);
-        	}
-        	else{
-            //get the LcsO value from TLV
-            PpsACVal->bLcsO = (PpsACVal->psMetaData->prgbStream)[bTagLocation+2];
-        	}
+           break;
         }
-        else
+        //Read lcsG
+        i4Status = IntLib_ReadLcs(eLCSG,&(PpsACVal->bLcsG));
+        if(INT_LIB_OK != i4Status)
+        {
+           break;
+        }
+        if(NULL != PpsCache)
+        {
+            PpsCache->bLcsA = PpsACVal->bLcsA;
+            PpsCache->bLcsG = PpsACVal->bLcsG;
+            PpsCache->bLcsValid = TRUE;
+        }
+    }while(FALSE);
+    return i4Status;
+}
+
+/**
+ *
+ * Gets the decoded metadata of a data object from the cache or reads and decodes it.<br>
+ * Metadata read from the security chip replaces the oldest entry of the cache.<br>
+ *
+ * \param[in,out]  PpsCache         Pointer to the cache, NULL if not enabled
+ * \param[in]      PwOID            OID of the data object
+ * \param[out]     PpsInfo          Pointer for returning the decoded metadata
+ *
+ * \retval    #INT_LIB_OK               Successful execution
+ * \retval    #INT_LIB_INVALID_RESPONSE Invalid metadata
+ * \retval    #CMD_DEV_ERROR
+ *
+ */
+static int32_t IntLib_GetMetaData(sIntLibCache_d *PpsCache, uint16_t PwOID, sIntLibObjectInfo_d *PpsInfo)
+{
+    int32_t i4Status  = (int32_t)INT_LIB_ERROR;
+    sGetData_d sGDVector;
+    sCmdResponse_d sCmdResponse;
+    sIntLibMetaData_d* psEntry;
+    uint8_t rgbMetaData[LENGTH_METADATA];
+    uint8_t bIndex;
+    do
+    {
+        if(NULL != PpsCache)
+        {
+            for(bIndex = 0; bIndex < PpsCache->bEntries; bIndex++)
+            {
+                if(PwOID == PpsCache->psEntries[bIndex].wOID)
+                {
+                    break;
+                }
+            }
+            if(bIndex < PpsCache->bEntries)
+            {
+                *PpsInfo = PpsCache->psEntries[bIndex].sInfo;
+                i4Status = INT_LIB_OK;
+                break;
+            }
+        }
+
+        //Get metadata of oid
+        sGDVector.wOID = PwOID;
+        sGDVector.wLength = LENGTH_METADATA;
+        sGDVector.wOffset = 0;
+        sGDVector.eDataOrMdata = eMETA_DATA;
+
+        sCmdResponse.prgbBuffer = rgbMetaData;
+        sCmdResponse.wBufferLength = LENGTH_METADATA;
+        sCmdResponse.wRespLength = 0;
+
+        i4Status = CmdLib_GetDataObject(&sGDVector,&sCmdResponse);
+        if(CMD_LIB_OK != i4Status)
+        {
+            break;
+        }
+        //Check the length, response length contains data + 2 byte Tag,Len
+        if((sCmdResponse.wRespLength < POS_VAL) || (*(sCmdResponse.prgbBuffer + POS_LEN) != (sCmdResponse.wRespLength-POS_VAL)))
         {
-            //LcsO not present
-            PpsACVal->bLcsO = 0x00;
+            i4Status = (int32_t)INT_LIB_INVALID_RESPONSE;
+            break;
         }
-        //reset tag location
-        bTagLocation = 0;
-        //get tag position
-        i4Status = IntLib_GetTagPos(PpsACVal->psMetaData->prgbStream,(uint8_t)PeMetaDataTag,&bTagLocation);
-        if((INT_LIB_OK != i4Status) || (PARSE_FAILURE == bTagLocation))
+        i4Status = IntLib_DecodeMetaData(rgbMetaData,sCmdResponse.wRespLength,PpsInfo);
+        if(INT_LIB_OK != i4Status)
         {
-			i4Status = (int32_t)INT_LIB_ERROR;
             break;
         }
-        //check access condition        
-        PpsACVal->psMetaData->wLen = *(PpsACVal->psMetaData->prgbStream + (bTagLocation+POS_LEN));
-        PpsACVal->psMetaData->prgbStream += (bTagLocation+POS_VAL);
-        
-        i4Status = IntLib_CheckAccessCondition(PpsACVal);
+        if((NULL != PpsCache) && (0x00 != PpsCache->bEntries))
+        {
+            psEntry = &PpsCache->psEntries[PpsCache->bNext];
+            PpsCache->bNext = (uint8_t)((PpsCache->bNext + 1) % PpsCache->bEntries);
+            psEntry->wOID = PwOID;
+            psEntry->sInfo = *PpsInfo;
+        }
+    }while(FALSE);
+    return i4Status;
+}
+
+/**
+ *
+ * Verifies the requested access condition of a data object against the life cycle states.<br>
+ * The life cycle states and decoded metadata are taken from the cache if enabled.<br>
+ * Access to LcsA and LcsG is not verified, their values are returned in PpsACVal.<br>
+ *
+ * \param[in]      PwOID            OID of the data object
+ * \param[in]      PeMetaDataTag    Type of access condition
+ * \param[in,out]  PpsACVal         Pointer for returning the life cycle states
+ *
+ * \retval    #INT_LIB_OK               Successful execution
+ * \retval    #INT_LIB_INVALID_AC       Access not permitted
+ * \retval    #INT_LIB_INVALID_RESPONSE Invalid metadata
+ * \retval    #INT_LIB_ERROR            Failure in execution
+ *
+ */
+static int32_t IntLib_VerifyObjectAC(uint16_t PwOID, eMetaDataTag_d PeMetaDataTag, sACVector_d *PpsACVal)
+{
+    int32_t i4Status  = (int32_t)INT_LIB_ERROR;
+    sIntLibCache_d* psCache = IntLib_GetCache();
+    sIntLibObjectInfo_d sInfo;
+    do
+    {
+        i4Status = IntLib_GetLcs(psCache,PpsACVal);
+        if(INT_LIB_OK != i4Status)
+        {
+           break;
+        }
+        //Do not read meta data if OID is lcsA or lcsG
+        if(((uint16_t)eLCSA == PwOID)||((uint16_t)eLCSG == PwOID))
+        {
+            break;
+        }
+        i4Status = IntLib_GetMetaData(psCache,PwOID,&sInfo);
+        if(INT_LIB_OK != i4Status)
+        {
+            break;
+        }
+        if(FALSE == IntLib_CheckAC((eREAD_AC == PeMetaDataTag) ? &sInfo.sReadAC : &sInfo.sChangeAC,
+                                   PpsACVal->bLcsA,PpsACVal->bLcsG))
+        {
+            i4Status = (int32_t)INT_LIB_INVALID_AC;
+            break;
+        }
     }while(FALSE);
-    
     return i4Status;
 }
 #endif /* MODULE_ENABLE_READ_WRITE*/
 
 #ifdef MODULE_ENABLE_ONE_WAY_AUTH
+///Cache of verified certificate chains, NULL if not enabled
+static sIntLibChainCache_d* psChainCache = NULL;
+
 /**
 *
 * Formats the Signature into DER encoded.<br>
@@ -819,19 +799,111 @@ static int32_t IntLib_GetEndEntityCertificate(uint16_t PwCertOID,sbBlob_d* PpsBl
         PpsBlobOPTIGACert->prgbStream = (uint8_t*)OCP_MALLOC(sBlobCertificate.wLen);
         if(NULL == PpsBlobOPTIGACert->prgbStream)
         {
-            i4Status = (int32_t)INT_LIB_MALLOC_FAILURE;
-            break;
+            i4Status = (int32_t)INT_LIB_MALLOC_FAILURE;
+            break;
+        }
+        OCP_MEMCPY(PpsBlobOPTIGACert->prgbStream,sBlobCertificate.prgbStream,sBlobCertificate.wLen);
+        PpsBlobOPTIGACert->wLen = sBlobCertificate.wLen;
+        i4Status = INT_LIB_OK;
+    } while (FALSE);
+
+#undef LENGTH_CERTLIST_LEN
+#undef LENGTH_CERTLEN
+#undef LENGTH_TAGlEN_PLUS_TAG
+#undef LENGTH_MINIMUM_DATA
+    return i4Status;
+}
+
+/**
+*
+* Calculates the key of a certificate chain on the host.<br>
+* The length of the CA certificate is hashed first, so the boundary between the certificates is unambiguous.<br>
+* No command is sent, so a hash calculation of the caller in progress on the security chip is not affected.<br>
+*
+* \param[in]   PpsCaCert          Pointer to CA Certificate
+* \param[in]   PpsOPTIGACert      Pointer to device certificate
+* \param[out]  PprgbKey           Buffer of #INT_LIB_CHAIN_KEY_LEN bytes for the key
+*
+* \retval    #INT_LIB_OK
+* \retval    #INT_LIB_ERROR      The cache is not enabled
+*
+*/
+static int32_t IntLib_GetChainKey(const sbBlob_d *PpsCaCert,const sbBlob_d *PpsOPTIGACert,uint8_t *PprgbKey)
+{
+    int32_t i4Status  = (int32_t)INT_LIB_ERROR;
+    sUtilSha256_d sSha;
+    uint8_t rgbCaCertLen[2];
+
+    do
+    {
+        if(NULL == psChainCache)
+        {
+            break;
+        }
+        Utility_SetUint16(rgbCaCertLen,PpsCaCert->wLen);
+        Utility_Sha256Init(&sSha);
+        Utility_Sha256Update(&sSha,rgbCaCertLen,sizeof(rgbCaCertLen));
+        Utility_Sha256Update(&sSha,PpsCaCert->prgbStream,PpsCaCert->wLen);
+        Utility_Sha256Update(&sSha,PpsOPTIGACert->prgbStream,PpsOPTIGACert->wLen);
+        Utility_Sha256Final(&sSha,PprgbKey);
+        i4Status = INT_LIB_OK;
+    }while(FALSE);
+
+    return i4Status;
+}
+
+/**
+*
+* Looks up a verified certificate chain.<br>
+*
+* \param[in]  PprgbKey     Key of the certificate chain
+*
+* \retval    Pointer to the entry, NULL if the chain was not verified before
+*
+*/
+static const sIntLibChain_d* IntLib_FindChain(const uint8_t *PprgbKey)
+{
+    const sIntLibChain_d* psChain = NULL;
+    uint8_t bIndex;
+
+    for(bIndex = 0; (NULL != psChainCache) && (bIndex < psChainCache->bEntries); bIndex++)
+    {
+        if((TRUE == psChainCache->psEntries[bIndex].bValid) &&
+           (0 == OCP_MEMCMP(psChainCache->psEntries[bIndex].rgbKey,PprgbKey,INT_LIB_CHAIN_KEY_LEN)))
+        {
+            psChain = &psChainCache->psEntries[bIndex];
+            break;
+        }
+    }
+    return psChain;
+}
+
+/**
+*
+* Adds a verified certificate chain to the cache, replacing the oldest entry.<br>
+*
+* \param[in]  PprgbKey         Key of the certificate chain
+* \param[in]  PprgbPublicKey   Public key of the device certificate
+*
+*/
+static void IntLib_AddChain(const uint8_t *PprgbKey,const uint8_t *PprgbPublicKey)
+{
+    sIntLibChain_d* psChain;
+    uint8_t bIndex;
+
+    if((NULL != psChainCache) && (0 != psChainCache->bEntries))
+    {
+        bIndex = psChainCache->bNext;
+        psChain = &psChainCache->psEntries[bIndex];
+        OCP_MEMCPY(psChain->rgbKey,PprgbKey,INT_LIB_CHAIN_KEY_LEN);
+        OCP_MEMCPY(psChain->rgbPublicKey,PprgbPublicKey,INT_LIB_CHAIN_PUBKEY_LEN);
+        psChain->bValid = TRUE;
+        psChainCache->bNext = (uint8_t)((bIndex + 1) % psChainCache->bEntries);
+        if(NULL != psChainCache->pfStore)
+        {
+            psChainCache->pfStore(psChainCache->pvStoreCtx,bIndex,psChain);
         }
-        OCP_MEMCPY(PpsBlobOPTIGACert->prgbStream,sBlobCertificate.prgbStream,sBlobCertificate.wLen);
-        PpsBlobOPTIGACert->wLen = sBlobCertificate.wLen;
-        i4Status = INT_LIB_OK;
-    } while (FALSE);
-
-#undef LENGTH_CERTLIST_LEN
-#undef LENGTH_CERTLEN
-#undef LENGTH_TAGlEN_PLUS_TAG
-#undef LENGTH_MINIMUM_DATA
-    return i4Status;
+    }
 }
 
 /**
@@ -853,6 +925,9 @@ static int32_t IntLib_VerifyPKIDomain(const sbBlob_d *PpsCaCert,uint16_t PwCertO
 	sbBlob_d sBlobOPTIGACert;
 	sCertificate_d sParsedCACert;
 	sCertificate_d sParsedOPTIGACert;
+	uint8_t rgbChainKey[INT_LIB_CHAIN_KEY_LEN];
+	const sIntLibChain_d* psChain;
+	bool_t bChainKey = FALSE;
 
 	do 
 	{
@@ -863,6 +938,17 @@ static int32_t IntLib_VerifyPKIDomain(const sbBlob_d *PpsCaCert,uint16_t PwCertO
 		{
 			break;
 		}
+		//Skip the verification of a chain verified before, the challenge is verified with its cached public key
+		if(INT_LIB_OK == IntLib_GetChainKey(PpsCaCert,&sBlobOPTIGACert,rgbChainKey))
+		{
+			bChainKey = TRUE;
+			psChain = IntLib_FindChain(rgbChainKey);
+			if(NULL != psChain)
+			{
+				OCP_MEMCPY(PpsOPTIGAPublicKey->prgbStream,psChain->rgbPublicKey,INT_LIB_CHAIN_PUBKEY_LEN);
+				break;
+			}
+		}
 		//Parse CA certificate
 		sParsedCACert.sPublicKey.prgbStream = rgbCAPublicKey;
 		sParsedCACert.sPublicKey.wLen = sizeof(rgbCAPublicKey);
@@ -885,6 +971,10 @@ static int32_t IntLib_VerifyPKIDomain(const sbBlob_d *PpsCaCert,uint16_t PwCertO
 		{
 			break;
 		}
+		if(TRUE == bChainKey)
+		{
+			IntLib_AddChain(rgbChainKey,PpsOPTIGAPublicKey->prgbStream);
+		}
 	} while (FALSE);
     //Clear allocated memory
 	if(NULL != sBlobOPTIGACert.prgbStream)
@@ -1003,7 +1093,8 @@ static int32_t IntLib_AuthenticateEndEntity(uint16_t PwChallengeLen,sbBlob_d *Pp
 *
 * - Reads the device certificate from the security chip, as specified by \ref sOneWayAuth_d.wOIDDevCertificate.<br>
 *
-* - Verifies the device certificate signature using the public key from CA certificate \ref sOneWayAuth_d.sCaCert.<br>
+* - Verifies the device certificate signature using the public key from CA certificate \ref sOneWayAuth_d.sCaCert.
+*   If the chain cache is enabled with #IntLib_InitChainCache and the chain was verified before, the cached public key is used instead.<br>
 *
 * - A random number of length \ref sOneWayAuth_d.wChallengeLen is generated on the host. This is used as a challenge to be sent to the security chip.<br>
 *
@@ -1095,6 +1186,79 @@ int32_t IntLib_Authenticate(const sOneWayAuth_d *PpsOneWayAuth)
 }
 
 
+/**
+* Enables the cache of certificate chains verified by #IntLib_Authenticate. An authentication with a chain
+* found in the cache skips parsing and verifying the certificates, only the challenge signature is verified.
+*
+* Notes: <br>
+* - A chain is identified by the SHA256 over the length of the CA certificate, the CA certificate and the device
+*   certificate read from the security chip. The hash is calculated on the host, so an enabled cache sends no
+*   additional commands and does not touch a hash calculation in progress on the security chip.<br>
+* - The challenge signature is always verified with the public key stored in the cache, not with the one in the
+*   presented certificate. A security chip can therefore not authenticate with a key it does not own.<br>
+* - The entries are used as given, so chains persisted earlier can be restored into them before the cache is enabled.
+*   Entries with bValid not TRUE are free. Persisted entries must be protected against modification, since a modified
+*   public key is trusted without verification.<br>
+* - PpfStore is invoked for every changed entry with its index, e.g. to persist it.<br>
+* - The cache is shared by all security chips. The cache and entries must stay valid as long as the cache is enabled.
+*   A NULL cache disables the cache.<br>
+*
+* \param[in,out]  PpsCache       Pointer to the cache
+* \param[in,out]  PpsEntries     Entries for the verified chains
+* \param[in]      PbEntries      Number of entries
+* \param[in]      PpfStore       Callback invoked for every changed entry, can be NULL
+* \param[in]      PpvStoreCtx    User context passed to PpfStore
+*/
+void IntLib_InitChainCache(sIntLibChainCache_d *PpsCache, sIntLibChain_d *PpsEntries, uint8_t PbEntries,
+                           pFIntLibChainStore_d PpfStore, void* PpvStoreCtx)
+{
+    uint8_t bIndex;
+
+    if(NULL != PpsCache)
+    {
+        PpsCache->psEntries = PpsEntries;
+        PpsCache->bEntries = (NULL != PpsEntries) ? PbEntries : 0;
+        PpsCache->pfStore = PpfStore;
+        PpsCache->pvStoreCtx = PpvStoreCtx;
+        //Fill free entries first
+        PpsCache->bNext = 0;
+        for(bIndex = 0; bIndex < PpsCache->bEntries; bIndex++)
+        {
+            if(TRUE != PpsEntries[bIndex].bValid)
+            {
+                PpsCache->bNext = bIndex;
+                break;
+            }
+        }
+    }
+    psChainCache = PpsCache;
+}
+
+/**
+* Drops all verified certificate chains, e.g. once a CA certificate is no longer trusted.
+* The store callback is invoked for every dropped entry.
+*/
+void IntLib_FlushChainCache(void)
+{
+    uint8_t bIndex;
+
+    for(bIndex = 0; (NULL != psChainCache) && (bIndex < psChainCache->bEntries); bIndex++)
+    {
+        if(TRUE == psChainCache->psEntries[bIndex].bValid)
+        {
+            OCP_MEMSET((uint8_t*)&psChainCache->psEntries[bIndex],0,sizeof(sIntLibChain_d));
+            if(NULL != psChainCache->pfStore)
+            {
+                psChainCache->pfStore(psChainCache->pvStoreCtx,bIndex,&psChainCache->psEntries[bIndex]);
+            }
+        }
+    }
+    if(NULL != psChainCache)
+    {
+        psChainCache->bNext = 0;
+    }
+}
+
 #endif /* MODULE_ENABLE_ONE_WAY_AUTH*/
 
 #ifdef MODULE_ENABLE_READ_WRITE
@@ -1117,6 +1281,8 @@ int32_t IntLib_Authenticate(const sOneWayAuth_d *PpsOneWayAuth)
 * - Under some erroneous conditions,error codes from Command Library and Crypto Library can also be returned.<br> 
 * - If the return code is #CMD_DEV_EXEC_ERROR, it might indicate that the application on the
 *   security chip is either closed or a reset has occurred. In such a case, user must invoke #CmdLib_OpenApplication before attempting any interaction with the security chip.<br>
+* - If the cache is enabled with #IntLib_InitCache, the life cycle states and metadata are read only once
+*   and a read of a known data object takes a single command.<br>
 *
 *
 * \param[in]  PpsGDVector         Pointer to Get Data parameters
@@ -1132,15 +1298,39 @@ int32_t IntLib_Authenticate(const sOneWayAuth_d *PpsOneWayAuth)
 * \retval    #CMD_DEV_EXEC_ERROR          
 */
 int32_t IntLib_ReadGPData(const sReadGPData_d *PpsGDVector, sbBlob_d *PpsGPData)
+{
+    return IntLib_ReadGPDataEx(PpsGDVector,PpsGPData,eAC_CHECK);
+}
+
+/**
+* Reads the specified general purpose data object from the security chip as #IntLib_ReadGPData.
+*
+* Notes: <br>
+* - With #eAC_SKIP the access conditions are not verified on the host and the data object is read with
+*   a single command. The security chip rejects the read if it is not permitted. LcsA and LcsG are then
+*   read as any other data object.<br>
+* - If the data object could not be read after the access conditions were verified, the cache is dropped.<br>
+*
+* \param[in]  PpsGDVector         Pointer to Get Data parameters
+* \param[in,out]  PpsGPData           Pointer to data buffer for response
+* \param[in]  PeACCheck           Verification of the access conditions on the host
+*
+* \retval    #INT_LIB_OK   
+* \retval    #INT_LIB_NULL_PARAM     
+* \retval    #INT_LIB_INVALID_RESPONSE    
+* \retval    #INT_LIB_INVALID_AC     
+* \retval    #INT_LIB_ZEROLEN_ERROR     
+* \retval    #INT_LIB_ERROR       
+* \retval    #CMD_DEV_ERROR     
+* \retval    #CMD_DEV_EXEC_ERROR          
+*/
+int32_t IntLib_ReadGPDataEx(const sReadGPData_d *PpsGDVector, sbBlob_d *PpsGPData, eIntLibACCheck_d PeACCheck)
 {
     //lint --e{818} suppress "PpsGPData is out parameter"
     int32_t i4Status  = (int32_t)INT_LIB_ERROR;
     sGetData_d sGDVector;
     sCmdResponse_d sCmdResponse;
-    uint8_t prgbMetaData[LENGTH_METADATA];
-    sbBlob_d sMetaData = {LENGTH_METADATA,prgbMetaData};
     sACVector_d sReadACVector;
-    uint8_t bRecvMetaDataLen;
     do
     {
         if((NULL == PpsGDVector)||(NULL == PpsGPData)||(NULL == PpsGPData->prgbStream))
@@ -1155,63 +1345,29 @@ int32_t IntLib_ReadGPData(const sReadGPData_d *PpsGDVector, sbBlob_d *PpsGPData)
             break;
         }
 
-		//Read lcsA
-        i4Status = IntLib_ReadLcs(eLCSA,&(sReadACVector.bLcsA));
-        if(INT_LIB_OK != i4Status)
-        {
-           break; 
-        }
-        //Read lcsG
-        i4Status = IntLib_ReadLcs(eLCSG,&(sReadACVector.bLcsG));
-        if(INT_LIB_OK != i4Status)
-        {
-           break; 
-        }    
-        //check if OID is for lcsA or lcaG
-        if((uint16_t)eLCSA == PpsGDVector->wOID)
-        {
-            //return the read value
-            *(PpsGPData->prgbStream) = sReadACVector.bLcsA;
-            PpsGPData->wLen = 0x01;
-            break;
-        }
-        if((uint16_t)eLCSG == PpsGDVector->wOID)
-        {
-            //return the read value
-            *(PpsGPData->prgbStream) = sReadACVector.bLcsG;
-            PpsGPData->wLen = 0x01;
-            break;
-        }
-            
-        //Get metadata of oid
-        sGDVector.wOID = PpsGDVector->wOID;
-        sGDVector.wLength = LENGTH_METADATA;
-        sGDVector.wOffset = 0;
-        sGDVector.eDataOrMdata = eMETA_DATA;
-        
-        sCmdResponse.prgbBuffer = prgbMetaData;
-        sCmdResponse.wBufferLength = sizeof(prgbMetaData);
-        sCmdResponse.wRespLength = 0;
-
-        i4Status = CmdLib_GetDataObject(&sGDVector,&sCmdResponse);
-        if(CMD_LIB_OK != i4Status)
-        {
-            break;
-        }        
-        //Check the length
-        bRecvMetaDataLen = *(sCmdResponse.prgbBuffer + POS_LEN );
-        if((bRecvMetaDataLen != (sCmdResponse.wRespLength-POS_VAL)))
-        {
-            i4Status = (int32_t)INT_LIB_INVALID_RESPONSE;
-            break;
-        }
-        //Check read access condition
-        sReadACVector.psMetaData = &sMetaData;
-        i4Status = IntLib_VerifyAC(eREAD_AC,&sReadACVector);
-        if(INT_LIB_OK != i4Status)
+        if(eAC_CHECK == PeACCheck)
         {
-            i4Status = (int32_t)INT_LIB_INVALID_AC;
-            break;
+            //Check read access condition
+            i4Status = IntLib_VerifyObjectAC(PpsGDVector->wOID,eREAD_AC,&sReadACVector);
+            if(INT_LIB_OK != i4Status)
+            {
+                break;
+            }
+            //check if OID is for lcsA or lcaG
+            if((uint16_t)eLCSA == PpsGDVector->wOID)
+            {
+                //return the read value
+                *(PpsGPData->prgbStream) = sReadACVector.bLcsA;
+                PpsGPData->wLen = 0x01;
+                break;
+            }
+            if((uint16_t)eLCSG == PpsGDVector->wOID)
+            {
+                //return the read value
+                *(PpsGPData->prgbStream) = sReadACVector.bLcsG;
+                PpsGPData->wLen = 0x01;
+                break;
+            }
         }
         //If access condition satisfied, get the data
         sGDVector.wOID = PpsGDVector->wOID;
@@ -1226,6 +1382,11 @@ int32_t IntLib_ReadGPData(const sReadGPData_d *PpsGDVector, sbBlob_d *PpsGPData)
         i4Status = CmdLib_GetDataObject(&sGDVector,&sCmdResponse);
         if(CMD_LIB_OK != i4Status)
         {
+            //The cached access conditions may be outdated
+            if(eAC_CHECK == PeACCheck)
+            {
+                IntLib_FlushCache();
+            }
             break;
         }
         PpsGPData->wLen = sCmdResponse.wRespLength;
@@ -1259,6 +1420,8 @@ int32_t IntLib_ReadGPData(const sReadGPData_d *PpsGDVector, sbBlob_d *PpsGPData)
 * - Under some erroneous conditions,error codes from Command Library and Crypto Library can also be returned.<br>
 * - If the return code is #CMD_DEV_EXEC_ERROR, it might indicate that the application on the
 *   security chip is either closed or a reset has occurred. In such a case, user must invoke #CmdLib_OpenApplication before attempting any interaction with the security chip.<br>
+* - If the cache is enabled with #IntLib_InitCache, the life cycle states and metadata are read only once.
+*   Writing LcsA or LcsG drops the cache.<br>
 *
 *
 * \param[in]  PpsSDVector         Pointer to Set Data parameters
@@ -1273,14 +1436,32 @@ int32_t IntLib_ReadGPData(const sReadGPData_d *PpsGDVector, sbBlob_d *PpsGPData)
 */
 int32_t IntLib_WriteGPData(const sWriteGPData_d *PpsSDVector)
 {
-    int32_t i4Status  = (int32_t)INT_LIB_ERROR;
-    uint8_t prgbMetaData[LENGTH_METADATA];
-    uint8_t bRecvMetaDataLen;
+    return IntLib_WriteGPDataEx(PpsSDVector,eAC_CHECK);
+}
 
+/**
+* Writes to the specified general purpose data object to the security chip as #IntLib_WriteGPData.
+*
+* Notes: <br>
+* - With #eAC_SKIP the access conditions are not verified on the host and the data object is written with
+*   a single command. The security chip rejects the write if it is not permitted.<br>
+* - If the data object could not be written after the access conditions were verified, the cache is dropped.<br>
+*
+* \param[in]  PpsSDVector         Pointer to Set Data parameters
+* \param[in]  PeACCheck           Verification of the access conditions on the host
+*
+* \retval    #INT_LIB_OK       
+* \retval    #INT_LIB_NULL_PARAM     
+* \retval    #INT_LIB_INVALID_RESPONSE     
+* \retval    #INT_LIB_INVALID_AC    
+* \retval    #INT_LIB_ERROR      
+* \retval    #CMD_DEV_ERROR     
+* \retval    #CMD_DEV_EXEC_ERROR    
+*/
+int32_t IntLib_WriteGPDataEx(const sWriteGPData_d *PpsSDVector, eIntLibACCheck_d PeACCheck)
+{
+    int32_t i4Status  = (int32_t)INT_LIB_ERROR;
     sSetData_d sSDVector;
-    sGetData_d sGDVector;
-    sCmdResponse_d sCmdResponse;
-    sbBlob_d sMetaData = {LENGTH_METADATA,prgbMetaData};
     sACVector_d sWriteACVector;
 
     do
@@ -1296,52 +1477,12 @@ int32_t IntLib_WriteGPData(const sWriteGPData_d *PpsSDVector)
             break;
         }
         
-        //Read lcsA
-        i4Status = IntLib_ReadLcs(eLCSA,&(sWriteACVector.bLcsA));
-        if(INT_LIB_OK != i4Status)
+        if(eAC_CHECK == PeACCheck)
         {
-           break; 
-        }
-        //Read lcsG
-        i4Status = IntLib_ReadLcs(eLCSG,&(sWriteACVector.bLcsG));
-        if(INT_LIB_OK != i4Status)
-        {
-           break; 
-        }   
-
-        //Do not read meta data if OID is lcsA or lcsG
-        if(((uint16_t)eLCSA != PpsSDVector->wOID)&&
-            ((uint16_t)eLCSG != PpsSDVector->wOID))
-        {
-            //Get metada data of oid
-            sGDVector.wOID = PpsSDVector->wOID;
-            sGDVector.wLength = LENGTH_METADATA;
-            sGDVector.wOffset = 0;
-            sGDVector.eDataOrMdata = eMETA_DATA;
-            
-            sCmdResponse.prgbBuffer = prgbMetaData;
-            sCmdResponse.wBufferLength = sizeof(prgbMetaData);
-            sCmdResponse.wRespLength = 0;
-
-            i4Status = CmdLib_GetDataObject(&sGDVector,&sCmdResponse);
-            if(CMD_LIB_OK != i4Status)
-            {
-                break;
-            }        
-            //Check the length
-            bRecvMetaDataLen = *(sCmdResponse.prgbBuffer + POS_LEN );
-            //response length contains data + 2 byte Tag,Len
-            if((bRecvMetaDataLen != (sCmdResponse.wRespLength-2)))
-            {
-                i4Status = (int32_t)INT_LIB_INVALID_RESPONSE;
-                break;
-            }         
             //Check change access condition
-            sWriteACVector.psMetaData = &sMetaData;
-            i4Status = IntLib_VerifyAC(eCHANGE_AC,&sWriteACVector);
+            i4Status = IntLib_VerifyObjectAC(PpsSDVector->wOID,eCHANGE_AC,&sWriteACVector);
             if(INT_LIB_OK != i4Status)
             {
-                i4Status = (int32_t)INT_LIB_INVALID_AC;
                 break;
             }
         }
@@ -1356,10 +1497,225 @@ int32_t IntLib_WriteGPData(const sWriteGPData_d *PpsSDVector)
         i4Status = CmdLib_SetDataObject(&sSDVector);
         if(CMD_LIB_OK != i4Status)
         {
+            //The cached access conditions may be outdated
+            if(eAC_CHECK == PeACCheck)
+            {
+                IntLib_FlushCache();
+            }
             break;
         }   
         i4Status = INT_LIB_OK;
     }while(FALSE);
     return i4Status;
 }
+
+/**
+* Decodes the metadata of a data object, so its access conditions can be verified without parsing it again.
+*
+* Notes: <br>
+* - PprgbMetaData is the metadata as read from the security chip, starting with tag 0x20.<br>
+* - bTags of the decoded metadata indicates which of the decoded tags are present. Other tags are ignored.<br>
+* - The access conditions are decoded into terms of permitted LcsA and LcsG ranges, see #IntLib_CheckAC.
+*   Comparisons with LcsO are resolved with the life cycle state in the metadata.<br>
+* - An absent access condition is decoded as never met. Decoding an access condition stops at an invalid or unsupported
+*   coding, e.g. a condition on authorization or integrity. The security chip always enforces the access conditions itself.<br>
+*
+* \param[in]   PprgbMetaData   Pointer to the metadata
+* \param[in]   PwLen           Length of the metadata
+* \param[out]  PpsInfo         Pointer to the decoded metadata
+*
+* \retval    #INT_LIB_OK
+* \retval    #INT_LIB_NULL_PARAM
+* \retval    #INT_LIB_INVALID_RESPONSE   The TLV encoding is invalid or a tag is duplicated
+*/
+int32_t IntLib_DecodeMetaData(const uint8_t *PprgbMetaData, uint16_t PwLen, sIntLibObjectInfo_d *PpsInfo)
+{
+    int32_t i4Status  = (int32_t)INT_LIB_INVALID_RESPONSE;
+    const uint8_t* prgbValue;
+    const uint8_t* prgbReadAC = NULL;
+    const uint8_t* prgbChangeAC = NULL;
+    uint8_t bReadACLen = 0;
+    uint8_t bChangeACLen = 0;
+    uint16_t wPos;
+    uint16_t wEnd;
+    uint8_t bLen;
+    uint8_t bFlag;
+
+    do
+    {
+        if((NULL == PprgbMetaData) || (NULL == PpsInfo))
+        {
+            i4Status = (int32_t)INT_LIB_NULL_PARAM;
+            break;
+        }
+        OCP_MEMSET((uint8_t*)PpsInfo,0,sizeof(sIntLibObjectInfo_d));
+        if((PwLen < TLV_HEADER_SIZE) || (METADATA_TAG != PprgbMetaData[0]) ||
+           ((PprgbMetaData[POS_LEN] + TLV_HEADER_SIZE) > PwLen))
+        {
+            break;
+        }
+
+        wEnd = PprgbMetaData[POS_LEN] + TLV_HEADER_SIZE;
+        for(wPos = TLV_HEADER_SIZE; (wPos + TLV_HEADER_SIZE) <= wEnd; wPos += TLV_HEADER_SIZE + bLen)
+        {
+            bLen = PprgbMetaData[wPos + POS_LEN];
+            prgbValue = &PprgbMetaData[wPos + POS_VAL];
+            if((wPos + TLV_HEADER_SIZE + bLen) > wEnd)
+            {
+                break;
+            }
+            switch((eMetaDataTag_d)PprgbMetaData[wPos])
+            {
+                case eLCSO:
+                    bFlag = 0xFF;
+                    if(1 == bLen)
+                    {
+                        bFlag = INT_LIB_META_LCSO;
+                        PpsInfo->bLcsO = prgbValue[0];
+                    }
+                    break;
+
+                case eMAX_SIZE:
+                    bFlag = 0xFF;
+                    if((1 == bLen) || (2 == bLen))
+                    {
+                        bFlag = INT_LIB_META_MAX_SIZE;
+                        PpsInfo->wMaxSize = (2 == bLen) ? Utility_GetUint16(prgbValue) : prgbValue[0];
+                    }
+                    break;
+
+                case eUSED_SIZE:
+                    bFlag = 0xFF;
+                    if((1 == bLen) || (2 == bLen))
+                    {
+                        bFlag = INT_LIB_META_USED_SIZE;
+                        PpsInfo->wUsedSize = (2 == bLen) ? Utility_GetUint16(prgbValue) : prgbValue[0];
+                    }
+                    break;
+
+                case eDATA_TYPE:
+                    bFlag = 0xFF;
+                    if(1 == bLen)
+                    {
+                        bFlag = INT_LIB_META_TYPE;
+                        PpsInfo->bType = prgbValue[0];
+                    }
+                    break;
+
+                case eREAD_AC:
+                    bFlag = INT_LIB_META_READ_AC;
+                    prgbReadAC = prgbValue;
+                    bReadACLen = bLen;
+                    break;
+
+                case eCHANGE_AC:
+                    bFlag = INT_LIB_META_CHANGE_AC;
+                    prgbChangeAC = prgbValue;
+                    bChangeACLen = bLen;
+                    break;
+
+                default:
+                    bFlag = 0x00;
+                    break;
+            }
+            //Invalid length or duplicated tag
+            if((0xFF == bFlag) || (0x00 != (PpsInfo->bTags & bFlag)))
+            {
+                break;
+            }
+            PpsInfo->bTags |= bFlag;
+        }
+        if(wPos != wEnd)
+        {
+            OCP_MEMSET((uint8_t*)PpsInfo,0,sizeof(sIntLibObjectInfo_d));
+            break;
+        }
+
+        //LcsO is known now
+        if(NULL != prgbReadAC)
+        {
+            IntLib_DecodeAC(prgbReadAC,bReadACLen,PpsInfo->bLcsO,&PpsInfo->sReadAC);
+        }
+        if(NULL != prgbChangeAC)
+        {
+            IntLib_DecodeAC(prgbChangeAC,bChangeACLen,PpsInfo->bLcsO,&PpsInfo->sChangeAC);
+        }
+        i4Status = INT_LIB_OK;
+    }while(FALSE);
+
+    return i4Status;
+}
+
+/**
+* Verifies a decoded access condition against the life cycle states. The condition is met if LcsA and LcsG
+* are within the ranges of any of its terms, so the verification takes at most #INT_LIB_AC_MAX_TERMS comparisons
+* of each life cycle state.
+*
+* \param[in]  PpsAC      Pointer to the access condition decoded with #IntLib_DecodeMetaData
+* \param[in]  PbLcsA     Application life cycle state
+* \param[in]  PbLcsG     Global life cycle state
+*
+* \retval    TRUE     The access condition is met
+* \retval    FALSE    The access condition is not met
+*/
+bool_t IntLib_CheckAC(const sIntLibAC_d *PpsAC, uint8_t PbLcsA, uint8_t PbLcsG)
+{
+    bool_t bMet = FALSE;
+    const sIntLibACTerm_d* psTerm;
+    uint8_t bIndex;
+
+    for(bIndex = 0; (NULL != PpsAC) && (bIndex < PpsAC->bTerms) && (bIndex < INT_LIB_AC_MAX_TERMS); bIndex++)
+    {
+        psTerm = &PpsAC->rgsTerm[bIndex];
+        if((PbLcsA >= psTerm->bLcsAMin) && (PbLcsA <= psTerm->bLcsAMax) &&
+           (PbLcsG >= psTerm->bLcsGMin) && (PbLcsG <= psTerm->bLcsGMax))
+        {
+            bMet = TRUE;
+            break;
+        }
+    }
+    return bMet;
+}
+
+/**
+* Enables the cache of the life cycle states and of the metadata of data objects for the security chip
+* selected with #CmdLib_SelectContext.
+*
+* Notes: <br>
+* - The cache is dropped whenever a command which may change metadata or life cycle states is sent through
+*   the command library, i.e. #CmdLib_OpenApplication, writing metadata and writing LcsA or LcsG.<br>
+* - If metadata or life cycle states are changed in another way, e.g. by another host, #IntLib_FlushCache must be invoked.<br>
+* - The metadata is cached in its decoded form and used to verify access conditions only. The used size of a data object is not updated by writes.<br>
+* - The cache and entries must stay valid as long as the cache is enabled. A NULL cache disables the cache.<br>
+*
+* \param[in,out]  PpsCache       Pointer to the cache
+* \param[in]      PpsEntries     Entries for the metadata of data objects, can be NULL to cache only the life cycle states
+* \param[in]      PbEntries      Number of entries
+*/
+void IntLib_InitCache(sIntLibCache_d *PpsCache, sIntLibMetaData_d *PpsEntries, uint8_t PbEntries)
+{
+    sCmdLibContext_d* psContext = IntLib_GetContext();
+
+    if(NULL != PpsCache)
+    {
+        PpsCache->psEntries = PpsEntries;
+        PpsCache->bEntries = (NULL != PpsEntries) ? PbEntries : 0;
+        IntLib_ClearCache(PpsCache);
+        PpsCache->wStateVersion = psContext->wStateVersion;
+    }
+    psContext->psIntLibCache = PpsCache;
+}
+
+/**
+* Drops the cached life cycle states and metadata of the security chip selected with #CmdLib_SelectContext.
+*/
+void IntLib_FlushCache(void)
+{
+    sCmdLibContext_d* psContext = IntLib_GetContext();
+
+    if(NULL != psContext->psIntLibCache)
+    {
+        IntLib_ClearCache(psContext->psIntLibCache);
+    }
+}
 #endif /* MODULE_ENABLE_READ_WRITE*/
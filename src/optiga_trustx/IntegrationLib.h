@@ -118,6 +118,140 @@ typedef struct sWriteGPData_d
 }sWriteGPData_d;
 
 
+///Maximum length of the metadata of a data object
+#define INT_LIB_METADATA_MAX_LEN            0x1C
+
+/**
+ * \brief Enumeration to specify the verification of the access conditions on the host.
+ */
+typedef enum eIntLibACCheck_d
+{
+    ///Verify the access conditions, the life cycle states and metadata are taken from the cache if enabled
+    eAC_CHECK,
+
+    ///Skip the verification on the host, the data object is accessed with a single command.
+    ///The security chip still enforces the access conditions.
+    eAC_SKIP
+}eIntLibACCheck_d;
+
+///Maximum number of terms of a decoded access condition
+#define INT_LIB_AC_MAX_TERMS                4
+
+///The metadata contains the life cycle state of the data object
+#define INT_LIB_META_LCSO                   0x01
+
+///The metadata contains the maximum size
+#define INT_LIB_META_MAX_SIZE               0x02
+
+///The metadata contains the used size
+#define INT_LIB_META_USED_SIZE              0x04
+
+///The metadata contains the data object type
+#define INT_LIB_META_TYPE                   0x08
+
+///The metadata contains the read access condition
+#define INT_LIB_META_READ_AC                0x10
+
+///The metadata contains the change access condition
+#define INT_LIB_META_CHANGE_AC              0x20
+
+/**
+ * \brief Term of a decoded access condition, met if LcsA and LcsG are within the ranges.
+ */
+typedef struct sIntLibACTerm_d
+{
+    ///Lowest permitted LcsA
+    uint8_t bLcsAMin;
+
+    ///Highest permitted LcsA
+    uint8_t bLcsAMax;
+
+    ///Lowest permitted LcsG
+    uint8_t bLcsGMin;
+
+    ///Highest permitted LcsG
+    uint8_t bLcsGMax;
+}sIntLibACTerm_d;
+
+/**
+ * \brief Decoded access condition, met if any of its terms is met. Without terms it is never met.
+ */
+typedef struct sIntLibAC_d
+{
+    ///Alternative terms
+    sIntLibACTerm_d rgsTerm[INT_LIB_AC_MAX_TERMS];
+
+    ///Number of terms
+    uint8_t bTerms;
+}sIntLibAC_d;
+
+/**
+ * \brief Metadata of a data object decoded with #IntLib_DecodeMetaData.
+ */
+typedef struct sIntLibObjectInfo_d
+{
+    ///INT_LIB_META_* flags of the tags present in the metadata
+    uint8_t bTags;
+
+    ///Life cycle state of the data object, 0 if not present
+    uint8_t bLcsO;
+
+    ///Data object type, 0 if not present
+    uint8_t bType;
+
+    ///Maximum size, 0 if not present
+    uint16_t wMaxSize;
+
+    ///Used size, 0 if not present
+    uint16_t wUsedSize;
+
+    ///Read access condition
+    sIntLibAC_d sReadAC;
+
+    ///Change access condition
+    sIntLibAC_d sChangeAC;
+}sIntLibObjectInfo_d;
+
+/**
+ * \brief Cached metadata of one data object.
+ */
+typedef struct sIntLibMetaData_d
+{
+    ///OID of the data object, 0 if the entry is not used
+    uint16_t wOID;
+
+    ///Decoded metadata
+    sIntLibObjectInfo_d sInfo;
+}sIntLibMetaData_d;
+
+/**
+ * \brief Cache of the life cycle states and of the metadata of data objects of one security chip.
+ * Enable it with #IntLib_InitCache.
+ */
+typedef struct sIntLibCache_d
+{
+    ///Entries for the metadata of data objects
+    sIntLibMetaData_d* psEntries;
+
+    ///Number of entries
+    uint8_t bEntries;
+
+    ///Entry replaced by the next metadata read
+    uint8_t bNext;
+
+    ///TRUE if bLcsA and bLcsG are cached
+    bool_t bLcsValid;
+
+    ///Application life cycle state
+    uint8_t bLcsA;
+
+    ///Global life cycle state
+    uint8_t bLcsG;
+
+    ///State version of the command library context the cached values belong to
+    uint16_t wStateVersion;
+}sIntLibCache_d;
+
 /**
  * \brief Structure to specify inputs for One-Way Authentication Public Key Scheme
  */
@@ -136,6 +270,53 @@ typedef struct sOneWayAuth_d
 	uint16_t wChallengeLen;
 }sOneWayAuth_d;
 
+///Length of the key of a verified certificate chain
+#define INT_LIB_CHAIN_KEY_LEN               32
+
+///Length of the device public key kept with a verified certificate chain
+#define INT_LIB_CHAIN_PUBKEY_LEN            0x41
+
+/**
+ * \brief Certificate chain verified by #IntLib_Authenticate.
+ */
+typedef struct sIntLibChain_d
+{
+    ///SHA256 over the length of the CA certificate, the CA certificate and the device certificate
+    uint8_t rgbKey[INT_LIB_CHAIN_KEY_LEN];
+
+    ///Public key of the device certificate
+    uint8_t rgbPublicKey[INT_LIB_CHAIN_PUBKEY_LEN];
+
+    ///TRUE if the entry holds a verified chain
+    bool_t bValid;
+}sIntLibChain_d;
+
+/**
+ * \brief Callback invoked whenever an entry of the chain cache was changed, e.g. to persist it.
+ */
+typedef void (*pFIntLibChainStore_d)(void* PpvStoreCtx, uint8_t PbIndex, const sIntLibChain_d* PpsChain);
+
+/**
+ * \brief Cache of verified certificate chains. Enable it with #IntLib_InitChainCache.
+ */
+typedef struct sIntLibChainCache_d
+{
+    ///Entries for the verified chains
+    sIntLibChain_d* psEntries;
+
+    ///Number of entries
+    uint8_t bEntries;
+
+    ///Entry replaced by the next verified chain
+    uint8_t bNext;
+
+    ///Invoked for every changed entry, can be NULL
+    pFIntLibChainStore_d pfStore;
+
+    ///User context passed to pfStore
+    void* pvStoreCtx;
+}sIntLibChainCache_d;
+
 
 #ifdef MODULE_ENABLE_ONE_WAY_AUTH
 /**
@@ -144,6 +325,17 @@ typedef struct sOneWayAuth_d
 */
 LIBRARY_EXPORTS int32_t IntLib_Authenticate(const sOneWayAuth_d *PpsOneWayAuth);
 
+/**
+ * \brief Enables the cache of certificate chains verified by #IntLib_Authenticate.
+ */
+LIBRARY_EXPORTS void IntLib_InitChainCache(sIntLibChainCache_d *PpsCache, sIntLibChain_d *PpsEntries, uint8_t PbEntries,
+                                           pFIntLibChainStore_d PpfStore, void* PpvStoreCtx);
+
+/**
+ * \brief Drops all verified certificate chains, e.g. once a CA certificate is no longer trusted.
+ */
+LIBRARY_EXPORTS void IntLib_FlushChainCache(void);
+
 #endif /* MODULE_ENABLE_ONE_WAY_AUTH*/
 
 #ifdef MODULE_ENABLE_READ_WRITE
@@ -157,6 +349,36 @@ LIBRARY_EXPORTS int32_t IntLib_ReadGPData(const sReadGPData_d *PpsGDVector, sbBl
  */
 LIBRARY_EXPORTS int32_t IntLib_WriteGPData(const sWriteGPData_d *PpsGDVector);
 
+/**
+ * \brief Read the specified general purpose data object, with or without verifying the access conditions on the host.
+ */
+LIBRARY_EXPORTS int32_t IntLib_ReadGPDataEx(const sReadGPData_d *PpsGDVector, sbBlob_d *PpsGPData, eIntLibACCheck_d PeACCheck);
+
+/**
+ * \brief Write to the specified general purpose data object, with or without verifying the access conditions on the host.
+ */
+LIBRARY_EXPORTS int32_t IntLib_WriteGPDataEx(const sWriteGPData_d *PpsSDVector, eIntLibACCheck_d PeACCheck);
+
+/**
+ * \brief Decodes the metadata of a data object for the verification of its access conditions.
+ */
+LIBRARY_EXPORTS int32_t IntLib_DecodeMetaData(const uint8_t *PprgbMetaData, uint16_t PwLen, sIntLibObjectInfo_d *PpsInfo);
+
+/**
+ * \brief Verifies a decoded access condition against the life cycle states.
+ */
+LIBRARY_EXPORTS bool_t IntLib_CheckAC(const sIntLibAC_d *PpsAC, uint8_t PbLcsA, uint8_t PbLcsG);
+
+/**
+ * \brief Enables the cache of life cycle states and metadata for the selected security chip.
+ */
+LIBRARY_EXPORTS void IntLib_InitCache(sIntLibCache_d *PpsCache, sIntLibMetaData_d *PpsEntries, uint8_t PbEntries);
+
+/**
+ * \brief Drops the cached life cycle states and metadata of the selected security chip.
+ */
+LIBRARY_EXPORTS void IntLib_FlushCache(void);
+
 #endif /* MODULE_ENABLE_READ_WRITE*/
 
 #ifdef __cplusplus
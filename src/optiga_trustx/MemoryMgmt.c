@@ -0,0 +1,297 @@
+/**
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+*
+* \file
+*
+* \brief This file implements the allocators behind the memory management macros.
+*
+*
+* \ingroup  grMemMgmt
+*
+*/
+
+#include <stdlib.h>
+#include <stdint.h>
+#include "MemoryMgmt.h"
+
+/// @cond hidden
+
+///Alignment of the pool blocks
+#define MEM_BLOCK_ALIGN         (sizeof(void*))
+
+//Allocator selected by MemMgmt_SetAllocator, the heap is used if pfMalloc is NULL
+static sMemAllocator_d sMemAllocator = {NULL, NULL, NULL};
+
+//Allocation counters
+static sMemStats_d sMemStats = {0, 0, 0, 0, 0};
+
+/**
+ * \brief Allocates from the heap.
+ */
+_STATIC_H void* MemMgmt_HeapMalloc(uint32_t PdwSize)
+{
+    void* pvBlock = NULL;
+
+#if (SIZE_MAX < UINT32_MAX)
+    //size_t is 16 bit on some targets, fail instead of allocating a truncated size
+    if(PdwSize <= SIZE_MAX)
+#endif
+    {
+        pvBlock = malloc((size_t)PdwSize);
+    }
+    if(NULL != pvBlock)
+    {
+        sMemStats.dwHeapAllocs++;
+    }
+    return pvBlock;
+}
+
+/**
+ * \brief Allocates a block of the pool, or from the heap if enabled and the pool can not serve the allocation.
+ */
+_STATIC_H void* MemMgmt_PoolMalloc(void* PpvCtx, uint32_t PdwSize)
+{
+    sMemPool_d* psPool = (sMemPool_d*)PpvCtx;
+    void* pvBlock = NULL;
+
+    do
+    {
+        if((PdwSize <= psPool->wBlockSize) && (NULL != psPool->pvFreeList))
+        {
+            pvBlock = psPool->pvFreeList;
+            psPool->pvFreeList = *(void**)pvBlock;
+            sMemStats.dwPoolAllocs++;
+            sMemStats.wBlocksInUse++;
+            if(sMemStats.wBlocksInUse > sMemStats.wPeakBlocksInUse)
+            {
+                sMemStats.wPeakBlocksInUse = sMemStats.wBlocksInUse;
+            }
+            break;
+        }
+        if(TRUE == psPool->bHeapFallback)
+        {
+            pvBlock = MemMgmt_HeapMalloc(PdwSize);
+        }
+    }while(FALSE);
+
+    return pvBlock;
+}
+
+/**
+ * \brief Returns a block to the pool, or to the heap if it was not allocated from the pool.
+ */
+_STATIC_H void MemMgmt_PoolFree(void* PpvCtx, void* PpvBlock)
+{
+    sMemPool_d* psPool = (sMemPool_d*)PpvCtx;
+
+    if(((uint8_t*)PpvBlock >= psPool->prgbStart) && ((uint8_t*)PpvBlock < psPool->prgbEnd))
+    {
+        *(void**)PpvBlock = psPool->pvFreeList;
+        psPool->pvFreeList = PpvBlock;
+        sMemStats.wBlocksInUse--;
+    }
+    else
+    {
+        free(PpvBlock);
+    }
+}
+
+/// @endcond
+
+/**
+* Allocates memory with the allocator selected by #MemMgmt_SetAllocator or #MemMgmt_UsePool.
+*
+* \param[in] PdwSize  Size of the memory in bytes
+*
+* \retval  Pointer to the memory, NULL if the allocation failed
+*/
+void* MemMgmt_Malloc(uint32_t PdwSize)
+{
+    void* pvBlock;
+
+    if(NULL != sMemAllocator.pfMalloc)
+    {
+        pvBlock = sMemAllocator.pfMalloc(sMemAllocator.pvCtx,PdwSize);
+    }
+    else
+    {
+        pvBlock = MemMgmt_HeapMalloc(PdwSize);
+    }
+
+    if(NULL == pvBlock)
+    {
+        sMemStats.dwFailures++;
+    }
+    return pvBlock;
+}
+
+/**
+* Allocates zeroed memory with the selected allocator.
+*
+* \param[in] PdwCount  Number of elements
+* \param[in] PdwSize   Size of an element in bytes
+*
+* \retval  Pointer to the memory, NULL if the allocation failed
+*/
+void* MemMgmt_Calloc(uint32_t PdwCount, uint32_t PdwSize)
+{
+    void* pvBlock = NULL;
+
+    //Fail instead of allocating a truncated size
+    if((0 != PdwSize) && (PdwCount > (UINT32_MAX / PdwSize)))
+    {
+        sMemStats.dwFailures++;
+    }
+    else
+    {
+        pvBlock = MemMgmt_Malloc(PdwCount * PdwSize);
+        if(NULL != pvBlock)
+        {
+            OCP_MEMSET(pvBlock,0,PdwCount * PdwSize);
+        }
+    }
+    return pvBlock;
+}
+
+/**
+* Frees memory allocated with #MemMgmt_Malloc or #MemMgmt_Calloc. NULL is ignored.
+*
+* \param[in] PpvBlock  Pointer to the memory
+*/
+void MemMgmt_Free(void* PpvBlock)
+{
+    if(NULL != PpvBlock)
+    {
+        if(NULL != sMemAllocator.pfFree)
+        {
+            sMemAllocator.pfFree(sMemAllocator.pvCtx,PpvBlock);
+        }
+        else
+        {
+            free(PpvBlock);
+        }
+    }
+}
+
+/**
+* Selects the allocator used by #OCP_MALLOC and #OCP_FREE.
+*
+* <br>
+* Notes:
+* - The allocator must be selected while no memory is allocated, i.e. before the first command or
+*   while no command is in progress.<br>
+*
+* \param[in] PpsAllocator  Pointer to the allocator, NULL to allocate from the heap
+*/
+void MemMgmt_SetAllocator(const sMemAllocator_d* PpsAllocator)
+{
+    if(NULL != PpsAllocator)
+    {
+        sMemAllocator = *PpsAllocator;
+    }
+    else
+    {
+        sMemAllocator.pfMalloc = NULL;
+        sMemAllocator.pfFree = NULL;
+        sMemAllocator.pvCtx = NULL;
+    }
+}
+
+/**
+* Carves a pool of fixed size blocks from an arena.
+*
+* <br>
+* Notes:
+* - Use the size returned by #CmdLib_GetMaxCommsBufferSize as block size. The blocks in use at the same time are
+*   - one per security chip for the APDU buffer of the command in progress,
+*   - two per hash stream of #CmdHash_Init for its chunk buffers, from #CmdHash_Init until the stream is freed. The
+*     CalcHash commands of the stream take the APDU buffer above,
+*   - one for the challenge of #IntLib_Authenticate.<br>
+* - Two allocations may be larger than a block: the copy of the device certificate made by #IntLib_Authenticate
+*   (up to 1728 bytes) and the APDU buffer of #CmdLib_GetMessage (1558 bytes). They fail unless PbHeapFallback is
+*   TRUE or the block size is increased accordingly.<br>
+* - The arena must stay valid as long as the pool is used.<br>
+*
+* \param[out] PpsPool         Pointer to the pool
+* \param[in]  PprgbArena      Memory the blocks are carved from, e.g. a static array
+* \param[in]  PdwArenaLen     Size of the arena in bytes
+* \param[in]  PwBlockSize     Size of a block in bytes
+* \param[in]  PbHeapFallback  TRUE to serve allocations larger than a block or exceeding the pool from the heap
+*
+* \retval  Number of blocks in the pool
+*/
+uint16_t MemMgmt_InitPool(sMemPool_d* PpsPool, uint8_t* PprgbArena, uint32_t PdwArenaLen, uint16_t PwBlockSize, bool_t PbHeapFallback)
+{
+    uint32_t dwBlockSize = ((uint32_t)PwBlockSize + MEM_BLOCK_ALIGN - 1) & ~(uint32_t)(MEM_BLOCK_ALIGN - 1);
+    uint32_t dwSkip = (uint32_t)((MEM_BLOCK_ALIGN - ((uintptr_t)PprgbArena % MEM_BLOCK_ALIGN)) % MEM_BLOCK_ALIGN);
+    uint8_t* prgbBlock;
+
+    PpsPool->pvFreeList = NULL;
+    PpsPool->wBlockSize = PwBlockSize;
+    PpsPool->wBlocks = 0;
+    PpsPool->bHeapFallback = PbHeapFallback;
+    PpsPool->prgbStart = PprgbArena + dwSkip;
+    PpsPool->prgbEnd = PpsPool->prgbStart;
+
+    if((PdwArenaLen > dwSkip) && (PwBlockSize >= sizeof(void*)))
+    {
+        //Link the blocks in address order
+        PpsPool->wBlocks = (uint16_t)((PdwArenaLen - dwSkip) / dwBlockSize);
+        PpsPool->prgbEnd = PpsPool->prgbStart + (PpsPool->wBlocks * dwBlockSize);
+        for(prgbBlock = PpsPool->prgbEnd; prgbBlock != PpsPool->prgbStart; )
+        {
+            prgbBlock -= dwBlockSize;
+            *(void**)prgbBlock = PpsPool->pvFreeList;
+            PpsPool->pvFreeList = prgbBlock;
+        }
+    }
+
+    return PpsPool->wBlocks;
+}
+
+/**
+* Selects a pool as the allocator used by #OCP_MALLOC and #OCP_FREE, see #MemMgmt_SetAllocator.
+*
+* \param[in] PpsPool  Pointer to the pool initialized with #MemMgmt_InitPool
+*/
+void MemMgmt_UsePool(sMemPool_d* PpsPool)
+{
+    sMemAllocator_d sPoolAllocator;
+
+    sPoolAllocator.pfMalloc = MemMgmt_PoolMalloc;
+    sPoolAllocator.pfFree = MemMgmt_PoolFree;
+    sPoolAllocator.pvCtx = PpsPool;
+    MemMgmt_SetAllocator(&sPoolAllocator);
+}
+
+/**
+* Returns the allocation counters. Once the pool is sized for the application, dwHeapAllocs and
+* dwFailures stay constant while commands are executed.
+*
+* \param[out] PpsStats  Pointer to the counters
+*/
+void MemMgmt_GetStats(sMemStats_d* PpsStats)
+{
+    *PpsStats = sMemStats;
+}
@@ -27,21 +27,29 @@
 * \brief This file defines the memory management related macros.
 *
 *
-* \ingroup  grMutualAuth
+* \ingroup  grMemMgmt
 *
 */
 
 #ifndef _MEMMGMT_H_
 #define _MEMMGMT_H_
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <string.h>
+#include "Datatypes.h"
+
 ///Malloc function to allocate the heap memory
-#define OCP_MALLOC(size)			malloc(size)
+#define OCP_MALLOC(size)			MemMgmt_Malloc(size)
 
 ///Malloc function to allocate the heap memory
-#define OCP_CALLOC(block,blocksize)	calloc(block,blocksize)
+#define OCP_CALLOC(block,blocksize)	MemMgmt_Calloc(block,blocksize)
 
 ///To free the allocated memory
-#define OCP_FREE(node)				free(node)
+#define OCP_FREE(node)				MemMgmt_Free(node)
 
 ///To copy the data from source to destination 
 #define OCP_MEMCPY(dst,src,size)	memcpy(dst,src,size)
@@ -49,5 +57,107 @@
 ///To copy the data from source to destination 
 #define OCP_MEMSET(src,val,size)	memset(src,val,size)
 
+///To compare the data of two buffers
+#define OCP_MEMCMP(src1,src2,size)	memcmp(src1,src2,size)
+
+/**
+ * \brief Allocator serving #OCP_MALLOC and #OCP_FREE.
+ */
+typedef struct sMemAllocator_d
+{
+    ///Allocates a block of the given size, returns NULL on failure
+    void* (*pfMalloc)(void* PpvCtx, uint32_t PdwSize);
+
+    ///Frees a block returned by pfMalloc
+    void (*pfFree)(void* PpvCtx, void* PpvBlock);
+
+    ///User context passed to pfMalloc and pfFree
+    void* pvCtx;
+}sMemAllocator_d;
+
+/**
+ * \brief Pool of fixed size blocks carved from a static arena. Initialize it with #MemMgmt_InitPool.
+ */
+typedef struct sMemPool_d
+{
+    ///First free block, the free blocks are linked through their first bytes
+    void* pvFreeList;
+
+    ///Start of the first block
+    uint8_t* prgbStart;
+
+    ///End of the last block
+    uint8_t* prgbEnd;
+
+    ///Size of a block
+    uint16_t wBlockSize;
+
+    ///Number of blocks
+    uint16_t wBlocks;
+
+    ///Serve allocations the pool can not serve from the heap instead of failing
+    bool_t bHeapFallback;
+}sMemPool_d;
+
+/**
+ * \brief Allocation counters, see #MemMgmt_GetStats.
+ */
+typedef struct sMemStats_d
+{
+    ///Allocations served from the pool
+    uint32_t dwPoolAllocs;
+
+    ///Allocations served from the heap
+    uint32_t dwHeapAllocs;
+
+    ///Failed allocations
+    uint32_t dwFailures;
+
+    ///Pool blocks currently allocated
+    uint16_t wBlocksInUse;
+
+    ///Maximum number of pool blocks allocated at the same time
+    uint16_t wPeakBlocksInUse;
+}sMemStats_d;
+
+/**
+ * \brief Allocates memory with the selected allocator.
+ */
+void* MemMgmt_Malloc(uint32_t PdwSize);
+
+/**
+ * \brief Allocates zeroed memory with the selected allocator.
+ */
+void* MemMgmt_Calloc(uint32_t PdwCount, uint32_t PdwSize);
+
+/**
+ * \brief Frees memory allocated with #MemMgmt_Malloc or #MemMgmt_Calloc.
+ */
+void MemMgmt_Free(void* PpvBlock);
+
+/**
+ * \brief Selects the allocator used by #OCP_MALLOC, NULL selects the heap.
+ */
+void MemMgmt_SetAllocator(const sMemAllocator_d* PpsAllocator);
+
+/**
+ * \brief Carves a pool of fixed size blocks from an arena.
+ */
+uint16_t MemMgmt_InitPool(sMemPool_d* PpsPool, uint8_t* PprgbArena, uint32_t PdwArenaLen, uint16_t PwBlockSize, bool_t PbHeapFallback);
+
+/**
+ * \brief Selects a pool as the allocator used by #OCP_MALLOC.
+ */
+void MemMgmt_UsePool(sMemPool_d* PpsPool);
+
+/**
+ * \brief Returns the allocation counters.
+ */
+void MemMgmt_GetStats(sMemStats_d* PpsStats);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* _MEMMGMT_H_ */
 
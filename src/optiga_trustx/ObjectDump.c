@@ -0,0 +1,625 @@
+/**
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+*
+* \file
+*
+* \brief   This file implements the object dump. The metadata and data of a set of data objects are read
+*          back to back from the event loop and written to a compact snapshot with a directory of offsets.
+*
+* \ingroup  grIntLib
+* @{
+*/
+
+#include <stdint.h>
+#include "ObjectDump.h"
+#include "MemoryMgmt.h"
+#include "Util.h"
+#include "pal_os_event.h"
+
+/// @cond hidden
+
+///OID of the global life cycle state
+#define OID_LCSG                        0xE0C0
+
+///OID of the application life cycle state
+#define OID_LCSA                        0xF1C0
+
+///Position of the number of entries in the snapshot header
+#define POS_ENTRIES                     1
+
+///Position of LcsG in the snapshot header
+#define POS_LCSG                        2
+
+///Position of LcsA in the snapshot header
+#define POS_LCSA                        3
+
+///Position of the total length in the snapshot header
+#define POS_LENGTH                      4
+
+///Positions within a directory entry
+#define POS_ENTRY_OID                   0
+#define POS_ENTRY_STATUS                2
+#define POS_ENTRY_METALEN               3
+#define POS_ENTRY_OFFSET                4
+#define POS_ENTRY_DATALEN               6
+
+///Error of the security chip reading past the end of a data object, see CommandLib.c
+#define ERR_DATA_OUT_OF_BOUND           0x00000008
+
+/**
+ * \brief Command in progress of the object dump.
+ */
+typedef enum eObjDumpStep_d
+{
+    ///Reading LcsG
+    eSTEP_LCSG,
+
+    ///Reading LcsA
+    eSTEP_LCSA,
+
+    ///Reading the metadata of the current data object
+    eSTEP_METADATA,
+
+    ///Reading the data of the current data object
+    eSTEP_DATA
+}eObjDumpStep_d;
+
+/**
+ * \brief Returns the directory entry of the current data object.
+ */
+_STATIC_H uint8_t* ObjDump_Entry(const sObjDump_d* PpsDump)
+{
+    return PpsDump->prgbSnapshot + OBJ_DUMP_HEADER_LEN + (PpsDump->bIndex * OBJ_DUMP_ENTRY_LEN);
+}
+
+/**
+ * \brief Prepares reading the given part of a data object to the end of the snapshot.
+ */
+_STATIC_H void ObjDump_SetRead(sObjDump_d* PpsDump, eObjDumpStep_d PeStep, uint16_t PwOID,
+                               eDataOrMedata_d PeDataOrMdata, uint16_t PwLength)
+{
+    PpsDump->bStep = (uint8_t)PeStep;
+    PpsDump->sGetData.wOID = PwOID;
+    PpsDump->sGetData.wOffset = 0;
+    PpsDump->sGetData.wLength = PwLength;
+    PpsDump->sGetData.eDataOrMdata = PeDataOrMdata;
+    PpsDump->sResponse.prgbBuffer = PpsDump->prgbSnapshot + PpsDump->wFill;
+    PpsDump->sResponse.wBufferLength = PwLength;
+    PpsDump->sResponse.wRespLength = 0;
+}
+
+/**
+ * \brief Starts the prepared read on the security chip of the object dump.
+ */
+_STATIC_H int32_t ObjDump_Send(sObjDump_d* PpsDump);
+
+/**
+ * \brief Moves on to the metadata of the next data object and completes the snapshot after the last one.
+ *        Returns FALSE once the snapshot is completed.
+ */
+_STATIC_H bool_t ObjDump_NextObject(sObjDump_d* PpsDump)
+{
+    bool_t bRead = FALSE;
+    uint8_t* prgbEntry;
+    uint16_t wSpace;
+
+    //Data objects without space for their metadata are only listed in the directory
+    while(PpsDump->bIndex < PpsDump->bCount)
+    {
+        prgbEntry = ObjDump_Entry(PpsDump);
+        Utility_SetUint16(prgbEntry + POS_ENTRY_OID,PpsDump->pwOIDs[PpsDump->bIndex]);
+        prgbEntry[POS_ENTRY_STATUS] = (uint8_t)eOBJ_DUMP_NO_SPACE;
+        prgbEntry[POS_ENTRY_METALEN] = 0;
+        Utility_SetUint16(prgbEntry + POS_ENTRY_OFFSET,PpsDump->wFill);
+        Utility_SetUint16(prgbEntry + POS_ENTRY_DATALEN,0);
+
+        wSpace = PpsDump->wSize - PpsDump->wFill;
+        if(0 != wSpace)
+        {
+            ObjDump_SetRead(PpsDump,eSTEP_METADATA,PpsDump->pwOIDs[PpsDump->bIndex],eMETA_DATA,
+                            (wSpace < OBJ_DUMP_MAX_METADATA) ? wSpace : OBJ_DUMP_MAX_METADATA);
+            bRead = TRUE;
+            break;
+        }
+        PpsDump->bIndex++;
+    }
+    return bRead;
+}
+
+/**
+ * \brief Records the metadata of the current data object and prepares reading its data if the read access
+ *        condition is met. Returns FALSE if the data is not read.
+ */
+_STATIC_H bool_t ObjDump_MetaDataDone(sObjDump_d* PpsDump)
+{
+    bool_t bRead = FALSE;
+    uint8_t* prgbEntry = ObjDump_Entry(PpsDump);
+    uint8_t* prgbMetaData = PpsDump->sResponse.prgbBuffer;
+    uint16_t wMetaLen = PpsDump->sResponse.wRespLength;
+    uint16_t wSpace;
+    uint16_t wLength;
+    sIntLibObjectInfo_d sInfo;
+
+    do
+    {
+        prgbEntry[POS_ENTRY_METALEN] = (uint8_t)wMetaLen;
+        PpsDump->wFill += wMetaLen;
+        wSpace = PpsDump->wSize - PpsDump->wFill;
+
+        if((INT_LIB_OK != IntLib_DecodeMetaData(prgbMetaData,wMetaLen,&sInfo)) ||
+           (FALSE == IntLib_CheckAC(&sInfo.sReadAC,PpsDump->prgbSnapshot[POS_LCSA],PpsDump->prgbSnapshot[POS_LCSG])))
+        {
+            prgbEntry[POS_ENTRY_STATUS] = (uint8_t)eOBJ_DUMP_ACCESS_DENIED;
+            break;
+        }
+
+        //The used size avoids reading past the end of the data object, without it the data is read up to the maximum size
+        PpsDump->bLimited = FALSE;
+        if(0 != (sInfo.bTags & INT_LIB_META_USED_SIZE))
+        {
+            wLength = sInfo.wUsedSize;
+            if(wLength > wSpace)
+            {
+                break;
+            }
+        }
+        else if(0 != wSpace)
+        {
+            wLength = ((0 != (sInfo.bTags & INT_LIB_META_MAX_SIZE)) && (sInfo.wMaxSize < wSpace)) ? sInfo.wMaxSize : wSpace;
+            //The data object may be larger than the remaining buffer, a full read is then not the complete data
+            PpsDump->bLimited = (wLength == wSpace) && ((0 == (sInfo.bTags & INT_LIB_META_MAX_SIZE)) || (sInfo.wMaxSize > wSpace));
+        }
+        else
+        {
+            break;
+        }
+
+        //Life cycle states are already read and empty data objects need no command
+        if((0 == wLength) || (((OID_LCSG == PpsDump->sGetData.wOID) || (OID_LCSA == PpsDump->sGetData.wOID)) && (1 == wLength)))
+        {
+            if(0 != wLength)
+            {
+                PpsDump->prgbSnapshot[PpsDump->wFill] = PpsDump->prgbSnapshot[(OID_LCSG == PpsDump->sGetData.wOID) ? POS_LCSG : POS_LCSA];
+                PpsDump->wFill++;
+            }
+            prgbEntry[POS_ENTRY_STATUS] = (uint8_t)eOBJ_DUMP_OK;
+            Utility_SetUint16(prgbEntry + POS_ENTRY_DATALEN,wLength);
+            break;
+        }
+
+        ObjDump_SetRead(PpsDump,eSTEP_DATA,PpsDump->sGetData.wOID,eDATA,wLength);
+        bRead = TRUE;
+    }while(FALSE);
+
+    return bRead;
+}
+
+/**
+ * \brief Processes the completed command and prepares the next one. Returns FALSE once the snapshot is completed.
+ */
+_STATIC_H bool_t ObjDump_Step(sObjDump_d* PpsDump, int32_t Pi4Status)
+{
+    bool_t bRead = FALSE;
+    uint8_t* prgbEntry;
+
+    switch(PpsDump->bStep)
+    {
+        case eSTEP_LCSG:
+        case eSTEP_LCSA:
+        {
+            //The access conditions can not be verified without the life cycle states
+            if((CMD_LIB_OK != Pi4Status) || (1 != PpsDump->sResponse.wRespLength))
+            {
+                PpsDump->i4Status = (CMD_LIB_OK != Pi4Status) ? Pi4Status : (int32_t)INT_LIB_INVALID_RESPONSE;
+                break;
+            }
+            if(eSTEP_LCSG == PpsDump->bStep)
+            {
+                PpsDump->wFill = POS_LCSA;
+                ObjDump_SetRead(PpsDump,eSTEP_LCSA,OID_LCSA,eDATA,1);
+                bRead = TRUE;
+                break;
+            }
+            PpsDump->wFill = OBJ_DUMP_HEADER_LEN + (PpsDump->bCount * OBJ_DUMP_ENTRY_LEN);
+            bRead = ObjDump_NextObject(PpsDump);
+        }
+        break;
+
+        case eSTEP_METADATA:
+        {
+            if(CMD_LIB_OK == Pi4Status)
+            {
+                bRead = ObjDump_MetaDataDone(PpsDump);
+            }
+            //Metadata exceeding the remaining buffer stays recorded with no space
+            else if((int32_t)CMD_LIB_INSUFFICIENT_MEMORY != Pi4Status)
+            {
+                ObjDump_Entry(PpsDump)[POS_ENTRY_STATUS] = (uint8_t)eOBJ_DUMP_METADATA_FAILED;
+            }
+            if(FALSE == bRead)
+            {
+                PpsDump->bIndex++;
+                bRead = ObjDump_NextObject(PpsDump);
+            }
+        }
+        break;
+
+        case eSTEP_DATA:
+        {
+            prgbEntry = ObjDump_Entry(PpsDump);
+            //The data is read from offset 0, so reading out of bound means the data object is empty
+            if((int32_t)(CMD_DEV_ERROR | ERR_DATA_OUT_OF_BOUND) == Pi4Status)
+            {
+                prgbEntry[POS_ENTRY_STATUS] = (uint8_t)eOBJ_DUMP_OK;
+            }
+            else if(CMD_LIB_OK != Pi4Status)
+            {
+                prgbEntry[POS_ENTRY_STATUS] = (uint8_t)eOBJ_DUMP_DATA_FAILED;
+            }
+            //Data read up to the end of the buffer is truncated, it stays recorded with no space and no data
+            else if((TRUE == PpsDump->bLimited) && (PpsDump->sGetData.wLength == PpsDump->sResponse.wRespLength))
+            {
+                prgbEntry[POS_ENTRY_STATUS] = (uint8_t)eOBJ_DUMP_NO_SPACE;
+            }
+            else
+            {
+                prgbEntry[POS_ENTRY_STATUS] = (uint8_t)eOBJ_DUMP_OK;
+                Utility_SetUint16(prgbEntry + POS_ENTRY_DATALEN,PpsDump->sResponse.wRespLength);
+                PpsDump->wFill += PpsDump->sResponse.wRespLength;
+            }
+            PpsDump->bIndex++;
+            bRead = ObjDump_NextObject(PpsDump);
+        }
+        break;
+
+        default:
+        {
+            PpsDump->i4Status = (int32_t)INT_LIB_ERROR;
+        }
+        break;
+    }
+    return bRead;
+}
+
+/**
+ * \brief Completes the snapshot and invokes the callback.
+ */
+_STATIC_H void ObjDump_Complete(sObjDump_d* PpsDump)
+{
+    if(INT_LIB_OK == PpsDump->i4Status)
+    {
+        Utility_SetUint16(PpsDump->prgbSnapshot + POS_LENGTH,PpsDump->wFill);
+    }
+    PpsDump->bInProgress = FALSE;
+    if(NULL != PpsDump->pfCallback)
+    {
+        PpsDump->pfCallback(PpsDump->pvCallbackCtx,PpsDump->i4Status);
+    }
+}
+
+/**
+ * \brief Invoked by the command library once a read is completed. The next read is started right away,
+ *        so the security chip is not idle between the commands of the snapshot.
+ */
+_STATIC_H void ObjDump_CommandDone(void* PpvDump, int32_t Pi4Status)
+{
+    sObjDump_d* psDump = (sObjDump_d*)PpvDump;
+    int32_t i4Status = Pi4Status;
+
+    //A read which could not be started is recorded like a failed one
+    while(TRUE == ObjDump_Step(psDump,i4Status))
+    {
+        i4Status = ObjDump_Send(psDump);
+        if(CMD_LIB_OK == i4Status)
+        {
+            return;
+        }
+    }
+    ObjDump_Complete(psDump);
+}
+
+_STATIC_H int32_t ObjDump_Send(sObjDump_d* PpsDump)
+{
+    sCmdLibContext_d* psSelected = CmdLib_SelectContext(PpsDump->psContext);
+    int32_t i4Status = CmdLib_GetDataObjectAsync(&PpsDump->sGetData,&PpsDump->sResponse,ObjDump_CommandDone,PpsDump);
+
+    CmdLib_SelectContext(psSelected);
+    return i4Status;
+}
+
+/// @endcond
+
+/**
+* Initializes an object dump of the given data objects into the snapshot buffer.
+*
+* <br>
+* Notes:
+* - The snapshot starts with a header of #OBJ_DUMP_HEADER_LEN bytes: version, number of entries, LcsG, LcsA and the
+*   total length of the snapshot. It is followed by a directory of #OBJ_DUMP_ENTRY_LEN bytes per data object in the
+*   order of PpwOIDs: OID, status as #eObjDumpStatus_d, length of the metadata, offset of the metadata and length
+*   of the data. The data follows the metadata. All values of two bytes are big endian, offsets are relative to the
+*   start of the snapshot.<br>
+* - The snapshot buffer must hold at least the header and the directory. Data objects which do not fit in the
+*   remaining buffer are recorded with #eOBJ_DUMP_NO_SPACE.<br>
+* - PpwOIDs and the snapshot buffer must stay valid as long as the object dump is used.<br>
+*
+* \param[out] PpsDump        Pointer to the object dump
+* \param[in]  PpsContext     Pointer to the command library context of the security chip, NULL for the default context
+* \param[in]  PpwOIDs        OIDs of the data objects, e.g. certificates, keys, arbitrary data objects and session contexts
+* \param[in]  PbCount        Number of OIDs
+* \param[in]  PprgbSnapshot  Buffer receiving the snapshot
+* \param[in]  PwSize         Length of the snapshot buffer
+*
+* \retval  #INT_LIB_OK
+* \retval  #INT_LIB_NULL_PARAM
+* \retval  #INT_LIB_ZEROLEN_ERROR
+* \retval  #INT_LIB_INVALID_LENGTH  The buffer can not hold the header and the directory
+*/
+int32_t ObjDump_Init(sObjDump_d* PpsDump, sCmdLibContext_d* PpsContext, const uint16_t* PpwOIDs,
+                     uint8_t PbCount, uint8_t* PprgbSnapshot, uint16_t PwSize)
+{
+    int32_t i4Status = (int32_t)INT_LIB_ERROR;
+
+    do
+    {
+        if((NULL == PpsDump) || (NULL == PpwOIDs) || (NULL == PprgbSnapshot))
+        {
+            i4Status = (int32_t)INT_LIB_NULL_PARAM;
+            break;
+        }
+        if(0 == PbCount)
+        {
+            i4Status = (int32_t)INT_LIB_ZEROLEN_ERROR;
+            break;
+        }
+        if(PwSize < (OBJ_DUMP_HEADER_LEN + (PbCount * OBJ_DUMP_ENTRY_LEN)))
+        {
+            i4Status = (int32_t)INT_LIB_INVALID_LENGTH;
+            break;
+        }
+
+        OCP_MEMSET((uint8_t*)PpsDump,0,sizeof(sObjDump_d));
+        PpsDump->psContext = PpsContext;
+        PpsDump->pwOIDs = PpwOIDs;
+        PpsDump->bCount = PbCount;
+        PpsDump->prgbSnapshot = PprgbSnapshot;
+        PpsDump->wSize = PwSize;
+        i4Status = INT_LIB_OK;
+    }while(FALSE);
+
+    return i4Status;
+}
+
+/**
+* Starts writing a snapshot of the data objects of the object dump. LcsG and LcsA are read first, then the metadata
+* of each data object and its data if the read access condition is met.
+*
+* <br>
+* Notes:
+* - Each read is started from the callback of the previous one, so the snapshot is read without waiting for the
+*   application in between. The metadata and data of a data object are read with one command each. The size of the
+*   data is taken from the used size in the metadata, so no command is spent reading past the end of the data object.
+*   Without the used size, the data is read up to the maximum size and an empty data object is recorded with
+*   #eOBJ_DUMP_OK and no data. If the maximum size is unknown or exceeds the remaining buffer, a read filling the
+*   remaining buffer may have cut the data, so the data object is recorded with #eOBJ_DUMP_NO_SPACE and no data.
+*   Data objects without data to read, e.g. keys and session contexts, need only the metadata command.<br>
+* - The snapshot holds the access conditions as verified on the host, see #IntLib_CheckAC. A condition which the host
+*   can not verify, e.g. on authorization, is recorded with #eOBJ_DUMP_ACCESS_DENIED without reading the data.<br>
+* - Once completed, PpfCallback is invoked from the event loop with #INT_LIB_OK or, if the life cycle states could
+*   not be read, the error of the command. The status of each data object is recorded in its directory entry.<br>
+* - If the function does not return #INT_LIB_OK, the snapshot is not started and PpfCallback is not invoked.<br>
+* - No other command must be started on the security chip until the snapshot is completed.<br>
+*
+* \param[in,out] PpsDump         Pointer to the object dump initialized with #ObjDump_Init
+* \param[in]     PpfCallback     Callback invoked once the snapshot is completed, can be NULL
+* \param[in]     PpvCallbackCtx  User context passed to PpfCallback
+*
+* \retval  #INT_LIB_OK
+* \retval  #INT_LIB_NULL_PARAM
+* \retval  #CMD_LIB_BUSY
+* \retval  #CMD_LIB_INSUFFICIENT_MEMORY
+* \retval  #CMD_DEV_EXEC_ERROR
+*/
+int32_t ObjDump_Start(sObjDump_d* PpsDump, pFCmdLibCallback_d PpfCallback, void* PpvCallbackCtx)
+{
+    int32_t i4Status = (int32_t)INT_LIB_ERROR;
+
+    do
+    {
+        if((NULL == PpsDump) || (NULL == PpsDump->prgbSnapshot))
+        {
+            i4Status = (int32_t)INT_LIB_NULL_PARAM;
+            break;
+        }
+        if(TRUE == PpsDump->bInProgress)
+        {
+            i4Status = (int32_t)CMD_LIB_BUSY;
+            break;
+        }
+
+        PpsDump->pfCallback = PpfCallback;
+        PpsDump->pvCallbackCtx = PpvCallbackCtx;
+        PpsDump->i4Status = INT_LIB_OK;
+        PpsDump->bIndex = 0;
+        PpsDump->prgbSnapshot[0] = OBJ_DUMP_VERSION;
+        PpsDump->prgbSnapshot[POS_ENTRIES] = PpsDump->bCount;
+        Utility_SetUint16(PpsDump->prgbSnapshot + POS_LENGTH,0);
+        PpsDump->wFill = POS_LCSG;
+        ObjDump_SetRead(PpsDump,eSTEP_LCSG,OID_LCSG,eDATA,1);
+
+        PpsDump->bInProgress = TRUE;
+        i4Status = ObjDump_Send(PpsDump);
+        if(CMD_LIB_OK != i4Status)
+        {
+            PpsDump->bInProgress = FALSE;
+            break;
+        }
+        i4Status = INT_LIB_OK;
+    }while(FALSE);
+
+    return i4Status;
+}
+
+/**
+* Writes a snapshot of the data objects of the object dump, see #ObjDump_Start, and waits in the event loop until
+* it is completed.
+*
+* \param[in,out] PpsDump  Pointer to the object dump initialized with #ObjDump_Init
+*
+* \retval  #INT_LIB_OK
+* \retval  #INT_LIB_NULL_PARAM
+* \retval  #INT_LIB_INVALID_RESPONSE
+* \retval  #CMD_LIB_BUSY
+* \retval  #CMD_DEV_ERROR
+*/
+int32_t ObjDump_Run(sObjDump_d* PpsDump)
+{
+    int32_t i4Status = ObjDump_Start(PpsDump,NULL,NULL);
+
+    if(INT_LIB_OK == i4Status)
+    {
+        while(TRUE == PpsDump->bInProgress)
+        {
+            pal_os_event_wait();
+        }
+        i4Status = PpsDump->i4Status;
+    }
+    return i4Status;
+}
+
+/**
+* Returns the header of a snapshot.
+*
+* \param[in]  PprgbSnapshot  Pointer to the snapshot
+* \param[in]  PwLen          Length of the snapshot buffer
+* \param[out] PpsHeader      Pointer to the header
+*
+* \retval  #INT_LIB_OK
+* \retval  #INT_LIB_NULL_PARAM
+* \retval  #INT_LIB_INVALID_PARAM   The version is not supported or the snapshot is not completed
+* \retval  #INT_LIB_INVALID_LENGTH  The snapshot exceeds the buffer
+*/
+int32_t ObjDump_GetHeader(const uint8_t* PprgbSnapshot, uint16_t PwLen, sObjDumpHeader_d* PpsHeader)
+{
+    int32_t i4Status = (int32_t)INT_LIB_ERROR;
+
+    do
+    {
+        if((NULL == PprgbSnapshot) || (NULL == PpsHeader))
+        {
+            i4Status = (int32_t)INT_LIB_NULL_PARAM;
+            break;
+        }
+        if(PwLen < OBJ_DUMP_HEADER_LEN)
+        {
+            i4Status = (int32_t)INT_LIB_INVALID_LENGTH;
+            break;
+        }
+        PpsHeader->bVersion = PprgbSnapshot[0];
+        PpsHeader->bEntries = PprgbSnapshot[POS_ENTRIES];
+        PpsHeader->bLcsG = PprgbSnapshot[POS_LCSG];
+        PpsHeader->bLcsA = PprgbSnapshot[POS_LCSA];
+        PpsHeader->wLength = Utility_GetUint16(PprgbSnapshot + POS_LENGTH);
+
+        if((OBJ_DUMP_VERSION != PpsHeader->bVersion) ||
+           (PpsHeader->wLength < (OBJ_DUMP_HEADER_LEN + (PpsHeader->bEntries * OBJ_DUMP_ENTRY_LEN))))
+        {
+            i4Status = (int32_t)INT_LIB_INVALID_PARAM;
+            break;
+        }
+        if(PpsHeader->wLength > PwLen)
+        {
+            i4Status = (int32_t)INT_LIB_INVALID_LENGTH;
+            break;
+        }
+        i4Status = INT_LIB_OK;
+    }while(FALSE);
+
+    return i4Status;
+}
+
+/**
+* Returns an entry of a snapshot. The metadata and data of the entry point into the snapshot.
+*
+* \param[in]  PprgbSnapshot  Pointer to the snapshot
+* \param[in]  PwLen          Length of the snapshot buffer
+* \param[in]  PbIndex        Index of the entry, in the order of the OIDs of the object dump
+* \param[out] PpsEntry       Pointer to the entry
+*
+* \retval  #INT_LIB_OK
+* \retval  #INT_LIB_NULL_PARAM
+* \retval  #INT_LIB_INVALID_PARAM     The snapshot is not valid or has no entry PbIndex
+* \retval  #INT_LIB_INVALID_LENGTH    The snapshot exceeds the buffer
+* \retval  #INT_LIB_INVALID_RESPONSE  The metadata or data of the entry exceeds the snapshot
+*/
+int32_t ObjDump_GetEntry(const uint8_t* PprgbSnapshot, uint16_t PwLen, uint8_t PbIndex, sObjDumpEntry_d* PpsEntry)
+{
+    int32_t i4Status = (int32_t)INT_LIB_ERROR;
+    sObjDumpHeader_d sHeader;
+    const uint8_t* prgbEntry;
+    uint16_t wOffset;
+    uint16_t wDataLen;
+
+    do
+    {
+        if(NULL == PpsEntry)
+        {
+            i4Status = (int32_t)INT_LIB_NULL_PARAM;
+            break;
+        }
+        i4Status = ObjDump_GetHeader(PprgbSnapshot,PwLen,&sHeader);
+        if(INT_LIB_OK != i4Status)
+        {
+            break;
+        }
+        if(PbIndex >= sHeader.bEntries)
+        {
+            i4Status = (int32_t)INT_LIB_INVALID_PARAM;
+            break;
+        }
+
+        prgbEntry = PprgbSnapshot + OBJ_DUMP_HEADER_LEN + (PbIndex * OBJ_DUMP_ENTRY_LEN);
+        wOffset = Utility_GetUint16(prgbEntry + POS_ENTRY_OFFSET);
+        wDataLen = Utility_GetUint16(prgbEntry + POS_ENTRY_DATALEN);
+        if(((uint32_t)wOffset + prgbEntry[POS_ENTRY_METALEN] + wDataLen) > sHeader.wLength)
+        {
+            i4Status = (int32_t)INT_LIB_INVALID_RESPONSE;
+            break;
+        }
+
+        PpsEntry->wOID = Utility_GetUint16(prgbEntry + POS_ENTRY_OID);
+        PpsEntry->bStatus = prgbEntry[POS_ENTRY_STATUS];
+        PpsEntry->sMetaData.prgbStream = (uint8_t*)PprgbSnapshot + wOffset;
+        PpsEntry->sMetaData.wLen = prgbEntry[POS_ENTRY_METALEN];
+        PpsEntry->sData.prgbStream = PpsEntry->sMetaData.prgbStream + PpsEntry->sMetaData.wLen;
+        PpsEntry->sData.wLen = wDataLen;
+        i4Status = INT_LIB_OK;
+    }while(FALSE);
+
+    return i4Status;
+}
+
+/**
+* @}
+*/
@@ -0,0 +1,196 @@
+/**
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+*
+* \file
+*
+* \brief   This file defines APIs, types and data structures used in the
+*          Object Dump implementation.
+*
+* \ingroup  grIntLib
+* @{
+*/
+#ifndef _OBJECT_DUMP_H_
+#define _OBJECT_DUMP_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "Datatypes.h"
+#include "CommandLib.h"
+#include "IntegrationLib.h"
+
+/****************************************************************************
+ *
+ * Definitions related to the object dump.
+ *
+ ****************************************************************************/
+
+///Version of the snapshot format
+#define OBJ_DUMP_VERSION                0x01
+
+///Length of the snapshot header: version, number of entries, LcsG, LcsA and the total length of the snapshot
+#define OBJ_DUMP_HEADER_LEN             6
+
+///Length of a directory entry: OID, status, metadata length, offset and data length
+#define OBJ_DUMP_ENTRY_LEN              8
+
+///Maximum length of the metadata of a data object
+#define OBJ_DUMP_MAX_METADATA           0x2C
+
+/**
+ * \brief Status of a data object in the snapshot.
+ */
+typedef enum eObjDumpStatus_d
+{
+    ///Metadata and data are read
+    eOBJ_DUMP_OK = 0x00,
+
+    ///Metadata is read, the read access condition is not met in the current life cycle states, e.g. a key
+    eOBJ_DUMP_ACCESS_DENIED = 0x01,
+
+    ///Metadata is read, the snapshot buffer is too small for the data
+    eOBJ_DUMP_NO_SPACE = 0x02,
+
+    ///Reading the metadata failed, e.g. the data object does not exist
+    eOBJ_DUMP_METADATA_FAILED = 0x03,
+
+    ///Metadata is read, reading the data failed
+    eOBJ_DUMP_DATA_FAILED = 0x04
+}eObjDumpStatus_d;
+
+/**
+ * \brief Header of a snapshot returned by #ObjDump_GetHeader.
+ */
+typedef struct sObjDumpHeader_d
+{
+    ///Version of the snapshot format
+    uint8_t bVersion;
+
+    ///Number of entries
+    uint8_t bEntries;
+
+    ///Global life cycle state the access conditions were verified with
+    uint8_t bLcsG;
+
+    ///Application life cycle state the access conditions were verified with
+    uint8_t bLcsA;
+
+    ///Total length of the snapshot
+    uint16_t wLength;
+}sObjDumpHeader_d;
+
+/**
+ * \brief Entry of a snapshot returned by #ObjDump_GetEntry, the metadata and data point into the snapshot.
+ */
+typedef struct sObjDumpEntry_d
+{
+    ///OID of the data object
+    uint16_t wOID;
+
+    ///Status as #eObjDumpStatus_d
+    uint8_t bStatus;
+
+    ///Metadata starting with tag 0x20, zero length if not read
+    sbBlob_d sMetaData;
+
+    ///Data, zero length if not read
+    sbBlob_d sData;
+}sObjDumpEntry_d;
+
+/**
+ * \brief Object dump writing a snapshot of a set of data objects. Initialize it with #ObjDump_Init.
+ */
+typedef struct sObjDump_d
+{
+    ///Command library context of the security chip
+    sCmdLibContext_d* psContext;
+
+    ///OIDs of the data objects
+    const uint16_t* pwOIDs;
+
+    ///Number of OIDs
+    uint8_t bCount;
+
+    ///Buffer receiving the snapshot
+    uint8_t* prgbSnapshot;
+
+    ///Length of the snapshot buffer
+    uint16_t wSize;
+
+    ///Callback invoked once the snapshot is completed
+    pFCmdLibCallback_d pfCallback;
+
+    ///User context passed to pfCallback
+    void* pvCallbackCtx;
+
+    ///Status of the last snapshot
+    int32_t i4Status;
+
+    ///Used only by the object dump
+    sGetData_d sGetData;
+    sCmdResponse_d sResponse;
+    uint8_t bStep;
+    uint8_t bIndex;
+    uint16_t wFill;
+    bool_t bLimited;
+    volatile bool_t bInProgress;
+}sObjDump_d;
+
+/**
+ * \brief Initializes an object dump of the given data objects into the snapshot buffer.
+ */
+LIBRARY_EXPORTS int32_t ObjDump_Init(sObjDump_d* PpsDump, sCmdLibContext_d* PpsContext, const uint16_t* PpwOIDs,
+                                     uint8_t PbCount, uint8_t* PprgbSnapshot, uint16_t PwSize);
+
+/**
+ * \brief Starts writing a snapshot, the data objects are read back to back from the event loop.
+ */
+LIBRARY_EXPORTS int32_t ObjDump_Start(sObjDump_d* PpsDump, pFCmdLibCallback_d PpfCallback, void* PpvCallbackCtx);
+
+/**
+ * \brief Writes a snapshot and waits until it is completed.
+ */
+LIBRARY_EXPORTS int32_t ObjDump_Run(sObjDump_d* PpsDump);
+
+/**
+ * \brief Returns the header of a snapshot.
+ */
+LIBRARY_EXPORTS int32_t ObjDump_GetHeader(const uint8_t* PprgbSnapshot, uint16_t PwLen, sObjDumpHeader_d* PpsHeader);
+
+/**
+ * \brief Returns an entry of a snapshot without copying its metadata and data.
+ */
+LIBRARY_EXPORTS int32_t ObjDump_GetEntry(const uint8_t* PprgbSnapshot, uint16_t PwLen, uint8_t PbIndex,
+                                         sObjDumpEntry_d* PpsEntry);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _OBJECT_DUMP_H_*/
+
+/**
+* @}
+*/
@@ -487,3 +487,156 @@ void Utility_Memmove(puint8_t PprgbDestBuf, const puint8_t PprgbSrcBuf, uint16_t
         }
     }while(0);
 }
+
+/// @cond hidden
+#define UTIL_SHA256_ROR(x,n)    (((x) >> (n)) | ((x) << (32 - (n))))
+
+static const uint32_t rgdwSha256K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static void Utility_Sha256Block(sUtilSha256_d* PpsSha, const uint8_t* PprgbBlock)
+{
+    uint32_t rgdwW[16];
+    uint32_t rgdwV[8];
+    uint32_t dwT1, dwT2;
+    uint8_t bIndex;
+
+    for (bIndex = 0; bIndex < 8; bIndex++)
+    {
+        rgdwV[bIndex] = PpsSha->rgdwState[bIndex];
+    }
+    for (bIndex = 0; bIndex < 64; bIndex++)
+    {
+        //The message schedule is kept as a ring of 16 words
+        if (bIndex < 16)
+        {
+            rgdwW[bIndex] = Utility_GetUint32(PprgbBlock + (bIndex * 4));
+        }
+        else
+        {
+            dwT1 = rgdwW[(bIndex - 15) & 15];
+            dwT2 = rgdwW[(bIndex - 2) & 15];
+            rgdwW[bIndex & 15] += (UTIL_SHA256_ROR(dwT1, 7) ^ UTIL_SHA256_ROR(dwT1, 18) ^ (dwT1 >> 3)) +
+                                  (UTIL_SHA256_ROR(dwT2, 17) ^ UTIL_SHA256_ROR(dwT2, 19) ^ (dwT2 >> 10)) +
+                                  rgdwW[(bIndex - 7) & 15];
+        }
+        dwT1 = rgdwV[7] + (UTIL_SHA256_ROR(rgdwV[4], 6) ^ UTIL_SHA256_ROR(rgdwV[4], 11) ^ UTIL_SHA256_ROR(rgdwV[4], 25)) +
+               ((rgdwV[4] & rgdwV[5]) ^ (~rgdwV[4] & rgdwV[6])) + rgdwSha256K[bIndex] + rgdwW[bIndex & 15];
+        dwT2 = (UTIL_SHA256_ROR(rgdwV[0], 2) ^ UTIL_SHA256_ROR(rgdwV[0], 13) ^ UTIL_SHA256_ROR(rgdwV[0], 22)) +
+               ((rgdwV[0] & rgdwV[1]) ^ (rgdwV[0] & rgdwV[2]) ^ (rgdwV[1] & rgdwV[2]));
+        rgdwV[7] = rgdwV[6];
+        rgdwV[6] = rgdwV[5];
+        rgdwV[5] = rgdwV[4];
+        rgdwV[4] = rgdwV[3] + dwT1;
+        rgdwV[3] = rgdwV[2];
+        rgdwV[2] = rgdwV[1];
+        rgdwV[1] = rgdwV[0];
+        rgdwV[0] = dwT1 + dwT2;
+    }
+    for (bIndex = 0; bIndex < 8; bIndex++)
+    {
+        PpsSha->rgdwState[bIndex] += rgdwV[bIndex];
+    }
+}
+/// @endcond
+
+/**
+ *
+ * Starts a SHA256 calculation on the host.<br>
+ * Used where the input is available on the host anyway, so no hash command has to be sent to the security chip.<br>
+ *
+ * \param[out]  PpsSha	Pointer to the SHA256 context
+ *
+ */
+void Utility_Sha256Init(sUtilSha256_d* PpsSha)
+{
+    PpsSha->rgdwState[0] = 0x6a09e667;
+    PpsSha->rgdwState[1] = 0xbb67ae85;
+    PpsSha->rgdwState[2] = 0x3c6ef372;
+    PpsSha->rgdwState[3] = 0xa54ff53a;
+    PpsSha->rgdwState[4] = 0x510e527f;
+    PpsSha->rgdwState[5] = 0x9b05688c;
+    PpsSha->rgdwState[6] = 0x1f83d9ab;
+    PpsSha->rgdwState[7] = 0x5be0cd19;
+    PpsSha->dwLength = 0;
+}
+
+/**
+ *
+ * Adds data to a SHA256 calculation on the host.<br>
+ *
+ * \param[in,out]  PpsSha	Pointer to the SHA256 context initialized with #Utility_Sha256Init
+ * \param[in]      PprgbData	Pointer to the data
+ * \param[in]      PdwLength	Length of the data
+ *
+ */
+void Utility_Sha256Update(sUtilSha256_d* PpsSha, const uint8_t* PprgbData, uint32_t PdwLength)
+{
+    uint32_t dwFill = PpsSha->dwLength % UTIL_SHA256_BLOCK_LEN;
+
+    PpsSha->dwLength += PdwLength;
+    while (0 < PdwLength)
+    {
+        if ((0 == dwFill) && (UTIL_SHA256_BLOCK_LEN <= PdwLength))
+        {
+            Utility_Sha256Block(PpsSha, PprgbData);
+            PprgbData += UTIL_SHA256_BLOCK_LEN;
+            PdwLength -= UTIL_SHA256_BLOCK_LEN;
+            continue;
+        }
+        PpsSha->rgbBlock[dwFill++] = *PprgbData++;
+        PdwLength--;
+        if (UTIL_SHA256_BLOCK_LEN == dwFill)
+        {
+            Utility_Sha256Block(PpsSha, PpsSha->rgbBlock);
+            dwFill = 0;
+        }
+    }
+}
+
+/**
+ *
+ * Finishes a SHA256 calculation on the host.<br>
+ * The context must be initialized again before it is reused.<br>
+ *
+ * \param[in,out]  PpsSha	Pointer to the SHA256 context
+ * \param[out]     PprgbHash	Buffer of #UTIL_SHA256_LEN bytes for the digest
+ *
+ */
+void Utility_Sha256Final(sUtilSha256_d* PpsSha, uint8_t* PprgbHash)
+{
+    uint32_t dwFill = PpsSha->dwLength % UTIL_SHA256_BLOCK_LEN;
+    uint8_t bIndex;
+
+    PpsSha->rgbBlock[dwFill++] = 0x80;
+    if ((UTIL_SHA256_BLOCK_LEN - 8) < dwFill)
+    {
+        while (UTIL_SHA256_BLOCK_LEN > dwFill)
+        {
+            PpsSha->rgbBlock[dwFill++] = 0;
+        }
+        Utility_Sha256Block(PpsSha, PpsSha->rgbBlock);
+        dwFill = 0;
+    }
+    while ((UTIL_SHA256_BLOCK_LEN - 8) > dwFill)
+    {
+        PpsSha->rgbBlock[dwFill++] = 0;
+    }
+    //Message length in bits
+    Utility_SetUint32(PpsSha->rgbBlock + (UTIL_SHA256_BLOCK_LEN - 8), PpsSha->dwLength >> 29);
+    Utility_SetUint32(PpsSha->rgbBlock + (UTIL_SHA256_BLOCK_LEN - 4), PpsSha->dwLength << 3);
+    Utility_Sha256Block(PpsSha, PpsSha->rgbBlock);
+
+    for (bIndex = 0; bIndex < 8; bIndex++)
+    {
+        Utility_SetUint32(PprgbHash + (bIndex * 4), PpsSha->rgdwState[bIndex]);
+    }
+}
@@ -71,6 +71,12 @@ extern "C" {
 ///Least significant bit set to high
 #define MOST_SIGNIFICANT_BIT_HIGH 0x80000000
 
+///Length of a SHA256 digest
+#define UTIL_SHA256_LEN 32
+
+///SHA256 block size
+#define UTIL_SHA256_BLOCK_LEN 64
+
 /**
  * \brief structure to store the record sequence number
  */
@@ -83,6 +89,21 @@ typedef struct sUint64
 	uint32_t dwLowerByte;
 }sUint64;
 
+/**
+ * \brief Context of a SHA256 calculation on the host
+ */
+typedef struct sUtilSha256_d
+{
+	///Intermediate hash value
+	uint32_t rgdwState[8];
+
+	///Number of bytes hashed so far
+	uint32_t dwLength;
+
+	///Input not yet hashed, less than a block
+	uint8_t rgbBlock[UTIL_SHA256_BLOCK_LEN];
+}sUtilSha256_d;
+
 /**
  * \brief The function compares two uint64 data type.<br>
  */
@@ -153,6 +174,21 @@ void Utility_SetUint32 (uint8_t* PprgbData,uint32_t Pdwvalue);
  */
 void Utility_Memmove(puint8_t PprgbDestBuf, const puint8_t PprgbSrcBuf, uint16_t PwLength);
 
+/**
+ * \brief Starts a SHA256 calculation on the host.<br>
+ */
+void Utility_Sha256Init(sUtilSha256_d* PpsSha);
+
+/**
+ * \brief Adds data to a SHA256 calculation on the host.<br>
+ */
+void Utility_Sha256Update(sUtilSha256_d* PpsSha, const uint8_t* PprgbData, uint32_t PdwLength);
+
+/**
+ * \brief Finishes a SHA256 calculation on the host.<br>
+ */
+void Utility_Sha256Final(sUtilSha256_d* PpsSha, uint8_t* PprgbHash);
+
 #ifdef __cplusplus
 }
 #endif
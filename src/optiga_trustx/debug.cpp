@@ -35,7 +35,12 @@
  * HEADER FILES
  *********************************************************************************************************************/
 
+#if defined(ARDUINO)
 #include "Arduino.h"
+#else
+#include <stdio.h>
+#include <string.h>
+#endif
 #include "debug.h"
 
 /**********************************************************************************************************************
@@ -53,6 +58,7 @@
 /**********************************************************************************************************************
  * API IMPLEMENTATION
  *********************************************************************************************************************/
+#if defined(ARDUINO)
 void print_debug(const char c[])
 {
 
@@ -63,6 +69,12 @@ void print_debug(const char c[])
 	    Serial.println(tmp);
 	  }else{Serial.println("Error: print buffer overflow");}
 }
+#else
+void print_debug(const char c[])
+{
+	printf("%s\r\n", c);
+}
+#endif
 
 /**
 * @}
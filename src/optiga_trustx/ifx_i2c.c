@@ -76,6 +76,9 @@ void ifx_i2c_tl_event_handler(ifx_i2c_context_t* p_ctx,host_lib_status_t event,
 /// Performs initialization
 static host_lib_status_t ifx_i2c_init(ifx_i2c_context_t* ifx_i2c_context);
 
+/// Timer callback continuing the initialization after a reset pin delay
+static void ifx_i2c_init_callback(void* p_ctx);
+
 //lint --e{526} suppress "This API is defined in ifx_i2c_physical_layer. Since it is a low level API, 
 //to avoid exposing, header file is not included "
 extern host_lib_status_t ifx_i2c_pl_write_slave_address(ifx_i2c_context_t *p_ctx, uint8_t slave_address, uint8_t storage_type);
@@ -105,6 +108,8 @@ extern host_lib_status_t ifx_i2c_pl_write_slave_address(ifx_i2c_context_t *p_ctx
  *   - <b>slave address</b> : Address of I2C slave
  *   - <b>frame_size</b> : Frame size in bytes.Minimum supported value is 16 bytes.<br> 
  *              - It is recommended not to use a value greater than the slave's frame size.
+ *              - Values above #DL_MAX_FRAME_SIZE are reduced to #DL_MAX_FRAME_SIZE.
+ *              - Larger frames need fewer frames, acknowledges and status polls per APDU.
  *              - The user specified frame size is written to I2C slave's frame size register.
  *                The frame size register is read back from I2C slave.
  *                This frame value is used by the ifx-i2c protocol even if it is not equal to the user specified value.
@@ -266,6 +271,57 @@ host_lib_status_t ifx_i2c_transceive(ifx_i2c_context_t *p_ctx,const uint8_t* p_d
 }
 
 
+/**
+ * Sends a command scattered over several buffers and receives a response for the command.<br>
+ * <br>
+ *
+ *<b>Pre Conditions:</b>
+ * - IFX I2C protocol stack must be initialized.<br>
+ *
+ *<b>API Details:</b>
+ * - Transmit data(Command), the concatenation of the segments, to I2C slave.<br>
+ * - Receive data(Response) from I2C slave.<br>
+ *<br>
+ *
+ *<b>User Input:</b><br>
+ * - The input #ifx_i2c_context_t p_ctx must not be NULL.
+ * - Same as #ifx_i2c_transceive.
+ *
+ *<b>Notes:</b>
+ * - The command is fragmented directly from the segments into the data link frames,
+ *   it is never assembled in one buffer.<br>
+ * - The segment array and the segment data must stay valid until the transceive is completed.<br>
+ * - Same as #ifx_i2c_transceive.
+ *
+ * \param[in,out] p_ctx   Pointer to #ifx_i2c_context_t
+ * \param[in]     p_segments    Pointer to the segments of the command
+ * \param[in]     segment_count Number of segments
+ * \param[in,out] p_rx_buffer     Pointer to the receive data buffer
+ * \param[in,out] p_rx_buffer_len    Pointer to the length of the receive data buffer 
+ *
+ * \retval  #IFX_I2C_STACK_SUCCESS 
+ * \retval  #IFX_I2C_STACK_ERROR
+ * \retval  #IFX_I2C_STACK_MEM_ERROR
+ */
+host_lib_status_t ifx_i2c_transceive_segments(ifx_i2c_context_t *p_ctx, const sTxSegment_d* p_segments,
+                                              uint8_t segment_count, uint8_t* p_rx_buffer, uint16_t* p_rx_buffer_len)
+{
+    host_lib_status_t api_status = (int32_t)IFX_I2C_STACK_ERROR;
+    // Proceed, if not busy and in idle state
+    if ((IFX_I2C_STATE_IDLE == p_ctx->state) && (IFX_I2C_STATUS_BUSY != p_ctx->status))
+    { 
+        p_ctx->p_upper_layer_rx_buffer = p_rx_buffer;
+        p_ctx->p_upper_layer_rx_buffer_len = p_rx_buffer_len;
+        api_status = ifx_i2c_tl_transceive_segments(p_ctx, p_segments, segment_count,
+                                                    p_rx_buffer, p_rx_buffer_len);
+        if (IFX_I2C_STACK_SUCCESS == api_status)
+        {
+            p_ctx->status = IFX_I2C_STATUS_BUSY;
+        }
+    }
+    return api_status;
+}
+
 /**
  * Closes the IFX I2C protocol stack for a given context.
  * <br>
@@ -359,10 +415,50 @@ host_lib_status_t ifx_i2c_set_slave_address(ifx_i2c_context_t *p_ctx, uint8_t sl
     return api_status;
 }
 
+/**
+* Gets the learned execution time statistics of a command.<br>
+*
+*<b>Pre Conditions:</b>
+* - None<br>
+*
+*<b>API Details:</b>
+*  - The physical layer measures the time from sending the last frame of a command until its response frame is
+*    available and keeps a moving average per command code. The STATUS register is polled only around the
+*    predicted completion time.
+*  - Up to #PL_LATENCY_MODEL_ENTRIES command codes are tracked. The least measured entry is replaced by a new command.
+*
+* \param[in]     p_ctx              Pointer to #ifx_i2c_context_t
+* \param[in]     cmd                Command code (first byte of the command APDU)
+* \param[out]    p_latency          Statistics of the command
+*
+* \retval  #IFX_I2C_STACK_SUCCESS
+* \retval  #IFX_I2C_STACK_ERROR   If the command has not been measured
+*/
+host_lib_status_t ifx_i2c_get_command_latency(const ifx_i2c_context_t *p_ctx, uint8_t cmd,
+                                              ifx_i2c_cmd_latency_t* p_latency)
+{
+    host_lib_status_t api_status = (int32_t)IFX_I2C_STACK_ERROR;
+    uint8_t i;
+
+    for (i = 0; i < PL_LATENCY_MODEL_ENTRIES; i++)
+    {
+        if ((p_ctx->pl.latency.cmd[i].samples) && (cmd == p_ctx->pl.latency.cmd[i].cmd))
+        {
+            *p_latency = p_ctx->pl.latency.cmd[i];
+            api_status = IFX_I2C_STACK_SUCCESS;
+            break;
+        }
+    }
+    return api_status;
+}
+
 /// @cond hidden
-//lint --e{715} suppress "This is ignored as ifx_i2c_event_handler_t handler function prototype requires this argument"
 void ifx_i2c_tl_event_handler(ifx_i2c_context_t* p_ctx,host_lib_status_t event, const uint8_t* p_data, uint16_t data_len)
 {
+    // The received data is already in the upper layer buffer, ifx_i2c_event_handler_t requires these arguments
+    (void)p_data;
+    (void)data_len;
+
     // If there is no upper layer handler, don't do anything and return
     if (NULL != p_ctx->upper_layer_event_handler)
     {
@@ -400,7 +496,7 @@ static host_lib_status_t ifx_i2c_init(ifx_i2c_context_t* p_ifx_i2c_context)
 				}
 				pal_gpio_set_low(p_ifx_i2c_context->p_slave_reset_pin);
 				p_ifx_i2c_context->reset_state = IFX_I2C_STATE_RESET_PIN_HIGH;
-				pal_os_event_register_callback_oneshot((register_callback)ifx_i2c_init,
+				pal_os_event_register_callback_oneshot(&p_ifx_i2c_context->event, ifx_i2c_init_callback,
                                                        (void *)p_ifx_i2c_context, RESET_LOW_TIME_MSEC);
 				api_status = IFX_I2C_STACK_SUCCESS;
 				break;
@@ -415,7 +511,7 @@ static host_lib_status_t ifx_i2c_init(ifx_i2c_context_t* p_ifx_i2c_context)
 				}
 				pal_gpio_set_high(p_ifx_i2c_context->p_slave_reset_pin);
 				p_ifx_i2c_context->reset_state = IFX_I2C_STATE_RESET_INIT;
-				pal_os_event_register_callback_oneshot((register_callback)ifx_i2c_init,
+				pal_os_event_register_callback_oneshot(&p_ifx_i2c_context->event, ifx_i2c_init_callback,
                                                        (void *)p_ifx_i2c_context, STARTUP_TIME_MSEC);
 				api_status = IFX_I2C_STACK_SUCCESS;
 				break;
@@ -437,6 +533,15 @@ static host_lib_status_t ifx_i2c_init(ifx_i2c_context_t* p_ifx_i2c_context)
 
     return api_status;
 }
+
+static void ifx_i2c_init_callback(void* p_ctx)
+{
+    // Nobody checks the status of a timer callback, report the failure to the upper layer instead
+    if (IFX_I2C_STACK_SUCCESS != ifx_i2c_init((ifx_i2c_context_t*)p_ctx))
+    {
+        ifx_i2c_tl_event_handler((ifx_i2c_context_t*)p_ctx, IFX_I2C_STACK_ERROR, NULL, 0);
+    }
+}
 /// @endcond
 /**
 * @}
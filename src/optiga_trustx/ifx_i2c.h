@@ -81,6 +81,12 @@ host_lib_status_t ifx_i2c_reset(ifx_i2c_context_t *p_ctx, ifx_i2c_reset_type_t r
 host_lib_status_t ifx_i2c_transceive(ifx_i2c_context_t *p_ctx,const uint8_t* p_data, const uint16_t* p_data_length, 
                           uint8_t* p_buffer, uint16_t* p_buffer_len);
 
+/**
+ * \brief   Sends a command scattered over several buffers and receives a response for the command.
+ */
+host_lib_status_t ifx_i2c_transceive_segments(ifx_i2c_context_t *p_ctx, const sTxSegment_d* p_segments,
+                                              uint8_t segment_count, uint8_t* p_rx_buffer, uint16_t* p_rx_buffer_len);
+
 /**
  * \brief   Closes the IFX I2C protocol stack for a given context.
  */
@@ -91,6 +97,12 @@ host_lib_status_t ifx_i2c_close(ifx_i2c_context_t *p_ctx);
  */
 host_lib_status_t ifx_i2c_set_slave_address(ifx_i2c_context_t *p_ctx, uint8_t slave_address, uint8_t persistent);
 
+/**
+ * \brief   Gets the learned execution time statistics of a command.
+ */
+host_lib_status_t ifx_i2c_get_command_latency(const ifx_i2c_context_t *p_ctx, uint8_t cmd,
+                                              ifx_i2c_cmd_latency_t* p_latency);
+
 #endif /* _IFXI2C_H_ */
 /**
  * @}
@@ -50,7 +50,6 @@
 ***********************************************************************************************************************/
 
 /** @brief This is IFX I2C context. Only one context is supported per slave.*/
-//lint --e{785} suppress "Only required fields are initialized, the rest are handled by consumer of this structure"
 ifx_i2c_context_t ifx_i2c_context_0 =
 {
     /// Slave address
@@ -58,13 +57,33 @@ ifx_i2c_context_t ifx_i2c_context_0 =
     /// i2c-master frequency
     100,
     /// IFX-I2C frame size
-    0x0019,
+    DL_MAX_FRAME_SIZE,
     /// Vdd pin
     &optiga_vdd_0,
     /// Reset pin
     &optiga_reset_0,
     /// optiga pal i2c context
-    &optiga_pal_i2c_context_0
+    &optiga_pal_i2c_context_0,
+    /// Upper layer event handler, context and receive buffer, set by ifx_i2c_open/ifx_i2c_transceive
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    /// Protocol state, status, reset state and type, pal init, received bytes, set by ifx_i2c_open
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    /// Event node, transport, data link and physical layer contexts, initialized by the layers
+    .event = {0},
+    .tl = {0},
+    .dl = {0},
+    .pl = {.buffer = {0}},
+    /// Frame buffers
+    .tx_frame_buffer = {0},
+    .rx_frame_buffer = {0}
 };
 
 /***********************************************************************************************************************
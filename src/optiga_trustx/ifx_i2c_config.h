@@ -44,6 +44,7 @@ extern "C" {
 #include "pal_i2c.h"
 #include "pal_gpio.h"
 #include "pal_os_timer.h"
+#include "pal_os_event.h"
 
 /***********************************************************************************************************************
 * MACROS
@@ -58,14 +59,51 @@ extern "C" {
 #define PL_POLLING_MAX_CNT          (200)
 /** @brief Physical Layer: data register polling interval in microseconds */
 #define PL_DATA_POLLING_INVERVAL_US (5000)
+/** @brief Physical Layer: shortest STATUS register polling interval in microseconds */
+#define PL_DATA_POLLING_MIN_INTERVAL_US (250)
+/** @brief Physical Layer: number of command codes tracked by the latency model */
+#define PL_LATENCY_MODEL_ENTRIES    (12)
 /** @brief Physical Layer: guard time interval in microseconds */
 #define PL_GUARD_TIME_INTERVAL_US   (50)
 
-/** @brief Data link layer: maximum frame size */
+/** @brief Data link layer: opt in to large frames on Arduino builds. Only for I2C drivers which transfer a frame
+ *         of #DL_MAX_FRAME_SIZE + 1 bytes in one transaction, the default Wire buffer (BUFFER_LENGTH) holds 32 bytes. */
+//#define IFX_I2C_LARGE_FRAMES
+/** @brief Data link layer: maximum frame size. Sizes the frame buffers, the frame size used is
+ *         #ifx_i2c_context_t.frame_size as negotiated with the slave.
+ *         Defaults to the slave maximum (0x115) on host builds and with #IFX_I2C_LARGE_FRAMES. Arduino builds
+ *         default to 0x19, so a frame and the register address fit the 32 byte Wire buffer. */
+#ifndef DL_MAX_FRAME_SIZE
+#if defined(PAL_TARGET_LINUX) || defined(IFX_I2C_LARGE_FRAMES)
+#define DL_MAX_FRAME_SIZE           (0x0115)
+#else
 #define DL_MAX_FRAME_SIZE           (0x19)
-//#define DL_MAX_FRAME_SIZE           300
+#endif
+#endif
+/** @brief Data link layer: minimum frame size supported by the slave */
+#define DL_MIN_FRAME_SIZE           (0x10)
 /** @brief Data link layer: header size */
 #define DL_HEADER_SIZE              (5)
+/** @brief Data link layer: frame CRC computed bit by bit, no table */
+#define IFX_I2C_DL_CRC_BITWISE      (0)
+/** @brief Data link layer: frame CRC computed per nibble, 32 byte table */
+#define IFX_I2C_DL_CRC_NIBBLE       (1)
+/** @brief Data link layer: frame CRC computed per byte, 512 byte table */
+#define IFX_I2C_DL_CRC_TABLE        (2)
+/** @brief Data link layer: frame CRC computed four bytes at a time (slice-by-4), 2 KB of tables */
+#define IFX_I2C_DL_CRC_SLICE4       (3)
+/** @brief Data link layer: frame CRC implementation, one of IFX_I2C_DL_CRC_*.
+ *         Defaults to slice-by-4 on host builds, to the table free variant on AVR (const tables are
+ *         copied to RAM there) and to the byte table elsewhere. */
+#ifndef IFX_I2C_DL_CRC
+#if defined(PAL_TARGET_LINUX)
+#define IFX_I2C_DL_CRC              IFX_I2C_DL_CRC_SLICE4
+#elif defined(__AVR__)
+#define IFX_I2C_DL_CRC              IFX_I2C_DL_CRC_BITWISE
+#else
+#define IFX_I2C_DL_CRC              IFX_I2C_DL_CRC_TABLE
+#endif
+#endif
 /** @brief Data link layer: maximum number of retries in case of transmission error */
 #define DL_TRANS_REPEAT             (3)
 /** @brief Data link layer: Trans timeout in milliseconds*/
@@ -124,6 +162,38 @@ typedef struct ifx_i2c_context ifx_i2c_context_t;
 /** @brief Event handler function prototype */
 typedef void (*ifx_i2c_event_handler_t)(struct ifx_i2c_context* ctx, host_lib_status_t event, const uint8_t* data, uint16_t data_len);
 
+/** @brief Learned execution time of one command code */
+typedef struct ifx_i2c_cmd_latency
+{
+    /// Command code (first byte of the command APDU)
+    uint8_t  cmd;
+    /// Number of executions measured, 0 if the entry is unused
+    uint16_t samples;
+    /// Moving average of the execution time in microseconds
+    uint32_t average_us;
+    /// Shortest execution time in microseconds
+    uint32_t min_us;
+    /// Longest execution time in microseconds
+    uint32_t max_us;
+    /// STATUS register polls issued while waiting for the response
+    uint32_t polls;
+} ifx_i2c_cmd_latency_t;
+
+/** @brief Latency model driving the STATUS register polling */
+typedef struct ifx_i2c_latency_model
+{
+    /// Learned execution times
+    ifx_i2c_cmd_latency_t cmd[PL_LATENCY_MODEL_ENTRIES];
+    /// Entry of the command being executed, NULL if none
+    ifx_i2c_cmd_latency_t* p_active;
+    /// Time (us) the last command frame was handed to the physical layer
+    uint32_t start_time_us;
+    /// Time (us) the response is predicted to be ready
+    uint32_t ready_time_us;
+    /// Current polling interval in microseconds
+    uint32_t poll_interval_us;
+} ifx_i2c_latency_model_t;
+
 /** @brief Physical layer structure */
 typedef struct ifx_i2c_pl
 {    
@@ -135,12 +205,16 @@ typedef struct ifx_i2c_pl
     uint16_t buffer_tx_len;
     /// Rx length
     uint16_t buffer_rx_len;
+    /// Buffer the register read lands in (buffer, or the data link receive frame slot for DATA)
+    uint8_t* p_rx_buffer;
     /// Action on register, read/write    
     uint8_t  register_action;
     /// i2c read/i2c write
     uint8_t  i2c_cmd;
     /// Retry counter
     uint16_t retry_counter;
+    /// Status of the synchronous PAL I2C write used to change the slave address
+    volatile host_lib_status_t pal_event_status;
     
     // Physical Layer high level interface variables
     
@@ -161,6 +235,9 @@ typedef struct ifx_i2c_pl
     uint8_t   negotiate_state;
     /// Soft reset requested
     uint8_t   request_soft_reset;
+
+    /// Predicts when the response of a command is ready, to poll STATUS only around that time
+    ifx_i2c_latency_model_t latency;
 } ifx_i2c_pl_t;
 
 /** @brief Datalink layer structure */
@@ -190,8 +267,12 @@ typedef struct ifx_i2c_dl
     uint16_t rx_buffer_size;
     /// Pointer to main transmit buffers
     uint8_t* p_tx_frame_buffer;
-    /// Pointer to main receive buffers
+    /// Pointer to main receive buffers. The physical layer reads data frames directly to this location
     uint8_t* p_rx_frame_buffer;
+    /// Frames sent (data and control frames, including retransmissions)
+    uint32_t tx_frame_count;
+    /// Frames received (including discarded frames)
+    uint32_t rx_frame_count;
     ///Start time of sending frame
     uint32_t frame_start_time;
     // Upper layer Event handler
@@ -205,13 +286,17 @@ typedef struct ifx_i2c_tl
     
     /// Transport layer state
     uint8_t  state;
-    /// Pointer to packet provided by user
-    uint8_t* p_actual_packet;
+    /// Segments of the packet provided by user, fragmented directly into the transmit frames
+    const sTxSegment_d* p_segments;
+    /// Number of entries in p_segments
+    uint8_t segment_count;
+    /// Segment describing a contiguous packet passed to #ifx_i2c_tl_transceive
+    sTxSegment_d single_segment;
     /// Total received data
     uint16_t total_recv_length;
-    /// Actual length of user provided packet
+    /// Actual length of user provided packet (sum of the segment lengths)
     uint16_t actual_packet_length;
-    /// Offset till which data is sent from p_actual_packet
+    /// Offset till which data is sent from the packet
     uint16_t packet_offset;
     /// Maximum length of packet at transport layer
     uint16_t max_packet_length;
@@ -231,6 +316,8 @@ typedef struct ifx_i2c_tl
     uint8_t transmission_completed;
 	/// Error event state
 	uint8_t error_event;
+    /// Bytes of p_recv_packet_buffer overwritten by the frame header of an in place receive
+    uint8_t saved_header[IFX_I2C_TL_HEADER_OFFSET+1];
     
     /// Upper layer event handler
     ifx_i2c_event_handler_t upper_layer_event_handler;
@@ -243,7 +330,7 @@ typedef struct ifx_i2c_context
     uint8_t slave_address;
     /// Frequency of i2c master
     uint16_t frequency;
-    /// Data link layer frame size
+    /// Data link layer frame size. Requested frame size before ifx_i2c_open, negotiated frame size afterwards
     uint16_t frame_size;
     /// Pointer to pal gpio context for vdd
     pal_gpio_t* p_slave_vdd_pin;
@@ -272,6 +359,10 @@ typedef struct ifx_i2c_context
     uint8_t reset_type;
     /// init pal
     uint8_t do_pal_init;
+    /// Received bytes copied between the protocol layers during the last transceive
+    uint32_t rx_bytes_copied;
+    /// Event node of the pending callback of the protocol layers, at most one is pending
+    pal_os_event_t event;
     
     /// Transport layer context
     ifx_i2c_tl_t tl;
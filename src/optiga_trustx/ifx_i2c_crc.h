@@ -0,0 +1,100 @@
+/**
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+*
+* \file ifx_i2c_crc.h
+*
+* \brief   This file defines the API prototype for the frame CRC of the Infineon I2C Protocol Stack library.
+*
+* \ingroup  grIFXI2C
+* @{
+*/
+
+#ifndef _IFX_I2C_CRC_H_
+#define _IFX_I2C_CRC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    
+/***********************************************************************************************************************
+* HEADER FILES
+**********************************************************************************************************************/
+#include "ifx_i2c_config.h"
+
+/***********************************************************************************************************************
+* MACROS
+**********************************************************************************************************************/
+/***********************************************************************************************************************
+* ENUMS
+**********************************************************************************************************************/
+/***********************************************************************************************************************
+* DATA STRUCTURES
+***********************************************************************************************************************/
+/***********************************************************************************************************************
+* API PROTOTYPES
+**********************************************************************************************************************/
+/**
+ * @brief Function for calculating the frame CRC with the implementation selected by #IFX_I2C_DL_CRC.
+ *
+ * The CRC is the 16 bit CRC of the data link layer (polynomial x^16 + x^12 + x^5 + 1, reflected).
+ * All variants below return the same value, they differ in speed and table size only.
+ *
+ * @param[in] seed          CRC of the preceding data, 0 to start a new frame.
+ * @param[in] p_data        Pointer to the data.
+ * @param[in] data_len      Length of the data.
+ *
+ * @retval  CRC of the data.
+ */
+uint16_t ifx_i2c_crc_calc(uint16_t seed, const uint8_t* p_data, uint16_t data_len);
+
+/**
+ * @brief Bit by bit CRC (#IFX_I2C_DL_CRC_BITWISE). Reference implementation, no table.
+ */
+uint16_t ifx_i2c_crc_calc_bitwise(uint16_t seed, const uint8_t* p_data, uint16_t data_len);
+
+/**
+ * @brief Nibble table CRC (#IFX_I2C_DL_CRC_NIBBLE). 32 byte table, for microcontrollers short of memory.
+ */
+uint16_t ifx_i2c_crc_calc_nibble(uint16_t seed, const uint8_t* p_data, uint16_t data_len);
+
+/**
+ * @brief Byte table CRC (#IFX_I2C_DL_CRC_TABLE). 512 byte table.
+ */
+uint16_t ifx_i2c_crc_calc_table(uint16_t seed, const uint8_t* p_data, uint16_t data_len);
+
+/**
+ * @brief Slice-by-4 CRC (#IFX_I2C_DL_CRC_SLICE4). 2 KB of tables, for host builds.
+ */
+uint16_t ifx_i2c_crc_calc_slice4(uint16_t seed, const uint8_t* p_data, uint16_t data_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _IFX_I2C_CRC_H_ */
+
+
+/**
+ * @}
+ **/
@@ -35,6 +35,7 @@
 **********************************************************************************************************************/
 #include "ifx_i2c_data_link_layer.h"
 #include "ifx_i2c_physical_layer.h"  // include lower layer header
+#include "ifx_i2c_crc.h"
 
 /// @cond hidden
 /***********************************************************************************************************************
@@ -97,10 +98,6 @@
 /***********************************************************************************************************************
 * LOCAL ROUTINES
 ***********************************************************************************************************************/
-/// Helper function to calculate CRC of a byte
-_STATIC_H host_lib_status_t ifx_i2c_dl_calc_crc_byte(uint16_t wSeed, uint8_t bByte);
-/// Helper function to calculate CRC of a frame
-_STATIC_H host_lib_status_t ifx_i2c_dl_calc_crc(const uint8_t* p_data, uint16_t data_len);
 /// Internal function to send frame
 _STATIC_H host_lib_status_t ifx_i2c_dl_send_frame_internal(ifx_i2c_context_t *p_ctx,uint16_t frame_len,uint8_t seqctr_value, uint8_t resend);
 /// Helper function to send resync
@@ -175,35 +172,6 @@ host_lib_status_t ifx_i2c_dl_receive_frame(ifx_i2c_context_t *p_ctx)
     return ifx_i2c_pl_receive_frame(p_ctx);
 }
 
-_STATIC_H host_lib_status_t ifx_i2c_dl_calc_crc_byte(uint16_t wSeed, uint8_t bByte)
-{
-    uint16_t wh1;
-    uint16_t wh2;
-    uint16_t wh3;
-    uint16_t wh4;
-
-    wh1 = (wSeed ^ bByte) & 0xFF;
-    wh2 = wh1 & 0x0F;
-    wh3 = ((uint16_t)(wh2 << 4)) ^ wh1;
-    wh4 = wh3 >> 4;
-
-    return ((uint16_t)((((uint16_t)((((uint16_t)(wh3 << 1)) ^ wh4) << 4)) ^ wh2) << 3)) ^ wh4
-        ^ (wSeed >> 8);
-}
-
-_STATIC_H host_lib_status_t ifx_i2c_dl_calc_crc(const uint8_t* p_data, uint16_t data_len)
-{
-    uint16_t i;
-    uint16_t crc = 0;
-
-    for (i = 0; i < data_len; i++)
-    {
-        crc = ifx_i2c_dl_calc_crc_byte(crc, p_data[i]);
-    }
-
-    return crc;
-}
-
 _STATIC_H host_lib_status_t ifx_i2c_dl_send_frame_internal(ifx_i2c_context_t *p_ctx,uint16_t frame_len,
     uint8_t seqctr_value, uint8_t resend)
 {
@@ -220,8 +188,8 @@ _STATIC_H host_lib_status_t ifx_i2c_dl_send_frame_internal(ifx_i2c_context_t *p_
     if(seqctr_value == DL_FCTR_SEQCTR_VALUE_RESYNC)
     {
         ack_nr = 0;
-		// Use rx buffer to send resync
-		p_buffer = p_ctx->dl.p_rx_frame_buffer;
+		// Use rx buffer to send resync. The receive slot may point to the transport layer buffer
+		p_buffer = p_ctx->rx_frame_buffer;
     }
 	else
 	{
@@ -252,11 +220,12 @@ _STATIC_H host_lib_status_t ifx_i2c_dl_send_frame_internal(ifx_i2c_context_t *p_
     p_buffer[2] = (uint8_t)frame_len;
 
     // Calculate frame CRC
-    crc = ifx_i2c_dl_calc_crc(p_buffer, 3 + frame_len);
+    crc = ifx_i2c_crc_calc(0, p_buffer, 3 + frame_len);
     p_buffer[3 + frame_len] = (uint8_t) (crc >> 8);
     p_buffer[4 + frame_len] = (uint8_t)crc;
 
     // Transmit frame
+    p_ctx->dl.tx_frame_count++;
     return ifx_i2c_pl_send_frame(p_ctx,p_buffer, DL_HEADER_SIZE + frame_len);
 }
 
@@ -365,6 +334,7 @@ _STATIC_H void ifx_i2c_pl_event_handler(ifx_i2c_context_t* p_ctx,host_lib_status
                 }
                 // Received frame from device, start analyzing
                 LOG_DL("[IFX-DL]: Received Frame of length %d\n",data_len);
+                p_ctx->dl.rx_frame_count++;
 
                 if (data_len < DL_HEADER_SIZE)
                 {	// Received length is less than minimum size
@@ -382,7 +352,7 @@ _STATIC_H void ifx_i2c_pl_event_handler(ifx_i2c_context_t* p_ctx,host_lib_status
 
                 // Check frame CRC value
                 crc_received = (p_data[data_len - 2] << 8) | p_data[data_len - 1];
-                crc_calculated = ifx_i2c_dl_calc_crc(p_data, data_len - 2);              	
+                crc_calculated = ifx_i2c_crc_calc(0, p_data, data_len - 2);              	
                 p_ctx->dl.state = (ftype == DL_FCTR_VALUE_CONTROL_FRAME)?DL_STATE_RX_CF:DL_STATE_RX_DF;             
             }
             break;
@@ -422,7 +392,12 @@ _STATIC_H void ifx_i2c_pl_event_handler(ifx_i2c_context_t* p_ctx,host_lib_status
                     break;	
                 }
                 p_ctx->dl.rx_seq_nr = (p_ctx->dl.rx_seq_nr + 1) & DL_MAX_FRAME_NUM;                  
-                memcpy(p_ctx->dl.p_rx_frame_buffer, p_data, data_len);
+                // Frame is normally read in place by the physical layer
+                if (p_data != p_ctx->dl.p_rx_frame_buffer)
+                {
+                    memcpy(p_ctx->dl.p_rx_frame_buffer, p_data, data_len);
+                    p_ctx->rx_bytes_copied += data_len;
+                }
                 p_ctx->dl.rx_buffer_size = data_len;
 
                 // Send control frame to acknowledge reception of this data frame
@@ -124,8 +124,6 @@
 * GLOBAL
 ***********************************************************************************************************************/
 
-static host_lib_status_t pal_event_status;
-
 /***********************************************************************************************************************
 * LOCAL ROUTINES
 ***********************************************************************************************************************/
@@ -141,6 +139,8 @@ static void ifx_i2c_pl_negotiation_event_handler(void *p_input_ctx);
 static host_lib_status_t ifx_i2c_pl_set_bit_rate(ifx_i2c_context_t *p_ctx, uint16_t bitrate);
 /// Physical Layer intermediate state machine (soft reset)
 static void ifx_i2c_pl_soft_reset(ifx_i2c_context_t *p_ctx);
+/// Physical Layer soft reset startup time callback
+static void ifx_i2c_pl_soft_reset_callback(void *p_ctx);
 /// Physical Layer high level interface state machine (read/write frames)
 static void ifx_i2c_pl_frame_event_handler(ifx_i2c_context_t *p_ctx,host_lib_status_t event);
 /// Physical Layer low level interface timer callback (I2C Nack/Busy polling)
@@ -151,6 +151,10 @@ static void ifx_i2c_pl_guard_time_callback(void *p_ctx);
 static void ifx_i2c_pl_pal_event_handler(void *p_ctx, host_lib_status_t event);
 /// Physical layer low level event handler for set slave address
 static void ifx_i2c_pl_pal_slave_addr_event_handler(void *p_input_ctx, host_lib_status_t event);
+/// Schedules the next STATUS register poll
+static void ifx_i2c_pl_schedule_status_poll(ifx_i2c_context_t *p_ctx);
+/// Completes the execution time measurement once a response frame is ready
+static void ifx_i2c_pl_stop_latency_measurement(ifx_i2c_context_t *p_ctx);
   
 /// @endcond
 /***********************************************************************************************************************
@@ -167,6 +171,9 @@ host_lib_status_t ifx_i2c_pl_init(ifx_i2c_context_t *p_ctx,ifx_i2c_event_handler
     p_ctx->p_pal_i2c_ctx->slave_address = p_ctx->slave_address;
     p_ctx->p_pal_i2c_ctx->upper_layer_event_handler = ifx_i2c_pl_pal_event_handler;
     p_ctx->pl.retry_counter = PL_POLLING_MAX_CNT;
+    p_ctx->pl.p_rx_buffer = p_ctx->pl.buffer;
+    // Learned execution times are kept across reinitialization
+    p_ctx->pl.latency.p_active = NULL;
     if(TRUE == p_ctx->do_pal_init)
     {
         // Initialize I2C driver
@@ -219,11 +226,47 @@ host_lib_status_t ifx_i2c_pl_receive_frame(ifx_i2c_context_t *p_ctx)
         return IFX_I2C_STACK_ERROR;
     }
     p_ctx->pl.frame_action = PL_ACTION_READ_FRAME;
+    p_ctx->pl.latency.poll_interval_us = PL_DATA_POLLING_MIN_INTERVAL_US;
 
     ifx_i2c_pl_frame_event_handler(p_ctx,IFX_I2C_STACK_SUCCESS);
     return IFX_I2C_STACK_SUCCESS;
 }
 
+void ifx_i2c_pl_start_latency_measurement(ifx_i2c_context_t *p_ctx, uint8_t cmd)
+{
+    ifx_i2c_latency_model_t* p_model = &p_ctx->pl.latency;
+    ifx_i2c_cmd_latency_t* p_entry = NULL;
+    uint8_t i;
+
+    for (i = 0; i < PL_LATENCY_MODEL_ENTRIES; i++)
+    {
+        if ((p_model->cmd[i].samples) && (p_model->cmd[i].cmd == cmd))
+        {
+            p_entry = &p_model->cmd[i];
+            break;
+        }
+        // Otherwise take an unused entry or replace the least measured one
+        if ((NULL == p_entry) || (p_model->cmd[i].samples < p_entry->samples))
+        {
+            p_entry = &p_model->cmd[i];
+        }
+    }
+    if (p_entry->cmd != cmd)
+    {
+        memset(p_entry, 0, sizeof(ifx_i2c_cmd_latency_t));
+        p_entry->cmd = cmd;
+    }
+
+    p_model->p_active = p_entry;
+    p_model->start_time_us = pal_os_timer_get_time_in_microseconds();
+    p_model->ready_time_us = p_model->start_time_us;
+    if (p_entry->samples)
+    {
+        // Wake slightly before the average, so faster executions are still learned
+        p_model->ready_time_us += p_entry->average_us - (p_entry->average_us >> 3);
+    }
+}
+
 host_lib_status_t ifx_i2c_pl_write_slave_address(ifx_i2c_context_t *p_ctx, uint8_t slave_address, uint8_t persistent)
 {    
     host_lib_status_t status = IFX_I2C_STACK_ERROR;
@@ -261,14 +304,18 @@ host_lib_status_t ifx_i2c_pl_write_slave_address(ifx_i2c_context_t *p_ctx, uint8
 
     while(p_ctx->pl.retry_counter)
     {
-        pal_event_status = PAL_WRITE_INIT_STATUS;
+        p_ctx->pl.pal_event_status = PAL_WRITE_INIT_STATUS;
 
         //print_debug("-call pal_i2c_write");
         //lint --e{534} suppress "Return value is not required to be checked"
         pal_i2c_write(p_ctx->p_pal_i2c_ctx, p_ctx->pl.buffer, p_ctx->pl.buffer_tx_len);
 
-        while(PAL_WRITE_INIT_STATUS == pal_event_status){};
-        if(PAL_I2C_EVENT_SUCCESS == pal_event_status)
+        // The event is delivered by the event loop when the PAL I2C completes asynchronously
+        while(PAL_WRITE_INIT_STATUS == p_ctx->pl.pal_event_status)
+        {
+            pal_os_event_wait();
+        }
+        if(PAL_I2C_EVENT_SUCCESS == p_ctx->pl.pal_event_status)
         {
         	//print_debug("-call pal_i2c_write success");
             break;
@@ -277,7 +324,7 @@ host_lib_status_t ifx_i2c_pl_write_slave_address(ifx_i2c_context_t *p_ctx, uint8
         pal_os_timer_delay_in_milliseconds(PL_POLLING_INVERVAL_US);
     }
 
-    if(PAL_I2C_EVENT_SUCCESS == pal_event_status)
+    if(PAL_I2C_EVENT_SUCCESS == p_ctx->pl.pal_event_status)
     {
         p_ctx->p_pal_i2c_ctx->slave_address = p_ctx->pl.buffer[ADDRESS_OFFSET];
         if(PL_REG_BASE_ADDR_VOLATILE != persistent)
@@ -313,6 +360,8 @@ static void ifx_i2c_pl_read_register(ifx_i2c_context_t *p_ctx,uint8_t reg_addr,
     p_ctx->pl.buffer_tx_len = 1;
 
     // Set low level interface variables and start transmission
+    // Data frames are read directly to the data link layer receive slot
+    p_ctx->pl.p_rx_buffer     = (PL_REG_DATA == reg_addr) ? p_ctx->dl.p_rx_frame_buffer : p_ctx->pl.buffer;
     p_ctx->pl.buffer_rx_len   = reg_len;
     p_ctx->pl.register_action = PL_ACTION_READ_REGISTER;
     p_ctx->pl.retry_counter   = PL_POLLING_MAX_CNT;
@@ -347,6 +396,83 @@ static void ifx_i2c_pl_status_poll_callback(void *p_ctx)
     ifx_i2c_pl_read_register((ifx_i2c_context_t*)p_ctx,PL_REG_I2C_STATE, PL_REG_LEN_I2C_STATE);
 }
 
+static void ifx_i2c_pl_schedule_status_poll(ifx_i2c_context_t *p_ctx)
+{
+    ifx_i2c_latency_model_t* p_model = &p_ctx->pl.latency;
+    ifx_i2c_cmd_latency_t* p_entry = p_model->p_active;
+    uint32_t current_time = pal_os_timer_get_time_in_microseconds();
+    uint32_t delay = p_model->poll_interval_us;
+
+    if (NULL != p_entry)
+    {
+        p_entry->polls++;
+    }
+    if ((NULL != p_entry) && (0 != p_entry->samples))
+    {
+        if ((int32_t)(p_model->ready_time_us - current_time) > (int32_t)PL_DATA_POLLING_MIN_INTERVAL_US)
+        {
+            // Sleep until the predicted completion
+            delay = p_model->ready_time_us - current_time;
+        }
+        else
+        {
+            // Poll around the predicted completion with 1/16 of the learned execution time
+            delay = p_entry->average_us >> 4;
+            if (delay < PL_DATA_POLLING_MIN_INTERVAL_US)
+            {
+                delay = PL_DATA_POLLING_MIN_INTERVAL_US;
+            }
+            if (delay > PL_DATA_POLLING_INVERVAL_US)
+            {
+                delay = PL_DATA_POLLING_INVERVAL_US;
+            }
+        }
+    }
+    // Nothing learned for this command, poll with increasing interval
+    else if (p_model->poll_interval_us < PL_DATA_POLLING_INVERVAL_US)
+    {
+        p_model->poll_interval_us <<= 1;
+    }
+    pal_os_event_register_callback_oneshot(&p_ctx->event, ifx_i2c_pl_status_poll_callback, (void *)p_ctx, delay);
+}
+
+static void ifx_i2c_pl_stop_latency_measurement(ifx_i2c_context_t *p_ctx)
+{
+    ifx_i2c_latency_model_t* p_model = &p_ctx->pl.latency;
+    ifx_i2c_cmd_latency_t* p_entry = p_model->p_active;
+    uint32_t sample;
+
+    if (NULL == p_entry)
+    {
+        return;
+    }
+    sample = pal_os_timer_get_time_in_microseconds() - p_model->start_time_us;
+    if (0 == p_entry->samples)
+    {
+        p_entry->average_us = sample;
+        p_entry->min_us = sample;
+        p_entry->max_us = sample;
+    }
+    else
+    {
+        // Exponential moving average with weight 1/4
+        p_entry->average_us = p_entry->average_us - (p_entry->average_us >> 2) + (sample >> 2);
+        if (sample < p_entry->min_us)
+        {
+            p_entry->min_us = sample;
+        }
+        if (sample > p_entry->max_us)
+        {
+            p_entry->max_us = sample;
+        }
+    }
+    if (p_entry->samples < 0xFFFF)
+    {
+        p_entry->samples++;
+    }
+    p_model->p_active = NULL;
+}
+
 static host_lib_status_t ifx_i2c_pl_set_bit_rate(ifx_i2c_context_t *p_ctx, uint16_t bitrate)
 {
     host_lib_status_t status;
@@ -363,7 +489,7 @@ static host_lib_status_t ifx_i2c_pl_set_bit_rate(ifx_i2c_context_t *p_ctx, uint1
         if (p_ctx->pl.retry_counter--)
         {
             LOG_PL("[IFX-PL]: Set bit rate failed, Retry setting.\n");
-            pal_os_event_register_callback_oneshot(ifx_i2c_pl_negotiation_event_handler,((void*)p_ctx),PL_POLLING_INVERVAL_US);
+            pal_os_event_register_callback_oneshot(&p_ctx->event, ifx_i2c_pl_negotiation_event_handler, ((void*)p_ctx),PL_POLLING_INVERVAL_US);
             status = IFX_I2C_STACK_BUSY;
         }
         else
@@ -385,7 +511,7 @@ static void ifx_i2c_pl_negotiation_event_handler(void *p_input_ctx)
     uint8_t continue_negotiation;
     ifx_i2c_context_t* p_ctx = (ifx_i2c_context_t*)p_input_ctx;
 	uint8_t i2c_mode_value[2];
-    uint8_t max_frame_size[2] = { (uint8_t)(p_ctx->frame_size >> 8), (uint8_t)(p_ctx->frame_size) };
+    uint8_t max_frame_size[2];
     uint16_t buffer_len = 0;
     uint16_t slave_frequency;
 	uint16_t slave_frame_len;
@@ -495,6 +621,13 @@ static void ifx_i2c_pl_negotiation_event_handler(void *p_input_ctx)
             // Start frame length negotiation by writing the requested frame length
             case PL_INIT_SET_DATA_REG_LEN:
             {
+                // Frame buffers are sized for DL_MAX_FRAME_SIZE
+                if (p_ctx->frame_size > DL_MAX_FRAME_SIZE)
+                {
+                    p_ctx->frame_size = DL_MAX_FRAME_SIZE;
+                }
+                max_frame_size[0] = (uint8_t)(p_ctx->frame_size >> 8);
+                max_frame_size[1] = (uint8_t)(p_ctx->frame_size);
                 p_ctx->pl.negotiate_state = PL_INIT_GET_DATA_REG_LEN;
                 ifx_i2c_pl_write_register(p_ctx,PL_REG_DATA_REG_LEN, sizeof(max_frame_size), max_frame_size);
             }
@@ -511,8 +644,8 @@ static void ifx_i2c_pl_negotiation_event_handler(void *p_input_ctx)
             {
 				p_ctx->pl.negotiate_state = PL_INIT_DONE;
 				slave_frame_len = (p_ctx->pl.buffer[0] << 8) | p_ctx->pl.buffer[1]; 
-                // Error if slave's frame length is more than requested frame length
-				if(p_ctx->frame_size >= slave_frame_len)
+                // Error if slave's frame length is more than requested frame length or too small for the protocol
+				if((p_ctx->frame_size >= slave_frame_len) && (slave_frame_len >= DL_MIN_FRAME_SIZE))
 				{
 					p_ctx->frame_size = slave_frame_len;
 					event = IFX_I2C_STACK_SUCCESS;
@@ -586,6 +719,11 @@ static void ifx_i2c_pl_frame_event_handler(ifx_i2c_context_t *p_ctx,host_lib_sta
                     frame_size = (p_ctx->pl.buffer[2] << 8) | p_ctx->pl.buffer[3];
                     if ((frame_size > 0) && (frame_size <= p_ctx->frame_size))
                     {
+                        // A data frame (not the acknowledge of the command) carries the response
+                        if (frame_size > DL_HEADER_SIZE)
+                        {
+                            ifx_i2c_pl_stop_latency_measurement(p_ctx);
+                        }
                         p_ctx->pl.frame_state = PL_STATE_RXTX;
                         ifx_i2c_pl_read_register(p_ctx,PL_REG_DATA, frame_size);
                     }
@@ -594,7 +732,7 @@ static void ifx_i2c_pl_frame_event_handler(ifx_i2c_context_t *p_ctx,host_lib_sta
                         // Continue polling STATUS register if retry limit is not reached
                         if ((pal_os_timer_get_time_in_milliseconds() - p_ctx->dl.frame_start_time) < p_ctx->dl.data_poll_timeout)
                         {
-                            pal_os_event_register_callback_oneshot(ifx_i2c_pl_status_poll_callback, (void *)p_ctx, PL_DATA_POLLING_INVERVAL_US);
+                            ifx_i2c_pl_schedule_status_poll(p_ctx);
                         }
                         else
                         {
@@ -616,7 +754,7 @@ static void ifx_i2c_pl_frame_event_handler(ifx_i2c_context_t *p_ctx,host_lib_sta
                     // Continue polling STATUS register if retry limit is not reached
                     if ((pal_os_timer_get_time_in_milliseconds() - p_ctx->dl.frame_start_time) < p_ctx->dl.data_poll_timeout)
                     {
-                        pal_os_event_register_callback_oneshot(ifx_i2c_pl_status_poll_callback, (void *)p_ctx, PL_DATA_POLLING_INVERVAL_US);
+                        ifx_i2c_pl_schedule_status_poll(p_ctx);
                     }
                     else
                     {
@@ -631,7 +769,7 @@ static void ifx_i2c_pl_frame_event_handler(ifx_i2c_context_t *p_ctx,host_lib_sta
             {
                 // Writing/reading of frame to/from DATA register complete
                 p_ctx->pl.frame_state = PL_STATE_READY;
-                p_ctx->pl.upper_layer_event_handler(p_ctx,IFX_I2C_STACK_SUCCESS, p_ctx->pl.buffer, p_ctx->pl.buffer_rx_len);
+                p_ctx->pl.upper_layer_event_handler(p_ctx,IFX_I2C_STACK_SUCCESS, p_ctx->pl.p_rx_buffer, p_ctx->pl.buffer_rx_len);
             }
             break;
             default:
@@ -653,7 +791,7 @@ static void ifx_i2c_pal_poll_callback(void *p_ctx)
     {
         LOG_PL("[IFX-PL]: Poll Timer elapsed  -> Restart Read Register -> Start TX\n");
         //lint --e{534} suppress "Return value is not required to be checked"
-        pal_i2c_read(p_local_ctx->p_pal_i2c_ctx,p_local_ctx->pl.buffer, p_local_ctx->pl.buffer_rx_len);
+        pal_i2c_read(p_local_ctx->p_pal_i2c_ctx,p_local_ctx->pl.p_rx_buffer, p_local_ctx->pl.buffer_rx_len);
     }
 }
 
@@ -668,7 +806,7 @@ static void ifx_i2c_pl_guard_time_callback(void *p_ctx)
     		LOG_PL("[IFX-PL]: GT done-> Start RX\n");
 			p_local_ctx->pl.i2c_cmd = PL_I2C_CMD_READ;
 			//lint --e{534} suppress "Return value is not required to be checked"
-            pal_i2c_read(p_local_ctx->p_pal_i2c_ctx,p_local_ctx->pl.buffer, p_local_ctx->pl.buffer_rx_len);
+            pal_i2c_read(p_local_ctx->p_pal_i2c_ctx,p_local_ctx->pl.p_rx_buffer, p_local_ctx->pl.buffer_rx_len);
     	}
     	else if (p_local_ctx->pl.i2c_cmd == PL_I2C_CMD_READ)
     	{
@@ -694,7 +832,7 @@ static void ifx_i2c_pl_pal_event_handler(void *p_ctx, host_lib_status_t event)
             if (p_local_ctx->pl.retry_counter--)
             {
 				LOG_PL("[IFX-PL]: PAL Error -> Continue polling\n");
-                pal_os_event_register_callback_oneshot(ifx_i2c_pal_poll_callback,p_local_ctx,PL_POLLING_INVERVAL_US);
+                pal_os_event_register_callback_oneshot(&p_local_ctx->event, ifx_i2c_pal_poll_callback, p_local_ctx,PL_POLLING_INVERVAL_US);
             }
             else
             {
@@ -705,7 +843,7 @@ static void ifx_i2c_pl_pal_event_handler(void *p_ctx, host_lib_status_t event)
             
         case PAL_I2C_EVENT_SUCCESS:
             LOG_PL("[IFX-PL]: PAL Success -> Wait Guard Time\n");
-            pal_os_event_register_callback_oneshot(ifx_i2c_pl_guard_time_callback,p_local_ctx,PL_GUARD_TIME_INTERVAL_US);
+            pal_os_event_register_callback_oneshot(&p_local_ctx->event, ifx_i2c_pl_guard_time_callback, p_local_ctx,PL_GUARD_TIME_INTERVAL_US);
             break;
         default:
             break;
@@ -713,6 +851,11 @@ static void ifx_i2c_pl_pal_event_handler(void *p_ctx, host_lib_status_t event)
 }
 
 
+static void ifx_i2c_pl_soft_reset_callback(void *p_ctx)
+{
+    ifx_i2c_pl_soft_reset((ifx_i2c_context_t*)p_ctx);
+}
+
 static void ifx_i2c_pl_soft_reset(ifx_i2c_context_t *p_ctx)
 {
     uint8_t i2c_mode_value[2] = {0};
@@ -743,7 +886,7 @@ static void ifx_i2c_pl_soft_reset(ifx_i2c_context_t *p_ctx)
             
 		case PL_RESET_STARTUP:
 			p_ctx->pl.request_soft_reset= PL_RESET_INIT;
-			pal_os_event_register_callback_oneshot((register_callback)ifx_i2c_pl_soft_reset, (void *)p_ctx, STARTUP_TIME_MSEC);
+			pal_os_event_register_callback_oneshot(&p_ctx->event, ifx_i2c_pl_soft_reset_callback, (void *)p_ctx, STARTUP_TIME_MSEC);
 			break;
 
 		case PL_RESET_INIT:
@@ -756,10 +899,8 @@ static void ifx_i2c_pl_soft_reset(ifx_i2c_context_t *p_ctx)
 	}    
 }
 
-//lint --e{715} suppress "This is used for synchromous implementation, hence p_ctx not used"
-//lint --e{818} suppress "This is ignored as upper layer handler function prototype requires this argument"
 static void ifx_i2c_pl_pal_slave_addr_event_handler(void *p_ctx, host_lib_status_t event)
 {
-    pal_event_status = event;
+    ((ifx_i2c_context_t*)p_ctx)->pl.pal_event_status = event;
 }
 
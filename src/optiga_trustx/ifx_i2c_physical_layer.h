@@ -114,6 +114,17 @@ host_lib_status_t ifx_i2c_pl_receive_frame(ifx_i2c_context_t *p_ctx);
  * @retval  IFX_I2C_STACK_ERROR   If setting slave address fails.
  */
 host_lib_status_t ifx_i2c_pl_write_slave_address(ifx_i2c_context_t *p_ctx, uint8_t slave_address, uint8_t storage_type);
+
+/**
+ * @brief Function for starting the execution time measurement of a command.
+ *
+ * Called when the last frame of a command is sent. Until the response frame is
+ * available the STATUS register is polled around the execution time learned for the command.
+ *
+ * @param[in,out] p_ctx     Pointer to ifx i2c context.
+ * @param[in] cmd           Command code (first byte of the command APDU).
+ */
+void ifx_i2c_pl_start_latency_measurement(ifx_i2c_context_t *p_ctx, uint8_t cmd);
 /**
  * @}
  **/
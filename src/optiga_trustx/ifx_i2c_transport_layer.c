@@ -34,6 +34,7 @@
 **********************************************************************************************************************/
 #include "ifx_i2c_transport_layer.h"
 #include "ifx_i2c_data_link_layer.h" // include lower layer header
+#include "ifx_i2c_physical_layer.h" // command latency measurement
 
 /// @cond hidden
 /***********************************************************************************************************************
@@ -98,6 +99,14 @@ _STATIC_H host_lib_status_t ifx_i2c_tl_send_chaining_error(ifx_i2c_context_t *p_
 _STATIC_H uint8_t ifx_i2c_tl_calculate_pctr(const ifx_i2c_context_t *p_ctx);
 /// Checks if chaining error occured based on current and previous pctr
 _STATIC_H host_lib_status_t ifx_i2c_tl_check_chaining_error(uint8_t current_chaning, uint8_t previous_chaining);
+/// Places the data link receive slot in the receive buffer, so the next fragment is read in place
+_STATIC_H void ifx_i2c_tl_set_rx_slot(ifx_i2c_context_t *p_ctx);
+/// Restores the receive buffer bytes overwritten by the frame header and resets the receive slot
+_STATIC_H void ifx_i2c_tl_release_rx_slot(ifx_i2c_context_t *p_ctx);
+/// Copies fragment payload to the receive buffer, unless it was read in place
+_STATIC_H void ifx_i2c_tl_store_fragment(ifx_i2c_context_t *p_ctx, const uint8_t* p_data, uint16_t data_len);
+/// Copies a range of the packet from its segments to a buffer
+_STATIC_H void ifx_i2c_tl_gather(const ifx_i2c_context_t *p_ctx, uint8_t* p_buffer, uint16_t offset, uint16_t length);
 /// @endcond
 /***********************************************************************************************************************
 * API PROTOTYPES
@@ -117,7 +126,6 @@ host_lib_status_t ifx_i2c_tl_init(ifx_i2c_context_t *p_ctx,ifx_i2c_event_handler
 
     p_ctx->tl.upper_layer_event_handler = handler;
     p_ctx->tl.state                     = TL_STATE_IDLE;
-    p_ctx->tl.max_packet_length = p_ctx->frame_size - (DL_HEADER_SIZE + TL_HEADER_SIZE);
 
     return IFX_I2C_STACK_SUCCESS;
 }
@@ -127,24 +135,58 @@ host_lib_status_t ifx_i2c_tl_transceive(ifx_i2c_context_t *p_ctx,uint8_t* p_pack
                                uint8_t* p_recv_packet, uint16_t* recv_packet_len)
 {
     host_lib_status_t status = IFX_I2C_STACK_ERROR;
-    LOG_TL("[IFX-TL]: Transceive txlen %d\n", packet_len);
+
+    // Transport Layer must be idle, the segment is in use otherwise
+    if (p_ctx->tl.state == TL_STATE_IDLE)
+    {
+        p_ctx->tl.single_segment.prgbStream = p_packet;
+        p_ctx->tl.single_segment.wLen = packet_len;
+        status = ifx_i2c_tl_transceive_segments(p_ctx, &p_ctx->tl.single_segment, 1,
+                                                p_recv_packet, recv_packet_len);
+    }
+    return status;
+}
+
+host_lib_status_t ifx_i2c_tl_transceive_segments(ifx_i2c_context_t *p_ctx, const sTxSegment_d* p_segments,
+                                                 uint8_t segment_count, uint8_t* p_recv_packet,
+                                                 uint16_t* recv_packet_len)
+{
+    host_lib_status_t status = IFX_I2C_STACK_ERROR;
+    uint32_t packet_len = 0;
+    uint8_t i;
 
     do
     {
         // Check function arguments
-        if (p_packet == NULL || packet_len == 0 )
+        if (p_segments == NULL || segment_count == 0)
         {
             break;
-        }   
+        }
+        for (i = 0; i < segment_count; i++)
+        {
+            if (p_segments[i].prgbStream == NULL && p_segments[i].wLen != 0)
+            {
+                break;
+            }
+            packet_len += p_segments[i].wLen;
+        }
+        if (i != segment_count || packet_len == 0 || packet_len > 0xFFFF)
+        {
+            break;
+        }
+        LOG_TL("[IFX-TL]: Transceive txlen %d in %d segments\n", (uint16_t)packet_len, segment_count);
         // Transport Layer must be idle
         if (p_ctx->tl.state != TL_STATE_IDLE)
         {
             break;
         }    
         p_ctx->tl.state = TL_STATE_TX;
+        // Frame size is known once the physical layer negotiation is done
+        p_ctx->tl.max_packet_length = p_ctx->frame_size - (DL_HEADER_SIZE + TL_HEADER_SIZE);
         p_ctx->tl.api_start_time = pal_os_timer_get_time_in_milliseconds();    
-        p_ctx->tl.p_actual_packet = p_packet;
-        p_ctx->tl.actual_packet_length = packet_len;
+        p_ctx->tl.p_segments = p_segments;
+        p_ctx->tl.segment_count = segment_count;
+        p_ctx->tl.actual_packet_length = (uint16_t)packet_len;
         p_ctx->tl.packet_offset = 0; 
         p_ctx->tl.p_recv_packet_buffer = p_recv_packet;
         p_ctx->tl.p_recv_packet_buffer_length = recv_packet_len;
@@ -153,6 +195,7 @@ host_lib_status_t ifx_i2c_tl_transceive(ifx_i2c_context_t *p_ctx,uint8_t* p_pack
         p_ctx->tl.master_chaining_error_count = 0;
         p_ctx->tl.transmission_completed = 0;
 		p_ctx->tl.error_event = IFX_I2C_STACK_ERROR;
+        p_ctx->rx_bytes_copied = 0;
         status = ifx_i2c_tl_send_next_fragment(p_ctx);
     }while(FALSE);
     return status;
@@ -204,6 +247,7 @@ _STATIC_H uint8_t ifx_i2c_tl_calculate_pctr(const ifx_i2c_context_t *p_ctx)
 _STATIC_H host_lib_status_t ifx_i2c_tl_send_next_fragment(ifx_i2c_context_t *p_ctx)
 {
     uint8_t pctr = 0;
+    uint8_t cmd;
     // Calculate size of fragment (last one might be shorter)
     uint16_t tl_fragment_size = p_ctx->tl.max_packet_length;
     pctr = ifx_i2c_tl_calculate_pctr(p_ctx);
@@ -214,9 +258,15 @@ _STATIC_H host_lib_status_t ifx_i2c_tl_send_next_fragment(ifx_i2c_context_t *p_c
 
     // Assign the pctr 
     p_ctx->tx_frame_buffer[IFX_I2C_TL_HEADER_OFFSET] = pctr;
-    //copy the data
-    memcpy(p_ctx->tx_frame_buffer+IFX_I2C_TL_HEADER_OFFSET+1,p_ctx->tl.p_actual_packet + p_ctx->tl.packet_offset,tl_fragment_size);
+    //copy the data from the packet segments
+    ifx_i2c_tl_gather(p_ctx, p_ctx->tx_frame_buffer+IFX_I2C_TL_HEADER_OFFSET+1, p_ctx->tl.packet_offset, tl_fragment_size);
     p_ctx->tl.packet_offset += tl_fragment_size;
+    // The slave starts executing the command once the last fragment is received
+    if (p_ctx->tl.packet_offset == p_ctx->tl.actual_packet_length)
+    {
+        ifx_i2c_tl_gather(p_ctx, &cmd, 0, 1);
+        ifx_i2c_pl_start_latency_measurement(p_ctx, cmd);
+    }
     //send the fragment to dl layer
     return ifx_i2c_dl_send_frame(p_ctx,tl_fragment_size+1);
 }
@@ -245,18 +295,88 @@ _STATIC_H host_lib_status_t ifx_i2c_tl_check_chaining_error(uint8_t current_chan
     return status;
 }
 
+_STATIC_H void ifx_i2c_tl_set_rx_slot(ifx_i2c_context_t *p_ctx)
+{
+    // The frame header (DL header and PCTR) precedes the payload
+    uint16_t header_len = IFX_I2C_TL_HEADER_OFFSET + TL_HEADER_SIZE;
+    uint8_t* p_slot;
+
+    // Needs the header bytes in front of the payload and room for a complete frame including CRC
+    if ((p_ctx->tl.total_recv_length < header_len) ||
+        ((p_ctx->tl.total_recv_length - header_len + p_ctx->frame_size) > *p_ctx->tl.p_recv_packet_buffer_length))
+    {
+        return;
+    }
+    p_slot = p_ctx->tl.p_recv_packet_buffer + p_ctx->tl.total_recv_length - header_len;
+    memcpy(p_ctx->tl.saved_header, p_slot, header_len);
+    p_ctx->dl.p_rx_frame_buffer = p_slot;
+}
+
+_STATIC_H void ifx_i2c_tl_release_rx_slot(ifx_i2c_context_t *p_ctx)
+{
+    if (p_ctx->dl.p_rx_frame_buffer != p_ctx->rx_frame_buffer)
+    {
+        memcpy(p_ctx->dl.p_rx_frame_buffer, p_ctx->tl.saved_header, IFX_I2C_TL_HEADER_OFFSET + TL_HEADER_SIZE);
+        p_ctx->dl.p_rx_frame_buffer = p_ctx->rx_frame_buffer;
+    }
+}
+
+_STATIC_H void ifx_i2c_tl_store_fragment(ifx_i2c_context_t *p_ctx, const uint8_t* p_data, uint16_t data_len)
+{
+    uint8_t* p_dest = p_ctx->tl.p_recv_packet_buffer + p_ctx->tl.total_recv_length;
+
+    if ((p_data + 1) != p_dest)
+    {
+        memcpy(p_dest, p_data + 1, data_len - 1);
+        p_ctx->rx_bytes_copied += (data_len - 1);
+    }
+    p_ctx->tl.total_recv_length += (data_len - 1);
+}
+
+_STATIC_H void ifx_i2c_tl_gather(const ifx_i2c_context_t *p_ctx, uint8_t* p_buffer, uint16_t offset, uint16_t length)
+{
+    const sTxSegment_d* p_segment = p_ctx->tl.p_segments;
+    uint16_t segment_length;
+
+    // Skip the segments before offset
+    while (offset >= p_segment->wLen)
+    {
+        offset -= p_segment->wLen;
+        p_segment++;
+    }
+    while (length > 0)
+    {
+        segment_length = p_segment->wLen - offset;
+        if (segment_length > length)
+        {
+            segment_length = length;
+        }
+        if (segment_length > 0)
+        {
+            memcpy(p_buffer, p_segment->prgbStream + offset, segment_length);
+        }
+        p_buffer += segment_length;
+        length -= segment_length;
+        offset = 0;
+        p_segment++;
+    }
+}
+
 _STATIC_H void ifx_i2c_dl_event_handler(ifx_i2c_context_t* p_ctx,host_lib_status_t event, const uint8_t* p_data, uint16_t data_len)
 {
     uint8_t pctr = 0;
     uint8_t chaining = 0;
     uint8_t exit_machine = TRUE;
+
+    if(NULL != p_data)
+    {
+        pctr = p_data[0];
+        chaining = pctr & TL_PCTR_CHAIN_MASK;
+    }
+    // The header of an in place frame overlaps the previous payload, so restore it once pctr is taken
+    ifx_i2c_tl_release_rx_slot(p_ctx);
     do
     {
-        if(NULL != p_data)
-        {
-            pctr = p_data[0];
-            chaining = pctr & TL_PCTR_CHAIN_MASK;
-        }
         // Propagate errors to upper layer
         if ((event & IFX_I2C_DL_EVENT_ERROR)||(pctr & TL_PCTR_CHANNEL_MASK))
         {
@@ -373,10 +493,17 @@ _STATIC_H void ifx_i2c_dl_event_handler(ifx_i2c_context_t* p_ctx,host_lib_status
                     {
                         LOG_TL("[IFX-TL]: Rx : No chain/Last chain received, Inform UL\n");
 
+                        // Check for possible receive buffer overflow
+                        if ((p_ctx->tl.total_recv_length + data_len - 1) > (*p_ctx->tl.p_recv_packet_buffer_length))
+                        {
+                            LOG_TL("[IFX-TL]: Rx : Buffer overflow\n");
+                            p_ctx->tl.error_event = IFX_I2C_STACK_MEM_ERROR;
+                            p_ctx->tl.state = TL_STATE_ERROR;
+                            break;
+                        }
                         exit_machine = FALSE;
                         // Copy frame payload to transport layer receive buffer
-                        memcpy(p_ctx->tl.p_recv_packet_buffer + p_ctx->tl.total_recv_length, p_data + 1, data_len - 1);
-                        p_ctx->tl.total_recv_length += (data_len - 1);
+                        ifx_i2c_tl_store_fragment(p_ctx, p_data, data_len);
                         // Inform upper layer that a packet has arrived
                         p_ctx->tl.state = TL_STATE_IDLE;
                         *p_ctx->tl.p_recv_packet_buffer_length = p_ctx->tl.total_recv_length;
@@ -421,15 +548,16 @@ _STATIC_H void ifx_i2c_dl_event_handler(ifx_i2c_context_t* p_ctx,host_lib_status
                     break;
                 }                
                 // Copy frame payload to transport layer receive buffer
-                memcpy(p_ctx->tl.p_recv_packet_buffer + p_ctx->tl.total_recv_length, p_data + 1, data_len - 1);
-                p_ctx->tl.total_recv_length += (data_len - 1);
+                ifx_i2c_tl_store_fragment(p_ctx, p_data, data_len);
 
                 p_ctx->tl.previous_chaining = pctr;
                 LOG_TL("[IFX-TL]: Chain : Continue  in receive mode\n");
                 p_ctx->tl.state = TL_STATE_RX;
-                // Continue receiving frames until packet is complete
+                // Continue receiving frames until packet is complete, next fragment is read in place
+                ifx_i2c_tl_set_rx_slot(p_ctx);
                 if (ifx_i2c_dl_receive_frame(p_ctx))
                 {
+                    ifx_i2c_tl_release_rx_slot(p_ctx);
                     p_ctx->tl.state = TL_STATE_ERROR;
                 }
                 exit_machine = FALSE;
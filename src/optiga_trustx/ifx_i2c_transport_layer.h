@@ -89,6 +89,27 @@ host_lib_status_t ifx_i2c_tl_init(ifx_i2c_context_t *p_ctx,ifx_i2c_event_handler
 host_lib_status_t ifx_i2c_tl_transceive(ifx_i2c_context_t *p_ctx,uint8_t* p_packet, uint16_t packet_len,
                                uint8_t* p_recv_packet, uint16_t* recv_packet_len);
 
+/**
+ * @brief Function to transmit a packet scattered over several buffers and receive a packet.
+ *
+ * Same as @ref ifx_i2c_tl_transceive, but the packet is the concatenation of the segments.
+ * Fragments are copied from the segments directly into the transmit frames, so the packet
+ * need not be assembled in one buffer. The segments (array and data) must stay valid until
+ * the transceive completes, since fragments are resent from them on chaining errors.
+ *
+ * @param[in,out] p_ctx            Pointer to ifx i2c context.
+ * @param[in] p_segments           Segments of the packet, in order.
+ * @param[in] segment_count        Number of segments.
+ * @param[in] p_recv_packet        Buffer for the received packet.
+ * @param[in,out] recv_packet_len  Length of the receive buffer / received packet.
+ *
+ * @retval  IFX_I2C_STACK_SUCCESS If function was successful.
+ * @retval  IFX_I2C_STACK_ERROR If the module is busy or the packet is empty or too long.
+ */
+host_lib_status_t ifx_i2c_tl_transceive_segments(ifx_i2c_context_t *p_ctx, const sTxSegment_d* p_segments,
+                                                 uint8_t segment_count, uint8_t* p_recv_packet,
+                                                 uint16_t* recv_packet_len);
+
 /**
  * @}
  **/
@@ -98,6 +98,14 @@ LIBRARY_EXPORTS host_lib_status_t optiga_comms_transceive(optiga_comms_t *p_ctx,
                                                           const uint16_t* p_data_length,
                                                           uint8_t* p_buffer, uint16_t* p_buffer_len);
 
+/**
+ * \brief   Sends an APDU scattered over several buffers and receives the response.
+ */
+LIBRARY_EXPORTS host_lib_status_t optiga_comms_transceive_segments(optiga_comms_t *p_ctx,
+                                                                   const sTxSegment_d* p_segments,
+                                                                   uint8_t segment_count,
+                                                                   uint8_t* p_buffer, uint16_t* p_buffer_len);
+
 /**
  * \brief   Closes the communication channel with OPTIGA.
  */
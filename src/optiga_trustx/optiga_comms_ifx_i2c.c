@@ -33,7 +33,7 @@
 /**********************************************************************************************************************
  * HEADER FILES
  *********************************************************************************************************************/
-#include <Arduino.h>
+#include <stdio.h>
 #include "debug.h"
 #include "optiga_comms.h"
 #include "ifx_i2c.h"
@@ -289,6 +289,55 @@ host_lib_status_t optiga_comms_transceive(optiga_comms_t *p_ctx,const uint8_t* p
     return status;
 }
 
+/**
+ * Sends a command scattered over several buffers to OPTIGA and receives a response.<br>
+ *
+ *
+ *<b>Pre Conditions:</b>
+ * - Communication channel must be established with OPTIGA.<br>
+ *
+ *<b>API Details:</b>
+ * - Transmit data(Command), the concatenation of the segments, to OPTIGA.<br>
+ * - Receive data(Response) from OPTIGA.<br>
+ *<br>
+ *
+ *<b>User Input:</b><br>
+ * - Same as #optiga_comms_transceive.<br>
+ *
+ *<b>Notes:</b>
+ * - The segment array and the segment data must stay valid until the transceive is completed.<br>
+ * - Same as #optiga_comms_transceive.
+ *
+ *
+ * \param[in,out] p_ctx             Pointer to #optiga_comms_t
+ * \param[in]     p_segments        Pointer to the segments of the command
+ * \param[in]     segment_count     Number of segments
+ * \param[in,out] p_buffer          Pointer to the receive data buffer
+ * \param[in,out] p_buffer_len      Pointer to the length of the receive data buffer 
+ *
+ * \retval  #OPTIGA_COMMS_SUCCESS
+ * \retval  #OPTIGA_COMMS_ERROR
+ * \retval  #IFX_I2C_STACK_MEM_ERROR
+ */
+host_lib_status_t optiga_comms_transceive_segments(optiga_comms_t *p_ctx, const sTxSegment_d* p_segments,
+                                                   uint8_t segment_count,
+                                                   uint8_t* p_buffer, uint16_t* p_buffer_len)
+{
+    host_lib_status_t status = OPTIGA_COMMS_ERROR;
+    if (OPTIGA_COMMS_SUCCESS == check_optiga_comms_state(p_ctx))
+    {
+        ((ifx_i2c_context_t*)(p_ctx->comms_ctx))->p_upper_layer_ctx = (void*)p_ctx;
+        ((ifx_i2c_context_t*)(p_ctx->comms_ctx))->upper_layer_event_handler = ifx_i2c_event_handler;
+        status = (ifx_i2c_transceive_segments((ifx_i2c_context_t*)(p_ctx->comms_ctx),p_segments,segment_count,
+                                              p_buffer,p_buffer_len));
+        if (IFX_I2C_STACK_SUCCESS != status)
+        {
+            p_ctx->state = OPTIGA_COMMS_FREE;
+        }
+    }
+    return status;
+}
+
 /**
  * Closes the communication with OPTIGA.<br>
  *
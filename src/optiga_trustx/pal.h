@@ -54,6 +54,11 @@
 /// PAL I2C is busy
 #define PAL_STATUS_I2C_BUSY     (0x0002)
 
+/// Host (Linux) build of the PAL. Arduino builds always define ARDUINO and keep the *_arduino.cpp ports.
+#if defined(__linux__) && !defined(ARDUINO)
+#define PAL_TARGET_LINUX
+#endif
+
 /**********************************************************************************************************************
  * ENUMS
  *********************************************************************************************************************/
@@ -0,0 +1,121 @@
+/**
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+*
+* \file
+*
+* \brief This file implements the platform specific contexts of the Arduino platform abstraction layer.
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#ifndef _PAL_ARDUINO_H_
+#define _PAL_ARDUINO_H_
+
+/**********************************************************************************************************************
+ * HEADER FILES
+ *********************************************************************************************************************/
+
+#include "pal.h"
+#include "pal_os_event.h"
+
+/**********************************************************************************************************************
+ * MACROS
+ *********************************************************************************************************************/
+/** @brief Opt in to non-blocking I2C transfers. #pal_i2c_t.p_i2c_hw_config then refers to a #pal_arduino_i2c_t
+ *         and the transfers are started through its driver hooks, for cores with an interrupt driven TWI API.
+ *         Without the flag the context refers to a TwoWire and the transfers block in Wire. */
+//#define PAL_I2C_ARDUINO_ASYNC
+
+/**********************************************************************************************************************
+ * DATA STRUCTURES
+ *********************************************************************************************************************/
+
+#if defined(PAL_I2C_ARDUINO_ASYNC)
+
+struct pal_arduino_i2c;
+
+/**
+ * \brief Starts a non-blocking write or read of length bytes to/from the slave and returns without waiting.
+ *        The driver reports the end of the transfer with #pal_i2c_arduino_transfer_done, typically from its
+ *        interrupt handler. Returns #PAL_STATUS_SUCCESS if the transfer was started.
+ */
+typedef pal_status_t (*pal_arduino_i2c_start_t)(struct pal_arduino_i2c* p_i2c, uint8_t slave_address,
+                                                 uint8_t* p_data, uint16_t length);
+
+/**
+ * \brief Arduino I2C master context, referred by #pal_i2c_t.p_i2c_hw_config if #PAL_I2C_ARDUINO_ASYNC is defined.
+ */
+typedef struct pal_arduino_i2c
+{
+    /// TwoWire instance, initialized and clocked by pal_i2c_init/pal_i2c_set_bitrate. May be NULL
+    void* p_wire;
+    /// Starts a non-blocking write. NULL: the write blocks in p_wire
+    pal_arduino_i2c_start_t start_write;
+    /// Starts a non-blocking read. NULL: the read blocks in p_wire
+    pal_arduino_i2c_start_t start_read;
+    /// Driver specific data of the hooks
+    void* p_driver;
+
+    /// Transfer is in progress (from start until completion is delivered)
+    volatile bool_t busy;
+    /// Result of the transfer in progress, set by #pal_i2c_arduino_transfer_done
+    volatile pal_status_t request_status;
+    /// Context of the transfer in progress
+    struct pal_i2c* p_request_ctx;
+    /// Completion delivered by the event loop
+    pal_os_event_post_t completion;
+} pal_arduino_i2c_t;
+
+#endif /* PAL_I2C_ARDUINO_ASYNC */
+
+/**********************************************************************************************************************
+ * API Prototypes
+ *********************************************************************************************************************/
+
+#if defined(PAL_I2C_ARDUINO_ASYNC)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Reports the end of a transfer started by a driver hook. Can be called from interrupt context.
+ */
+void pal_i2c_arduino_transfer_done(pal_arduino_i2c_t* p_i2c, pal_status_t status);
+
+/// Arduino I2C master context used by #optiga_pal_i2c_context_0
+extern pal_arduino_i2c_t optiga_pal_arduino_i2c_0;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PAL_I2C_ARDUINO_ASYNC */
+
+#endif /* _PAL_ARDUINO_H_ */
+
+/**
+* @}
+*/
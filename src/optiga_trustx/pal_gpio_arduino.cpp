@@ -31,6 +31,8 @@
 */
 
 
+#if defined(ARDUINO)
+
 /**********************************************************************************************************************
  * HEADER FILES
  *********************************************************************************************************************/
@@ -103,6 +105,8 @@ void pal_gpio_set_low(const pal_gpio_t* p_gpio_context)
   //Serial.println("<pal_gpio_set_low");
 }
 
+#endif /* ARDUINO */
+
 /**
 * @}
 */
@@ -0,0 +1,124 @@
+/**
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+*
+* \file
+*
+* \brief This file implements the platform abstraction layer APIs for gpio on Linux hosts.
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include "pal.h"
+
+#if defined(PAL_TARGET_LINUX)
+
+/**********************************************************************************************************************
+ * HEADER FILES
+ *********************************************************************************************************************/
+#include <fcntl.h>
+#include <unistd.h>
+#include "pal_gpio.h"
+#include "pal_linux.h"
+
+/**********************************************************************************************************************
+ * MACROS
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * LOCAL DATA
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * LOCAL ROUTINES
+ *********************************************************************************************************************/
+/// @cond hidden
+static void pal_gpio_linux_set(const pal_gpio_t* p_gpio_context, uint8_t level)
+{
+    const pal_linux_gpio_t* p_gpio;
+    int fd;
+
+    if ((NULL == p_gpio_context) || (NULL == p_gpio_context->p_gpio_hw))
+    {
+        return;
+    }
+    p_gpio = (const pal_linux_gpio_t*)p_gpio_context->p_gpio_hw;
+
+    if (NULL != p_gpio->p_virtual_chip)
+    {
+        pal_i2c_virtual_chip_set_reset(p_gpio->p_virtual_chip, (uint8_t)!level);
+    }
+    if (NULL != p_gpio->p_value_path)
+    {
+        fd = open(p_gpio->p_value_path, O_WRONLY);
+        if (fd >= 0)
+        {
+            //lint --e{534} suppress "A failing write leaves the pin unchanged, same as a missing pin"
+            write(fd, level ? "1" : "0", 1);
+            close(fd);
+        }
+    }
+}
+/// @endcond
+
+/**********************************************************************************************************************
+ * API IMPLEMENTATION
+ *********************************************************************************************************************/
+
+/**
+* Sets the gpio pin to high state
+*
+* <b>API Details:</b>
+*      The API sets the pin high, only if the pin is assigned to a valid gpio context.<br>
+*      Otherwise the API returns without any faliure status.<br>
+*
+*\param[in] p_gpio_context Pointer to pal layer gpio context
+*
+*
+*/
+void pal_gpio_set_high(const pal_gpio_t* p_gpio_context)
+{
+    pal_gpio_linux_set(p_gpio_context, 1);
+}
+
+/**
+* Sets the gpio pin to low state
+*
+* <b>API Details:</b>
+*      The API set the pin low, only if the pin is assigned to a valid gpio context.<br>
+*      Otherwise the API returns without any faliure status.<br>
+*
+*\param[in] p_gpio_context Pointer to pal layer gpio context
+*
+*/
+void pal_gpio_set_low(const pal_gpio_t* p_gpio_context)
+{
+    pal_gpio_linux_set(p_gpio_context, 0);
+}
+
+#endif /* PAL_TARGET_LINUX */
+
+/**
+* @}
+*/
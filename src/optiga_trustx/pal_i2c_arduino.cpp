@@ -30,12 +30,15 @@
 * @{
 */
 
+#if defined(ARDUINO)
+
 /**********************************************************************************************************************
  * HEADER FILES
  *********************************************************************************************************************/
 #include <Arduino.h>
 #include <Wire.h>
 #include "pal_i2c.h"
+#include "pal_arduino.h"
 
 /**********************************************************************************************************************
  * MACROS
@@ -49,6 +52,118 @@
 /**********************************************************************************************************************
  * LOCAL ROUTINES
  *********************************************************************************************************************/
+// TwoWire of the context, NULL if there is none
+static TwoWire* pal_i2c_arduino_wire(const pal_i2c_t* p_i2c_context)
+{
+#if defined(PAL_I2C_ARDUINO_ASYNC)
+	return (TwoWire *)((pal_arduino_i2c_t*)p_i2c_context->p_i2c_hw_config)->p_wire;
+#else
+	return (TwoWire *)p_i2c_context->p_i2c_hw_config;
+#endif
+}
+
+static void pal_i2c_arduino_notify(const pal_i2c_t* p_i2c_context, pal_status_t status)
+{
+	app_event_handler_t upper_layer_handler = (app_event_handler_t)p_i2c_context->upper_layer_event_handler;
+	host_lib_status_t event = PAL_I2C_EVENT_ERROR;
+
+	if (PAL_STATUS_SUCCESS == status)
+	{
+		event = PAL_I2C_EVENT_SUCCESS;
+	}
+	else if (PAL_STATUS_I2C_BUSY == status)
+	{
+		event = PAL_I2C_EVENT_BUSY;
+	}
+	if (NULL != upper_layer_handler)
+	{
+		upper_layer_handler(p_i2c_context->upper_layer_ctx, event);
+	}
+}
+
+// Blocking write in Wire, returns once the stop condition is sent
+static pal_status_t pal_i2c_arduino_wire_write(TwoWire* i2c, uint8_t slave_address, uint8_t* p_data, uint16_t length)
+{
+	i2c->beginTransmission(slave_address);
+	i2c->write(p_data, length);
+	return (0 == i2c->endTransmission(true)) ? PAL_STATUS_SUCCESS : PAL_STATUS_FAILURE;
+}
+
+// Blocking read in Wire, returns once length bytes are received
+static pal_status_t pal_i2c_arduino_wire_read(TwoWire* i2c, uint8_t slave_address, uint8_t* p_data, uint16_t length)
+{
+	uint16_t rx_len = 0;
+
+	if (0 == i2c->requestFrom((int)slave_address, (int)length))
+	{
+		return PAL_STATUS_FAILURE;
+	}
+	while (i2c->available() && (rx_len < length))
+	{
+		p_data[rx_len] = i2c->read();
+		rx_len++;
+	}
+	return (rx_len == length) ? PAL_STATUS_SUCCESS : PAL_STATUS_FAILURE;
+}
+
+#if defined(PAL_I2C_ARDUINO_ASYNC)
+// Runs in the event loop once the driver reported the end of the transfer
+static void pal_i2c_arduino_completion(void* p_args)
+{
+	pal_arduino_i2c_t* p_i2c = (pal_arduino_i2c_t*)p_args;
+
+	p_i2c->busy = FALSE;
+	pal_i2c_arduino_notify(p_i2c->p_request_ctx, p_i2c->request_status);
+}
+#endif
+
+static pal_status_t pal_i2c_arduino_submit(pal_i2c_t* p_i2c_context, bool_t write, uint8_t* p_data, uint16_t length)
+{
+	TwoWire* i2c;
+	pal_status_t status;
+#if defined(PAL_I2C_ARDUINO_ASYNC)
+	pal_arduino_i2c_t* p_i2c;
+	pal_arduino_i2c_start_t start;
+#endif
+
+	if ((NULL == p_i2c_context) || (NULL == p_i2c_context->p_i2c_hw_config))
+	{
+		return PAL_STATUS_FAILURE;
+	}
+#if defined(PAL_I2C_ARDUINO_ASYNC)
+	p_i2c = (pal_arduino_i2c_t*)p_i2c_context->p_i2c_hw_config;
+	start = (write) ? p_i2c->start_write : p_i2c->start_read;
+	if (NULL != start)
+	{
+		if (p_i2c->busy)
+		{
+			pal_i2c_arduino_notify(p_i2c_context, PAL_STATUS_I2C_BUSY);
+			return PAL_STATUS_I2C_BUSY;
+		}
+		p_i2c->busy = TRUE;
+		p_i2c->p_request_ctx = p_i2c_context;
+		p_i2c->request_status = PAL_STATUS_FAILURE;
+		//The driver may already report the end from its interrupt, the completion is delivered by the event loop
+		status = start(p_i2c, p_i2c_context->slave_address, p_data, length);
+		if (PAL_STATUS_SUCCESS != status)
+		{
+			p_i2c->busy = FALSE;
+			pal_i2c_arduino_notify(p_i2c_context, PAL_STATUS_FAILURE);
+		}
+		return status;
+	}
+#endif
+	i2c = pal_i2c_arduino_wire(p_i2c_context);
+	if (NULL == i2c)
+	{
+		return PAL_STATUS_FAILURE;
+	}
+	status = (write) ? pal_i2c_arduino_wire_write(i2c, p_i2c_context->slave_address, p_data, length) :
+	                   pal_i2c_arduino_wire_read(i2c, p_i2c_context->slave_address, p_data, length);
+	pal_i2c_arduino_notify(p_i2c_context, status);
+	return status;
+}
+/// @endcond
 
 /**********************************************************************************************************************
  * API IMPLEMENTATION
@@ -76,14 +191,33 @@
  *
  * \retval  #PAL_STATUS_SUCCESS  Returns when the I2C master init it successfull
  * \retval  #PAL_STATUS_FAILURE  Returns when the I2C init fails.
+ *
+ *<b>Notes:</b><br>
+ *  - With #PAL_I2C_ARDUINO_ASYNC the completion of the #pal_arduino_i2c_t is registered with the event loop, so the
+ *    API must be called from the event loop context.<br>
  */
 pal_status_t pal_i2c_init(const pal_i2c_t* p_i2c_context)
 {
 	pal_status_t status = PAL_STATUS_FAILURE;
+	TwoWire * i2c = NULL;
+#if defined(PAL_I2C_ARDUINO_ASYNC)
+	pal_arduino_i2c_t* p_i2c;
+#endif
 
 	if ((p_i2c_context != NULL) && (p_i2c_context->p_i2c_hw_config != NULL))
 	{
-		((TwoWire *)(p_i2c_context->p_i2c_hw_config))->begin();
+#if defined(PAL_I2C_ARDUINO_ASYNC)
+		p_i2c = (pal_arduino_i2c_t*)p_i2c_context->p_i2c_hw_config;
+		if (!p_i2c->busy)
+		{
+			pal_os_event_post_init(&p_i2c->completion, pal_i2c_arduino_completion, p_i2c);
+		}
+#endif
+		i2c = pal_i2c_arduino_wire(p_i2c_context);
+		if (i2c != NULL)
+		{
+			i2c->begin();
+		}
 		status = PAL_STATUS_SUCCESS;
 	}
 
@@ -111,6 +245,7 @@ pal_status_t pal_i2c_init(const pal_i2c_t* p_i2c_context)
  *
  * \retval  #PAL_STATUS_SUCCESS  Returns when the I2C master de-init it successfull
  * \retval  #PAL_STATUS_FAILURE  Returns when the I2C de-init fails.
+ * \retval  #PAL_STATUS_I2C_BUSY Returns when a non-blocking transfer is in progress.
  */
 pal_status_t pal_i2c_deinit(const pal_i2c_t* p_i2c_context)
 {
@@ -119,6 +254,12 @@ pal_status_t pal_i2c_deinit(const pal_i2c_t* p_i2c_context)
 	if ((p_i2c_context != NULL) && (p_i2c_context->p_i2c_hw_config != NULL))
 	{
 		status = PAL_STATUS_SUCCESS;
+#if defined(PAL_I2C_ARDUINO_ASYNC)
+		if (((pal_arduino_i2c_t*)p_i2c_context->p_i2c_hw_config)->busy)
+		{
+			status = PAL_STATUS_I2C_BUSY;
+		}
+#endif
 	}
 
     return status;
@@ -134,6 +275,10 @@ pal_status_t pal_i2c_deinit(const pal_i2c_t* p_i2c_context)
  *<b>API Details:</b>
  * - The API attempts to write if the I2C bus is free, else it returns busy status #PAL_STATUS_I2C_BUSY<br>
  * - The bus is released only after the completion of transmission or after completion of error handling.<br>
+ * - By default the write blocks in Wire and the upper layer handler is invoked before the API returns.<br>
+ * - With #PAL_I2C_ARDUINO_ASYNC and a #pal_arduino_i2c_t.start_write hook, the API only starts the transfer and
+ *   returns. The upper layer handler is invoked from the event loop (#pal_os_event_wait/#pal_os_event_process)
+ *   after the driver called #pal_i2c_arduino_transfer_done.<br>
  * - The API invokes the upper layer handler with the respective event status as explained below.
  *   - #PAL_I2C_EVENT_BUSY when I2C bus in busy state
  *   - #PAL_I2C_EVENT_ERROR when API fails
@@ -156,52 +301,9 @@ pal_status_t pal_i2c_deinit(const pal_i2c_t* p_i2c_context)
  * \retval  #PAL_STATUS_FAILURE  Returns when the I2C write fails.
  * \retval  #PAL_STATUS_I2C_BUSY Returns when the I2C bus is busy. 
  */
-#define MAX_POLLING	50
 pal_status_t pal_i2c_write(pal_i2c_t* p_i2c_context,uint8_t* p_data , uint16_t length)
 {
-	app_event_handler_t upper_layer_handler;
-	//Serial.println(">pal_i2c_write");
-	upper_layer_handler = (app_event_handler_t)p_i2c_context->upper_layer_event_handler;
-    pal_status_t status = PAL_STATUS_FAILURE;
-    TwoWire * i2c = NULL;
-    uint16_t ack = 0;
-    uint8_t tx_cntr = 0;
-
-    do {
-    	if (p_i2c_context == NULL)
-    		break;
-
-    	if (p_i2c_context->p_i2c_hw_config == NULL)
-    		break;
-
-    	i2c = (TwoWire *)p_i2c_context->p_i2c_hw_config;
-
-		i2c->beginTransmission(p_i2c_context->slave_address);
-		i2c->write(p_data, length);
-		ack = i2c->endTransmission(true);
-
-		if (ack == 0) {
-			upper_layer_handler(p_i2c_context->upper_layer_ctx, PAL_I2C_EVENT_SUCCESS);
-			status = PAL_STATUS_SUCCESS;
-/*
-			Serial.print("->  ");
-			for(int i = 0; i < length; i++)
-			{
-				Serial.print("0x");
-			    Serial.print(p_data[i], HEX);
-				Serial.print(" ");
-			}
-			Serial.print("\n");
-*/
-		} else {
-			upper_layer_handler(p_i2c_context->upper_layer_ctx, PAL_I2C_EVENT_ERROR);
-			//Serial.print("~->\n");
-		}
-    }while(0);
-
-
-    //Serial.println("<pal_i2c_write");
-    return status;
+	return pal_i2c_arduino_submit(p_i2c_context, TRUE, p_data, length);
 }
 
 /**
@@ -213,6 +315,10 @@ pal_status_t pal_i2c_write(pal_i2c_t* p_i2c_context,uint8_t* p_data , uint16_t l
  *<b>API Details:</b>
  * - The API attempts to read if the I2C bus is free, else it returns busy status #PAL_STATUS_I2C_BUSY<br>
  * - The bus is released only after the completion of reception or after completion of error handling.<br>
+ * - By default the read blocks in Wire and the upper layer handler is invoked before the API returns.<br>
+ * - With #PAL_I2C_ARDUINO_ASYNC and a #pal_arduino_i2c_t.start_read hook, the API only starts the transfer and
+ *   returns. The driver fills p_data, so the buffer must stay valid until the upper layer handler is invoked
+ *   from the event loop.<br>
  * - The API invokes the upper layer handler with the respective event status as explained below.
  *   - #PAL_I2C_EVENT_BUSY when I2C bus in busy state
  *   - #PAL_I2C_EVENT_ERROR when API fails
@@ -237,60 +343,7 @@ pal_status_t pal_i2c_write(pal_i2c_t* p_i2c_context,uint8_t* p_data , uint16_t l
  */
 pal_status_t pal_i2c_read(pal_i2c_t* p_i2c_context , uint8_t* p_data , uint16_t length)
 {
-	app_event_handler_t upper_layer_handler;
-	upper_layer_handler = (app_event_handler_t)p_i2c_context->upper_layer_event_handler;
-    pal_status_t status = PAL_STATUS_FAILURE;
-    TwoWire * i2c = NULL;
-    uint16_t rx_len = 0;
-    int 	 bytes = length;
-
-    do {
-    	if (p_i2c_context == NULL)
-    		break;
-
-    	if (p_i2c_context->p_i2c_hw_config == NULL)
-    		break;
-
-    	i2c = (TwoWire *)p_i2c_context->p_i2c_hw_config;
-
-		bytes = i2c->requestFrom((int)p_i2c_context->slave_address, bytes);
-
-		if (bytes == 0)
-		{
-			//Serial.print("~<\n");
-			upper_layer_handler(p_i2c_context->upper_layer_ctx, PAL_I2C_EVENT_ERROR);
-			break;
-		}
-
-		while (i2c->available() && (rx_len < length))
-		{
-			p_data[rx_len] = i2c->read();
-			rx_len++;
-		}
-
-		if (rx_len == length)
-		{
-			upper_layer_handler(p_i2c_context->upper_layer_ctx, PAL_I2C_EVENT_SUCCESS);
-			status = PAL_STATUS_SUCCESS;
-			/*
-			Serial.print("<-  ");
-			for(int i = 0; i < rx_len; i++)
-			{
-				Serial.print("0x");
-			    Serial.print(p_data[i], HEX);
-				Serial.print(" ");
-			}
-			Serial.print("\n");
-			*/
-		}
-		else {
-			//Serial.print("~<-\n");
-			upper_layer_handler(p_i2c_context->upper_layer_ctx, PAL_I2C_EVENT_ERROR);
-		}
-
-    }while(0);
-
-    return status;
+	return pal_i2c_arduino_submit(p_i2c_context, FALSE, p_data, length);
 }
 
    
@@ -325,6 +378,7 @@ pal_status_t pal_i2c_read(pal_i2c_t* p_i2c_context , uint8_t* p_data , uint16_t
 pal_status_t pal_i2c_set_bitrate(const pal_i2c_t* p_i2c_context , uint16_t bitrate)
 {
 	pal_status_t status = PAL_STATUS_FAILURE;
+	TwoWire * i2c = NULL;
 
 	if (bitrate > PAL_I2C_MASTER_MAX_BITRATE)
 	{
@@ -333,13 +387,38 @@ pal_status_t pal_i2c_set_bitrate(const pal_i2c_t* p_i2c_context , uint16_t bitra
 
 	if ((p_i2c_context != NULL) && (p_i2c_context->p_i2c_hw_config != NULL))
 	{
-		((TwoWire *)(p_i2c_context->p_i2c_hw_config))->setClock(bitrate*1000);
+		i2c = pal_i2c_arduino_wire(p_i2c_context);
+		if (i2c != NULL)
+		{
+			i2c->setClock(bitrate*1000);
+		}
 		status = PAL_STATUS_SUCCESS;
 	}
 
 	return status;
 }
 
+#if defined(PAL_I2C_ARDUINO_ASYNC)
+/**
+ * Reports the end of a transfer started by a #pal_arduino_i2c_t driver hook.
+ * <br>
+ *
+ *<b>API Details:</b>
+ * - Stores the result and posts the completion of the context. The upper layer handler is invoked by the next
+ *   #pal_os_event_dispatch, so the function can be called from the interrupt handler of the driver.<br>
+ *
+ * \param[in,out] p_i2c  Context the transfer was started on
+ * \param[in]     status #PAL_STATUS_SUCCESS if all bytes were transferred, else #PAL_STATUS_FAILURE
+ */
+void pal_i2c_arduino_transfer_done(pal_arduino_i2c_t* p_i2c, pal_status_t status)
+{
+	p_i2c->request_status = status;
+	pal_os_event_post(&p_i2c->completion);
+}
+#endif
+
+#endif /* ARDUINO */
+
 /**
 * @}
 */
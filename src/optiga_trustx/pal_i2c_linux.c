@@ -0,0 +1,429 @@
+/**
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+*
+* \file
+*
+* \brief This file implements the platform abstraction layer(pal) APIs for I2C on Linux hosts (i2c-dev).
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include "pal.h"
+
+#if defined(PAL_TARGET_LINUX)
+
+/**********************************************************************************************************************
+ * HEADER FILES
+ *********************************************************************************************************************/
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c-dev.h>
+#include "pal_i2c.h"
+#include "pal_linux.h"
+
+/**********************************************************************************************************************
+ * MACROS
+ *********************************************************************************************************************/
+/// i2c-dev does not allow to change the bus frequency, the value is only used to clip requests
+#define PAL_I2C_MASTER_MAX_BITRATE  (1000)
+/// Marks that no slave address is selected on the file descriptor
+#define PAL_LINUX_I2C_NO_ADDRESS    (0xFF)
+
+/// Worker request: none
+#define PAL_LINUX_I2C_REQUEST_NONE  (0x00)
+/// Worker request: write transfer
+#define PAL_LINUX_I2C_REQUEST_WRITE (0x01)
+/// Worker request: read transfer
+#define PAL_LINUX_I2C_REQUEST_READ  (0x02)
+/// Worker request: terminate the worker
+#define PAL_LINUX_I2C_REQUEST_STOP  (0x03)
+
+/// @cond hidden
+/*********************************************************************************************************************
+ * LOCAL DATA
+ *********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ * LOCAL ROUTINES
+ *********************************************************************************************************************/
+static pal_status_t pal_i2c_linux_select_slave(pal_linux_i2c_t* p_i2c, uint8_t slave_address)
+{
+    if (p_i2c->fd < 0)
+    {
+        return PAL_STATUS_FAILURE;
+    }
+    if (p_i2c->selected_address != slave_address)
+    {
+        if (ioctl(p_i2c->fd, I2C_SLAVE, (unsigned long)slave_address) < 0)
+        {
+            return PAL_STATUS_FAILURE;
+        }
+        p_i2c->selected_address = slave_address;
+    }
+    return PAL_STATUS_SUCCESS;
+}
+
+static void pal_i2c_linux_notify(const pal_i2c_t* p_i2c_context, pal_status_t status)
+{
+    app_event_handler_t upper_layer_handler = (app_event_handler_t)p_i2c_context->upper_layer_event_handler;
+    host_lib_status_t event = PAL_I2C_EVENT_ERROR;
+
+    if (PAL_STATUS_SUCCESS == status)
+    {
+        event = PAL_I2C_EVENT_SUCCESS;
+    }
+    else if (PAL_STATUS_I2C_BUSY == status)
+    {
+        event = PAL_I2C_EVENT_BUSY;
+    }
+    if (NULL != upper_layer_handler)
+    {
+        upper_layer_handler(p_i2c_context->upper_layer_ctx, event);
+    }
+}
+
+static pal_status_t pal_i2c_linux_transfer(pal_linux_i2c_t* p_i2c, uint8_t slave_address, uint8_t request,
+                                           uint8_t* p_data, uint16_t length)
+{
+    ssize_t done;
+
+    if (NULL != p_i2c->p_virtual_chip)
+    {
+        return (PAL_LINUX_I2C_REQUEST_WRITE == request) ?
+               pal_i2c_virtual_chip_write(p_i2c->p_virtual_chip, slave_address, p_data, length) :
+               pal_i2c_virtual_chip_read(p_i2c->p_virtual_chip, slave_address, p_data, length);
+    }
+    if (PAL_STATUS_SUCCESS != pal_i2c_linux_select_slave(p_i2c, slave_address))
+    {
+        return PAL_STATUS_FAILURE;
+    }
+    done = (PAL_LINUX_I2C_REQUEST_WRITE == request) ? write(p_i2c->fd, p_data, length) :
+                                                      read(p_i2c->fd, p_data, length);
+    return (done == (ssize_t)length) ? PAL_STATUS_SUCCESS : PAL_STATUS_FAILURE;
+}
+
+// Runs in the event loop once the worker posted the completion
+static void pal_i2c_linux_completion(void* p_args)
+{
+    pal_linux_i2c_t* p_i2c = (pal_linux_i2c_t*)p_args;
+
+    p_i2c->busy = FALSE;
+    pal_i2c_linux_notify(p_i2c->p_request_ctx, p_i2c->request_status);
+}
+
+static void* pal_i2c_linux_worker(void* p_args)
+{
+    pal_linux_i2c_t* p_i2c = (pal_linux_i2c_t*)p_args;
+    uint8_t request;
+
+    for (;;)
+    {
+        pthread_mutex_lock(&p_i2c->lock);
+        while (PAL_LINUX_I2C_REQUEST_NONE == p_i2c->request)
+        {
+            pthread_cond_wait(&p_i2c->request_signal, &p_i2c->lock);
+        }
+        request = p_i2c->request;
+        pthread_mutex_unlock(&p_i2c->lock);
+
+        if (PAL_LINUX_I2C_REQUEST_STOP == request)
+        {
+            break;
+        }
+        p_i2c->request_status = pal_i2c_linux_transfer(p_i2c, p_i2c->p_request_ctx->slave_address, request,
+                                                       p_i2c->p_request_data, p_i2c->request_length);
+
+        pthread_mutex_lock(&p_i2c->lock);
+        p_i2c->request = PAL_LINUX_I2C_REQUEST_NONE;
+        pthread_mutex_unlock(&p_i2c->lock);
+        pal_os_event_post(&p_i2c->completion);
+    }
+    return NULL;
+}
+
+static pal_status_t pal_i2c_linux_start_worker(pal_linux_i2c_t* p_i2c)
+{
+    if (p_i2c->worker_started)
+    {
+        return PAL_STATUS_SUCCESS;
+    }
+    p_i2c->request = PAL_LINUX_I2C_REQUEST_NONE;
+    p_i2c->busy = FALSE;
+    pal_os_event_post_init(&p_i2c->completion, pal_i2c_linux_completion, p_i2c);
+    if ((0 != pthread_mutex_init(&p_i2c->lock, NULL)) || (0 != pthread_cond_init(&p_i2c->request_signal, NULL)))
+    {
+        return PAL_STATUS_FAILURE;
+    }
+    if (0 != pthread_create(&p_i2c->worker, NULL, pal_i2c_linux_worker, p_i2c))
+    {
+        return PAL_STATUS_FAILURE;
+    }
+    p_i2c->worker_started = TRUE;
+    return PAL_STATUS_SUCCESS;
+}
+
+static void pal_i2c_linux_stop_worker(pal_linux_i2c_t* p_i2c)
+{
+    if (p_i2c->worker_started)
+    {
+        pthread_mutex_lock(&p_i2c->lock);
+        p_i2c->request = PAL_LINUX_I2C_REQUEST_STOP;
+        pthread_cond_signal(&p_i2c->request_signal);
+        pthread_mutex_unlock(&p_i2c->lock);
+        pthread_join(p_i2c->worker, NULL);
+        p_i2c->worker_started = FALSE;
+        p_i2c->busy = FALSE;
+    }
+}
+
+static pal_status_t pal_i2c_linux_submit(pal_i2c_t* p_i2c_context, uint8_t request, uint8_t* p_data, uint16_t length)
+{
+    pal_linux_i2c_t* p_i2c;
+    pal_status_t status;
+
+    if ((NULL == p_i2c_context) || (NULL == p_i2c_context->p_i2c_hw_config))
+    {
+        return PAL_STATUS_FAILURE;
+    }
+    p_i2c = (pal_linux_i2c_t*)p_i2c_context->p_i2c_hw_config;
+
+    if (!p_i2c->worker_started)
+    {
+        status = pal_i2c_linux_transfer(p_i2c, p_i2c_context->slave_address, request, p_data, length);
+        pal_i2c_linux_notify(p_i2c_context, status);
+        return status;
+    }
+    if (p_i2c->busy)
+    {
+        pal_i2c_linux_notify(p_i2c_context, PAL_STATUS_I2C_BUSY);
+        return PAL_STATUS_I2C_BUSY;
+    }
+    p_i2c->busy = TRUE;
+    pthread_mutex_lock(&p_i2c->lock);
+    p_i2c->p_request_ctx = p_i2c_context;
+    p_i2c->p_request_data = p_data;
+    p_i2c->request_length = length;
+    p_i2c->request = request;
+    pthread_cond_signal(&p_i2c->request_signal);
+    pthread_mutex_unlock(&p_i2c->lock);
+    return PAL_STATUS_SUCCESS;
+}
+/// @endcond
+
+/**********************************************************************************************************************
+ * API IMPLEMENTATION
+ *********************************************************************************************************************/
+
+/**
+ * Initializes the i2c master with the given context.
+ * <br>
+ *
+ *<b>API Details:</b>
+ * - Opens the i2c-dev node of the context, unless the context is bound to a virtual chip.<br>
+ * - If #pal_linux_i2c_t.async is set, starts the worker thread executing the transfers.<br>
+ * - Repeated initialization keeps the already opened node and worker.<br>
+ *
+ *<b>User Input:</b><br>
+ * - The input #pal_i2c_t p_i2c_context must not be NULL.<br>
+ *
+ * \param[in] p_i2c_context   Pal i2c context to be initialized
+ *
+ * \retval  #PAL_STATUS_SUCCESS  Returns when the I2C master init it successfull
+ * \retval  #PAL_STATUS_FAILURE  Returns when the I2C init fails.
+ */
+pal_status_t pal_i2c_init(const pal_i2c_t* p_i2c_context)
+{
+    pal_status_t status = PAL_STATUS_FAILURE;
+    pal_linux_i2c_t* p_i2c;
+
+    do
+    {
+        if ((NULL == p_i2c_context) || (NULL == p_i2c_context->p_i2c_hw_config))
+        {
+            break;
+        }
+        p_i2c = (pal_linux_i2c_t*)p_i2c_context->p_i2c_hw_config;
+        if ((NULL == p_i2c->p_virtual_chip) && (p_i2c->fd < 0))
+        {
+            p_i2c->fd = open((NULL != p_i2c->p_device) ? p_i2c->p_device : PAL_LINUX_I2C_DEFAULT_DEVICE, O_RDWR);
+            if (p_i2c->fd < 0)
+            {
+                break;
+            }
+            p_i2c->selected_address = PAL_LINUX_I2C_NO_ADDRESS;
+        }
+        status = (p_i2c->async) ? pal_i2c_linux_start_worker(p_i2c) : PAL_STATUS_SUCCESS;
+    } while (FALSE);
+
+    return status;
+}
+
+/**
+ * De-initializes the I2C master with the specified context.
+ * <br>
+ *
+ *<b>API Details:</b>
+ * - Stops the worker thread and closes the i2c-dev node of the context.<br>
+ *
+ *<b>User Input:</b><br>
+ * - The input #pal_i2c_t p_i2c_context must not be NULL.<br>
+ *
+ * \param[in] p_i2c_context   I2C context to be de-initialized
+ *
+ * \retval  #PAL_STATUS_SUCCESS  Returns when the I2C master de-init it successfull
+ * \retval  #PAL_STATUS_FAILURE  Returns when the I2C de-init fails.
+ */
+pal_status_t pal_i2c_deinit(const pal_i2c_t* p_i2c_context)
+{
+    pal_status_t status = PAL_STATUS_FAILURE;
+    pal_linux_i2c_t* p_i2c;
+
+    if ((NULL != p_i2c_context) && (NULL != p_i2c_context->p_i2c_hw_config))
+    {
+        p_i2c = (pal_linux_i2c_t*)p_i2c_context->p_i2c_hw_config;
+        pal_i2c_linux_stop_worker(p_i2c);
+        if (p_i2c->fd >= 0)
+        {
+            close(p_i2c->fd);
+            p_i2c->fd = -1;
+        }
+        status = PAL_STATUS_SUCCESS;
+    }
+
+    return status;
+}
+
+/**
+ * Writes the data to I2C slave.
+ * <br>
+ *
+ *<b>API Details:</b>
+ * - Without #pal_linux_i2c_t.async the transfer is executed synchronously and the upper layer handler is invoked
+ *   before the API returns.<br>
+ * - With #pal_linux_i2c_t.async the transfer is handed to the worker thread and the API returns immediately.
+ *   The upper layer handler is invoked from the event loop (#pal_os_event_wait/#pal_os_event_process)
+ *   once the transfer is complete.<br>
+ * - The upper layer handler is invoked with the respective event status as explained below.
+ *   - #PAL_I2C_EVENT_BUSY when a transfer is still in progress
+ *   - #PAL_I2C_EVENT_ERROR when API fails (Example: slave does not acknowledge)
+ *   - #PAL_I2C_EVENT_SUCCESS when operation is successfully completed
+ *<br>
+ *
+ *<b>User Input:</b><br>
+ * - The input #pal_i2c_t p_i2c_context must not be NULL.<br>
+ * - The upper_layer_event_handler must be initialized in the p_i2c_context before invoking the API.<br>
+ *
+ *<b>Notes:</b><br> 
+ *  - The caller of this API must take care of the guard time based on the slave's requirement.<br>
+ *
+ * \param[in] p_i2c_context  Pointer to the pal I2C context #pal_i2c_t
+ * \param[in] p_data         Pointer to the data to be written
+ * \param[in] length         Length of the data to be written
+ *
+ * \retval  #PAL_STATUS_SUCCESS  Returns when the I2C write is invoked successfully
+ * \retval  #PAL_STATUS_FAILURE  Returns when the I2C write fails.
+ * \retval  #PAL_STATUS_I2C_BUSY Returns when a transfer is in progress.
+ */
+pal_status_t pal_i2c_write(pal_i2c_t* p_i2c_context, uint8_t* p_data, uint16_t length)
+{
+    return pal_i2c_linux_submit(p_i2c_context, PAL_LINUX_I2C_REQUEST_WRITE, p_data, length);
+}
+
+/**
+ * Reads the data from I2C slave.
+ * <br>
+ *
+ *<b>API Details:</b>
+ * - Without #pal_linux_i2c_t.async the transfer is executed synchronously and the upper layer handler is invoked
+ *   before the API returns.<br>
+ * - With #pal_linux_i2c_t.async the transfer is handed to the worker thread and the API returns immediately.
+ *   The upper layer handler is invoked from the event loop (#pal_os_event_wait/#pal_os_event_process)
+ *   once the transfer is complete.<br>
+ * - The upper layer handler is invoked with the respective event status as explained below.
+ *   - #PAL_I2C_EVENT_BUSY when a transfer is still in progress
+ *   - #PAL_I2C_EVENT_ERROR when API fails (Example: slave does not acknowledge)
+ *   - #PAL_I2C_EVENT_SUCCESS when operation is successfully completed
+ *<br>
+ *
+ *<b>User Input:</b><br>
+ * - The input #pal_i2c_t p_i2c_context must not be NULL.<br>
+ * - The upper_layer_event_handler must be initialized in the p_i2c_context before invoking the API.<br>
+ *
+ *<b>Notes:</b><br> 
+ *  - The caller of this API must take care of the guard time based on the slave's requirement.<br>
+ *
+ * \param[in]  p_i2c_context  pointer to the PAL i2c context #pal_i2c_t
+ * \param[in]  p_data         Pointer to the data buffer to store the read data
+ * \param[in]  length         Length of the data to be read
+ *
+ * \retval  #PAL_STATUS_SUCCESS  Returns when the I2C read is invoked successfully
+ * \retval  #PAL_STATUS_FAILURE  Returns when the I2C read fails.
+ * \retval  #PAL_STATUS_I2C_BUSY Returns when a transfer is in progress.
+ */
+pal_status_t pal_i2c_read(pal_i2c_t* p_i2c_context, uint8_t* p_data, uint16_t length)
+{
+    return pal_i2c_linux_submit(p_i2c_context, PAL_LINUX_I2C_REQUEST_READ, p_data, length);
+}
+
+/**
+ * Sets the bitrate/speed(KHz) of I2C master.
+ * <br>
+ *
+ *<b>API Details:</b>
+ * - The bus frequency of an i2c-dev adapter is fixed by the kernel/device tree configuration. The API only
+ *   validates the context, so the slave side negotiation of the stack still takes place.<br>
+ *
+ *<b>User Input:</b><br>
+ * - The input #pal_i2c_t  p_i2c_context must not be NULL.<br>
+ *
+ * \param[in] p_i2c_context  Pointer to the pal i2c context
+ * \param[in] bitrate        Bitrate to be used by i2c master in KHz
+ *
+ * \retval  #PAL_STATUS_SUCCESS  Returns when the setting of bitrate is successfully completed
+ * \retval  #PAL_STATUS_FAILURE  Returns when the setting of bitrate fails.
+ */
+pal_status_t pal_i2c_set_bitrate(const pal_i2c_t* p_i2c_context, uint16_t bitrate)
+{
+    pal_status_t status = PAL_STATUS_FAILURE;
+
+    if (bitrate > PAL_I2C_MASTER_MAX_BITRATE)
+    {
+        bitrate = PAL_I2C_MASTER_MAX_BITRATE;
+    }
+
+    if ((NULL != p_i2c_context) && (NULL != p_i2c_context->p_i2c_hw_config) && (0 != bitrate))
+    {
+        status = PAL_STATUS_SUCCESS;
+    }
+
+    return status;
+}
+
+#endif /* PAL_TARGET_LINUX */
+
+/**
+* @}
+*/
@@ -0,0 +1,1038 @@
+/**
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+*
+* \file
+*
+* \brief This file implements a simulated OPTIGA I2C slave (virtual chip).
+*
+* The virtual chip implements the slave side of the IFX I2C protocol: the register interface of the physical layer,
+* the frame/acknowledge handling of the data link layer and the chaining of the transport layer. Reassembled APDUs are
+* passed to a pluggable APDU handler. The response becomes visible in I2C_STATE only after the configured execution
+* time has elapsed, so polling behaviour of the host stack can be profiled without hardware.
+*
+* \ingroup  grPAL
+* @{
+*/
+
+/**********************************************************************************************************************
+ * HEADER FILES
+ *********************************************************************************************************************/
+#include <string.h>
+#include "pal_i2c_virtual_chip.h"
+#include "pal_os_timer.h"
+
+/// @cond hidden
+/**********************************************************************************************************************
+ * MACROS
+ *********************************************************************************************************************/
+// Registers
+#define VC_REG_DATA                 0x80
+#define VC_REG_DATA_REG_LEN         0x81
+#define VC_REG_I2C_STATE            0x82
+#define VC_REG_BASE_ADDR            0x83
+#define VC_REG_MAX_SCL_FREQU        0x84
+#define VC_REG_SOFT_RESET           0x88
+#define VC_REG_I2C_MODE             0x89
+
+// I2C_STATE flags
+#define VC_I2C_STATE_BUSY           0x80
+#define VC_I2C_STATE_RESPONSE_READY 0x40
+#define VC_I2C_STATE_SOFT_RESET     0x08
+
+// I2C_MODE values
+#define VC_I2C_MODE_FM_PLUS         0x04
+#define VC_MAX_SCL_FREQUENCY_FM_PLUS (1000)
+
+// Smallest frame size the slave accepts in DATA_REG_LEN
+#define VC_MIN_FRAME_SIZE           0x0010
+
+// Data link layer
+#define VC_DL_HEADER_SIZE           5
+#define VC_DL_MAX_FRAME_NUM         0x03
+#define VC_DL_FCTR_CONTROL_FRAME    0x80
+#define VC_DL_FCTR_SEQCTR_OFFSET    5
+#define VC_DL_FCTR_FRNR_OFFSET      2
+#define VC_DL_SEQCTR_ACK            0
+#define VC_DL_SEQCTR_NACK           1
+#define VC_DL_SEQCTR_RESYNC         2
+
+// Transport layer
+#define VC_TL_PCTR_CHAIN_MASK       0x07
+#define VC_TL_CHAINING_NO           0x00
+#define VC_TL_CHAINING_FIRST        0x01
+#define VC_TL_CHAINING_INTERMEDIATE 0x02
+#define VC_TL_CHAINING_LAST         0x04
+#define VC_TL_CHAINING_ERROR        0x07
+
+// APDU layout
+#define VC_APDU_HEADER_SIZE         4
+#define VC_CMD_GETDATA              0x01
+#define VC_CMD_SETDATA              0x02
+#define VC_CMD_GET_RND              0x0C
+#define VC_CMD_CALC_HASH            0x30
+#define VC_CMD_OPEN_APP             0x70
+#define VC_CMD_CODE_MSB             0x80
+#define VC_PARAM_GET_METADATA       0x01
+#define VC_PARAM_SET_METADATA       0x01
+#define VC_PARAM_SET_DATA_ERASE     0x40
+#define VC_PARAM_HASH_SHA256        0xE2
+
+// CalcHash: data tag is the data type (high nibble) and the sequence (low nibble)
+#define VC_HASH_SEQ_START           0x00
+#define VC_HASH_SEQ_START_FINAL     0x01
+#define VC_HASH_SEQ_CONTINUE        0x02
+#define VC_HASH_SEQ_FINAL           0x03
+#define VC_HASH_SEQ_TERMINATE       0x04
+#define VC_HASH_SEQ_INTERMEDIATE    0x05
+#define VC_HASH_TYPE_STREAM         0x00
+#define VC_HASH_TYPE_OID            0x01
+#define VC_HASH_TAG_OUTPUT          0x01
+#define VC_HASH_TAG_IMPORT          0x06
+#define VC_HASH_TAG_EXPORT          0x07
+#define VC_HASH_TLV_HEADER_SIZE     3
+#define VC_HASH_OID_DATA_SIZE       6
+
+// Objects provided by the chip itself when not part of the object table
+#define VC_OID_LCSG                 0xE0C0
+#define VC_OID_MAX_COMMS_BUFFER     0xE0C6
+#define VC_OID_LCSA                 0xF1C0
+#define VC_OID_ERROR_CODES          0xF1C2
+#define VC_LCS_OPERATIONAL          0x07
+
+/**********************************************************************************************************************
+ * LOCAL DATA
+ *********************************************************************************************************************/
+/// Metadata reported for objects without own metadata: change always, read always
+static const uint8_t vc_default_metadata[] = {0x20, 0x06, 0xD0, 0x01, 0x00, 0xD1, 0x01, 0x00};
+
+/**********************************************************************************************************************
+ * LOCAL ROUTINES
+ *********************************************************************************************************************/
+static uint32_t vc_now_us(void)
+{
+    return pal_os_timer_get_time_in_microseconds();
+}
+
+static uint16_t vc_calc_crc_byte(uint16_t wSeed, uint8_t bByte)
+{
+    uint16_t wh1;
+    uint16_t wh2;
+    uint16_t wh3;
+    uint16_t wh4;
+
+    wh1 = (wSeed ^ bByte) & 0xFF;
+    wh2 = wh1 & 0x0F;
+    wh3 = ((uint16_t)(wh2 << 4)) ^ wh1;
+    wh4 = wh3 >> 4;
+
+    return ((uint16_t)((((uint16_t)((((uint16_t)(wh3 << 1)) ^ wh4) << 4)) ^ wh2) << 3)) ^ wh4
+        ^ (wSeed >> 8);
+}
+
+static uint16_t vc_calc_crc(const uint8_t* p_data, uint16_t data_len)
+{
+    uint16_t i;
+    uint16_t crc = 0;
+
+    for (i = 0; i < data_len; i++)
+    {
+        crc = vc_calc_crc_byte(crc, p_data[i]);
+    }
+    return crc;
+}
+
+static void vc_reset_protocol(pal_i2c_virtual_chip_t* p_chip)
+{
+    p_chip->tx_seq_nr = VC_DL_MAX_FRAME_NUM;
+    p_chip->rx_seq_nr = VC_DL_MAX_FRAME_NUM;
+    p_chip->awaiting_ack = FALSE;
+    p_chip->out_frame_length = 0;
+    p_chip->last_data_frame_length = 0;
+    p_chip->apdu_length = 0;
+    p_chip->response_length = 0;
+    p_chip->response_offset = 0;
+    p_chip->response_pending = FALSE;
+}
+
+static void vc_dl_finish_frame(uint8_t* p_frame, uint16_t packet_len)
+{
+    uint16_t crc;
+
+    p_frame[1] = (uint8_t)(packet_len >> 8);
+    p_frame[2] = (uint8_t)packet_len;
+    crc = vc_calc_crc(p_frame, 3 + packet_len);
+    p_frame[3 + packet_len] = (uint8_t)(crc >> 8);
+    p_frame[4 + packet_len] = (uint8_t)crc;
+}
+
+static void vc_dl_queue_control_frame(pal_i2c_virtual_chip_t* p_chip, uint8_t seqctr, uint8_t ack_nr)
+{
+    p_chip->out_frame[0] = (uint8_t)(VC_DL_FCTR_CONTROL_FRAME | (seqctr << VC_DL_FCTR_SEQCTR_OFFSET) |
+                                     (ack_nr & VC_DL_MAX_FRAME_NUM));
+    vc_dl_finish_frame(p_chip->out_frame, 0);
+    p_chip->out_frame_length = VC_DL_HEADER_SIZE;
+}
+
+static void vc_tl_queue_next_fragment(pal_i2c_virtual_chip_t* p_chip)
+{
+    uint16_t max_packet_length = p_chip->frame_size - (VC_DL_HEADER_SIZE + 1);
+    uint16_t remaining = p_chip->response_length - p_chip->response_offset;
+    uint16_t fragment_length = remaining;
+    uint8_t pctr;
+    uint8_t* p_frame = p_chip->last_data_frame;
+
+    if (remaining > max_packet_length)
+    {
+        fragment_length = max_packet_length;
+        pctr = (0 == p_chip->response_offset) ? VC_TL_CHAINING_FIRST : VC_TL_CHAINING_INTERMEDIATE;
+    }
+    else
+    {
+        pctr = (0 == p_chip->response_offset) ? VC_TL_CHAINING_NO : VC_TL_CHAINING_LAST;
+    }
+
+    p_chip->tx_seq_nr = (p_chip->tx_seq_nr + 1) & VC_DL_MAX_FRAME_NUM;
+    p_frame[0] = (uint8_t)((p_chip->tx_seq_nr << VC_DL_FCTR_FRNR_OFFSET) | p_chip->rx_seq_nr);
+    p_frame[3] = pctr;
+    memcpy(&p_frame[4], &p_chip->response[p_chip->response_offset], fragment_length);
+    vc_dl_finish_frame(p_frame, fragment_length + 1);
+    p_chip->last_data_frame_length = VC_DL_HEADER_SIZE + fragment_length + 1;
+
+    memcpy(p_chip->out_frame, p_frame, p_chip->last_data_frame_length);
+    p_chip->out_frame_length = p_chip->last_data_frame_length;
+    p_chip->awaiting_ack = TRUE;
+
+    p_chip->response_offset += fragment_length;
+    if (p_chip->response_offset == p_chip->response_length)
+    {
+        p_chip->response_pending = FALSE;
+    }
+}
+
+static void vc_execute_apdu(pal_i2c_virtual_chip_t* p_chip)
+{
+    uint16_t data_length = 0;
+    uint32_t execution_time = 0;
+    uint8_t status;
+
+    p_chip->stats.apdus++;
+    status = p_chip->apdu_handler(p_chip, p_chip->apdu, p_chip->apdu_length,
+                                  &p_chip->response[VC_APDU_HEADER_SIZE], &data_length, &execution_time);
+    if (0 != status)
+    {
+        p_chip->last_error = status;
+        data_length = 0;
+        p_chip->response[0] = 0xFF;
+    }
+    else
+    {
+        p_chip->response[0] = 0x00;
+    }
+    p_chip->response[1] = 0x00;
+    p_chip->response[2] = (uint8_t)(data_length >> 8);
+    p_chip->response[3] = (uint8_t)data_length;
+    p_chip->response_length = VC_APDU_HEADER_SIZE + data_length;
+    p_chip->response_offset = 0;
+    p_chip->response_pending = TRUE;
+    p_chip->response_ready_time = vc_now_us() + execution_time;
+    p_chip->apdu_length = 0;
+}
+
+static void vc_tl_receive_packet(pal_i2c_virtual_chip_t* p_chip, const uint8_t* p_packet, uint16_t packet_len)
+{
+    uint8_t chaining = p_packet[0] & VC_TL_PCTR_CHAIN_MASK;
+
+    if (VC_TL_CHAINING_ERROR == chaining)
+    {
+        p_chip->apdu_length = 0;
+        p_chip->response_pending = FALSE;
+        return;
+    }
+    if ((VC_TL_CHAINING_NO == chaining) || (VC_TL_CHAINING_FIRST == chaining))
+    {
+        p_chip->apdu_length = 0;
+    }
+    if ((p_chip->apdu_length + packet_len - 1) > VIRTUAL_CHIP_MAX_APDU_SIZE)
+    {
+        p_chip->apdu_length = 0;
+        return;
+    }
+    memcpy(&p_chip->apdu[p_chip->apdu_length], &p_packet[1], packet_len - 1);
+    p_chip->apdu_length += packet_len - 1;
+
+    if ((VC_TL_CHAINING_NO == chaining) || (VC_TL_CHAINING_LAST == chaining))
+    {
+        vc_execute_apdu(p_chip);
+    }
+}
+
+static void vc_dl_receive_frame(pal_i2c_virtual_chip_t* p_chip, const uint8_t* p_frame, uint16_t frame_len)
+{
+    uint8_t fctr;
+    uint8_t seqctr;
+    uint8_t fr_nr;
+    uint8_t ack_nr;
+    uint16_t packet_len;
+
+    p_chip->stats.frames_received++;
+    if (frame_len < VC_DL_HEADER_SIZE)
+    {
+        p_chip->stats.frame_errors++;
+        return;
+    }
+    fctr = p_frame[0];
+    seqctr = (fctr >> VC_DL_FCTR_SEQCTR_OFFSET) & VC_DL_MAX_FRAME_NUM;
+    fr_nr = (fctr >> VC_DL_FCTR_FRNR_OFFSET) & VC_DL_MAX_FRAME_NUM;
+    ack_nr = fctr & VC_DL_MAX_FRAME_NUM;
+    packet_len = (uint16_t)((p_frame[1] << 8) | p_frame[2]);
+
+    if ((frame_len != VC_DL_HEADER_SIZE + packet_len) ||
+        (vc_calc_crc(p_frame, frame_len - 2) != (uint16_t)((p_frame[frame_len - 2] << 8) | p_frame[frame_len - 1])))
+    {
+        p_chip->stats.frame_errors++;
+        if (0 == (fctr & VC_DL_FCTR_CONTROL_FRAME))
+        {
+            vc_dl_queue_control_frame(p_chip, VC_DL_SEQCTR_NACK, (p_chip->rx_seq_nr + 1) & VC_DL_MAX_FRAME_NUM);
+        }
+        return;
+    }
+
+    if (fctr & VC_DL_FCTR_CONTROL_FRAME)
+    {
+        if (VC_DL_SEQCTR_RESYNC == seqctr)
+        {
+            vc_reset_protocol(p_chip);
+        }
+        else if ((VC_DL_SEQCTR_ACK == seqctr) && (p_chip->awaiting_ack) && (ack_nr == p_chip->tx_seq_nr))
+        {
+            p_chip->awaiting_ack = FALSE;
+            if (p_chip->response_pending)
+            {
+                vc_tl_queue_next_fragment(p_chip);
+            }
+        }
+        else if ((VC_DL_SEQCTR_NACK == seqctr) && (p_chip->awaiting_ack))
+        {
+            memcpy(p_chip->out_frame, p_chip->last_data_frame, p_chip->last_data_frame_length);
+            p_chip->out_frame_length = p_chip->last_data_frame_length;
+        }
+        return;
+    }
+
+    if ((0 == packet_len) || (VC_DL_SEQCTR_ACK != seqctr))
+    {
+        p_chip->stats.frame_errors++;
+        vc_dl_queue_control_frame(p_chip, VC_DL_SEQCTR_NACK, (p_chip->rx_seq_nr + 1) & VC_DL_MAX_FRAME_NUM);
+        return;
+    }
+    // A data frame from the master acknowledges any outstanding data frame
+    if ((p_chip->awaiting_ack) && (ack_nr == p_chip->tx_seq_nr))
+    {
+        p_chip->awaiting_ack = FALSE;
+    }
+    if (fr_nr == ((p_chip->rx_seq_nr + 1) & VC_DL_MAX_FRAME_NUM))
+    {
+        p_chip->rx_seq_nr = fr_nr;
+        vc_dl_queue_control_frame(p_chip, VC_DL_SEQCTR_ACK, p_chip->rx_seq_nr);
+        vc_tl_receive_packet(p_chip, &p_frame[3], packet_len);
+    }
+    else
+    {
+        // Repeated frame (acknowledge got lost) or out of sequence: acknowledge the last accepted frame
+        vc_dl_queue_control_frame(p_chip, VC_DL_SEQCTR_ACK, p_chip->rx_seq_nr);
+    }
+}
+
+static void vc_update(pal_i2c_virtual_chip_t* p_chip)
+{
+    if ((0 == p_chip->out_frame_length) && (!p_chip->awaiting_ack) && (p_chip->response_pending) &&
+        ((int32_t)(vc_now_us() - p_chip->response_ready_time) >= 0))
+    {
+        vc_tl_queue_next_fragment(p_chip);
+    }
+}
+
+static pal_i2c_virtual_chip_object_t* vc_find_object(const pal_i2c_virtual_chip_t* p_chip, uint16_t oid)
+{
+    uint16_t i;
+
+    for (i = 0; i < p_chip->object_count; i++)
+    {
+        if (p_chip->p_objects[i].oid == oid)
+        {
+            return &p_chip->p_objects[i];
+        }
+    }
+    return NULL;
+}
+
+static uint8_t vc_get_data(pal_i2c_virtual_chip_t* p_chip, uint8_t param, const uint8_t* p_payload,
+                           uint16_t payload_len, uint8_t* p_response, uint16_t* p_response_length)
+{
+    uint16_t oid;
+    uint16_t offset = 0;
+    uint16_t length = 0xFFFF;
+    uint8_t builtin[2];
+    uint8_t metadata[sizeof(vc_default_metadata) + 4];
+    const uint8_t* p_data = builtin;
+    uint16_t data_length;
+    const pal_i2c_virtual_chip_object_t* p_object;
+
+    if ((2 != payload_len) && (6 != payload_len))
+    {
+        return VIRTUAL_CHIP_ERROR_INVALID_LENGTH;
+    }
+    oid = (uint16_t)((p_payload[0] << 8) | p_payload[1]);
+    if (6 == payload_len)
+    {
+        offset = (uint16_t)((p_payload[2] << 8) | p_payload[3]);
+        length = (uint16_t)((p_payload[4] << 8) | p_payload[5]);
+    }
+
+    p_object = vc_find_object(p_chip, oid);
+    if (NULL != p_object)
+    {
+        p_data = p_object->p_data;
+        data_length = p_object->length;
+    }
+    else if (VC_OID_MAX_COMMS_BUFFER == oid)
+    {
+        builtin[0] = (uint8_t)(VIRTUAL_CHIP_MAX_COMMS_BUFFER >> 8);
+        builtin[1] = (uint8_t)VIRTUAL_CHIP_MAX_COMMS_BUFFER;
+        data_length = 2;
+    }
+    else if ((VC_OID_LCSA == oid) || (VC_OID_LCSG == oid))
+    {
+        builtin[0] = VC_LCS_OPERATIONAL;
+        data_length = 1;
+    }
+    else if (VC_OID_ERROR_CODES == oid)
+    {
+        builtin[0] = p_chip->last_error;
+        data_length = 1;
+    }
+    else
+    {
+        return VIRTUAL_CHIP_ERROR_INVALID_OID;
+    }
+
+    if (VC_PARAM_GET_METADATA == param)
+    {
+        if ((NULL != p_object) && (NULL != p_object->p_metadata))
+        {
+            p_data = p_object->p_metadata;
+            data_length = p_object->metadata_length;
+        }
+        else if (NULL != p_object)
+        {
+            // Report the used size (tag 0xC5) in front of the default access conditions, like the chip does
+            metadata[0] = vc_default_metadata[0];
+            metadata[1] = (uint8_t)(vc_default_metadata[1] + 4);
+            metadata[2] = 0xC5;
+            metadata[3] = 0x02;
+            metadata[4] = (uint8_t)(p_object->length >> 8);
+            metadata[5] = (uint8_t)p_object->length;
+            memcpy(&metadata[6], &vc_default_metadata[2], sizeof(vc_default_metadata) - 2);
+            p_data = metadata;
+            data_length = sizeof(metadata);
+        }
+        else
+        {
+            p_data = vc_default_metadata;
+            data_length = sizeof(vc_default_metadata);
+        }
+        offset = 0;
+    }
+    else if (0 != param)
+    {
+        return VIRTUAL_CHIP_ERROR_INVALID_PARAM;
+    }
+
+    if ((offset >= data_length) && (0 != data_length))
+    {
+        return VIRTUAL_CHIP_ERROR_OUT_OF_BOUND;
+    }
+    data_length -= offset;
+    if (length < data_length)
+    {
+        data_length = length;
+    }
+    if (data_length > VIRTUAL_CHIP_MAX_COMMS_BUFFER - VC_APDU_HEADER_SIZE)
+    {
+        data_length = VIRTUAL_CHIP_MAX_COMMS_BUFFER - VC_APDU_HEADER_SIZE;
+    }
+    memcpy(p_response, p_data + offset, data_length);
+    *p_response_length = data_length;
+    return 0;
+}
+
+static uint8_t vc_set_data(pal_i2c_virtual_chip_t* p_chip, uint8_t param, const uint8_t* p_payload,
+                           uint16_t payload_len)
+{
+    uint16_t oid;
+    uint16_t offset;
+    uint16_t data_length;
+    pal_i2c_virtual_chip_object_t* p_object;
+
+    if (payload_len < 4)
+    {
+        return VIRTUAL_CHIP_ERROR_INVALID_LENGTH;
+    }
+    if (VC_PARAM_SET_METADATA == param)
+    {
+        // Metadata of the virtual chip is fixed
+        return VIRTUAL_CHIP_ERROR_INVALID_PARAM;
+    }
+    oid = (uint16_t)((p_payload[0] << 8) | p_payload[1]);
+    offset = (uint16_t)((p_payload[2] << 8) | p_payload[3]);
+    data_length = payload_len - 4;
+
+    p_object = vc_find_object(p_chip, oid);
+    if ((NULL == p_object) || (0 == p_object->max_length))
+    {
+        return VIRTUAL_CHIP_ERROR_INVALID_OID;
+    }
+    if ((uint32_t)offset + data_length > p_object->max_length)
+    {
+        return VIRTUAL_CHIP_ERROR_OUT_OF_BOUND;
+    }
+    memcpy(&p_object->p_data[offset], &p_payload[4], data_length);
+    if ((VC_PARAM_SET_DATA_ERASE == param) || ((offset + data_length) > p_object->length))
+    {
+        p_object->length = offset + data_length;
+    }
+    return 0;
+}
+
+static uint8_t vc_get_random(pal_i2c_virtual_chip_t* p_chip, const uint8_t* p_payload, uint16_t payload_len,
+                             uint8_t* p_response, uint16_t* p_response_length)
+{
+    uint16_t length;
+    uint16_t i;
+    uint32_t x = p_chip->random_state;
+
+    if (2 != payload_len)
+    {
+        return VIRTUAL_CHIP_ERROR_INVALID_LENGTH;
+    }
+    length = (uint16_t)((p_payload[0] << 8) | p_payload[1]);
+    if ((length < 8) || (length > 256))
+    {
+        return VIRTUAL_CHIP_ERROR_INVALID_LENGTH;
+    }
+    for (i = 0; i < length; i++)
+    {
+        // xorshift32
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        p_response[i] = (uint8_t)x;
+    }
+    p_chip->random_state = x;
+    *p_response_length = length;
+    return 0;
+}
+
+// Hashes the data of an OID data tag, the range is limited like a GetDataObject
+static uint8_t vc_hash_object(const pal_i2c_virtual_chip_t* p_chip, const uint8_t* p_oid_data, sUtilSha256_d* p_hash)
+{
+    uint16_t oid = (uint16_t)((p_oid_data[0] << 8) | p_oid_data[1]);
+    uint16_t offset = (uint16_t)((p_oid_data[2] << 8) | p_oid_data[3]);
+    uint16_t length = (uint16_t)((p_oid_data[4] << 8) | p_oid_data[5]);
+    const pal_i2c_virtual_chip_object_t* p_object = vc_find_object(p_chip, oid);
+
+    if (NULL == p_object)
+    {
+        return VIRTUAL_CHIP_ERROR_INVALID_OID;
+    }
+    if (offset >= p_object->length)
+    {
+        return VIRTUAL_CHIP_ERROR_OUT_OF_BOUND;
+    }
+    if (length > (p_object->length - offset))
+    {
+        length = p_object->length - offset;
+    }
+    Utility_Sha256Update(p_hash, &p_object->p_data[offset], length);
+    return 0;
+}
+
+static uint8_t vc_calc_hash(pal_i2c_virtual_chip_t* p_chip, uint8_t param, const uint8_t* p_payload,
+                            uint16_t payload_len, uint8_t* p_response, uint16_t* p_response_length)
+{
+    uint8_t sequence;
+    uint8_t type;
+    uint16_t data_length;
+    uint16_t pos;
+    uint16_t tag_length;
+    const uint8_t* p_import = NULL;
+    uint8_t export_context = FALSE;
+    uint8_t finalize;
+    uint8_t status;
+    sUtilSha256_d hash;
+
+    if (VC_PARAM_HASH_SHA256 != param)
+    {
+        return VIRTUAL_CHIP_ERROR_INVALID_PARAM;
+    }
+    if (payload_len < VC_HASH_TLV_HEADER_SIZE)
+    {
+        return VIRTUAL_CHIP_ERROR_INVALID_LENGTH;
+    }
+    type = (uint8_t)(p_payload[0] >> 4);
+    sequence = (uint8_t)(p_payload[0] & 0x0F);
+    data_length = (uint16_t)((p_payload[1] << 8) | p_payload[2]);
+    pos = VC_HASH_TLV_HEADER_SIZE + data_length;
+    if (pos > payload_len)
+    {
+        return VIRTUAL_CHIP_ERROR_INVALID_LENGTH;
+    }
+
+    // Optional context tags
+    while (pos < payload_len)
+    {
+        if ((pos + VC_HASH_TLV_HEADER_SIZE) > payload_len)
+        {
+            return VIRTUAL_CHIP_ERROR_INVALID_LENGTH;
+        }
+        tag_length = (uint16_t)((p_payload[pos + 1] << 8) | p_payload[pos + 2]);
+        if ((uint32_t)pos + VC_HASH_TLV_HEADER_SIZE + tag_length > payload_len)
+        {
+            return VIRTUAL_CHIP_ERROR_INVALID_LENGTH;
+        }
+        if ((VC_HASH_TAG_IMPORT == p_payload[pos]) && (VIRTUAL_CHIP_HASH_CONTEXT_SIZE == tag_length))
+        {
+            p_import = &p_payload[pos + VC_HASH_TLV_HEADER_SIZE];
+        }
+        else if ((VC_HASH_TAG_EXPORT == p_payload[pos]) && (0 == tag_length))
+        {
+            export_context = TRUE;
+        }
+        else
+        {
+            return VIRTUAL_CHIP_ERROR_INVALID_DATA;
+        }
+        pos = (uint16_t)(pos + VC_HASH_TLV_HEADER_SIZE + tag_length);
+    }
+
+    finalize = (VC_HASH_SEQ_START_FINAL == sequence) || (VC_HASH_SEQ_FINAL == sequence);
+    if ((finalize || (VC_HASH_SEQ_INTERMEDIATE == sequence)) && export_context)
+    {
+        return VIRTUAL_CHIP_ERROR_INVALID_DATA;
+    }
+    switch (sequence)
+    {
+        case VC_HASH_SEQ_START:
+        case VC_HASH_SEQ_START_FINAL:
+        {
+            if (NULL != p_import)
+            {
+                return VIRTUAL_CHIP_ERROR_INVALID_DATA;
+            }
+            Utility_Sha256Init(&hash);
+        }
+        break;
+        case VC_HASH_SEQ_CONTINUE:
+        case VC_HASH_SEQ_FINAL:
+        case VC_HASH_SEQ_INTERMEDIATE:
+        {
+            // An imported context replaces the active one
+            if (NULL != p_import)
+            {
+                memcpy(&hash, p_import, sizeof(hash));
+            }
+            else if (p_chip->hash_active)
+            {
+                hash = p_chip->hash;
+            }
+            else
+            {
+                return VIRTUAL_CHIP_ERROR_OUT_OF_SEQUENCE;
+            }
+        }
+        break;
+        case VC_HASH_SEQ_TERMINATE:
+        {
+            p_chip->hash_active = FALSE;
+            return 0;
+        }
+        default:
+        {
+            return VIRTUAL_CHIP_ERROR_INVALID_DATA;
+        }
+    }
+
+    if (VC_HASH_TYPE_STREAM == type)
+    {
+        Utility_Sha256Update(&hash, &p_payload[VC_HASH_TLV_HEADER_SIZE], data_length);
+    }
+    else if ((VC_HASH_TYPE_OID == type) && (VC_HASH_OID_DATA_SIZE == data_length))
+    {
+        status = vc_hash_object(p_chip, &p_payload[VC_HASH_TLV_HEADER_SIZE], &hash);
+        if (0 != status)
+        {
+            return status;
+        }
+    }
+    else
+    {
+        return VIRTUAL_CHIP_ERROR_INVALID_DATA;
+    }
+
+    p_chip->hash = hash;
+    p_chip->hash_active = !finalize;
+    if (finalize || (VC_HASH_SEQ_INTERMEDIATE == sequence))
+    {
+        p_response[0] = VC_HASH_TAG_OUTPUT;
+        p_response[1] = 0x00;
+        p_response[2] = UTIL_SHA256_LEN;
+        Utility_Sha256Final(&hash, &p_response[VC_HASH_TLV_HEADER_SIZE]);
+        *p_response_length = VC_HASH_TLV_HEADER_SIZE + UTIL_SHA256_LEN;
+    }
+    else if (export_context)
+    {
+        // The context is exported as is, the chip would protect it against modification
+        p_response[0] = VC_HASH_TAG_IMPORT;
+        p_response[1] = 0x00;
+        p_response[2] = VIRTUAL_CHIP_HASH_CONTEXT_SIZE;
+        memset(&p_response[VC_HASH_TLV_HEADER_SIZE], 0, VIRTUAL_CHIP_HASH_CONTEXT_SIZE);
+        memcpy(&p_response[VC_HASH_TLV_HEADER_SIZE], &hash, sizeof(hash));
+        *p_response_length = VC_HASH_TLV_HEADER_SIZE + VIRTUAL_CHIP_HASH_CONTEXT_SIZE;
+    }
+    return 0;
+}
+
+/// @endcond
+/**********************************************************************************************************************
+ * API IMPLEMENTATION
+ *********************************************************************************************************************/
+
+/**
+* Initializes the virtual chip to its power up state.<br>
+*
+*\param[in,out] p_chip        Pointer to the virtual chip
+*\param[in]     slave_address Initial I2C slave address
+*\param[in]     apdu_handler  APDU handler, NULL to use #pal_i2c_virtual_chip_default_apdu_handler
+*\param[in]     p_objects     Data objects served by the default handler
+*\param[in]     object_count  Number of entries in p_objects
+*/
+void pal_i2c_virtual_chip_init(pal_i2c_virtual_chip_t* p_chip,
+                               uint8_t slave_address,
+                               pal_i2c_virtual_chip_apdu_handler_t apdu_handler,
+                               pal_i2c_virtual_chip_object_t* p_objects,
+                               uint16_t object_count)
+{
+    memset(p_chip, 0, sizeof(*p_chip));
+    p_chip->slave_address = slave_address;
+    p_chip->frame_size = VIRTUAL_CHIP_MAX_FRAME_SIZE;
+    p_chip->random_state = 0x2545F491;
+    p_chip->apdu_handler = (NULL != apdu_handler) ? apdu_handler : pal_i2c_virtual_chip_default_apdu_handler;
+    p_chip->p_objects = p_objects;
+    p_chip->object_count = object_count;
+    vc_reset_protocol(p_chip);
+}
+
+/**
+* Holds or releases the virtual chip in reset. While in reset the chip does not acknowledge its address.
+* Releasing the reset restores the power up protocol state (frame size, sequence numbers).<br>
+*
+*\param[in,out] p_chip   Pointer to the virtual chip
+*\param[in]     in_reset TRUE to assert the reset line, FALSE to release it
+*/
+void pal_i2c_virtual_chip_set_reset(pal_i2c_virtual_chip_t* p_chip, uint8_t in_reset)
+{
+    if ((p_chip->in_reset) && (!in_reset))
+    {
+        p_chip->frame_size = VIRTUAL_CHIP_MAX_FRAME_SIZE;
+        p_chip->i2c_mode = 0;
+        p_chip->last_error = 0;
+        p_chip->hash_active = FALSE;
+        vc_reset_protocol(p_chip);
+    }
+    p_chip->in_reset = in_reset;
+}
+
+/**
+* Handles a write transaction of the I2C master.<br>
+* The first byte selects the register; further bytes are written to the register.<br>
+*
+*\param[in,out] p_chip        Pointer to the virtual chip
+*\param[in]     slave_address Addressed slave
+*\param[in]     p_data        Written bytes
+*\param[in]     length        Number of written bytes
+*
+* \retval  #PAL_STATUS_SUCCESS  The slave acknowledged the transaction
+* \retval  #PAL_STATUS_FAILURE  The slave did not acknowledge (wrong address, in reset, no data)
+*/
+pal_status_t pal_i2c_virtual_chip_write(pal_i2c_virtual_chip_t* p_chip,
+                                        uint8_t slave_address,
+                                        const uint8_t* p_data,
+                                        uint16_t length)
+{
+    uint16_t value;
+
+    if ((p_chip->in_reset) || (slave_address != p_chip->slave_address) || (0 == length))
+    {
+        return PAL_STATUS_FAILURE;
+    }
+    p_chip->register_address = p_data[0];
+    if (1 == length)
+    {
+        return PAL_STATUS_SUCCESS;
+    }
+    p_chip->stats.register_writes++;
+
+    switch (p_chip->register_address)
+    {
+        case VC_REG_DATA:
+        {
+            vc_dl_receive_frame(p_chip, &p_data[1], length - 1);
+        }
+        break;
+        case VC_REG_DATA_REG_LEN:
+        {
+            if (length < 3)
+            {
+                return PAL_STATUS_FAILURE;
+            }
+            value = (uint16_t)((p_data[1] << 8) | p_data[2]);
+            p_chip->frame_size = (value > VIRTUAL_CHIP_MAX_FRAME_SIZE) ? VIRTUAL_CHIP_MAX_FRAME_SIZE :
+                                 ((value < VC_MIN_FRAME_SIZE) ? VC_MIN_FRAME_SIZE : value);
+        }
+        break;
+        case VC_REG_I2C_MODE:
+        {
+            p_chip->i2c_mode = p_data[length - 1];
+        }
+        break;
+        case VC_REG_BASE_ADDR:
+        {
+            if (length < 3)
+            {
+                return PAL_STATUS_FAILURE;
+            }
+            p_chip->slave_address = p_data[2] & 0x7F;
+        }
+        break;
+        case VC_REG_SOFT_RESET:
+        {
+            p_chip->last_error = 0;
+            vc_reset_protocol(p_chip);
+        }
+        break;
+        default:
+        break;
+    }
+    return PAL_STATUS_SUCCESS;
+}
+
+/**
+* Handles a read transaction of the I2C master from the register selected by the previous write.<br>
+*
+*\param[in,out] p_chip        Pointer to the virtual chip
+*\param[in]     slave_address Addressed slave
+*\param[out]    p_data        Buffer to store the read bytes
+*\param[in]     length        Number of bytes to read
+*
+* \retval  #PAL_STATUS_SUCCESS  The slave acknowledged the transaction
+* \retval  #PAL_STATUS_FAILURE  The slave did not acknowledge (wrong address, in reset, no frame pending)
+*/
+pal_status_t pal_i2c_virtual_chip_read(pal_i2c_virtual_chip_t* p_chip,
+                                       uint8_t slave_address,
+                                       uint8_t* p_data,
+                                       uint16_t length)
+{
+    uint8_t reg[4] = {0};
+    uint16_t reg_length = sizeof(reg);
+    uint16_t frequency;
+
+    if ((p_chip->in_reset) || (slave_address != p_chip->slave_address))
+    {
+        return PAL_STATUS_FAILURE;
+    }
+    p_chip->stats.register_reads++;
+
+    switch (p_chip->register_address)
+    {
+        case VC_REG_DATA:
+        {
+            if ((0 == p_chip->out_frame_length) || (length > p_chip->out_frame_length))
+            {
+                return PAL_STATUS_FAILURE;
+            }
+            memcpy(p_data, p_chip->out_frame, length);
+            p_chip->out_frame_length = 0;
+            p_chip->stats.frames_sent++;
+            return PAL_STATUS_SUCCESS;
+        }
+        case VC_REG_I2C_STATE:
+        {
+            vc_update(p_chip);
+            reg[0] = VC_I2C_STATE_SOFT_RESET;
+            if (p_chip->out_frame_length)
+            {
+                reg[0] |= VC_I2C_STATE_RESPONSE_READY;
+            }
+            else if (p_chip->response_pending)
+            {
+                reg[0] |= VC_I2C_STATE_BUSY;
+            }
+            reg[2] = (uint8_t)(p_chip->out_frame_length >> 8);
+            reg[3] = (uint8_t)p_chip->out_frame_length;
+        }
+        break;
+        case VC_REG_DATA_REG_LEN:
+        {
+            reg[0] = (uint8_t)(p_chip->frame_size >> 8);
+            reg[1] = (uint8_t)p_chip->frame_size;
+            reg_length = 2;
+        }
+        break;
+        case VC_REG_MAX_SCL_FREQU:
+        {
+            frequency = (VC_I2C_MODE_FM_PLUS == p_chip->i2c_mode) ? VC_MAX_SCL_FREQUENCY_FM_PLUS :
+                                                                     VIRTUAL_CHIP_MAX_SCL_FREQUENCY;
+            reg[2] = (uint8_t)(frequency >> 8);
+            reg[3] = (uint8_t)frequency;
+        }
+        break;
+        case VC_REG_I2C_MODE:
+        {
+            reg[1] = p_chip->i2c_mode;
+            reg_length = 2;
+        }
+        break;
+        case VC_REG_BASE_ADDR:
+        {
+            reg[1] = p_chip->slave_address;
+            reg_length = 2;
+        }
+        break;
+        default:
+        break;
+    }
+
+    memset(p_data, 0, length);
+    memcpy(p_data, reg, (length < reg_length) ? length : reg_length);
+    return PAL_STATUS_SUCCESS;
+}
+
+/**
+* Default APDU handler of the virtual chip.<br>
+*
+* Supports:
+* - OpenApplication
+* - GetDataObject (data and metadata) for the object table, max comms buffer (0xE0C6), LcsG/LcsA and error codes (0xF1C2)
+* - SetDataObject (write, erase & write) for writable objects of the table
+* - GetRandom
+* - CalcHash (SHA256) on a data stream or a range of an object of the table, with context import and export
+*
+* The execution time is taken from #pal_i2c_virtual_chip_t.execution_time_us.<br>
+*
+*\param[in,out] p_chip              Pointer to the virtual chip
+*\param[in]     p_apdu              Command APDU including header
+*\param[in]     apdu_length         Length of the command APDU
+*\param[out]    p_response          Buffer for the response data
+*\param[out]    p_response_length   Length of the response data
+*\param[out]    p_execution_time_us Simulated execution time
+*
+* \retval  0      Command executed successfully
+* \retval  others Device error code
+*/
+uint8_t pal_i2c_virtual_chip_default_apdu_handler(pal_i2c_virtual_chip_t* p_chip,
+                                                  const uint8_t* p_apdu,
+                                                  uint16_t apdu_length,
+                                                  uint8_t* p_response,
+                                                  uint16_t* p_response_length,
+                                                  uint32_t* p_execution_time_us)
+{
+    uint8_t command;
+    uint8_t param;
+    uint16_t payload_len;
+    uint8_t status;
+
+    *p_response_length = 0;
+    *p_execution_time_us = VIRTUAL_CHIP_DEFAULT_EXECUTION_TIME;
+    if (apdu_length < VC_APDU_HEADER_SIZE)
+    {
+        return VIRTUAL_CHIP_ERROR_INVALID_LENGTH;
+    }
+    command = p_apdu[0];
+    param = p_apdu[1];
+    payload_len = (uint16_t)((p_apdu[2] << 8) | p_apdu[3]);
+    if (0 != p_chip->execution_time_us[command & 0x7F])
+    {
+        *p_execution_time_us = p_chip->execution_time_us[command & 0x7F];
+    }
+    if (payload_len != apdu_length - VC_APDU_HEADER_SIZE)
+    {
+        return VIRTUAL_CHIP_ERROR_INVALID_LENGTH;
+    }
+    // Error codes are cleared when a command with the MSB set is issued
+    if (command & VC_CMD_CODE_MSB)
+    {
+        p_chip->last_error = 0;
+    }
+
+    switch (command & (uint8_t)~VC_CMD_CODE_MSB)
+    {
+        case VC_CMD_OPEN_APP:
+        {
+            status = 0;
+        }
+        break;
+        case VC_CMD_GETDATA:
+        {
+            status = vc_get_data(p_chip, param, &p_apdu[VC_APDU_HEADER_SIZE], payload_len,
+                                 p_response, p_response_length);
+        }
+        break;
+        case VC_CMD_SETDATA:
+        {
+            status = vc_set_data(p_chip, param, &p_apdu[VC_APDU_HEADER_SIZE], payload_len);
+        }
+        break;
+        case VC_CMD_GET_RND:
+        {
+            status = vc_get_random(p_chip, &p_apdu[VC_APDU_HEADER_SIZE], payload_len, p_response, p_response_length);
+        }
+        break;
+        case VC_CMD_CALC_HASH:
+        {
+            status = vc_calc_hash(p_chip, param, &p_apdu[VC_APDU_HEADER_SIZE], payload_len, p_response,
+                                  p_response_length);
+        }
+        break;
+        default:
+        {
+            status = VIRTUAL_CHIP_ERROR_INVALID_COMMAND;
+        }
+        break;
+    }
+    return status;
+}
+
+/**
+* @}
+*/
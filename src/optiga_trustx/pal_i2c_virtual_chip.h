@@ -0,0 +1,258 @@
+/**
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+*
+* \file
+*
+* \brief This file implements the prototype declarations of the simulated OPTIGA I2C slave (virtual chip).
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#ifndef _PAL_I2C_VIRTUAL_CHIP_H_
+#define _PAL_I2C_VIRTUAL_CHIP_H_
+
+/**********************************************************************************************************************
+ * HEADER FILES
+ *********************************************************************************************************************/
+
+#include "pal.h"
+#include "Util.h"
+
+/**********************************************************************************************************************
+ * MACROS
+ *********************************************************************************************************************/
+/// Largest DATA_REG_LEN the virtual chip accepts
+#define VIRTUAL_CHIP_MAX_FRAME_SIZE         (0x0115)
+/// Largest APDU (command or response) the virtual chip buffers
+#define VIRTUAL_CHIP_MAX_APDU_SIZE          (0x0640)
+/// Maximum communication buffer size reported in OID 0xE0C6
+#define VIRTUAL_CHIP_MAX_COMMS_BUFFER       (0x0615)
+/// Maximum SCL frequency in KHz reported in MAX_SCL_FREQU register
+#define VIRTUAL_CHIP_MAX_SCL_FREQUENCY      (400)
+/// Default execution time of a command in microseconds
+#define VIRTUAL_CHIP_DEFAULT_EXECUTION_TIME (500)
+
+/// Device error: Invalid OID
+#define VIRTUAL_CHIP_ERROR_INVALID_OID      (0x01)
+/// Device error: Invalid parameter field in command
+#define VIRTUAL_CHIP_ERROR_INVALID_PARAM    (0x03)
+/// Device error: Invalid length field in command
+#define VIRTUAL_CHIP_ERROR_INVALID_LENGTH   (0x04)
+/// Device error: Invalid parameter in data field
+#define VIRTUAL_CHIP_ERROR_INVALID_DATA     (0x05)
+/// Device error: Data object boundary exceeded
+#define VIRTUAL_CHIP_ERROR_OUT_OF_BOUND     (0x08)
+/// Device error: Invalid command code
+#define VIRTUAL_CHIP_ERROR_INVALID_COMMAND  (0x0A)
+/// Device error: Command out of sequence
+#define VIRTUAL_CHIP_ERROR_OUT_OF_SEQUENCE  (0x0B)
+/// Length of an exported SHA256 hash context
+#define VIRTUAL_CHIP_HASH_CONTEXT_SIZE      (130)
+
+/**********************************************************************************************************************
+ * ENUMS
+ *********************************************************************************************************************/
+
+
+/**********************************************************************************************************************
+ * DATA STRUCTURES
+ *********************************************************************************************************************/
+
+struct pal_i2c_virtual_chip;
+
+/**
+ * \brief APDU handler of the virtual chip.
+ *
+ * The handler gets the reassembled command APDU (including the 4 byte header) and writes the response data,
+ * without the 4 byte response header, to p_response. A non zero return value is reported as device error.
+ */
+typedef uint8_t (*pal_i2c_virtual_chip_apdu_handler_t)(struct pal_i2c_virtual_chip* p_chip,
+                                                       const uint8_t* p_apdu,
+                                                       uint16_t apdu_length,
+                                                       uint8_t* p_response,
+                                                       uint16_t* p_response_length,
+                                                       uint32_t* p_execution_time_us);
+
+/**
+ * \brief Data object served by #pal_i2c_virtual_chip_default_apdu_handler.
+ */
+typedef struct pal_i2c_virtual_chip_object
+{
+    /// Object identifier
+    uint16_t oid;
+    /// Object data
+    uint8_t* p_data;
+    /// Current length of the data
+    uint16_t length;
+    /// Size of the p_data buffer, 0 for a read only object
+    uint16_t max_length;
+    /// Metadata TLV (0x20 ...), NULL to report the used size and read/change always
+    const uint8_t* p_metadata;
+    /// Length of p_metadata
+    uint16_t metadata_length;
+} pal_i2c_virtual_chip_object_t;
+
+/**
+ * \brief Statistics of the virtual chip.
+ */
+typedef struct pal_i2c_virtual_chip_stats
+{
+    /// Register reads seen on the bus
+    uint32_t register_reads;
+    /// Register writes seen on the bus (excluding register address selection)
+    uint32_t register_writes;
+    /// Data link frames received
+    uint32_t frames_received;
+    /// Data link frames sent
+    uint32_t frames_sent;
+    /// Frames received with CRC or length errors
+    uint32_t frame_errors;
+    /// APDUs executed
+    uint32_t apdus;
+} pal_i2c_virtual_chip_stats_t;
+
+/**
+ * \brief Simulated OPTIGA Trust X slave speaking the IFX I2C register and frame protocol.
+ */
+typedef struct pal_i2c_virtual_chip
+{
+    /// Current slave address
+    uint8_t slave_address;
+    /// Register addressed by the last write
+    uint8_t register_address;
+    /// Contents of the I2C_MODE register
+    uint8_t i2c_mode;
+    /// Chip is held in reset
+    uint8_t in_reset;
+    /// Negotiated frame size (DATA_REG_LEN)
+    uint16_t frame_size;
+
+    /// Frame number of the last data frame sent
+    uint8_t tx_seq_nr;
+    /// Frame number of the last data frame received
+    uint8_t rx_seq_nr;
+    /// Last data frame sent is not yet acknowledged
+    uint8_t awaiting_ack;
+    /// Frame pending to be read by the master
+    uint8_t out_frame[VIRTUAL_CHIP_MAX_FRAME_SIZE];
+    /// Length of out_frame, 0 if nothing pending
+    uint16_t out_frame_length;
+    /// Last data frame sent, kept for retransmission
+    uint8_t last_data_frame[VIRTUAL_CHIP_MAX_FRAME_SIZE];
+    /// Length of last_data_frame
+    uint16_t last_data_frame_length;
+
+    /// Command APDU under reassembly
+    uint8_t apdu[VIRTUAL_CHIP_MAX_APDU_SIZE];
+    /// Length of the command APDU
+    uint16_t apdu_length;
+    /// Response APDU
+    uint8_t response[VIRTUAL_CHIP_MAX_APDU_SIZE];
+    /// Length of the response APDU
+    uint16_t response_length;
+    /// Offset of the next response fragment to send
+    uint16_t response_offset;
+    /// Response fragments are pending
+    uint8_t response_pending;
+    /// Time (us) at which the response becomes available
+    uint32_t response_ready_time;
+
+    /// Last device error code (OID 0xF1C2)
+    uint8_t last_error;
+    /// Random generator state
+    uint32_t random_state;
+    /// Active hash context of CalcHash
+    sUtilSha256_d hash;
+    /// A hash calculation is started and not yet finalized
+    uint8_t hash_active;
+    /// APDU handler
+    pal_i2c_virtual_chip_apdu_handler_t apdu_handler;
+    /// Data objects served by the default APDU handler
+    pal_i2c_virtual_chip_object_t* p_objects;
+    /// Number of entries in p_objects
+    uint16_t object_count;
+    /// Execution time (us) per command code (lower 7 bits), 0 selects #VIRTUAL_CHIP_DEFAULT_EXECUTION_TIME
+    uint32_t execution_time_us[0x80];
+    /// Statistics
+    pal_i2c_virtual_chip_stats_t stats;
+} pal_i2c_virtual_chip_t;
+
+/**********************************************************************************************************************
+ * API Prototypes
+ *********************************************************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Initializes the virtual chip. A NULL handler selects #pal_i2c_virtual_chip_default_apdu_handler.
+ */
+void pal_i2c_virtual_chip_init(pal_i2c_virtual_chip_t* p_chip,
+                               uint8_t slave_address,
+                               pal_i2c_virtual_chip_apdu_handler_t apdu_handler,
+                               pal_i2c_virtual_chip_object_t* p_objects,
+                               uint16_t object_count);
+
+/**
+ * \brief Holds (TRUE) or releases (FALSE) the virtual chip in reset.
+ */
+void pal_i2c_virtual_chip_set_reset(pal_i2c_virtual_chip_t* p_chip, uint8_t in_reset);
+
+/**
+ * \brief Handles an I2C write transaction addressed to slave_address.
+ */
+pal_status_t pal_i2c_virtual_chip_write(pal_i2c_virtual_chip_t* p_chip,
+                                        uint8_t slave_address,
+                                        const uint8_t* p_data,
+                                        uint16_t length);
+
+/**
+ * \brief Handles an I2C read transaction addressed to slave_address.
+ */
+pal_status_t pal_i2c_virtual_chip_read(pal_i2c_virtual_chip_t* p_chip,
+                                       uint8_t slave_address,
+                                       uint8_t* p_data,
+                                       uint16_t length);
+
+/**
+ * \brief Default APDU handler serving OpenApplication, GetDataObject, SetDataObject, GetRandom and CalcHash.
+ */
+uint8_t pal_i2c_virtual_chip_default_apdu_handler(pal_i2c_virtual_chip_t* p_chip,
+                                                  const uint8_t* p_apdu,
+                                                  uint16_t apdu_length,
+                                                  uint8_t* p_response,
+                                                  uint16_t* p_response_length,
+                                                  uint32_t* p_execution_time_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _PAL_I2C_VIRTUAL_CHIP_H_ */
+
+/**
+* @}
+*/
@@ -30,6 +30,8 @@
 * @{
 */
 
+#if defined(ARDUINO)
+
 /**********************************************************************************************************************
  * HEADER FILES
  *********************************************************************************************************************/
@@ -38,17 +40,48 @@
 
 #include "pal_gpio.h"
 #include "pal_i2c.h"
+#include "pal_arduino.h"
 
 /*********************************************************************************************************************
  * pal ifx i2c instance
  *********************************************************************************************************************/
+#if defined(PAL_I2C_ARDUINO_ASYNC)
+/**
+ * \brief Arduino I2C master used by #optiga_pal_i2c_context_0. Set the driver hooks before the stack is opened,
+ *        transfers block in Wire as long as they are NULL.
+ */
+pal_arduino_i2c_t optiga_pal_arduino_i2c_0 =
+{
+    /// TwoWire instance
+    static_cast<void*>(&Wire),
+    /// Non-blocking write
+    NULL,
+    /// Non-blocking read
+    NULL,
+    /// Driver specific data
+    NULL,
+    /// No transfer in progress
+    FALSE,
+    /// No result
+    PAL_STATUS_FAILURE,
+    /// No transfer context
+    NULL,
+    /// Completion, registered by pal_i2c_init
+    {NULL, NULL, 0, NULL}
+};
+#endif
+
 /**
  * \brief PAL I2C configuration for OPTIGA.
  */
 pal_i2c_t optiga_pal_i2c_context_0 =
 {
     /// Pointer to I2C master platform specific context
+#if defined(PAL_I2C_ARDUINO_ASYNC)
+    static_cast<void*>(&optiga_pal_arduino_i2c_0),
+#else
 	static_cast<void*>(&Wire),
+#endif
     /// Slave address
     0x30,
     /// Upper layer context
@@ -85,6 +118,8 @@ pal_gpio_t optiga_reset_0 =
 };
 
 
+#endif /* ARDUINO */
+
 /**
 * @}
 */
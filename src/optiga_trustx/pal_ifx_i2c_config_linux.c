@@ -0,0 +1,134 @@
+/**
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+*
+* \file
+*
+* \brief This file implements platform abstraction layer configurations for ifx i2c protocol on Linux hosts.
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include "pal.h"
+
+#if defined(PAL_TARGET_LINUX)
+
+/**********************************************************************************************************************
+ * HEADER FILES
+ *********************************************************************************************************************/
+#include "pal_gpio.h"
+#include "pal_i2c.h"
+#include "pal_linux.h"
+
+/*********************************************************************************************************************
+ * pal ifx i2c instance
+ *********************************************************************************************************************/
+/**
+ * \brief Linux I2C master used for OPTIGA. Set p_virtual_chip before opening the stack to use the simulated device.
+ */
+pal_linux_i2c_t optiga_pal_linux_i2c_0 =
+{
+    /// i2c-dev node
+    PAL_LINUX_I2C_DEFAULT_DEVICE,
+    /// Not opened
+    -1,
+    /// No slave selected
+    0xFF,
+    /// Real device
+    NULL,
+    /// Synchronous transfers
+    FALSE,
+    /// Worker thread, created by pal_i2c_init
+    0,
+    /// Request lock
+    PTHREAD_MUTEX_INITIALIZER,
+    /// Request signal
+    PTHREAD_COND_INITIALIZER,
+    /// Worker not running
+    FALSE,
+    /// No request
+    0,
+    /// Idle
+    FALSE,
+    /// No transfer in progress
+    NULL,
+    NULL,
+    0,
+    PAL_STATUS_SUCCESS,
+    /// Completion, registered by pal_i2c_init
+    {NULL, NULL, 0, NULL}
+};
+
+/**
+ * \brief PAL I2C configuration for OPTIGA.
+ */
+pal_i2c_t optiga_pal_i2c_context_0 =
+{
+    /// Pointer to I2C master platform specific context
+    &optiga_pal_linux_i2c_0,
+    /// Slave address
+    0x30,
+    /// Upper layer context
+    NULL,
+    /// Callback event handler
+    NULL
+};
+
+/*********************************************************************************************************************
+ * PAL GPIO configurations
+ *********************************************************************************************************************/
+/**
+ * \brief Linux reset pin used for OPTIGA. Both members are optional.
+ */
+pal_linux_gpio_t optiga_pal_linux_reset_0 =
+{
+    /// sysfs value file of the reset pin
+    NULL,
+    /// Simulated device
+    NULL
+};
+
+/**
+ *  \brief PAL vdd pin configuration for OPTIGA.
+ */
+pal_gpio_t optiga_vdd_0 =
+{
+    // Platform specific GPIO context for the pin used to toggle Vdd.
+    NULL
+};
+
+/**
+ * \brief PAL reset pin configuration for OPTIGA.
+*/
+pal_gpio_t optiga_reset_0 =
+{
+    // Platform specific GPIO context for the pin used to toggle Reset.
+    &optiga_pal_linux_reset_0
+};
+
+#endif /* PAL_TARGET_LINUX */
+
+/**
+* @}
+*/
@@ -0,0 +1,132 @@
+/**
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+*
+* \file
+*
+* \brief This file implements the platform specific contexts of the Linux host platform abstraction layer.
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#ifndef _PAL_LINUX_H_
+#define _PAL_LINUX_H_
+
+/**********************************************************************************************************************
+ * HEADER FILES
+ *********************************************************************************************************************/
+
+#include <pthread.h>
+#include "pal.h"
+#include "pal_os_event.h"
+#include "pal_i2c_virtual_chip.h"
+
+/**********************************************************************************************************************
+ * MACROS
+ *********************************************************************************************************************/
+/// Default i2c-dev node used by the Linux port
+#define PAL_LINUX_I2C_DEFAULT_DEVICE    "/dev/i2c-1"
+
+/**********************************************************************************************************************
+ * ENUMS
+ *********************************************************************************************************************/
+
+
+/**********************************************************************************************************************
+ * DATA STRUCTURES
+ *********************************************************************************************************************/
+
+/**
+ * \brief Linux I2C master context, referred by #pal_i2c_t.p_i2c_hw_config.
+ */
+typedef struct pal_linux_i2c
+{
+    /// i2c-dev device node (Example: "/dev/i2c-1")
+    const char* p_device;
+    /// File descriptor of the opened device node, -1 if closed
+    int fd;
+    /// Slave address currently selected with I2C_SLAVE, 0xFF if none
+    uint8_t selected_address;
+    /// Simulated slave. If not NULL, all transfers are routed to it instead of the device node
+    pal_i2c_virtual_chip_t* p_virtual_chip;
+    /// TRUE: transfers run on a worker thread and complete through the event loop (set before pal_i2c_init)
+    bool_t async;
+
+    /// Worker thread executing asynchronous transfers
+    pthread_t worker;
+    /// Protects the request fields below
+    pthread_mutex_t lock;
+    /// Signals a new request to the worker
+    pthread_cond_t request_signal;
+    /// Worker thread is running
+    bool_t worker_started;
+    /// Pending request: 0 none, otherwise PL style command (write/read)
+    uint8_t request;
+    /// Transfer is in progress (from request until completion is delivered)
+    volatile bool_t busy;
+    /// Context of the transfer in progress
+    struct pal_i2c* p_request_ctx;
+    /// Data of the transfer in progress
+    uint8_t* p_request_data;
+    /// Length of the transfer in progress
+    uint16_t request_length;
+    /// Result of the transfer in progress
+    pal_status_t request_status;
+    /// Completion delivered by the event loop
+    pal_os_event_post_t completion;
+} pal_linux_i2c_t;
+
+/**
+ * \brief Linux GPIO context, referred by #pal_gpio_t.p_gpio_hw.
+ */
+typedef struct pal_linux_gpio
+{
+    /// sysfs value file of an exported output pin (Example: "/sys/class/gpio/gpio17/value")
+    const char* p_value_path;
+    /// Simulated slave. If not NULL, a low level on this pin holds the virtual chip in reset
+    pal_i2c_virtual_chip_t* p_virtual_chip;
+} pal_linux_gpio_t;
+
+/**********************************************************************************************************************
+ * API Prototypes
+ *********************************************************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Linux I2C master context used by #optiga_pal_i2c_context_0
+extern pal_linux_i2c_t optiga_pal_linux_i2c_0;
+/// Linux GPIO context used by #optiga_reset_0
+extern pal_linux_gpio_t optiga_pal_linux_reset_0;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _PAL_LINUX_H_ */
+
+/**
+* @}
+*/
@@ -0,0 +1,125 @@
+/**
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+*
+* \file
+*
+* \brief This file implements the subset of the Arduino core API used by IFX_OPTIGA_TrustX on Linux host builds.
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#ifndef _PAL_LINUX_ARDUINO_COMPAT_H_
+#define _PAL_LINUX_ARDUINO_COMPAT_H_
+
+#include "pal.h"
+
+#if defined(PAL_TARGET_LINUX) && defined(__cplusplus)
+
+/**********************************************************************************************************************
+ * HEADER FILES
+ *********************************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include "pal_os_timer.h"
+
+/**********************************************************************************************************************
+ * MACROS
+ *********************************************************************************************************************/
+#define DEC     10
+#define HEX     16
+
+/**********************************************************************************************************************
+ * DATA STRUCTURES
+ *********************************************************************************************************************/
+
+/**
+ * \brief Arduino String replacement.
+ */
+class String : public std::string
+{
+public:
+    String() {}
+    String(const char* str) : std::string(str) {}
+    String(const std::string& str) : std::string(str) {}
+};
+
+/**
+ * \brief Placeholder for the Arduino I2C master. The Linux port selects the bus in #optiga_pal_linux_i2c_0.
+ */
+class TwoWire
+{
+};
+
+/**
+ * \brief Serial console mapped to stdout.
+ */
+class HostSerial
+{
+public:
+    void print(const char* str)  { fputs(str, stdout); }
+    void print(char c)           { fputc(c, stdout); }
+    void print(long value, int base = DEC)
+    {
+        printf((HEX == base) ? "%lX" : "%ld", value);
+    }
+    void print(unsigned long value, int base = DEC)
+    {
+        printf((HEX == base) ? "%lX" : "%lu", value);
+    }
+    void print(int value, int base = DEC)          { print((long)value, base); }
+    void print(unsigned int value, int base = DEC) { print((unsigned long)value, base); }
+    void println(void)           { fputs("\r\n", stdout); }
+    void println(const char* str) { print(str); println(); }
+    void println(long value, int base = DEC) { print(value, base); println(); }
+    void println(unsigned long value, int base = DEC) { print(value, base); println(); }
+    void println(int value, int base = DEC)          { print(value, base); println(); }
+    void println(unsigned int value, int base = DEC) { print(value, base); println(); }
+};
+
+/**********************************************************************************************************************
+ * GLOBAL
+ *********************************************************************************************************************/
+///Defined once in OPTIGATrustX.cpp
+extern TwoWire Wire;
+extern HostSerial Serial;
+
+/**********************************************************************************************************************
+ * API IMPLEMENTATION
+ *********************************************************************************************************************/
+inline uint32_t millis(void)            { return pal_os_timer_get_time_in_milliseconds(); }
+inline uint32_t micros(void)            { return pal_os_timer_get_time_in_microseconds(); }
+inline void delay(uint32_t ms)          { pal_os_timer_delay_in_milliseconds((uint16_t)ms); }
+inline int analogRead(uint8_t pin)      { (void)pin; return rand(); }
+inline void randomSeed(unsigned long s) { srand((unsigned int)(s ^ micros())); }
+inline long random(long max)            { return (max > 0) ? (rand() % max) : 0; }
+
+#endif /* PAL_TARGET_LINUX && __cplusplus */
+
+#endif /* _PAL_LINUX_ARDUINO_COMPAT_H_ */
+
+/**
+* @}
+*/
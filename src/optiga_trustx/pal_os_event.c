@@ -0,0 +1,273 @@
+/**
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+*
+* \file
+*
+* \brief This file implements the platform independent timer queue of the os event/scheduler.
+*
+* Oneshot callbacks are kept in a list ordered by their due time in microseconds. Each owner (For example: the Ifx
+* i2c context) provides the list node, so a registration can not be dropped for lack of space. Registering a node
+* again replaces its pending callback, so several stack instances and layers can schedule independently.
+*
+* \ingroup  grPAL
+* @{
+*/
+
+/**********************************************************************************************************************
+ * HEADER FILES
+ *********************************************************************************************************************/
+#include "pal.h"
+#include "pal_os_event.h"
+#include "pal_os_timer.h"
+#if !defined(PAL_TARGET_LINUX) && defined(__AVR__)
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#endif
+
+/**********************************************************************************************************************
+ * MACROS
+ *********************************************************************************************************************/
+/// @cond hidden
+#if !defined(PAL_TARGET_LINUX) && defined(__arm__)
+/// Single core MCU, posts come from interrupts which are masked around the read and clear of the flag.
+/// ARMv6-M (Cortex-M0) has no exclusive access instructions, __atomic_exchange_n would need a libatomic call.
+#define PAL_OS_EVENT_LOCK(state)            __asm__ volatile ("mrs %0, primask\n cpsid i" : "=r" (state) :: "memory")
+#define PAL_OS_EVENT_UNLOCK(state)          __asm__ volatile ("msr primask, %0" :: "r" (state) : "memory")
+#elif !defined(PAL_TARGET_LINUX) && defined(__AVR__)
+#define PAL_OS_EVENT_LOCK(state)            do { (state) = SREG; cli(); } while (0)
+#define PAL_OS_EVENT_UNLOCK(state)          do { SREG = (uint8_t)(state); } while (0)
+#endif
+
+#if defined(PAL_OS_EVENT_LOCK)
+#define PAL_OS_EVENT_TAKE_PENDING(p_flag)   pal_os_event_take_pending(p_flag)
+#define PAL_OS_EVENT_SET_PENDING(p_flag)    do { __asm__ volatile ("" ::: "memory"); *(p_flag) = 1; } while (0)
+#else
+/// Posts can come from other threads (Linux) or cores, the pending flag is exchanged atomically
+#define PAL_OS_EVENT_TAKE_PENDING(p_flag)   __atomic_exchange_n((p_flag), 0, __ATOMIC_ACQUIRE)
+#define PAL_OS_EVENT_SET_PENDING(p_flag)    __atomic_store_n((p_flag), 1, __ATOMIC_RELEASE)
+#endif
+
+/*********************************************************************************************************************
+ * LOCAL DATA
+ *********************************************************************************************************************/
+/// Pending callbacks, earliest first
+static pal_os_event_t* p_event_list = NULL;
+/// Registered completions
+static pal_os_event_post_t* p_post_list = NULL;
+
+/**********************************************************************************************************************
+ * LOCAL ROUTINES
+ *********************************************************************************************************************/
+#if defined(PAL_OS_EVENT_LOCK)
+static uint8_t pal_os_event_take_pending(volatile uint8_t* p_flag)
+{
+    uint32_t state;
+    uint8_t pending;
+
+    PAL_OS_EVENT_LOCK(state);
+    pending = *p_flag;
+    *p_flag = 0;
+    PAL_OS_EVENT_UNLOCK(state);
+    return pending;
+}
+#endif
+
+static void pal_os_event_dispatch_posts(void)
+{
+    pal_os_event_post_t* p_post;
+
+    for (p_post = p_post_list; NULL != p_post; p_post = p_post->p_next)
+    {
+        // Acquire pairs with the release in pal_os_event_post, so data written before posting is visible
+        if (PAL_OS_EVENT_TAKE_PENDING(&p_post->pending))
+        {
+            p_post->callback(p_post->callback_args);
+        }
+    }
+}
+
+static void pal_os_event_unlink(const pal_os_event_t* p_event)
+{
+    pal_os_event_t** pp_entry;
+
+    for (pp_entry = &p_event_list; NULL != *pp_entry; pp_entry = &(*pp_entry)->p_next)
+    {
+        if (*pp_entry == p_event)
+        {
+            *pp_entry = p_event->p_next;
+            break;
+        }
+    }
+}
+
+/// @endcond
+/**********************************************************************************************************************
+ * API IMPLEMENTATION
+ *********************************************************************************************************************/
+
+/**
+* Platform independent event call back registration function to trigger once when timer expires.
+* <br>
+*
+* <b>API Details:</b>
+*         This function registers the callback function supplied by the caller.<br>
+*         The callback is due after the supplied time interval in microseconds. Callbacks with the same due time
+*         are invoked in the order of registration.<br>
+*         The event node is owned by the caller and must stay valid until the callback is invoked or cancelled.
+*         A pending callback of the same node is replaced.<br>
+*
+* \param[in,out] p_event           Event node of the owner, need not be initialized
+* \param[in] callback              Callback function pointer
+* \param[in] callback_args         Callback arguments
+* \param[in] time_us               time in micro seconds to trigger the call back
+*
+*/
+void pal_os_event_register_callback_oneshot(pal_os_event_t* p_event,
+                                            register_callback callback, 
+                                            void* callback_args, 
+                                            uint32_t time_us)
+{
+    pal_os_event_t** pp_entry;
+
+    pal_os_event_unlink(p_event);
+    p_event->due_time = pal_os_timer_get_time_in_microseconds() + time_us;
+    p_event->callback = callback;
+    p_event->callback_args = callback_args;
+
+    pp_entry = &p_event_list;
+    while ((NULL != *pp_entry) && ((int32_t)(p_event->due_time - (*pp_entry)->due_time) >= 0))
+    {
+        pp_entry = &(*pp_entry)->p_next;
+    }
+    p_event->p_next = *pp_entry;
+    *pp_entry = p_event;
+}
+
+/**
+* Cancels the pending callback of the event node, if any.
+*
+* \param[in] p_event               Event node used at registration
+*
+*/
+void pal_os_event_cancel(const pal_os_event_t* p_event)
+{
+    pal_os_event_unlink(p_event);
+}
+
+/**
+* Registers a completion object with the event loop.
+* <br>
+*
+* <b>API Details:</b>
+*         The object must stay valid while the event loop is in use. Registering the same object again only
+*         updates the callback.<br>
+*
+* \param[in,out] p_post              Completion object
+* \param[in]     callback            Callback invoked from the event loop once posted
+* \param[in]     callback_args       Callback arguments
+*
+*/
+void pal_os_event_post_init(pal_os_event_post_t* p_post, register_callback callback, void* callback_args)
+{
+    pal_os_event_post_t* p_entry;
+
+    p_post->callback = callback;
+    p_post->callback_args = callback_args;
+    p_post->pending = 0;
+    for (p_entry = p_post_list; NULL != p_entry; p_entry = p_entry->p_next)
+    {
+        if (p_entry == p_post)
+        {
+            return;
+        }
+    }
+    p_post->p_next = p_post_list;
+    p_post_list = p_post;
+}
+
+/**
+* Posts a completion to the event loop.
+* <br>
+*
+* <b>API Details:</b>
+*         The callback of the completion is invoked by the next #pal_os_event_dispatch in the event loop context.
+*         The function only sets a flag and signals #pal_os_event_wakeup, so it can be used from interrupt
+*         context or from another thread (For example: an I2C completion).<br>
+*
+* \param[in,out] p_post              Completion object registered with #pal_os_event_post_init
+*
+*/
+void pal_os_event_post(pal_os_event_post_t* p_post)
+{
+    PAL_OS_EVENT_SET_PENDING(&p_post->pending);
+    pal_os_event_wakeup();
+}
+
+/**
+* Invokes the posted completions and the callbacks whose time has elapsed, earliest first.
+* <br>
+*
+* <b>API Details:</b>
+*         Callbacks registered from within a callback are invoked by this call only if they are due at the time
+*         the dispatch started. This bounds the work done by one call.<br>
+*
+*/
+void pal_os_event_dispatch(void)
+{
+    uint32_t now;
+    pal_os_event_t* p_event;
+
+    pal_os_event_dispatch_posts();
+    now = pal_os_timer_get_time_in_microseconds();
+
+    while ((NULL != p_event_list) && ((int32_t)(now - p_event_list->due_time) >= 0))
+    {
+        // Unlinked before the callback, which may register the node again
+        p_event = p_event_list;
+        p_event_list = p_event->p_next;
+        p_event->callback(p_event->callback_args);
+    }
+}
+
+/**
+* Gets the due time of the earliest pending callback.
+*
+* \param[out] p_due_time_us        Due time in microseconds (pal_os_timer_get_time_in_microseconds time base)
+*
+* \retval  TRUE   A callback is pending
+* \retval  FALSE  No callback is pending
+*/
+bool_t pal_os_event_get_next_due_time(uint32_t* p_due_time_us)
+{
+    if (NULL == p_event_list)
+    {
+        return FALSE;
+    }
+    *p_due_time_us = p_event_list->due_time;
+    return TRUE;
+}
+
+/**
+* @}
+*/
@@ -47,7 +47,6 @@ extern "C" {
  * MACROS
  *********************************************************************************************************************/
 
-
 /**********************************************************************************************************************
  * ENUMS
  *********************************************************************************************************************/
@@ -61,16 +60,82 @@ extern "C" {
  */
 typedef void (*register_callback)(void*);
 
+/**
+ * @brief Oneshot callback of one owner. The owner provides the node, see #pal_os_event_register_callback_oneshot.
+ */
+typedef struct pal_os_event
+{
+    /// Time stamp in microseconds at which the callback is due
+    uint32_t due_time;
+    /// Callback function
+    register_callback callback;
+    /// Callback argument
+    void* callback_args;
+    /// Next pending callback
+    struct pal_os_event* p_next;
+} pal_os_event_t;
+
+/**
+ * @brief Completion that can be posted from interrupt context or another thread and is delivered by the event loop.
+ */
+typedef struct pal_os_event_post
+{
+    /// Callback invoked from #pal_os_event_dispatch
+    register_callback callback;
+    /// Callback argument
+    void* callback_args;
+    /// Set by #pal_os_event_post, cleared before the callback is invoked
+    volatile uint8_t pending;
+    /// Next registered completion
+    struct pal_os_event_post* p_next;
+} pal_os_event_post_t;
+
 
 /**
- * @brief Platform specific event processing functions.
+ * @brief Platform specific event processing functions. Invokes the elapsed callbacks without blocking.
  */
 void pal_os_event_process(void);
 
+/**
+ * @brief Sleeps until the next callback is due or a wakeup is signalled, then invokes the elapsed callbacks.
+ */
+void pal_os_event_wait(void);
+
+/**
+ * @brief Wakes up a sleeping #pal_os_event_wait. Can be called from interrupt context or another thread.
+ */
+void pal_os_event_wakeup(void);
+
 /**
  * @brief Callback registration function to trigger once when timer expires.
  */
-void pal_os_event_register_callback_oneshot(register_callback callback, void* callback_args, uint32_t time_us);
+void pal_os_event_register_callback_oneshot(pal_os_event_t* p_event, register_callback callback, void* callback_args,
+                                            uint32_t time_us);
+
+/**
+ * @brief Cancels the pending callback of the event node.
+ */
+void pal_os_event_cancel(const pal_os_event_t* p_event);
+
+/**
+ * @brief Registers a completion object with the event loop. Must be called from the event loop context.
+ */
+void pal_os_event_post_init(pal_os_event_post_t* p_post, register_callback callback, void* callback_args);
+
+/**
+ * @brief Marks the completion as pending and wakes up the event loop. Can be called from interrupt context or another thread.
+ */
+void pal_os_event_post(pal_os_event_post_t* p_post);
+
+/**
+ * @brief Invokes all callbacks whose time has elapsed. Used by the platform specific pal_os_event_process.
+ */
+void pal_os_event_dispatch(void);
+
+/**
+ * @brief Gets the time (in microseconds) at which the next callback is due.
+ */
+bool_t pal_os_event_get_next_due_time(uint32_t* p_due_time_us);
 
 #ifdef __cplusplus
 }
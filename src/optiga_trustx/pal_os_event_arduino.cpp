@@ -30,92 +30,100 @@
 * @{
 */
 
+#if defined(ARDUINO)
+
 /**********************************************************************************************************************
  * HEADER FILES
  *********************************************************************************************************************/
 #include <Arduino.h>
-#include "../simple_timer/SimpleTimer.h"
 #include "pal_os_event.h"
 
 /**********************************************************************************************************************
  * MACROS
  *********************************************************************************************************************/
+/// Remaining time (us) above which the core is halted until the next interrupt (SysTick at least every millisecond)
+#define PAL_OS_EVENT_IDLE_THRESHOLD_US  (1000)
+
+#if defined(__arm__)
+/// Halts the core until the next interrupt
+#define PAL_OS_EVENT_IDLE()     __asm__ volatile ("wfi")
+#else
+/// Core has no portable idle instruction, keep polling
+#define PAL_OS_EVENT_IDLE()
+#endif
 
 /*********************************************************************************************************************
  * LOCAL DATA
  *********************************************************************************************************************/
 /// @cond hidden
-/// Callback function when timer elapses
-static volatile register_callback callback_registered = NULL;
-/// Pointer to store upper layer callback context (For example: Ifx i2c context)
-static void * callback_ctx;
-
-// the timer object
-SimpleTimer callback_timer;
+/// Set by pal_os_event_wakeup
+static volatile bool_t wakeup_pending = FALSE;
+/// @endcond
 
+/**********************************************************************************************************************
+ * API IMPLEMENTATION
+ *********************************************************************************************************************/
 
 /**
-*  Timer callback handler.
-*
-*  This get called from the TIMER elapse event.<br>
-*  Once the timer expires, the registered callback funtion gets called from the timer event handler, if
-*  the call back is not NULL.<br>
+* Platform specific event processing functions.
+* <br>
 *
-*\param[in] args Callback argument
+* <b>API Details:</b>
+*         This function invokes the elapsed callbacks of the timer queue (see pal_os_event.c)<br>
+*         It does not block; use #pal_os_event_wait to sleep until the next event.<br>
 *
 */
-void scheduler_timer_isr(void)
+void pal_os_event_process(void)
 {
-    register_callback callback;
-
-    if (callback_registered)
-    {
-		
-        callback = callback_registered;
-        callback_registered = NULL;
-        callback((void*)callback_ctx);
-
-    }
+	pal_os_event_dispatch();
 }
 
 /**
-* Platform specific event processing functions.
+* Sleeps until the next callback is due or #pal_os_event_wakeup is called, then invokes the elapsed callbacks.
 * <br>
 *
 * <b>API Details:</b>
-*         This function calls platform specific event processing events routine
+*         While the next deadline is more than #PAL_OS_EVENT_IDLE_THRESHOLD_US away, the core waits for
+*         interrupt (WFI). The last part is polled with micros() to keep the microsecond resolution.<br>
 *
 */
-void pal_os_event_process(void)
+void pal_os_event_wait(void)
 {
-	callback_timer.run();
-	delay(1);
+	uint32_t due_time;
+	bool_t pending;
+
+	while (!wakeup_pending)
+	{
+		//Callbacks and posts can be queued from interrupts while the core sleeps, re-read the queue after each wake up
+		pending = pal_os_event_get_next_due_time(&due_time);
+		if (pending && ((int32_t)(micros() - due_time) >= 0))
+		{
+			break;
+		}
+		if ((!pending) || ((int32_t)(due_time - micros()) > PAL_OS_EVENT_IDLE_THRESHOLD_US))
+		{
+			PAL_OS_EVENT_IDLE();
+		}
+	}
+	wakeup_pending = FALSE;
+	pal_os_event_dispatch();
 }
 
 /**
-* Platform specific event call back registration function to trigger once when timer expires.
+* Wakes up a sleeping #pal_os_event_wait.
 * <br>
 *
 * <b>API Details:</b>
-*         This function registers the callback function supplied by the caller.<br>
-*         It triggers a timer with the supplied time interval in microseconds.<br>
-*         Once the timer expires, the registered callback function gets called.<br>
-*
-* \param[in] callback              Callback function pointer
-* \param[in] callback_args         Callback arguments
-* \param[in] time_us               time in micro seconds to trigger the call back
+*         Can be called from interrupt context (For example: I2C completion interrupt).<br>
 *
 */
-void pal_os_event_register_callback_oneshot(register_callback callback, 
-                                            void* callback_args, 
-                                            uint32_t time_us)
+void pal_os_event_wakeup(void)
 {
-    callback_registered = callback;
-    callback_ctx = callback_args;
-
-    callback_timer.setTimeout(time_us/1000, scheduler_timer_isr);
+	wakeup_pending = TRUE;
 }
 
+#endif /* ARDUINO */
+
 /**
 * @}
 */
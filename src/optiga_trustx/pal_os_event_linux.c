@@ -0,0 +1,165 @@
+/**
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+*
+* \file
+*
+* \brief This file implements the platform abstraction layer APIs for os event/scheduler on Linux hosts.
+*
+* \ingroup  grPAL
+* @{
+*/
+
+/// ppoll() is a GNU extension
+#define _GNU_SOURCE
+#include "pal.h"
+
+#if defined(PAL_TARGET_LINUX)
+
+/**********************************************************************************************************************
+ * HEADER FILES
+ *********************************************************************************************************************/
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/prctl.h>
+#include "pal_os_event.h"
+#include "pal_os_timer.h"
+
+/**********************************************************************************************************************
+ * MACROS
+ *********************************************************************************************************************/
+/// Longest sleep if the eventfd could not be created, posted events are delivered after at most this time
+#define PAL_OS_EVENT_POLL_FALLBACK_US   (1000)
+
+/*********************************************************************************************************************
+ * LOCAL DATA
+ *********************************************************************************************************************/
+/// @cond hidden
+/// eventfd signalled by pal_os_event_wakeup, created before main() so signalling it is a plain write()
+static int wakeup_fd = -1;
+/// Timer slack of the event loop thread is lowered
+static bool_t timer_slack_set = FALSE;
+
+/**********************************************************************************************************************
+ * LOCAL ROUTINES
+ *********************************************************************************************************************/
+__attribute__((constructor)) static void pal_os_event_create_wakeup_fd(void)
+{
+    wakeup_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+}
+/// @endcond
+
+/**********************************************************************************************************************
+ * API IMPLEMENTATION
+ *********************************************************************************************************************/
+
+/**
+* Platform specific event processing functions.
+* <br>
+*
+* <b>API Details:</b>
+*         This function invokes the elapsed callbacks of the timer queue (see pal_os_event.c)<br>
+*         It does not block; use #pal_os_event_wait to sleep until the next event.<br>
+*
+*/
+void pal_os_event_process(void)
+{
+    pal_os_event_dispatch();
+}
+
+/**
+* Sleeps until the next callback is due or #pal_os_event_wakeup is called, then invokes the elapsed callbacks.
+* <br>
+*
+* <b>API Details:</b>
+*         The thread blocks in ppoll() on an eventfd with the time left to the next deadline as timeout, so the
+*         wait has nanosecond resolution and does not consume CPU. Without pending callbacks, it blocks until
+*         a wakeup is signalled.<br>
+*         If the eventfd could not be created, a wakeup can not interrupt the sleep. The wait is then limited to
+*         #PAL_OS_EVENT_POLL_FALLBACK_US, so posted events are still delivered.<br>
+*
+*/
+void pal_os_event_wait(void)
+{
+    struct pollfd wakeup;
+    struct timespec timeout;
+    uint32_t due_time;
+    int32_t remaining = 0;
+    uint64_t counter;
+    bool_t pending = pal_os_event_get_next_due_time(&due_time);
+
+    if (pending)
+    {
+        remaining = (int32_t)(due_time - pal_os_timer_get_time_in_microseconds());
+    }
+    if ((wakeup_fd < 0) && ((!pending) || (remaining > PAL_OS_EVENT_POLL_FALLBACK_US)))
+    {
+        pending = TRUE;
+        remaining = PAL_OS_EVENT_POLL_FALLBACK_US;
+    }
+    if ((!pending) || (remaining > 0))
+    {
+        if (!timer_slack_set)
+        {
+            // The default timer slack (50us) is as long as the I2C guard time
+            //lint --e{534} suppress "Without it the wait is only less precise"
+            prctl(PR_SET_TIMERSLACK, 1UL, 0UL, 0UL, 0UL);
+            timer_slack_set = TRUE;
+        }
+        wakeup.fd = wakeup_fd;
+        wakeup.events = POLLIN;
+        wakeup.revents = 0;
+        timeout.tv_sec = remaining / 1000000;
+        timeout.tv_nsec = (long)(remaining % 1000000) * 1000;
+        if ((ppoll(&wakeup, 1, pending ? &timeout : NULL, NULL) > 0) && (wakeup.revents & POLLIN))
+        {
+            //lint --e{534} suppress "Only clears the eventfd counter"
+            read(wakeup.fd, &counter, sizeof(counter));
+        }
+    }
+    pal_os_event_dispatch();
+}
+
+/**
+* Wakes up a sleeping #pal_os_event_wait.
+* <br>
+*
+* <b>API Details:</b>
+*         Can be called from another thread or a signal handler, it only write()s to an eventfd created at startup.<br>
+*
+*/
+void pal_os_event_wakeup(void)
+{
+    uint64_t one = 1;
+
+    //lint --e{534} suppress "A saturated eventfd is already signalled"
+    write(wakeup_fd, &one, sizeof(one));
+}
+
+#endif /* PAL_TARGET_LINUX */
+
+/**
+* @}
+*/
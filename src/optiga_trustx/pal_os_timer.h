@@ -72,6 +72,11 @@ extern "C" {
  */
 uint32_t pal_os_timer_get_time_in_milliseconds(void);
 
+/**
+ * @brief Gets tick count value in microseconds
+ */
+uint32_t pal_os_timer_get_time_in_microseconds(void);
+
 /**
  * @brief Waits or delay until the supplied milliseconds
  */
@@ -30,6 +30,8 @@
 * @{
 */
 
+#if defined(ARDUINO)
+
 /**********************************************************************************************************************
  * HEADER FILES
  *********************************************************************************************************************/
@@ -65,6 +67,17 @@ uint32_t pal_os_timer_get_time_in_milliseconds(void)
 	return millis();
 }
 
+/**
+* Get the current time in microseconds<br>
+*
+*
+* \retval  uint32_t time in microseconds
+*/
+uint32_t pal_os_timer_get_time_in_microseconds(void)
+{
+	return micros();
+}
+
 /**
 * Waits or delays until the given milliseconds time
 * 
@@ -76,6 +89,8 @@ void pal_os_timer_delay_in_milliseconds(uint16_t milliseconds)
 	delay(milliseconds);
 }
 
+#endif /* ARDUINO */
+
 /**
 * @}
 */
@@ -0,0 +1,464 @@
+/**
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \file
+*
+* \brief   Host test of the decoded access conditions. Random read access conditions are decoded with
+*          IntLib_DecodeMetaData and verified with IntLib_CheckAC for a set of LcsA, LcsG and LcsO values. The result
+*          is compared with the evaluator of the raw metadata which the decoded form replaced, copied below.
+*          A well formed condition with at most INT_LIB_AC_MAX_TERMS terms must give the same result. Any other
+*          condition, e.g. one with an operator not followed by a complete condition, may only be met if the old
+*          evaluator met it too.
+*
+*          Build and run on a Linux host from the repository root:
+*          S=src/optiga_trustx; gcc -I$S test/ac_equivalence.c $S/IntegrationLib.c $S/CommandLib.c $S/CommandHash.c
+*              $S/MemoryMgmt.c $S/Util.c $S/debug.cpp $S/optiga_comms_ifx_i2c.c $S/ifx_i2c*.c $S/pal_*linux.c
+*              $S/pal_os_event.c $S/pal_i2c_virtual_chip.c -lpthread -o ac_equivalence && ./ac_equivalence
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "IntegrationLib.h"
+#include "CryptoLib.h"
+
+#define ROUNDS          200000
+#define MAX_AC_LENGTH   40
+
+static const uint8_t lcs_values[] = {0x00, 0x01, 0x02, 0x03, 0x06, 0x07, 0x08, 0x0F, 0x10, 0x7F, 0xFE, 0xFF};
+
+//The crypto library is not part of the tree, the access condition checks do not use it
+int32_t CryptoLib_ParseCertificate(const sbBlob_d *PpsRawCertificate,sCertificate_d *PpsCertificate)
+{
+    (void)PpsRawCertificate;
+    (void)PpsCertificate;
+    return (int32_t)INT_LIB_ERROR;
+}
+
+int32_t CryptoLib_VerifySignature(const sSignatureVector_d *PpsSignatureVector)
+{
+    (void)PpsSignatureVector;
+    return (int32_t)INT_LIB_ERROR;
+}
+
+int32_t CryptoLib_GetRandom(uint16_t PwRandomDataLength,sCmdResponse_d *PpsResponse)
+{
+    (void)PwRandomDataLength;
+    (void)PpsResponse;
+    return (int32_t)INT_LIB_ERROR;
+}
+
+/// @cond hidden
+//Evaluator of the raw access condition, as before the metadata was decoded
+typedef enum eOperator_d {
+    eOP_EQUAL = 0xFA,
+    eOP_GREATER_THAN = 0xFB,
+    eOP_LESS_THAN = 0xFC,
+    eOP_AND = 0xFD,
+    eOP_OR = 0xFE
+} eOperator_d;
+
+typedef enum eAccessConditionID_d
+{
+    eACID_ALW = 0x00,
+    eACID_LCSG = 0x70,
+    eACID_LCSA = 0xE0,
+    eACID_LCSO = 0xE1,
+    eACID_NEV = 0xFF
+} eAccessConditionID_d;
+
+typedef struct sACVector_d
+{
+    uint8_t bLcsA;
+    uint8_t bLcsG;
+    uint8_t bLcsO;
+    sbBlob_d *psMetaData;
+}sACVector_d;
+
+static int32_t IntLib_VerifyLcsAGO(const sACVector_d* PpsACVal, const uint8_t* PprgbAC,puint16_t PpwVerifyOver)
+{
+    int32_t i4Status = (int32_t)INT_LIB_ERROR;
+    uint8_t bVal, bLcs = 0x00;
+    eOperator_d eOp ;
+
+    do
+    {
+        if((NULL == PpwVerifyOver)
+            || (NULL == PpsACVal) || (NULL == PprgbAC))
+        {
+            break;
+        }
+
+        bLcs = PpsACVal->bLcsA;
+        if ((uint8_t)eACID_LCSG == *PprgbAC)
+        {
+            bLcs = PpsACVal->bLcsG;
+        }
+        else if((uint8_t)eACID_LCSO == *PprgbAC)
+        {
+            bLcs = PpsACVal->bLcsO;
+        }
+
+        eOp = (eOperator_d)(*(PprgbAC+1));
+        bVal = *(PprgbAC+2);
+
+        if(eOp == eOP_GREATER_THAN)
+        {
+            if(bLcs > bVal)
+            {
+                i4Status = INT_LIB_OK;
+            }
+        }
+        else if(eOp == eOP_LESS_THAN)
+        {
+            if(bLcs < bVal)
+            {
+                i4Status = INT_LIB_OK;
+            }
+        }
+        else if(eOp == eOP_EQUAL)
+        {
+            if(bLcs == bVal)
+            {
+                i4Status = INT_LIB_OK;
+            }
+        }
+        else
+        {
+            i4Status = (int32_t)INT_LIB_ERROR;
+            *PpwVerifyOver = TRUE;
+            break;
+        }
+    } while(0);
+    return i4Status;
+}
+
+static int32_t IntLib_CheckAccessCondition(const sACVector_d *PpsACVal)
+{
+    int32_t i4Status = (int32_t)INT_LIB_ERROR;
+    int32_t i4StatusCurr = (int32_t)INT_LIB_ERROR;
+    int32_t i4StatusPrev = (int32_t)INT_LIB_OK;
+    uint16_t wIndex = 0, wLen, wIDCount = 0;
+    uint16_t wVerificationOver = 0;
+    uint8_t bComplexAcOP = 0x00;
+    puint8_t prgbAccessCode;
+
+    #define REMAINING_BYTES (wLen - wIndex)
+
+    do
+    {
+        if((NULL == PpsACVal) || (NULL == PpsACVal->psMetaData)
+                    || (NULL == PpsACVal->psMetaData->prgbStream))
+        {
+            break;
+        }
+
+        wLen = PpsACVal->psMetaData->wLen;
+        prgbAccessCode = PpsACVal->psMetaData->prgbStream;
+
+        while(wIndex < wLen)
+        {
+            switch((eAccessConditionID_d)*(prgbAccessCode+wIndex))
+            {
+                case  eACID_ALW:
+                case  eACID_NEV:
+                    if((REMAINING_BYTES > 1) || (wIDCount > 0))
+                    {
+                        wVerificationOver = TRUE;
+                        break;
+                    }
+                    i4StatusCurr = INT_LIB_OK;
+                    if((uint8_t)eACID_NEV == *(prgbAccessCode+wIndex))
+                    {
+                        i4StatusCurr = (int32_t)INT_LIB_ERROR;
+                    }
+                    wIndex++;
+                    wIDCount++;
+                    break;
+
+                case  eACID_LCSO:
+                case  eACID_LCSA:
+                case  eACID_LCSG:
+                    if(REMAINING_BYTES < 3)
+                    {
+                        wVerificationOver = TRUE;
+                        break;
+                    }
+
+                    i4StatusCurr = IntLib_VerifyLcsAGO(PpsACVal, prgbAccessCode+wIndex, &wVerificationOver);
+                    if(TRUE == wVerificationOver)
+                    {
+                        break;
+                    }
+
+                    wIndex+=3;
+                    wIDCount++;
+                    break;
+
+                default:
+                    i4StatusPrev = (int32_t)INT_LIB_ERROR;
+                    i4StatusCurr = (int32_t)INT_LIB_ERROR;
+                    wVerificationOver = TRUE;
+                    break;
+            }
+
+            if(wVerificationOver)
+            {
+                break;
+            }
+
+            if(bComplexAcOP == (uint8_t)eOP_AND)
+            {
+                if(i4StatusCurr != i4StatusPrev)
+                {
+                    i4StatusCurr = (int32_t)INT_LIB_ERROR;
+                }
+            }
+
+            if(wIndex == wLen)
+            {
+                break;
+            }
+
+            if(REMAINING_BYTES < 3)
+            {
+                i4StatusPrev = (int32_t)INT_LIB_ERROR;
+                i4StatusCurr = (int32_t)INT_LIB_ERROR;
+                break;
+            }
+
+            bComplexAcOP = *(prgbAccessCode+wIndex);
+            switch(bComplexAcOP)
+            {
+                case  eOP_AND:
+                    i4StatusPrev = i4StatusCurr;
+                    i4StatusCurr = (int32_t)INT_LIB_ERROR;
+                    break;
+
+                case  eOP_OR:
+                    i4StatusPrev = INT_LIB_OK;
+                    if(i4StatusCurr == INT_LIB_OK)
+                    {
+                        wVerificationOver = TRUE;
+                    }
+                    break;
+
+                default:
+                    i4StatusPrev = (int32_t)INT_LIB_ERROR;
+                    i4StatusCurr = (int32_t)INT_LIB_ERROR;
+                    wVerificationOver = TRUE;
+                    break;
+            }
+
+            if(wVerificationOver)
+            {
+                break;
+            }
+
+            wIndex++;
+            wIDCount++;
+        }
+
+        if((i4StatusPrev == INT_LIB_OK) &&
+        (i4StatusCurr == INT_LIB_OK))
+        {
+            i4Status = INT_LIB_OK;
+        }
+
+    }while(0);
+
+    return i4Status;
+#undef REMAINING_BYTES
+}
+/// @endcond
+
+static uint8_t random_byte(const uint8_t* p_values, uint8_t count)
+{
+    //Mostly valid codings, sometimes any byte
+    return (rand() % 16) ? p_values[rand() % count] : (uint8_t)rand();
+}
+
+//Random access condition, returns the length
+static uint8_t random_ac(uint8_t* p_ac)
+{
+    static const uint8_t ids[] = {eACID_LCSA, eACID_LCSG, eACID_LCSO};
+    static const uint8_t ops[] = {eOP_EQUAL, eOP_GREATER_THAN, eOP_LESS_THAN};
+    static const uint8_t joins[] = {eOP_AND, eOP_OR};
+    uint8_t len = 0;
+    uint8_t conditions;
+
+    if (0 == rand() % 16)
+    {
+        p_ac[len++] = (rand() % 2) ? eACID_ALW : eACID_NEV;
+    }
+    else
+    {
+        conditions = 1 + rand() % 8;
+        while ((conditions-- > 0) && ((len + 4) <= MAX_AC_LENGTH))
+        {
+            if (0 != len)
+                p_ac[len++] = random_byte(joins, sizeof(joins));
+            p_ac[len++] = random_byte(ids, sizeof(ids));
+            p_ac[len++] = random_byte(ops, sizeof(ops));
+            p_ac[len++] = random_byte(lcs_values, sizeof(lcs_values));
+        }
+    }
+    //Truncated coding or trailing bytes
+    if ((0 == rand() % 8) && (len > 0))
+        len -= 1 + rand() % ((len < 3) ? len : 3);
+    else if ((0 == rand() % 8) && (len < MAX_AC_LENGTH))
+        p_ac[len++] = random_byte(joins, sizeof(joins));
+    return len;
+}
+
+//A single ALW/NEV or conditions joined by AND/OR. Returns the number of terms, 0 if not well formed.
+static uint8_t well_formed_terms(const uint8_t* p_ac, uint8_t len)
+{
+    uint8_t terms = 1;
+    uint8_t index = 0;
+
+    if ((1 == len) && ((eACID_ALW == p_ac[0]) || (eACID_NEV == p_ac[0])))
+        return 1;
+    while ((index + 3) <= len)
+    {
+        if (((eACID_LCSA != p_ac[index]) && (eACID_LCSG != p_ac[index]) && (eACID_LCSO != p_ac[index])) ||
+            ((eOP_EQUAL != p_ac[index + 1]) && (eOP_GREATER_THAN != p_ac[index + 1]) &&
+             (eOP_LESS_THAN != p_ac[index + 1])))
+            return 0;
+        index += 3;
+        if (index == len)
+            return terms;
+        if ((eOP_OR == p_ac[index]) && ((index + 4) <= len))
+            terms++;
+        else if ((eOP_AND != p_ac[index]) || ((index + 4) > len))
+            return 0;
+        index++;
+    }
+    return 0;
+}
+
+//Compares both evaluators for all life cycle states, returns 1 on a mismatch
+static uint32_t compare(const uint8_t* p_ac, uint8_t len, uint8_t lcs_o, int exact)
+{
+    uint8_t metadata[7 + 255];
+    uint8_t raw[255];
+    sbBlob_d blob;
+    sACVector_d vector;
+    sIntLibObjectInfo_d info;
+    uint8_t a, g;
+    uint8_t index;
+    int old_met, new_met;
+
+    metadata[0] = 0x20;
+    metadata[1] = (uint8_t)(5 + len);
+    metadata[2] = 0xC0;
+    metadata[3] = 0x01;
+    metadata[4] = lcs_o;
+    metadata[5] = 0xD1;
+    metadata[6] = len;
+    memcpy(&metadata[7], p_ac, len);
+    if (INT_LIB_OK != IntLib_DecodeMetaData(metadata, (uint16_t)(7 + len), &info))
+        return 1;
+
+    for (a = 0; a < sizeof(lcs_values); a++)
+    {
+        for (g = 0; g < sizeof(lcs_values); g++)
+        {
+            //The old evaluator moves the blob
+            memcpy(raw, p_ac, len);
+            blob.prgbStream = raw;
+            blob.wLen = len;
+            vector.bLcsA = lcs_values[a];
+            vector.bLcsG = lcs_values[g];
+            vector.bLcsO = lcs_o;
+            vector.psMetaData = &blob;
+            old_met = (INT_LIB_OK == IntLib_CheckAccessCondition(&vector));
+            new_met = (TRUE == IntLib_CheckAC(&info.sReadAC, lcs_values[a], lcs_values[g]));
+            //Report the first mismatch of the access condition only
+            if ((exact && (old_met != new_met)) || (new_met && !old_met))
+            {
+                printf("mismatch LcsA %02X LcsG %02X LcsO %02X old %d new %d AC", lcs_values[a], lcs_values[g],
+                       lcs_o, old_met, new_met);
+                for (index = 0; index < len; index++)
+                    printf(" %02X", p_ac[index]);
+                printf("\n");
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+//Returns 1 if the access condition is met for LcsA and LcsG
+static int decoded_met(const uint8_t* p_ac, uint8_t len, uint8_t lcs_a, uint8_t lcs_g)
+{
+    uint8_t metadata[2 + 2 + 255];
+    sIntLibObjectInfo_d info;
+
+    metadata[0] = 0x20;
+    metadata[1] = (uint8_t)(2 + len);
+    metadata[2] = 0xD1;
+    metadata[3] = len;
+    memcpy(&metadata[4], p_ac, len);
+    return (INT_LIB_OK == IntLib_DecodeMetaData(metadata, (uint16_t)(4 + len), &info)) &&
+           (TRUE == IntLib_CheckAC(&info.sReadAC, lcs_a, lcs_g));
+}
+
+int main(void)
+{
+    //An OR without a complete condition after it
+    static const uint8_t trailing_or_g[] = {eACID_LCSG, eOP_GREATER_THAN, 0x01, eOP_OR};
+    static const uint8_t trailing_or_a[] = {eACID_LCSA, eOP_GREATER_THAN, 0x01, eOP_OR};
+    static const uint8_t short_or[] = {eACID_LCSG, eOP_GREATER_THAN, 0x01, eOP_OR, eACID_LCSG, eOP_EQUAL};
+    //Five terms, each met by its LcsA
+    static const uint8_t five_terms[] = {eACID_LCSA, eOP_EQUAL, 0x01, eOP_OR, eACID_LCSA, eOP_EQUAL, 0x02, eOP_OR,
+                                         eACID_LCSA, eOP_EQUAL, 0x03, eOP_OR, eACID_LCSA, eOP_EQUAL, 0x04, eOP_OR,
+                                         eACID_LCSA, eOP_EQUAL, 0x05};
+    uint8_t ac[MAX_AC_LENGTH];
+    uint8_t len;
+    uint8_t terms;
+    uint32_t mismatches = 0;
+    uint32_t exact = 0;
+    uint32_t round;
+
+    mismatches += decoded_met(trailing_or_g, sizeof(trailing_or_g), 0x07, 0x07);
+    mismatches += decoded_met(trailing_or_a, sizeof(trailing_or_a), 0x07, 0x07);
+    mismatches += decoded_met(short_or, sizeof(short_or), 0x07, 0x07);
+    mismatches += decoded_met(five_terms, sizeof(five_terms), 0x01, 0x00);
+    mismatches += !decoded_met(five_terms, sizeof(five_terms) - 4, 0x04, 0x00);
+    printf("fixed cases: %u mismatches\n", mismatches);
+
+    srand(1);
+    for (round = 0; round < ROUNDS; round++)
+    {
+        len = random_ac(ac);
+        terms = well_formed_terms(ac, len);
+        if ((0 != terms) && (terms <= INT_LIB_AC_MAX_TERMS))
+            exact++;
+        mismatches += compare(ac, len, lcs_values[rand() % sizeof(lcs_values)],
+                              (0 != terms) && (terms <= INT_LIB_AC_MAX_TERMS));
+    }
+    printf("%u access conditions, %u compared exactly: %u mismatches\n", ROUNDS, exact, mismatches);
+
+    return (0 == mismatches) ? 0 : 1;
+}
@@ -0,0 +1,94 @@
+/**
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \file
+*
+* \brief   Host test of the data link layer frame CRC variants. Every variant is compared with the bit by bit
+*          reference for all frame lengths up to the maximum frame size and random seeds, then 200 rounds of a
+*          maximum size frame are timed per variant.
+*
+*          Build and run on a Linux host from the repository root:
+*          gcc -O2 -Isrc/optiga_trustx test/crc_reference.c src/optiga_trustx/ifx_i2c_crc.c
+*              src/optiga_trustx/pal_os_timer_linux.c -o crc_reference && ./crc_reference
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "ifx_i2c_config.h"
+#include "ifx_i2c_crc.h"
+#include "pal_os_timer.h"
+
+#define FRAME_LENGTH    (DL_MAX_FRAME_SIZE - 2)
+#define ROUNDS          200
+#define SEEDS           16
+
+typedef uint16_t (*crc_function_t)(uint16_t seed, const uint8_t* p_data, uint16_t data_len);
+
+static const char* names[] = {"bitwise", "nibble ", "table  ", "slice4 "};
+static const crc_function_t functions[] = {ifx_i2c_crc_calc_bitwise, ifx_i2c_crc_calc_nibble,
+                                           ifx_i2c_crc_calc_table, ifx_i2c_crc_calc_slice4};
+
+int main(void)
+{
+    static uint8_t frame[FRAME_LENGTH];
+    uint32_t mismatches = 0;
+    uint32_t ts;
+    uint16_t crc;
+    uint16_t seed;
+    uint16_t len;
+    unsigned i, j;
+
+    srand(1);
+    for (i = 0; i < FRAME_LENGTH; i++)
+    {
+        frame[i] = (uint8_t)rand();
+    }
+
+    for (i = 0; i < sizeof(functions) / sizeof(functions[0]); i++)
+    {
+        for (len = 0; len <= FRAME_LENGTH; len++)
+        {
+            for (j = 0; j < SEEDS; j++)
+            {
+                seed = (0 == j) ? 0 : (uint16_t)rand();
+                if (functions[i](seed, frame, len) != ifx_i2c_crc_calc_bitwise(seed, frame, len))
+                {
+                    mismatches++;
+                }
+            }
+        }
+
+        crc = 0;
+        ts = pal_os_timer_get_time_in_microseconds();
+        for (j = 0; j < ROUNDS; j++)
+        {
+            // Chain the rounds so the calls can't be optimised away
+            crc = functions[i](crc, frame, FRAME_LENGTH);
+        }
+        ts = pal_os_timer_get_time_in_microseconds() - ts;
+        printf("%s %u us for %u rounds of %u bytes, crc 0x%04X\n", names[i], (unsigned)ts, ROUNDS, FRAME_LENGTH, crc);
+    }
+
+    printf("%u mismatches\n", (unsigned)mismatches);
+    return (0 == mismatches) ? 0 : 1;
+}
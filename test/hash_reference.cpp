@@ -0,0 +1,218 @@
+/**
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \file
+*
+* \brief   Host test of the SHA256 calculation on the simulated security chip. The digests of a stream passed in
+*          chunks of several sizes, of three sessions updated in turn from a pool of hash contexts and of slices of
+*          a data object are compared with digests computed with sha256sum. The sessions share the context on the
+*          chip, so they must be swapped with context imports, which are counted in the APDU handler.
+*
+*          Build and run on a Linux host from the repository root:
+*          S=src/optiga_trustx; gcc -c -I$S $S/CertificateIndex.c $S/Command*.c $S/IntegrationLib.c
+*              $S/MemoryMgmt.c $S/ObjectDump.c $S/Util.c $S/optiga_comms_ifx_i2c.c $S/ifx_i2c*.c $S/pal_*linux.c
+*              $S/pal_os_event.c $S/pal_i2c_virtual_chip.c src/third_crypto/uECC.c && g++ -Isrc -I$S
+*              test/hash_reference.cpp src/OPTIGATrustX.cpp src/aes/AES.cpp $S/debug.cpp *.o -lpthread
+*              -o hash_reference && ./hash_reference
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "OPTIGATrustX.h"
+#include "optiga_trustx/IntegrationLib.h"
+#include "optiga_trustx/pal_linux.h"
+extern "C" {
+#include "optiga_trustx/CryptoLib.h"
+}
+
+#define STREAM_LENGTH   5000
+#define SESSION_LENGTH  3000
+#define SESSION_COUNT   3
+#define SESSION_CHUNK   100
+#define SESSION_BUFFER  64
+#define OBJECT_LENGTH   1500
+
+extern "C" {
+//The crypto library is not part of the tree, the hash calculation does not use it
+int32_t CryptoLib_ParseCertificate(const sbBlob_d *PpsRawCertificate,sCertificate_d *PpsCertificate)
+{
+    (void)PpsRawCertificate;
+    (void)PpsCertificate;
+    return (int32_t)INT_LIB_ERROR;
+}
+
+int32_t CryptoLib_VerifySignature(const sSignatureVector_d *PpsSignatureVector)
+{
+    (void)PpsSignatureVector;
+    return (int32_t)INT_LIB_ERROR;
+}
+
+int32_t CryptoLib_GetRandom(uint16_t PwRandomDataLength,sCmdResponse_d *PpsResponse)
+{
+    (void)PwRandomDataLength;
+    (void)PpsResponse;
+    return (int32_t)INT_LIB_ERROR;
+}
+}
+
+//sha256sum of the input patterns below
+static const char* const stream_hash = "61005d719d55169d8eaa5512b3e1ac8a6c360e9eb8deab87c517ed5bef93c3b1";
+static const char* const session_hash[SESSION_COUNT] = {
+    "79377de5e174f4d17e4bc9550a5776175255f1bc0c3f2cdbb118c61b7e301d22",
+    "8c1a66baad7b59241c360326eb69f99233247547dc8c74a2afc55d7043fc4bb4",
+    "6c0d207f52de077d02b5aa25b77c50151351d6064f90d4fbdc54fab804c8cef8"
+};
+static const char* const object_hash = "70fbc6bd67a5b5a6dd3a7113bacfa5e8325e8bae54d1e9583f0b8979e08d4ff5";
+//Bytes 100 to 1099 of the object
+static const char* const slice_hash = "81291546e5723ae9a71321b3854368d5cbdc1e5b8c6d9d95e1759efd62b30b35";
+static const uint16_t chunk_sizes[] = {1, 63, 64, 65, 200, 700, 1};
+
+static pal_i2c_virtual_chip_t chip;
+static uint8_t object_data[OBJECT_LENGTH];
+static pal_i2c_virtual_chip_object_t objects[] = {{0xF1D1, object_data, OBJECT_LENGTH, OBJECT_LENGTH, NULL, 0}};
+static uint32_t imports;
+static uint32_t failures;
+
+//Counts the CalcHash commands that import a hash context after the data
+static uint8_t apdu_handler(pal_i2c_virtual_chip_t* p_chip, const uint8_t* p_apdu, uint16_t apdu_len,
+                            uint8_t* p_resp, uint16_t* p_resp_len, uint32_t* p_exec_time_us)
+{
+    uint16_t data_end;
+
+    if ((0x30 == p_apdu[0]) && (apdu_len > 7))
+    {
+        data_end = (uint16_t)(7 + ((p_apdu[5] << 8) | p_apdu[6]));
+        if ((data_end < apdu_len) && (0x06 == p_apdu[data_end]))
+        {
+            imports++;
+        }
+    }
+    return pal_i2c_virtual_chip_default_apdu_handler(p_chip, p_apdu, apdu_len, p_resp, p_resp_len, p_exec_time_us);
+}
+
+static void pattern(uint8_t* p_data, uint32_t offset, uint32_t length, uint8_t key)
+{
+    uint32_t i;
+
+    for (i = 0; i < length; i++)
+    {
+        p_data[i] = (uint8_t)((offset + i) * 13 + 5 + key);
+    }
+}
+
+static int equal(const uint8_t* p_hash, const char* p_hex)
+{
+    char hex[2 * 32 + 1];
+    int i;
+
+    for (i = 0; i < 32; i++)
+    {
+        sprintf(&hex[2 * i], "%02x", p_hash[i]);
+    }
+    return (0 == strcmp(hex, p_hex));
+}
+
+static void check(const char* p_step, int ok)
+{
+    printf("%-10s %s\n", p_step, ok ? "ok" : "FAIL");
+    if (!ok)
+    {
+        failures++;
+    }
+}
+
+int main(void)
+{
+    static uint8_t stream[STREAM_LENGTH];
+    static uint8_t pool[SESSION_COUNT * CMD_HASH_SESSION_SLOT_SIZE(SESSION_BUFFER)];
+    sCmdHashSession_d session[SESSION_COUNT];
+    uint8_t chunk[SESSION_CHUNK];
+    uint8_t hash[32];
+    uint32_t offset;
+    uint32_t length;
+    int32_t ret;
+    int i;
+
+    pal_i2c_virtual_chip_init(&chip, 0x30, apdu_handler, objects, 1);
+    optiga_pal_linux_i2c_0.p_virtual_chip = &chip;
+    optiga_pal_linux_reset_0.p_virtual_chip = &chip;
+    if (0 != trustX.begin())
+    {
+        puts("begin failed");
+        return 1;
+    }
+    pattern(object_data, 0, OBJECT_LENGTH, 0);
+
+    //One calculation, the input is split into chunks of different sizes
+    pattern(stream, 0, STREAM_LENGTH, 0);
+    ret = trustX.sha256Start();
+    for (offset = 0, i = 0; (0 == ret) && (offset < STREAM_LENGTH); offset += length, i++)
+    {
+        length = chunk_sizes[i % (sizeof(chunk_sizes) / sizeof(chunk_sizes[0]))];
+        if (length > STREAM_LENGTH - offset)
+        {
+            length = STREAM_LENGTH - offset;
+        }
+        ret = trustX.sha256Update(&stream[offset], length);
+    }
+    ret |= trustX.sha256Final(hash);
+    check("stream", (0 == ret) && equal(hash, stream_hash));
+
+    //Three sessions in turn, each update swaps the context on the chip
+    ret = trustX.hashSessionsBegin(pool, sizeof(pool), SESSION_BUFFER);
+    for (i = 0; i < SESSION_COUNT; i++)
+    {
+        ret |= trustX.hashSessionOpen(session[i]);
+    }
+    imports = 0;
+    for (offset = 0; (0 == ret) && (offset < SESSION_LENGTH); offset += SESSION_CHUNK)
+    {
+        for (i = 0; i < SESSION_COUNT; i++)
+        {
+            pattern(chunk, offset, SESSION_CHUNK, (uint8_t)i);
+            ret |= trustX.hashSessionUpdate(session[i], chunk, SESSION_CHUNK);
+        }
+        //A hash of an object in between replaces the context on the chip
+        if (SESSION_LENGTH / 2 == offset)
+        {
+            ret |= trustX.sha256Object(0xF1D1, hash);
+        }
+    }
+    for (i = 0; i < SESSION_COUNT; i++)
+    {
+        ret |= trustX.hashSessionFinal(session[i], hash);
+        check("session", (0 == ret) && equal(hash, session_hash[i]));
+    }
+    printf("%u context imports\n", (unsigned)imports);
+    check("swapped", imports > 0);
+
+    //Slices of an object, the chip reads the object itself
+    ret = trustX.sha256Object(0xF1D1, hash);
+    check("object", (0 == ret) && equal(hash, object_hash));
+    ret = trustX.sha256Object(0xF1D1, 100, 1000, hash);
+    check("slice", (0 == ret) && equal(hash, slice_hash));
+    check("outside", 0 != trustX.sha256Object(0xF1D1, OBJECT_LENGTH, 10, hash));
+
+    trustX.end();
+    return (0 == failures) ? 0 : 1;
+}
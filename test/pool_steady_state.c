@@ -0,0 +1,212 @@
+/**
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \file
+*
+* \brief   Host test of the memory pool. 400 blocking SetData/GetData/CalculateSign/GetRandom commands are run against
+*          the simulated security chip with the command library allocating from a pool. All APDU buffers must come from
+*          the pool, with no heap allocation and never more than one block in use. Pool exhaustion, the heap
+*          fallback and the size overflow check of MemMgmt_Calloc are checked as well.
+*
+*          Build and run on a Linux host from the repository root:
+*          S=src/optiga_trustx; gcc -I$S test/pool_steady_state.c $S/CommandLib.c $S/MemoryMgmt.c $S/Util.c
+*              $S/debug.cpp $S/optiga_comms_ifx_i2c.c $S/ifx_i2c*.c $S/pal_*linux.c $S/pal_os_event.c
+*              $S/pal_i2c_virtual_chip.c -lpthread -o pool_steady_state && ./pool_steady_state
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "optiga_comms.h"
+#include "ifx_i2c_config.h"
+#include "CommandLib.h"
+#include "MemoryMgmt.h"
+#include "pal_os_event.h"
+#include "pal_linux.h"
+
+#define ROUNDS          100
+#define OBJECT_LENGTH   1500
+
+optiga_comms_t optiga_comms = {(void*)&ifx_i2c_context_0, NULL, NULL, 0};
+
+static volatile host_lib_status_t comms_status;
+static pal_i2c_virtual_chip_t chip;
+static uint8_t object_data[OBJECT_LENGTH];
+static pal_i2c_virtual_chip_object_t objects[] = {{0xF1D1, object_data, 0, sizeof(object_data), NULL, 0}};
+//Two blocks of the maximum communication buffer size, misaligned on purpose
+static uint8_t arena[2 * 1600 + 3];
+static uint32_t failures;
+
+static void comms_event_handler(void* p_ctx, host_lib_status_t event)
+{
+    (void)p_ctx;
+    comms_status = event;
+}
+
+//The simulated chip does not implement CalculateSign, answer with a signature of the usual size
+static uint8_t apdu_handler(pal_i2c_virtual_chip_t* p_chip, const uint8_t* p_apdu, uint16_t apdu_len,
+                            uint8_t* p_resp, uint16_t* p_resp_len, uint32_t* p_exec_time_us)
+{
+    if (0x31 == p_apdu[0])
+    {
+        memset(p_resp, 0x30, 70);
+        p_resp[1] = 68;
+        *p_resp_len = 70;
+        *p_exec_time_us = 1000;
+        return 0;
+    }
+    return pal_i2c_virtual_chip_default_apdu_handler(p_chip, p_apdu, apdu_len, p_resp, p_resp_len, p_exec_time_us);
+}
+
+static void check(const char* p_step, int ok)
+{
+    sMemStats_d stats;
+
+    MemMgmt_GetStats(&stats);
+    printf("%-10s %s pool %u heap %u fail %u inuse %u peak %u\n", p_step, ok ? "ok  " : "FAIL",
+           (unsigned)stats.dwPoolAllocs, (unsigned)stats.dwHeapAllocs, (unsigned)stats.dwFailures,
+           (unsigned)stats.wBlocksInUse, (unsigned)stats.wPeakBlocksInUse);
+    if (!ok)
+    {
+        failures++;
+    }
+}
+
+int main(void)
+{
+    static uint8_t read_buffer[1600];
+    sOpenApp_d open_app;
+    sMemPool_d pool;
+    sMemStats_d stats;
+    sSetData_d set_data;
+    sGetData_d get_data;
+    sCmdResponse_d get_resp;
+    sCalcSignOptions_d sign_opt;
+    sRngOptions_d rng_opt;
+    sCmdResponse_d rng_resp;
+    sbBlob_d signature;
+    uint8_t digest[32];
+    uint8_t sign_buffer[80];
+    uint8_t random[32];
+    uint16_t block_size;
+    uint32_t commands_ok = 0;
+    void* p_block[4];
+    int i;
+
+    pal_i2c_virtual_chip_init(&chip, 0x30, apdu_handler, objects, 1);
+    optiga_pal_linux_i2c_0.p_virtual_chip = &chip;
+    optiga_pal_linux_reset_0.p_virtual_chip = &chip;
+    comms_status = OPTIGA_COMMS_BUSY;
+    optiga_comms.upper_layer_handler = comms_event_handler;
+    if (OPTIGA_COMMS_SUCCESS != optiga_comms_open(&optiga_comms))
+    {
+        puts("optiga_comms_open failed");
+        return 1;
+    }
+    while (OPTIGA_COMMS_BUSY == comms_status)
+    {
+        pal_os_event_wait();
+    }
+    CmdLib_SetOptigaCommsContext(&optiga_comms);
+    open_app.eOpenType = eInit;
+    if (CMD_LIB_OK != CmdLib_OpenApplication(&open_app))
+    {
+        puts("CmdLib_OpenApplication failed");
+        return 1;
+    }
+
+    block_size = CmdLib_GetMaxCommsBufferSize();
+    check("blocks", 2 == MemMgmt_InitPool(&pool, arena + 1, sizeof(arena) - 1, block_size, FALSE));
+    MemMgmt_UsePool(&pool);
+
+    for (i = 0; i < OBJECT_LENGTH; i++)
+    {
+        object_data[i] = (uint8_t)(i * 7 + 3);
+    }
+    set_data.wOID = 0xF1D1;
+    set_data.wOffset = 0;
+    set_data.eDataOrMdata = eDATA;
+    set_data.eWriteOption = eERASE_AND_WRITE;
+    set_data.prgbData = object_data;
+    set_data.wLength = OBJECT_LENGTH;
+    get_data.wOID = 0xF1D1;
+    get_data.wOffset = 0;
+    get_data.wLength = 0xFFFF;
+    get_data.eDataOrMdata = eDATA;
+    memset(digest, 0xAB, sizeof(digest));
+    sign_opt.eSignScheme = eECDSA_FIPS_186_3_WITHOUT_HASH;
+    sign_opt.wOIDSignKey = 0xE0F0;
+    sign_opt.sDigestToSign.prgbStream = digest;
+    sign_opt.sDigestToSign.wLen = sizeof(digest);
+    rng_opt.eRngType = eTRNG;
+    rng_opt.wRandomDataLen = sizeof(random);
+
+    for (i = 0; i < ROUNDS; i++)
+    {
+        commands_ok += (CMD_LIB_OK == CmdLib_SetDataObject(&set_data));
+        get_resp.prgbBuffer = read_buffer;
+        get_resp.wBufferLength = sizeof(read_buffer);
+        commands_ok += (CMD_LIB_OK == CmdLib_GetDataObject(&get_data, &get_resp));
+        signature.prgbStream = sign_buffer;
+        signature.wLen = sizeof(sign_buffer);
+        commands_ok += (CMD_LIB_OK == CmdLib_CalculateSign(&sign_opt, &signature));
+        rng_resp.prgbBuffer = random;
+        rng_resp.wBufferLength = sizeof(random);
+        commands_ok += (CMD_LIB_OK == CmdLib_GetRandom(&rng_opt, &rng_resp));
+    }
+    printf("%u/%u commands ok\n", (unsigned)commands_ok, 4 * ROUNDS);
+    //GetData, CalculateSign and GetRandom take an APDU buffer, SetData sends from the user buffer
+    MemMgmt_GetStats(&stats);
+    check("steady", (4 * ROUNDS == commands_ok) && (0 == memcmp(read_buffer, object_data, OBJECT_LENGTH)) &&
+                    (3 * ROUNDS == stats.dwPoolAllocs) && (0 == stats.dwHeapAllocs) && (0 == stats.dwFailures) &&
+                    (0 == stats.wBlocksInUse) && (1 == stats.wPeakBlocksInUse));
+
+    p_block[0] = OCP_MALLOC(10);
+    p_block[1] = OCP_MALLOC(10);
+    p_block[2] = OCP_MALLOC(10);
+    MemMgmt_GetStats(&stats);
+    check("exhausted", (NULL != p_block[0]) && (NULL != p_block[1]) && (NULL == p_block[2]) && (1 == stats.dwFailures));
+    OCP_FREE(p_block[0]);
+    OCP_FREE(p_block[1]);
+
+    MemMgmt_InitPool(&pool, arena, sizeof(arena), block_size, TRUE);
+    p_block[0] = OCP_MALLOC(3000);
+    p_block[1] = OCP_MALLOC(10);
+    p_block[2] = OCP_MALLOC(10);
+    p_block[3] = OCP_MALLOC(10);
+    MemMgmt_GetStats(&stats);
+    check("fallback", (NULL != p_block[0]) && (NULL != p_block[3]) && (2 == stats.dwHeapAllocs) && (2 == stats.wBlocksInUse));
+    for (i = 0; i < 4; i++)
+    {
+        OCP_FREE(p_block[i]);
+    }
+    MemMgmt_GetStats(&stats);
+    check("freed", 0 == stats.wBlocksInUse);
+
+    MemMgmt_SetAllocator(NULL);
+    p_block[0] = OCP_CALLOC(0x10000, 0x10001);
+    MemMgmt_GetStats(&stats);
+    check("overflow", (NULL == p_block[0]) && (2 == stats.dwFailures));
+
+    printf("%u failures\n", (unsigned)failures);
+    return (0 == failures) ? 0 : 1;
+}
@@ -0,0 +1,246 @@
+/**
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \file
+*
+* \brief   Host test of the command scheduler and the awaitable operations on the simulated security chip. Requests
+*          submitted together must run by priority class, earliest deadline first within a class and then in
+*          submission order. A request which could not be started within its deadline is completed with
+*          CMD_LIB_DEADLINE_MISSED without being started, a request already queued is rejected with CMD_LIB_BUSY.
+*          A second command awaited while one is in flight on the same chip gets CMD_LIB_BUSY and the first
+*          coroutine is resumed from the event loop once its command completed.
+*
+*          Build and run on a Linux host from the repository root:
+*          S=src/optiga_trustx; gcc -c -I$S $S/CertificateIndex.c $S/Command*.c $S/IntegrationLib.c
+*              $S/MemoryMgmt.c $S/ObjectDump.c $S/Util.c $S/optiga_comms_ifx_i2c.c $S/ifx_i2c*.c $S/pal_*linux.c
+*              $S/pal_os_event.c $S/pal_i2c_virtual_chip.c src/third_crypto/uECC.c && g++ -std=c++20 -Isrc -I$S
+*              test/scheduler_order.cpp src/OPTIGATrustX.cpp src/aes/AES.cpp $S/debug.cpp *.o -lpthread
+*              -o scheduler_order && ./scheduler_order
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "OPTIGATrustX.h"
+#include "optiga_trustx/CommandScheduler.h"
+#include "optiga_trustx/IntegrationLib.h"
+#include "optiga_trustx/pal_linux.h"
+extern "C" {
+#include "optiga_trustx/CryptoLib.h"
+}
+
+#define REQUEST_COUNT   6
+#define RANDOM_LENGTH   32
+//Command code of GetRandom without the flags
+#define CMD_GET_RANDOM  0x0C
+
+extern "C" {
+//The crypto library is not part of the tree, the scheduled commands do not use it
+int32_t CryptoLib_ParseCertificate(const sbBlob_d *PpsRawCertificate,sCertificate_d *PpsCertificate)
+{
+    (void)PpsRawCertificate;
+    (void)PpsCertificate;
+    return (int32_t)INT_LIB_ERROR;
+}
+
+int32_t CryptoLib_VerifySignature(const sSignatureVector_d *PpsSignatureVector)
+{
+    (void)PpsSignatureVector;
+    return (int32_t)INT_LIB_ERROR;
+}
+
+int32_t CryptoLib_GetRandom(uint16_t PwRandomDataLength,sCmdResponse_d *PpsResponse)
+{
+    (void)PwRandomDataLength;
+    (void)PpsResponse;
+    return (int32_t)INT_LIB_ERROR;
+}
+}
+
+//GetRandom started by a scheduled request
+typedef struct random_command
+{
+    int id;
+    int started;
+    int32_t status;
+    sRngOptions_d opt;
+    sCmdResponse_d resp;
+    uint8_t random[RANDOM_LENGTH];
+    sCmdSchedRequest_d request;
+} random_command_t;
+
+//Coroutine started right away and destroyed once it returns
+struct task
+{
+    struct promise_type
+    {
+        task get_return_object(void) { return {}; }
+        std::suspend_never initial_suspend(void) { return {}; }
+        std::suspend_never final_suspend(void) noexcept { return {}; }
+        void return_void(void) {}
+        void unhandled_exception(void) { abort(); }
+    };
+};
+
+static pal_i2c_virtual_chip_t chip;
+static random_command_t commands[REQUEST_COUNT];
+static int order[REQUEST_COUNT];
+static int completed;
+static uint32_t failures;
+
+static int32_t start_random(void* p_ctx, pFCmdLibCallback_d callback, void* p_callback_ctx)
+{
+    random_command_t* p_command = (random_command_t*)p_ctx;
+
+    p_command->started = 1;
+    p_command->opt.eRngType = eTRNG;
+    p_command->opt.wRandomDataLen = RANDOM_LENGTH;
+    p_command->resp.prgbBuffer = p_command->random;
+    p_command->resp.wBufferLength = RANDOM_LENGTH;
+    p_command->resp.wRespLength = 0;
+    return CmdLib_GetRandomAsync(&p_command->opt, &p_command->resp, callback, p_callback_ctx);
+}
+
+static void random_done(void* p_ctx, int32_t status)
+{
+    random_command_t* p_command = (random_command_t*)p_ctx;
+
+    p_command->status = status;
+    order[completed++] = p_command->id;
+}
+
+static void submit(sCmdScheduler_d* p_scheduler, int id, eCmdPriority_d priority, uint32_t deadline_us)
+{
+    random_command_t* p_command = &commands[id];
+
+    memset(p_command, 0, sizeof(*p_command));
+    p_command->id = id;
+    CmdSched_InitRequest(&p_command->request, start_random, p_command, priority, deadline_us, random_done, p_command);
+    if (CMD_LIB_OK != CmdSched_Submit(p_scheduler, &p_command->request))
+    {
+        printf("submit %d failed\n", id);
+        failures++;
+    }
+}
+
+static void run_queue(int count)
+{
+    completed = 0;
+    while (completed < count)
+    {
+        pal_os_event_wait();
+    }
+}
+
+static void check(const char* p_step, int ok)
+{
+    printf("%-10s %s\n", p_step, ok ? "ok" : "FAIL");
+    if (!ok)
+    {
+        failures++;
+    }
+}
+
+static int awaited;
+static int resumed_early;
+static int32_t await_status[2];
+static uint8_t await_random[2][RANDOM_LENGTH];
+
+static task await_random_task(int id)
+{
+    await_status[id] = co_await trustX.getRandomAsync(RANDOM_LENGTH, await_random[id]);
+    awaited++;
+}
+
+int main(void)
+{
+    static const int edf_order[REQUEST_COUNT] = {3, 4, 2, 1, 5, 0};
+    sCmdScheduler_d scheduler;
+    sCmdLibContext_d* p_context;
+    int ok;
+    int i;
+
+    pal_i2c_virtual_chip_init(&chip, 0x30, NULL, NULL, 0);
+    optiga_pal_linux_i2c_0.p_virtual_chip = &chip;
+    optiga_pal_linux_reset_0.p_virtual_chip = &chip;
+    if (0 != trustX.begin())
+    {
+        puts("begin failed");
+        return 1;
+    }
+    //begin() left the context of the chip selected
+    p_context = CmdLib_SelectContext(NULL);
+    CmdLib_SelectContext(p_context);
+    CmdSched_Init(&scheduler, p_context);
+
+    //Submitted together, dispatched by priority class, deadline and submission order
+    chip.execution_time_us[CMD_GET_RANDOM] = 1000;
+    submit(&scheduler, 0, eCMD_PRIO_BACKGROUND, 0);
+    submit(&scheduler, 1, eCMD_PRIO_NORMAL, 0);
+    submit(&scheduler, 2, eCMD_PRIO_NORMAL, 900000);
+    submit(&scheduler, 3, eCMD_PRIO_HIGH, 0);
+    submit(&scheduler, 4, eCMD_PRIO_NORMAL, 800000);
+    submit(&scheduler, 5, eCMD_PRIO_NORMAL, 0);
+    check("queued", (int32_t)CMD_LIB_BUSY == CmdSched_Submit(&scheduler, &commands[0].request));
+    run_queue(REQUEST_COUNT);
+    ok = 1;
+    for (i = 0; i < REQUEST_COUNT; i++)
+    {
+        ok &= (edf_order[i] == order[i]) && (CMD_LIB_OK == commands[order[i]].status) &&
+              (RANDOM_LENGTH == commands[order[i]].resp.wRespLength);
+    }
+    printf("order %d %d %d %d %d %d\n", order[0], order[1], order[2], order[3], order[4], order[5]);
+    check("edf", ok);
+
+    //The long command ahead makes the request with the short deadline miss it
+    chip.execution_time_us[CMD_GET_RANDOM] = 50000;
+    submit(&scheduler, 0, eCMD_PRIO_HIGH, 0);
+    submit(&scheduler, 1, eCMD_PRIO_NORMAL, 10000);
+    submit(&scheduler, 2, eCMD_PRIO_NORMAL, 1000000);
+    run_queue(3);
+    check("deadline", (CMD_LIB_OK == commands[0].status) && ((int32_t)CMD_LIB_DEADLINE_MISSED == commands[1].status) &&
+                      (0 == commands[1].started) && (commands[1].request.dwQueueTime >= 10000) &&
+                      (CMD_LIB_OK == commands[2].status) && (0 == order[0]) && (1 == order[1]));
+
+    //The second command on the chip is rejected, the first coroutine resumes once its command completed
+    chip.execution_time_us[CMD_GET_RANDOM] = 20000;
+    awaited = 0;
+    memset(await_random, 0, sizeof(await_random));
+    await_random_task(0);
+    resumed_early = awaited;
+    await_random_task(1);
+    check("busy", (1 == awaited) && ((int32_t)CMD_LIB_BUSY == await_status[1]));
+    while (awaited < 2)
+    {
+        pal_os_event_wait();
+    }
+    ok = 0;
+    for (i = 0; i < RANDOM_LENGTH; i++)
+    {
+        ok |= await_random[0][i];
+    }
+    check("resumed", (0 == resumed_early) && (0 == await_status[0]) && (0 != ok));
+
+    trustX.end();
+    return (0 == failures) ? 0 : 1;
+}